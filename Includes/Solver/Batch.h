@@ -0,0 +1,73 @@
+/** @file Batch.h
+ * Solve all grids of a stream one after the other, using one or several threads, and print one line per grid.
+ * @author Adrien RICCIARDI
+ * @version 1.0 : 17/10/2026
+ * @version 1.1 : 17/10/2026, the solvers configuration can be provided.
+ * @version 1.2 : 17/10/2026, the 9x9 grids can be propagated several at once.
+ * @version 1.3 : 17/10/2026, the solutions of each grid can be counted, the options are grouped in a configuration.
+ * @version 1.4 : 17/10/2026, the statistics of each grid solving can be written to a stream.
+ * @version 1.5 : 17/10/2026, the solving of each grid can be limited in time and in loops.
+ * @version 1.6 : 17/10/2026, the grids can be read from a file mapped in memory.
+ * @version 1.7 : 17/10/2026, the grids can be read from a packed grids file, the grids and their solutions can be written to a packed grids file.
+ * @version 1.8 : 17/10/2026, the grids are read, solved and written by pipelined stages when several threads are used.
+ */
+#ifndef H_BATCH_H
+#define H_BATCH_H
+
+#include <Corpus.h>
+#include <Packed_Grids.h>
+#include <Solver.h>
+#include <stdio.h>
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** How the grids of a batch are solved. */
+typedef struct
+{
+	int Threads_Count; //! How many threads solve the grids (use 0 to have one thread per processor core).
+	int Is_Threads_Pinning_Enabled; //! Set to 1 to bind each thread to a processor core, set to 0 to let the operating system schedule the threads.
+	int Is_Lanes_Solver_Enabled; //! Set to 1 to propagate the 9x9 grids several at once with the lanes solver, the grids needing a guess are then solved one by one (this is used only with the backtracking engine and when the propagation is enabled). Set to 0 to solve all grids one by one.
+	int Is_Counting_Enabled; //! Set to 1 to print the solutions count of each grid instead of its solution.
+	unsigned long long Solutions_Limit; //! When counting, the counting of a grid stops when this many solutions are found (use 0 to count all solutions, use 2 to check that each grid has a single solution).
+	int Is_Solutions_Display_Enabled; //! When counting, set to 1 to print each found solution before the grid solutions count. The grids are then solved by a single thread without the lanes solver, so the solutions are printed in the grids order.
+	unsigned long long Time_Limit; //! The solving of a grid is stopped after this many microseconds, the grid is then reported as timed out (use 0 for no limit).
+	unsigned long long Loops_Limit; //! The solving of a grid is stopped after this many loops, the grid is then reported as timed out (use 0 for no limit).
+	FILE *Statistics_File; //! When not NULL, receive the statistics record of each solved grid (see SolverWriteStatisticsRecord()), in the solving order. The grids are then all solved by the solvers, without the lanes solver.
+	FILE *Packed_Output_File; //! When not NULL, receive a packed grids file holding each grid with its solution, in the grids order (see Packed_Grids.h). The file holds the grids having the size of the first grid, it can't be used when counting.
+	TSolverConfiguration Solver_Configuration; //! The configuration of all solvers.
+} TBatchConfiguration;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Fill a batch configuration with the default values (a single thread, the lanes solver enabled, no counting, no limits, no statistics, no packed output and the default solver configuration).
+ * @param Pointer_Configuration On output, contain the default configuration.
+ */
+void BatchGetDefaultConfiguration(TBatchConfiguration *Pointer_Configuration);
+
+/** Solve all grids of a stream. A line is printed for each grid, in the grids order : the solved grid on a single line (or the solutions count when counting), "Unsolvable" if the grid has no solution, "Timed out" if the solving reached a limit or "Bad grid" if the grid could not be loaded.
+ * @param File The stream to read grids from.
+ * @param Pointer_Configuration How to solve the grids.
+ * @return EXIT_SUCCESS if all grids were solved (or have at least one solution when counting),
+ * @return EXIT_FAILURE if at least one grid could not be solved or if the threads could not be started.
+ */
+int BatchSolve(FILE *File, TBatchConfiguration *Pointer_Configuration);
+
+/** Solve all grids of a file mapped in memory, the grid characters are converted without being copied. The same lines than BatchSolve() are printed, and each bad grid is also reported on the error output with its line and byte offset in the file.
+ * @param Pointer_Corpus The mapped file, its grids are read from the current offset.
+ * @param Pointer_Configuration How to solve the grids.
+ * @return EXIT_SUCCESS if all grids were solved (or have at least one solution when counting),
+ * @return EXIT_FAILURE if at least one grid could not be solved or if the threads could not be started.
+ */
+int BatchSolveCorpus(TCorpus *Pointer_Corpus, TBatchConfiguration *Pointer_Configuration);
+
+/** Solve all grids of a packed grids file. The same lines than BatchSolve() are printed, and each bad grid is also reported on the error output with its record index.
+ * @param Pointer_Packed_Grids The packed grids file opened for reading, its grids are read from the next record.
+ * @param Pointer_Configuration How to solve the grids.
+ * @return EXIT_SUCCESS if all grids were solved (or have at least one solution when counting),
+ * @return EXIT_FAILURE if at least one grid could not be solved or if the threads could not be started.
+ */
+int BatchSolvePacked(TPackedGrids *Pointer_Packed_Grids, TBatchConfiguration *Pointer_Configuration);
+
+#endif
@@ -0,0 +1,64 @@
+/** @file Candidates.h
+ * Compute the allowed numbers of all cells of a grid at once. Each row bitmask is broadcast to all cells of the row and combined with the column and square bitmasks of several cells at the same time with the SIMD instructions of the processor (AVX2 or SSE4.2), and the same pass counts the allowed numbers of each cell, lists the naked singles and detects the empty cells allowing no number.
+ * The instruction set is selected at run time according to the processor, a scalar version is used when no supported SIMD instruction set is available.
+ * @author Adrien RICCIARDI
+ * @version 1.0 : 17/10/2026
+ */
+#ifndef H_CANDIDATES_H
+#define H_CANDIDATES_H
+
+#include <Configuration.h>
+#include <Grid.h>
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+/** Use the best instruction set supported by the processor. */
+#define CANDIDATES_INSTRUCTION_SET_AUTOMATIC 0
+/** Compute one cell at a time. */
+#define CANDIDATES_INSTRUCTION_SET_SCALAR 1
+/** Compute 128 bits of bitmasks at a time with the SSE4.2 instructions. */
+#define CANDIDATES_INSTRUCTION_SET_SSE4 2
+/** Compute 256 bits of bitmasks at a time with the AVX2 instructions. */
+#define CANDIDATES_INSTRUCTION_SET_AVX2 3
+
+/** The arrays have room for some more cells than needed, so the last vector of a row can go beyond the row end. */
+#define CANDIDATES_PADDING_CELLS_COUNT 8
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** The allowed numbers of all cells of a grid. */
+typedef struct
+{
+	TGridBitmask Cells_Candidates[GRID_MAXIMUM_CELLS_COUNT + CANDIDATES_PADDING_CELLS_COUNT]; //! The allowed numbers of each cell, the filled cells allow no number.
+	unsigned char Cells_Candidates_Count[GRID_MAXIMUM_CELLS_COUNT + CANDIDATES_PADDING_CELLS_COUNT]; //! How many numbers each cell allows.
+	unsigned short Naked_Singles[GRID_MAXIMUM_CELLS_COUNT]; //! The indexes of the empty cells allowing a single number, in increasing order.
+	int Naked_Singles_Count; //! How many cells are in the naked singles list.
+	TGridBitmask Bands_Bitmasks[CONFIGURATION_GRID_MAXIMUM_SIZE][CONFIGURATION_GRID_MAXIMUM_SIZE + CANDIDATES_PADDING_CELLS_COUNT]; //! For each horizontal band of squares, the bitmask of each column combined with the bitmask of its square in the band (this is a work area).
+} TCandidates;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Choose the instruction set used by all following computations, in all threads. The best instruction set supported by the processor is used if this function is never called.
+ * @param Instruction_Set The instruction set (use CANDIDATES_INSTRUCTION_SET_XXX).
+ * @return 0 if the instruction set was selected,
+ * @return -1 if the processor does not support this instruction set (the current instruction set is kept).
+ */
+int CandidatesSetInstructionSet(int Instruction_Set);
+
+/** Tell which instruction set is used.
+ * @return CANDIDATES_INSTRUCTION_SET_SCALAR, CANDIDATES_INSTRUCTION_SET_SSE4 or CANDIDATES_INSTRUCTION_SET_AVX2.
+ */
+int CandidatesGetInstructionSet(void);
+
+/** Compute the allowed numbers of all cells, their count and the naked singles list.
+ * @param Pointer_Candidates On output, contain the allowed numbers of all cells.
+ * @param Pointer_Grid The grid.
+ * @return 0 if all empty cells allow at least one number,
+ * @return -1 if an empty cell allows no number (all results are computed anyway).
+ */
+int CandidatesCompute(TCandidates *Pointer_Candidates, TGrid *Pointer_Grid);
+
+#endif
@@ -0,0 +1,50 @@
+/** @file Canonical.h
+ * Find the canonical form of a grid, which is the same for all grids that are the same puzzle under the Sudoku symmetries : the numbers relabeling, the rows permutations inside a band (a row of squares), the bands permutations, the same permutations of the columns and of the stacks (the columns of squares), and the transposition when the squares are square (the 6x6 and 12x12 grids can't be transposed, their squares would get another shape).
+ * The canonical form is the smallest transformed grid when the cells are read in the rows order, an empty cell being smaller than any number and the numbers being relabeled in the order they first appear. When the grid has at least as many empty cells as its size, the transformed grids are compared by their pattern (which cells are empty) first, and then by their numbers, so the numbers orders are tried only for the rows and the columns giving the smallest pattern. It is built one row at a time, only the rows and the columns giving the smallest cells so far are tried, and the lines having the same cells as an already tried line are skipped, so only the grids having many symmetries of their own take some time.
+ * @author Adrien RICCIARDI
+ * @version 1.0 : 17/10/2026
+ */
+#ifndef H_CANONICAL_H
+#define H_CANONICAL_H
+
+#include <Grid.h>
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** A symmetry transformation of a grid, the grid is transposed first (when requested), then its rows and its columns are permuted and its numbers are relabeled. */
+typedef struct
+{
+	int Is_Transposed; //! Set to 1 when the grid rows become its columns before the other transformations.
+	unsigned char Rows[CONFIGURATION_GRID_MAXIMUM_SIZE]; //! The transformed grid row i is the row Rows[i] of the (transposed) grid.
+	unsigned char Columns[CONFIGURATION_GRID_MAXIMUM_SIZE]; //! The transformed grid column i is the column Columns[i] of the (transposed) grid.
+	unsigned char Numbers[CONFIGURATION_GRID_MAXIMUM_SIZE]; //! The number N becomes the number Numbers[N].
+} TCanonicalTransformation;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Find the canonical form of a grid and the transformation leading to it.
+ * @param Pointer_Grid The grid, it is not modified.
+ * @param Pointer_Canonical_Grid On output, contain the canonical grid. It must not be the grid.
+ * @param Pointer_Transformation On output, contain the transformation turning the grid into the canonical grid. The numbers missing from the grid get the remaining canonical numbers in increasing order, so the transformation also applies to the grid solutions.
+ * @return 0 if the canonical form was found,
+ * @return -1 if the grid is bigger than 12x12 and has less empty cells than its size (its canonical form would take too long to find, as the patterns of such grids can't tell the rows and the columns apart).
+ */
+int CanonicalGetForm(TGrid *Pointer_Grid, TGrid *Pointer_Canonical_Grid, TCanonicalTransformation *Pointer_Transformation);
+
+/** Transform a grid, a solution transformed like its grid is a solution of the transformed grid.
+ * @param Pointer_Grid The grid.
+ * @param Pointer_Transformation The transformation, made for grids of this size.
+ * @param Pointer_Transformed_Grid On output, contain the transformed grid. It must not be the grid.
+ */
+void CanonicalTransformGrid(TGrid *Pointer_Grid, TCanonicalTransformation *Pointer_Transformation, TGrid *Pointer_Transformed_Grid);
+
+/** Undo the transformation of a grid, like to bring the solution of a canonical grid back to the grids having this canonical form.
+ * @param Pointer_Transformed_Grid The transformed grid.
+ * @param Pointer_Transformation The transformation that gave the transformed grid.
+ * @param Pointer_Grid On output, contain the grid before its transformation. It must not be the transformed grid.
+ */
+void CanonicalRestoreGrid(TGrid *Pointer_Transformed_Grid, TCanonicalTransformation *Pointer_Transformation, TGrid *Pointer_Grid);
+
+#endif
@@ -0,0 +1,153 @@
+/** @file Cells_Buckets.h
+ * An index of the empty cells sorted by their count of allowed numbers, so the most constrained cell can be found without parsing the whole grid. Each bucket is a doubly linked list of the cells having the same allowed numbers count.
+ * @author Adrien RICCIARDI
+ * @version 1.0 : 17/10/2026
+ * @version 1.1 : 17/10/2026, the functions used at each search step are inlined in the callers.
+ */
+#ifndef H_CELLS_BUCKETS_H
+#define H_CELLS_BUCKETS_H
+
+#include <assert.h>
+#include <Configuration.h>
+#include <Grid.h>
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+/** There is one bucket for each allowed numbers count, from 0 to the grid size. */
+#define CELLS_BUCKETS_COUNT (CONFIGURATION_GRID_MAXIMUM_SIZE + 1)
+
+/** Mark the end of a bucket list. */
+#define CELLS_BUCKETS_NO_CELL -1
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** The buckets index. */
+typedef struct
+{
+	short Buckets_Head[CELLS_BUCKETS_COUNT]; //! The first cell of each bucket.
+	short Next_Cells[GRID_MAXIMUM_CELLS_COUNT]; //! The next cell in the same bucket.
+	short Previous_Cells[GRID_MAXIMUM_CELLS_COUNT]; //! The previous cell in the same bucket.
+	unsigned char Cells_Count[GRID_MAXIMUM_CELLS_COUNT]; //! The allowed numbers count of each indexed cell, this is the bucket the cell belongs to.
+	int Indexed_Cells_Count; //! How many cells are in the index.
+} TCellsBuckets;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Empty all buckets.
+ * @param Pointer_Buckets The index.
+ */
+void CellsBucketsInitialize(TCellsBuckets *Pointer_Buckets);
+
+/** Insert a cell at the head of a bucket.
+ * @param Pointer_Buckets The index.
+ * @param Cell_Index The cell index.
+ * @param Count The bucket.
+ * @note This is an internal function, use the other ones.
+ */
+static inline void CellsBucketsLink(TCellsBuckets *Pointer_Buckets, int Cell_Index, int Count)
+{
+	int Head_Cell_Index;
+	
+	Head_Cell_Index = Pointer_Buckets->Buckets_Head[Count];
+	Pointer_Buckets->Next_Cells[Cell_Index] = Head_Cell_Index;
+	Pointer_Buckets->Previous_Cells[Cell_Index] = CELLS_BUCKETS_NO_CELL;
+	if (Head_Cell_Index != CELLS_BUCKETS_NO_CELL) Pointer_Buckets->Previous_Cells[Head_Cell_Index] = Cell_Index;
+	Pointer_Buckets->Buckets_Head[Count] = Cell_Index;
+	Pointer_Buckets->Cells_Count[Cell_Index] = Count;
+}
+
+/** Remove a cell from its bucket.
+ * @param Pointer_Buckets The index.
+ * @param Cell_Index The cell index.
+ * @note This is an internal function, use the other ones.
+ */
+static inline void CellsBucketsUnlink(TCellsBuckets *Pointer_Buckets, int Cell_Index)
+{
+	int Next_Cell_Index, Previous_Cell_Index;
+	
+	Next_Cell_Index = Pointer_Buckets->Next_Cells[Cell_Index];
+	Previous_Cell_Index = Pointer_Buckets->Previous_Cells[Cell_Index];
+	if (Previous_Cell_Index == CELLS_BUCKETS_NO_CELL) Pointer_Buckets->Buckets_Head[Pointer_Buckets->Cells_Count[Cell_Index]] = Next_Cell_Index;
+	else Pointer_Buckets->Next_Cells[Previous_Cell_Index] = Next_Cell_Index;
+	if (Next_Cell_Index != CELLS_BUCKETS_NO_CELL) Pointer_Buckets->Previous_Cells[Next_Cell_Index] = Previous_Cell_Index;
+}
+
+/** Add a cell to the index.
+ * @param Pointer_Buckets The index.
+ * @param Cell_Index The cell index (Row * Grid_Size + Column).
+ * @param Count How many numbers are allowed in the cell.
+ * @warning The cell must not be already in the index.
+ */
+static inline void CellsBucketsAdd(TCellsBuckets *Pointer_Buckets, int Cell_Index, int Count)
+{
+	assert((Count >= 0) && (Count < CELLS_BUCKETS_COUNT));
+	
+	CellsBucketsLink(Pointer_Buckets, Cell_Index, Count);
+	Pointer_Buckets->Indexed_Cells_Count++;
+}
+
+/** Remove a cell from the index.
+ * @param Pointer_Buckets The index.
+ * @param Cell_Index The cell index.
+ * @warning The cell must be in the index.
+ */
+static inline void CellsBucketsRemove(TCellsBuckets *Pointer_Buckets, int Cell_Index)
+{
+	assert(Pointer_Buckets->Indexed_Cells_Count > 0);
+	
+	CellsBucketsUnlink(Pointer_Buckets, Cell_Index);
+	Pointer_Buckets->Indexed_Cells_Count--;
+}
+
+/** Move an indexed cell to the bucket of the previous allowed numbers count.
+ * @param Pointer_Buckets The index.
+ * @param Cell_Index The cell index.
+ */
+static inline void CellsBucketsDecrement(TCellsBuckets *Pointer_Buckets, int Cell_Index)
+{
+	int Count;
+	
+	Count = Pointer_Buckets->Cells_Count[Cell_Index];
+	assert(Count > 0);
+	
+	CellsBucketsUnlink(Pointer_Buckets, Cell_Index);
+	CellsBucketsLink(Pointer_Buckets, Cell_Index, Count - 1);
+}
+
+/** Move an indexed cell to the bucket of the next allowed numbers count.
+ * @param Pointer_Buckets The index.
+ * @param Cell_Index The cell index.
+ */
+static inline void CellsBucketsIncrement(TCellsBuckets *Pointer_Buckets, int Cell_Index)
+{
+	int Count;
+	
+	Count = Pointer_Buckets->Cells_Count[Cell_Index];
+	assert(Count < CELLS_BUCKETS_COUNT - 1);
+	
+	CellsBucketsUnlink(Pointer_Buckets, Cell_Index);
+	CellsBucketsLink(Pointer_Buckets, Cell_Index, Count + 1);
+}
+
+/** Get the indexed cell with the fewest allowed numbers, without removing it from the index.
+ * @param Pointer_Buckets The index.
+ * @param Pointer_Cell_Index On output, contain the cell index.
+ * @return 1 if a cell was found,
+ * @return 0 if the index is empty.
+ */
+static inline int CellsBucketsGetMostConstrainedCell(TCellsBuckets *Pointer_Buckets, int *Pointer_Cell_Index)
+{
+	int Count;
+	
+	if (Pointer_Buckets->Indexed_Cells_Count == 0) return 0;
+	
+	// The lowest non-empty bucket holds the most constrained cells
+	for (Count = 0; Pointer_Buckets->Buckets_Head[Count] == CELLS_BUCKETS_NO_CELL; Count++) assert(Count < CELLS_BUCKETS_COUNT - 1);
+	*Pointer_Cell_Index = Pointer_Buckets->Buckets_Head[Count];
+	return 1;
+}
+
+#endif
@@ -1,34 +1,65 @@
 /** @file Cells_Stack.h
- * A very simple implementation of an unique stack gathering all empty cells.
+ * A very simple implementation of a stack gathering all empty cells.
  * @author Adrien RICCIARDI
  * @version 1.0 : 17/04/2014
+ * @version 1.1 : 17/10/2026, the stack content is stored in a caller-provided structure, so several stacks can be used simultaneously.
  */
 #ifndef H_CELLS_STACK_H
 #define H_CELLS_STACK_H
 
+#include <Configuration.h>
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+/** How many elements the stack can hold. */
+#define CELLS_STACK_SIZE (CONFIGURATION_GRID_MAXIMUM_SIZE * CONFIGURATION_GRID_MAXIMUM_SIZE)
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** A cell coordinates. */
+typedef struct
+{
+	int Row; //! The cell row coordinate.
+	int Column; //! The cell column coordinate.
+} TCellCoordinates;
+
+/** A stack of cells. */
+typedef struct
+{
+	TCellCoordinates Cells[CELLS_STACK_SIZE]; //! The stack content.
+	int Pointer; //! The stack pointer. This is a fully ascending stack.
+} TCellsStack;
+
 //-------------------------------------------------------------------------------------------------
 // Functions
 //-------------------------------------------------------------------------------------------------
-/** Set the stack as empty. */
-void CellsStackInitialize(void);
+/** Set the stack as empty.
+ * @param Pointer_Stack The stack.
+ */
+void CellsStackInitialize(TCellsStack *Pointer_Stack);
 
 /** Push a cell coordinates on the top of the stack.
+ * @param Pointer_Stack The stack.
  * @param Cell_Row The cell row coordinate.
  * @param Cell_Column The cell column coordinate.
  */
-void CellsStackPush(int Cell_Row, int Cell_Column);
+void CellsStackPush(TCellsStack *Pointer_Stack, int Cell_Row, int Cell_Column);
 
 /** Get the top of the stack without removing it.
+ * @param Pointer_Stack The stack.
  * @param Pointer_Cell_Row On output, will contain the top of stack cell's row coordinate.
  * @param Pointer_Cell_Column On output, will contain the top of stack cell's column coordinate.
  * @return 1 if the cell was correctly poped,
  * @return 0 if the stack is empty.
  */
-int CellsStackReadTop(int *Pointer_Cell_Row, int *Pointer_Cell_Column);
+int CellsStackReadTop(TCellsStack *Pointer_Stack, int *Pointer_Cell_Row, int *Pointer_Cell_Column);
 
 /** Remove the top of the stack.
+ * @param Pointer_Stack The stack.
  * @note Make sure the stack is not empty before calling this function.
  */
-void CellsStackRemoveTop(void);
+void CellsStackRemoveTop(TCellsStack *Pointer_Stack);
 
 #endif
@@ -0,0 +1,52 @@
+/** @file Checkpoint.h
+ * Save the state of a long solving to a file from time to time, so the solving can be resumed after the program was stopped. A checkpoint file holds the grids of all unexplored subtrees of the search tree (see SolverWriteCheckpoint()), one grid per line, so it is a grids file that can be resumed as a whole or split into several files resumed on different computers.
+ * @author Adrien RICCIARDI
+ * @version 1.0 : 17/10/2026
+ */
+#ifndef H_CHECKPOINT_H
+#define H_CHECKPOINT_H
+
+#include <Solver.h>
+#include <stdatomic.h>
+#include <stdio.h>
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** A checkpointed solving. */
+typedef struct
+{
+	char *String_File_Name; //! The checkpoint file, it is replaced at once by each new checkpoint.
+	unsigned long long Period; //! How many microseconds between two checkpoints.
+	unsigned long long Next_Checkpoint_Time; //! When the next checkpoint is due, in nanoseconds of the monotonic clock.
+	atomic_int *Pointer_Request_Flag; //! When not NULL, a checkpoint is written as soon as possible after the pointed value becomes different from 0 (the value is then cleared).
+	FILE *Pending_Grids_File; //! The grids to solve after the current one, or NULL if there is none.
+	unsigned long long Checkpoints_Count; //! How many checkpoints were written.
+	int Is_Write_Failed; //! Set to 1 when the last checkpoint could not be written.
+} TCheckpoint;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Initialize a checkpointed solving.
+ * @param Pointer_Checkpoint The checkpointed solving.
+ * @param String_File_Name The checkpoint file.
+ * @param Period How many microseconds between two checkpoints.
+ * @param Pointer_Request_Flag A checkpoint is written as soon as possible after the pointed value becomes different from 0 (a signal handler can set it for instance). Use NULL if the checkpoints are only periodic.
+ */
+void CheckpointInitialize(TCheckpoint *Pointer_Checkpoint, char *String_File_Name, unsigned long long Period, atomic_int *Pointer_Request_Flag);
+
+/** Solve the grid loaded in a solver context with the backtracking engine, then the pending grids one after the other until one of them is solved. A checkpoint is written periodically, on request and when the solving is stopped by a cancellation or a limit, it contains the unexplored subtrees of the current grid followed by the pending grids not loaded yet. The checkpoint file is removed when the whole search is over.
+ * @param Pointer_Checkpoint The checkpointed solving.
+ * @param Pointer_Solver The solver context, its statistics are the sum of the statistics of all solved grids on output. Its time limit and loops limit apply to the whole solving, not to each grid.
+ * @param Pending_Grids_File The grids to solve when the loaded grid has no solution (a resumed checkpoint file for instance), it must be a seekable file. Use NULL if there is no other grid.
+ * @return SOLVER_RESULT_SOLVED if a grid was solved (the solver context holds the solution),
+ * @return SOLVER_RESULT_UNSOLVABLE if no grid has a solution,
+ * @return SOLVER_RESULT_CANCELLED if the solving was cancelled,
+ * @return SOLVER_RESULT_TIMED_OUT if the solving of a grid reached its time limit or its loops limit,
+ * @return -3 if a pending grid is bad.
+ * @note The solving is always done by the calling thread, and the solver context must not use the dancing links engine because its state can't be saved.
+ */
+int CheckpointSolve(TCheckpoint *Pointer_Checkpoint, TSolver *Pointer_Solver, FILE *Pending_Grids_File);
+
+#endif
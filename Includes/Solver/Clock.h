@@ -0,0 +1,25 @@
+/** @file Clock.h
+ * The monotonic clock shared by the time limits, the periodic tasks and the durations measures.
+ * @author Adrien RICCIARDI
+ * @version 1.0 : 17/10/2026
+ */
+#ifndef H_CLOCK_H
+#define H_CLOCK_H
+
+#include <time.h>
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Get the current time. The clock is not changed by the system time adjustments, so it can measure the durations.
+ * @return The time in nanoseconds, from an unspecified starting point.
+ */
+static inline unsigned long long ClockGetTime(void)
+{
+	struct timespec Time;
+	
+	clock_gettime(CLOCK_MONOTONIC, &Time);
+	return (unsigned long long) Time.tv_sec * 1000000000ULL + Time.tv_nsec;
+}
+
+#endif
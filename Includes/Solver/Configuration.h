@@ -2,6 +2,9 @@
  * Contain global configuration flags of the program.
  * @author Adrien RICCIARDI
  * @version 1.0 : 15/06/2013
+ * @version 1.1 : 17/10/2026, grids can be up to 64x64 and the maximum size can be chosen at build time.
+ * @version 1.2 : 17/10/2026, the search instrumentation can be built.
+ * @version 1.3 : 17/10/2026, grids are up to 32x32 by default so the bitmasks stay 32-bit wide, the 64x64 grids need a dedicated build.
  */
 #ifndef H_CONFIGURATION_H
 #define H_CONFIGURATION_H
@@ -9,7 +12,14 @@
 //-------------------------------------------------------------------------------------------------
 // Constants
 //-------------------------------------------------------------------------------------------------
-/** Width and height of a grid in cells (a grid is CONFIGURATION_GRID_MAXIMUM_SIZE x CONFIGURATION_GRID_MAXIMUM_SIZE). */
-#define CONFIGURATION_GRID_MAXIMUM_SIZE 16
+/** Width and height of a grid in cells (a grid is CONFIGURATION_GRID_MAXIMUM_SIZE x CONFIGURATION_GRID_MAXIMUM_SIZE). The default size keeps 32-bit bitmasks (so the vectorized code handles twice as many cells at once). It can be raised at build time to 64 (with -DCONFIGURATION_GRID_MAXIMUM_SIZE=64, or with "make big_grids") to solve the 36x36, 49x49 and 64x64 grids with 64-bit bitmasks, or lowered (to 16 for instance) to get smaller contexts. */
+#ifndef CONFIGURATION_GRID_MAXIMUM_SIZE
+	#define CONFIGURATION_GRID_MAXIMUM_SIZE 32
+#endif
+
+/** Set to 1 at build time (with -DCONFIGURATION_SOLVER_INSTRUMENTATION=1) to measure the search tree depths, the branching, the propagation and the solving phases durations (see Instrumentation.h). The instrumentation is not built by default, so it does not slow the search down. */
+#ifndef CONFIGURATION_SOLVER_INSTRUMENTATION
+	#define CONFIGURATION_SOLVER_INSTRUMENTATION 0
+#endif
 
 #endif
\ No newline at end of file
@@ -0,0 +1,81 @@
+/** @file Corpus.h
+ * Read the grids of a huge grids file without copying it : the file is mapped in memory and each grid record is handed out as a view of the mapped characters, which are directly converted to the grid cells. The grids up to 16x16 are converted and validated 16 characters at a time with the SSE4.2 instructions (a 16-byte lookup table classifies the '0' to 'F' and '.' characters), the other grids and the processors without SSE4.2 use the scalar conversion.
+ * The records are found with the same rules than GridLoadFromStream(), a bad record is reported with its line and byte offset and the reading continues with the next record.
+ * @author Adrien RICCIARDI
+ * @version 1.0 : 17/10/2026
+ */
+#ifndef H_CORPUS_H
+#define H_CORPUS_H
+
+#include <Grid.h>
+#include <stddef.h>
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** A grids file mapped in memory. */
+typedef struct
+{
+	const char *Pointer_Data; //! The file content, or NULL if the file is empty.
+	size_t Size; //! The file size in bytes.
+	size_t Offset; //! Where the next record is searched from.
+	unsigned long long Line; //! How many lines were read, this is the number of the last read line (the first line of the file is 1).
+} TCorpus;
+
+/** A grid record of a corpus, its characters are not copied. */
+typedef struct
+{
+	const char *Pointer_Characters; //! The record first character in the mapped file.
+	size_t Length; //! The record length in bytes, up to the end of its last row (the line ends between the rows are included).
+	unsigned long long Offset; //! The byte offset of the record in the file.
+	unsigned long long Line; //! The line of the record first row (the first line of the file is 1).
+	unsigned int Grid_Size; //! The size of the record grid, or 0 if the record does not have the shape of a supported grid.
+	int Is_Single_Line; //! Set to 1 if the whole grid is stored on a single line, set to 0 if the grid has one line per row.
+} TCorpusRecord;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Map a grids file in memory.
+ * @param Pointer_Corpus On output, contain the mapped file.
+ * @param String_File_Name The grids file.
+ * @return 0 if the file was mapped,
+ * @return -1 if the file could not be opened,
+ * @return -2 if the file can't be mapped (it is not a regular file for instance), so it must be read as a stream.
+ */
+int CorpusOpen(TCorpus *Pointer_Corpus, char *String_File_Name);
+
+/** Unmap a grids file.
+ * @param Pointer_Corpus The mapped file.
+ */
+void CorpusClose(TCorpus *Pointer_Corpus);
+
+/** Find the next grid record, skipping the blank lines. A record which has not the shape of a grid is handed out too, with a grid size of 0.
+ * @param Pointer_Corpus The mapped file.
+ * @param Pointer_Record On output, contain the view of the next record.
+ * @return 0 if a record was found,
+ * @return 1 if the end of the file was reached.
+ */
+int CorpusReadNextRecord(TCorpus *Pointer_Corpus, TCorpusRecord *Pointer_Record);
+
+/** Convert the characters of a record to a grid.
+ * @param Pointer_Grid On output, contain the loaded grid.
+ * @param Pointer_Record The record.
+ * @return 0 if the grid was correctly loaded,
+ * @return -2 if the record has not the shape of a supported grid,
+ * @return -3 if the cells data are bad.
+ */
+int CorpusLoadGrid(TGrid *Pointer_Grid, const TCorpusRecord *Pointer_Record);
+
+/** Load the next grid of a mapped file, like GridLoadFromStream() would do with the same file (the lines following a multi-lines grid with bad cells are discarded up to the next blank line).
+ * @param Pointer_Corpus The mapped file.
+ * @param Pointer_Grid On output, contain the loaded grid.
+ * @param Pointer_Record On output, contain the view of the grid record, to locate a bad grid in the file.
+ * @return 0 if the grid was correctly loaded,
+ * @return 1 if the end of the file was reached,
+ * @return -2 if the record has not the shape of a supported grid,
+ * @return -3 if the cells data are bad.
+ */
+int CorpusLoadNextGrid(TCorpus *Pointer_Corpus, TGrid *Pointer_Grid, TCorpusRecord *Pointer_Record);
+
+#endif
@@ -0,0 +1,62 @@
+/** @file Daemon.h
+ * Keep solving grids received from clients without restarting the program, so the requests latency does not include the program startup and the solvers initialization. The grids are received from a Unix domain socket (each connection is a client) or from the standard input (the responses are then written to the standard output), and they are solved by a pool of solver contexts prepared once.
+ * A client can send many requests without waiting for their responses, the responses are sent as soon as their grids are solved, so they can come in a different order than the requests : each response carries the identifier of its request. A client can have up to 64 requests not answered yet, its requests are not read anymore beyond, so a client not reading its responses only stops its own requests. All multi-bytes values are little-endian.
+ * A request is made of :
+ * - bytes 0 to 3 : the request length, not counting these 4 bytes,
+ * - bytes 4 to 7 : the request identifier, chosen by the client,
+ * - byte 8 : the flags, bit 0 is set to receive a text line response instead of a binary response (the other bits are reserved and must be 0),
+ * - the remaining bytes : the grid, in any format accepted by GridLoadFromString().
+ * A binary response is made of :
+ * - bytes 0 to 3 : the response length, not counting these 4 bytes,
+ * - bytes 4 to 7 : the request identifier,
+ * - byte 8 : the status (a DAEMON_STATUS_XXX value),
+ * - byte 9 : the grid size, or 0 if the grid could not be loaded,
+ * - bytes 10 and 11 : reserved (0),
+ * - bytes 12 to 19 : the solutions count (1 for a solved grid when not counting, 0 otherwise),
+ * - bytes 20 to 27 : the loops count,
+ * - bytes 28 to 35 : the bad solutions found count,
+ * - bytes 36 to 43 : the cells filled by propagation count,
+ * - bytes 44 to 51 : the solving duration in microseconds,
+ * - the remaining bytes : when the grid was solved (and its solutions were not counted), the solution packed like a packed grids file grid (see PackedGridsPackGrid()).
+ * A text line response holds the same fields separated by spaces : "Identifier Status Solutions_Count Loops_Count Bad_Solutions_Count Propagated_Cells_Count Microseconds Solution", the status is a word ("solved", "unsolvable", "timed-out", "bad-grid" or "cancelled") and the solution is written with the grid file characters, or is a '-' when there is no solution.
+ * @author Adrien RICCIARDI
+ * @version 1.0 : 17/10/2026
+ * @version 1.1 : 17/10/2026, the responses of each client are written by its own thread, so a client not reading its responses can't block the solving threads.
+ */
+#ifndef H_DAEMON_H
+#define H_DAEMON_H
+
+#include <Batch.h>
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+/** Receive a text line response instead of a binary response. */
+#define DAEMON_REQUEST_FLAG_LINE_RESPONSE 0x01
+
+/** The grid was solved (or has at least one solution when counting). */
+#define DAEMON_STATUS_SOLVED 0
+/** The grid has no solution. */
+#define DAEMON_STATUS_UNSOLVABLE 1
+/** The solving reached its time limit or its loops limit. */
+#define DAEMON_STATUS_TIMED_OUT 2
+/** The grid could not be loaded. */
+#define DAEMON_STATUS_BAD_GRID 3
+/** The solving was stopped because the daemon is stopping. */
+#define DAEMON_STATUS_CANCELLED 4
+
+/** The size of a binary response without its solution, including its length. */
+#define DAEMON_BINARY_RESPONSE_HEADER_SIZE 52
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Solve the grids of the requests until the program is stopped by SIGINT or SIGTERM when listening to a socket (the grids being solved are then answered as cancelled, the queued requests are answered before returning), or until the end of the standard input is reached and all responses are written.
+ * @param Pointer_Configuration How the grids are solved (the threads count is the solver contexts count, the lanes solver, the solutions display and the packed grids file are not used). The statistics records carry the requests identifiers.
+ * @param String_Socket_File_Name The Unix domain socket to create, or NULL to read the requests from the standard input and to write the responses to the standard output. An existing socket file is replaced.
+ * @return EXIT_SUCCESS if the daemon was stopped normally,
+ * @return EXIT_FAILURE if the daemon could not be started or if a request stream was corrupted.
+ */
+int DaemonRun(TBatchConfiguration *Pointer_Configuration, char *String_Socket_File_Name);
+
+#endif
@@ -0,0 +1,97 @@
+/** @file Dancing_Links.h
+ * An exact cover solving engine using Knuth's Algorithm X with dancing links. A grid is converted to a matrix where each row is the placement of a number in a cell, and each column is a constraint that must be satisfied exactly once (each cell holds a number, each number appears once in each row, column and square).
+ * @author Adrien RICCIARDI
+ * @version 1.0 : 17/10/2026
+ * @version 1.1 : 17/10/2026, the search can go on after a solution to count the solutions.
+ * @version 1.2 : 17/10/2026, the search is stopped by a polling callback instead of a cancellation flag, so the caller can apply its own limits.
+ */
+#ifndef H_DANCING_LINKS_H
+#define H_DANCING_LINKS_H
+
+#include <Configuration.h>
+#include <Grid.h>
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+/** There are 4 constraints families (cell, row-number, column-number and square-number), each one having as many constraints as grid cells. */
+#define DANCING_LINKS_MAXIMUM_COLUMNS_COUNT (4 * GRID_MAXIMUM_CELLS_COUNT)
+/** There is a matrix row for each number of each cell. */
+#define DANCING_LINKS_MAXIMUM_ROWS_COUNT (GRID_MAXIMUM_CELLS_COUNT * CONFIGURATION_GRID_MAXIMUM_SIZE)
+/** The root node, a header node per column and 4 nodes per matrix row. */
+#define DANCING_LINKS_MAXIMUM_NODES_COUNT (1 + DANCING_LINKS_MAXIMUM_COLUMNS_COUNT + 4 * DANCING_LINKS_MAXIMUM_ROWS_COUNT)
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** Called each time a solution is found, the solution can be retrieved with DancingLinksGetSolution() during the call.
+ * @param Pointer_Argument The callback argument.
+ */
+typedef void (*TDancingLinksSolutionCallback)(void *Pointer_Argument);
+
+/** Called every 1024 loops to know whether the search must stop (because it was cancelled or because it reached a limit).
+ * @param Pointer_Argument The callback argument.
+ * @return 1 if the search must stop,
+ * @return 0 if the search can go on.
+ */
+typedef int (*TDancingLinksPollCallback)(void *Pointer_Argument);
+
+/** A matrix node, linked to its neighbors on the same row and on the same column. */
+typedef struct
+{
+	int Left; //! The previous node on the same row.
+	int Right; //! The next node on the same row.
+	int Up; //! The previous node on the same column.
+	int Down; //! The next node on the same column.
+	int Column; //! The header node of the column.
+	int Row; //! The matrix row index, which is Cell_Index * Grid_Size + Number.
+} TDancingLinksNode;
+
+/** A dancing links engine context, big enough for the biggest supported grid. As it is quite big, it should be allocated statically or on the heap. */
+typedef struct
+{
+	TDancingLinksNode Nodes[DANCING_LINKS_MAXIMUM_NODES_COUNT]; //! All matrix nodes, the root node is the first one and the column headers follow.
+	int Columns_Size[DANCING_LINKS_MAXIMUM_COLUMNS_COUNT + 1]; //! How many nodes each column holds (indexed by the column header node).
+	unsigned char Is_Column_Satisfied[DANCING_LINKS_MAXIMUM_COLUMNS_COUNT]; //! Tell which constraints are already satisfied by the grid filled cells.
+	int Solution_Rows[GRID_MAXIMUM_CELLS_COUNT]; //! The matrix rows chosen at each search depth.
+	int Solution_Rows_Count; //! How many matrix rows are in the solution.
+	unsigned int Grid_Size; //! The loaded grid size.
+	int Is_Grid_Consistent; //! Set to 0 when the filled cells of the loaded grid already break a constraint.
+	unsigned long long Loops_Count; //! How many matrix rows were chosen.
+	unsigned long long Bad_Solutions_Found_Count; //! How many chosen matrix rows led to a dead end.
+	unsigned long long Solutions_Limit; //! The search stops when this many solutions are found (0 means that all solutions are searched).
+	unsigned long long Solutions_Count; //! How many solutions were found.
+	TDancingLinksSolutionCallback Solution_Callback; //! When not NULL, called for each found solution.
+	TDancingLinksPollCallback Poll_Callback; //! When not NULL, periodically called to know whether the search must stop.
+	void *Pointer_Callbacks_Argument; //! The argument given to the callbacks.
+	int Is_Stopped; //! Set to 1 when the search was stopped by the polling callback.
+} TDancingLinks;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Build the exact cover matrix of a grid. Only the constraints that the filled cells do not satisfy yet and the allowed numbers of the empty cells are put in the matrix.
+ * @param Pointer_Dancing_Links The engine context.
+ * @param Pointer_Grid The grid to solve.
+ */
+void DancingLinksLoadFromGrid(TDancingLinks *Pointer_Dancing_Links, TGrid *Pointer_Grid);
+
+/** Search the exact covers of the loaded matrix, always branching on the column having the fewest nodes. The search goes on after each found solution until the solutions limit is reached (the found solutions count is in the Solutions_Count field).
+ * @param Pointer_Dancing_Links The engine context.
+ * @param Solutions_Limit The search stops when this many solutions are found, use 0 to search all solutions.
+ * @param Solution_Callback Called for each found solution, use NULL if the solutions are not needed.
+ * @param Poll_Callback Periodically called to know whether the search must stop, use NULL if the search can't be stopped.
+ * @param Pointer_Argument The argument given to both callbacks.
+ * @return 1 if the solutions limit was reached (the last solution can be retrieved with DancingLinksGetSolution()),
+ * @return 0 if the whole search tree was explored,
+ * @return -1 if the search was stopped by the polling callback.
+ */
+int DancingLinksSolve(TDancingLinks *Pointer_Dancing_Links, unsigned long long Solutions_Limit, TDancingLinksSolutionCallback Solution_Callback, TDancingLinksPollCallback Poll_Callback, void *Pointer_Argument);
+
+/** Fill the empty cells of a grid with the found solution.
+ * @param Pointer_Dancing_Links The engine context.
+ * @param Pointer_Grid The grid the matrix was built from.
+ */
+void DancingLinksGetSolution(TDancingLinks *Pointer_Dancing_Links, TGrid *Pointer_Grid);
+
+#endif
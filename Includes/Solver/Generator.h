@@ -0,0 +1,50 @@
+/** @file Generator.h
+ * Generate random grids having a single solution. A random complete grid is built by the solver from an empty grid (or from a shuffled pattern for the biggest grids), then its givens are removed one by one in a random order, a given being put back when the grid has no more a single solution. All uniqueness checks reuse the same solver context, the grids are never reloaded from a text.
+ * @author Adrien RICCIARDI
+ * @version 1.0 : 17/10/2026
+ */
+#ifndef H_GENERATOR_H
+#define H_GENERATOR_H
+
+#include <Grid.h>
+#include <Solver.h>
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** A generator context. */
+typedef struct
+{
+	TSolver Solver; //! Build the complete grids and check the uniqueness of the puzzles.
+	int Cells_Indexes[GRID_MAXIMUM_CELLS_COUNT]; //! The cells in the order their givens are removed.
+	unsigned int Random_State; //! The random numbers generator state.
+	unsigned long long Uniqueness_Checks_Count; //! How many times the solver was run to check that a puzzle has a single solution.
+} TGenerator;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Initialize a generator context. This must be done once before using the context.
+ * @param Pointer_Generator The generator context.
+ */
+void GeneratorInitialize(TGenerator *Pointer_Generator);
+
+/** Set the seed of the next generations, the generated grids only depend on the seed. Consecutive seeds give independent grids, so a seed can be built from a base seed and a grid index.
+ * @param Pointer_Generator The generator context.
+ * @param Seed The seed.
+ */
+void GeneratorSetSeed(TGenerator *Pointer_Generator, unsigned long long Seed);
+
+/** Generate a random grid having a single solution.
+ * @param Pointer_Generator The generator context.
+ * @param Size The grid side size in cells.
+ * @param Givens_Target Stop removing the givens when the grid has this many givens. Use 0 to remove givens until none can be removed anymore (the grid is then minimal : removing any of its givens would give several solutions).
+ * @param Pointer_Puzzle On output, contain the generated grid.
+ * @param Pointer_Solution On output, contain the generated grid solution. Use NULL if the solution is not needed.
+ * @return 0 if the grid was generated,
+ * @return -2 if the grid size is not 6, 9, 12, 16, 25, 36, 49 or 64.
+ * @note A grid may not be reducible to the target givens count, in this case the generated grid is minimal and has more givens than the target.
+ */
+int GeneratorGenerate(TGenerator *Pointer_Generator, unsigned int Size, unsigned int Givens_Target, TGrid *Pointer_Puzzle, TGrid *Pointer_Solution);
+
+#endif
@@ -6,11 +6,19 @@
  * @version 1.2 : 16/06/2013, added GridGetEmptyCellsCount().
  * @version 1.3 : 25/08/2013, used bitmasks of all rows, columns and squares instead of cell lists.
  * @version 1.4 : 16/04/2014, made a prettier and faster code to access grid cells.
+ * @version 1.5 : 17/10/2026, grids can be loaded one after the other from a stream and stored on a single line.
+ * @version 1.6 : 17/10/2026, the grid state is stored in a caller-provided structure instead of private variables, so several grids can be used simultaneously.
+ * @version 1.7 : 17/10/2026, added the shared geometry tables giving the row, column, square and peers of each cell.
+ * @version 1.8 : 17/10/2026, added the cells of each row, column and square to the geometry tables.
+ * @version 1.9 : 17/10/2026, grids can be up to 64x64 with 64-bit bitmasks and the cells are stored in a single dimension array.
+ * @version 1.10 : 17/10/2026, added GridInitialize() to create an empty grid, GridIsCorrectlyFilled() checks each row, column and square once.
+ * @version 1.11 : 17/10/2026, added GridConvertCharacterToValue(), GridIsSizeSupported() and GridLoadFromCells() for the loaders converting the cells themselves.
  */
 #ifndef H_GRID_H
 #define H_GRID_H
 
-#include <Cells_Stack.h>
+#include <Configuration.h>
+#include <stdio.h>
 
 //-------------------------------------------------------------------------------------------------
 // Constants
@@ -23,64 +31,213 @@
 /** Value of an empty cell. */
 #define GRID_EMPTY_CELL_VALUE 1000 // A normally unreacheable value
 
+/** Size of a buffer able to hold a whole grid stored on a single line, with its terminating zero. */
+#define GRID_STRING_SIZE (CONFIGURATION_GRID_MAXIMUM_SIZE * CONFIGURATION_GRID_MAXIMUM_SIZE + 1)
+
+/** Get a bitmask with only the bit of a number set.
+ * @param Number The number.
+ * @return The number bitmask.
+ */
+#define GRID_BITMASK_NUMBER(Number) ((TGridBitmask) 1 << (Number))
+
+/** How many cells a grid can hold. */
+#define GRID_MAXIMUM_CELLS_COUNT (CONFIGURATION_GRID_MAXIMUM_SIZE * CONFIGURATION_GRID_MAXIMUM_SIZE)
+/** A cell can't have more peers than the other cells of its row, of its column and of its square. */
+#define GRID_MAXIMUM_PEERS_COUNT (3 * CONFIGURATION_GRID_MAXIMUM_SIZE)
+/** A grid has as many rows, columns and squares than its size. */
+#define GRID_MAXIMUM_UNITS_COUNT (3 * CONFIGURATION_GRID_MAXIMUM_SIZE)
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+// The bitmasks are as narrow as the biggest grid allows, each bit represents a number
+#if CONFIGURATION_GRID_MAXIMUM_SIZE <= 32
+	/** A set of numbers. */
+	typedef unsigned int TGridBitmask;
+	
+	/** Count the numbers of a bitmask. */
+	#define GRID_BITMASK_COUNT_NUMBERS(Bitmask) __builtin_popcount(Bitmask)
+	/** Get the smallest number of a non-empty bitmask. */
+	#define GRID_BITMASK_GET_SMALLEST_NUMBER(Bitmask) __builtin_ctz(Bitmask)
+	/** Get the biggest number of a non-empty bitmask. */
+	#define GRID_BITMASK_GET_BIGGEST_NUMBER(Bitmask) (31 - __builtin_clz(Bitmask))
+#else
+	/** A set of numbers. */
+	typedef unsigned long long TGridBitmask;
+	
+	/** Count the numbers of a bitmask. */
+	#define GRID_BITMASK_COUNT_NUMBERS(Bitmask) __builtin_popcountll(Bitmask)
+	/** Get the smallest number of a non-empty bitmask. */
+	#define GRID_BITMASK_GET_SMALLEST_NUMBER(Bitmask) __builtin_ctzll(Bitmask)
+	/** Get the biggest number of a non-empty bitmask. */
+	#define GRID_BITMASK_GET_BIGGEST_NUMBER(Bitmask) (63 - __builtin_clzll(Bitmask))
+#endif
+
+/** Precomputed tables describing a grid geometry, they are shared by all grids of the same size. A cell is identified by its index Row * Grid_Size + Column. */
+typedef struct
+{
+	unsigned char Cells_Row[GRID_MAXIMUM_CELLS_COUNT]; //! The row of each cell.
+	unsigned char Cells_Column[GRID_MAXIMUM_CELLS_COUNT]; //! The column of each cell.
+	unsigned char Cells_Square[GRID_MAXIMUM_CELLS_COUNT]; //! The square of each cell (its index in the Bitmask_Squares array).
+	unsigned short Peers[GRID_MAXIMUM_CELLS_COUNT][GRID_MAXIMUM_PEERS_COUNT]; //! The indexes of the cells sharing a row, a column or a square with each cell.
+	unsigned int Peers_Count; //! How many peers each cell has.
+	unsigned short Units_Cells[GRID_MAXIMUM_UNITS_COUNT][CONFIGURATION_GRID_MAXIMUM_SIZE]; //! The indexes of the cells of each unit, all rows come first, then all columns and all squares.
+} TGridGeometry;
+
+/** A grid and all data needed to quickly find the allowed numbers of a cell. */
+typedef struct
+{
+	unsigned int Size; //! Current grid side size in cells.
+	unsigned int Square_Width; //! Width of a square in cells.
+	unsigned int Square_Height; //! Height of a square in cells.
+	unsigned int Squares_Horizontal_Count; //! How many squares on the grid width.
+	unsigned int Squares_Vertical_Count; //! How many squares on the grid height.
+	int Display_Starting_Number; //! The grid starting number (usually 0 or 1) added to all cell values when the grid is displayed.
+	const TGridGeometry *Pointer_Geometry; //! The tables describing the grid geometry.
+	TGridBitmask Bitmask_Rows[CONFIGURATION_GRID_MAXIMUM_SIZE]; //! All row bitmasks.
+	TGridBitmask Bitmask_Columns[CONFIGURATION_GRID_MAXIMUM_SIZE]; //! All column bitmasks.
+	TGridBitmask Bitmask_Squares[CONFIGURATION_GRID_MAXIMUM_SIZE]; //! All square bitmasks.
+	int Cells[GRID_MAXIMUM_CELLS_COUNT]; //! The grid cells values, the cell at (Row ; Column) is at index Row * Size + Column. The cells are the last member so a small grid only uses the beginning of the structure (see GridCopy()).
+} TGrid;
+
 //-------------------------------------------------------------------------------------------------
 // Functions
 //-------------------------------------------------------------------------------------------------
-/** Print the grid to the screen. */
-void GridShow(void);
+/** Print the grid to the screen.
+ * @param Pointer_Grid The grid.
+ */
+void GridShow(TGrid *Pointer_Grid);
+
+/** Print the grid on a single line using the grid file characters, followed by a new line character.
+ * @param Pointer_Grid The grid.
+ */
+void GridShowLine(TGrid *Pointer_Grid);
+
+/** Convert the grid to a single line string using the grid file characters.
+ * @param Pointer_Grid The grid.
+ * @param String_Destination On output, contain the grid string. The buffer must be at least Grid_Size * Grid_Size + 1 bytes long.
+ */
+void GridConvertToString(TGrid *Pointer_Grid, char *String_Destination);
 
 /** Print the grid and highlight differences between current grid and the one from the last function call.
+ * @param Pointer_Grid The grid.
  * @param Color_Code Color used to display different cells (use GRID_COLOR_CODE_XXX).
+ * @warning This debug function remembers the last displayed grid in a private variable, so it must not be used with several grids at the same time.
  */
-void GridShowDifferences(int Color_Code);
+void GridShowDifferences(TGrid *Pointer_Grid, int Color_Code);
 
 /** Retrieve the allowed numbers for a cell.
+ * @param Pointer_Grid The grid.
  * @param Cell_Row Row coordinate.
  * @param Cell_Column Column coordinate.
  * @return A bitmask containing all allowed numbers.
  */
-unsigned int GridGetCellMissingNumbers(unsigned int Cell_Row, unsigned int Cell_Column);
+TGridBitmask GridGetCellMissingNumbers(TGrid *Pointer_Grid, unsigned int Cell_Row, unsigned int Cell_Column);
 
 /** Tell if the grid is correctly filled (there is no bad at wrong position).
+ * @param Pointer_Grid The grid.
  * @return 1 if the grid is correctly filled or 0 if not.
  */
-int GridIsCorrectlyFilled(void);
+int GridIsCorrectlyFilled(TGrid *Pointer_Grid);
 
 /** Set the value of a cell.
+ * @param Pointer_Grid The grid.
  * @param Cell_Row Row coordinate of the cell.
  * @param Cell_Column Column coordinate of the cell.
  * @param Cell_Value Value of the cell.
  * @warning No check is done on the provided coordinates, be sure to not cross grid bounds.
  */
-void GridSetCellValue(unsigned int Cell_Row, unsigned int Cell_Column, int Cell_Value);
+void GridSetCellValue(TGrid *Pointer_Grid, unsigned int Cell_Row, unsigned int Cell_Column, int Cell_Value);
+
+/** Copy a grid. Only the cells used by the grid size are copied, which is a lot faster than a structure assignment for small grids.
+ * @param Pointer_Destination_Grid On output, contain a copy of the source grid.
+ * @param Pointer_Source_Grid The grid to copy.
+ */
+void GridCopy(TGrid *Pointer_Destination_Grid, TGrid *Pointer_Source_Grid);
+
+/** Create an empty grid of the specified size.
+ * @param Pointer_Grid On output, contain the empty grid.
+ * @param Size The grid side size in cells.
+ * @return 0 if the grid was created,
+ * @return -2 if the grid size is not 6, 9, 12, 16, 25, 36, 49 or 64.
+ */
+int GridInitialize(TGrid *Pointer_Grid, unsigned int Size);
+
+/** Convert a grid character read from a text file into a program operable value.
+ * @param Character The character's value read from the file.
+ * @return GRID_EMPTY_CELL_VALUE if the cell is empty,
+ * @return The corresponding numerical value if the value was recognized,
+ * @return -1 if the character is not a value character or a dot.
+ */
+int GridConvertCharacterToValue(char Character);
+
+/** Tell whether grids of a size can be loaded.
+ * @param Size The grid side size in cells.
+ * @return 1 if the size is 6, 9, 12, 16, 25, 36, 49 or 64 (and not bigger than CONFIGURATION_GRID_MAXIMUM_SIZE),
+ * @return 0 if the size is not supported.
+ */
+int GridIsSizeSupported(unsigned int Size);
+
+/** Finish the loading of a grid whose cells values were directly written to its Cells array by the caller, this configures the grid size and computes the bitmasks.
+ * @param Pointer_Grid The grid, the first Size * Size cells must hold values lower than Size or GRID_EMPTY_CELL_VALUE.
+ * @param Size The grid side size in cells.
+ * @return 0 if the grid was loaded,
+ * @return -2 if the grid size is not 6, 9, 12, 16, 25, 36, 49 or 64.
+ */
+int GridLoadFromCells(TGrid *Pointer_Grid, unsigned int Size);
 
 /** Load the grid content from a file.
+ * @param Pointer_Grid The grid to load.
  * @param String_File_Name Name of the file describing the grid.
- * @param Pointer_Grid_Size On output, contain the grid size in cells (6, 9, 12 or 16).
  * @return 0 if the grid was correctly loaded,
  * @return -1 if the file was not found,
- * @return -2 if the grid size is not 6, 9, 12 or 16,
+ * @return -2 if the grid size is not 6, 9, 12, 16, 25, 36, 49 or 64,
+ * @return -3 if the cells data are bad.
+ */
+int GridLoadFromFile(TGrid *Pointer_Grid, char *String_File_Name);
+
+/** Load the next grid from a stream containing several grids. A grid can be stored on multiple lines (like in a grid file) or on a single line holding all rows one after the other. Blank lines between grids are ignored.
+ * A 36 characters line is always a 6x6 grid stored on a single line, so 36x36 grids must be stored on a single line.
+ * The cell values are written with the characters '0' to '9' (values 0 to 9), 'A' to 'Z' (values 10 to 35), 'a' to 'z' (values 36 to 61), '@' and '#' (values 62 and 63), an empty cell is a '.'.
+ * @param Pointer_Grid The grid to load.
+ * @param File The stream to read from.
+ * @return 0 if the grid was correctly loaded,
+ * @return 1 if the end of the stream was reached,
+ * @return -2 if the grid size is not 6, 9, 12, 16, 25, 36, 49 or 64,
+ * @return -3 if the cells data are bad.
+ * @note When a grid can't be loaded, the stream is left at the beginning of the next grid so the loading can go on.
+ */
+int GridLoadFromStream(TGrid *Pointer_Grid, FILE *File);
+
+/** Load the first grid found in a string, using the same formats than GridLoadFromStream().
+ * @param Pointer_Grid The grid to load.
+ * @param String_Grid The grid text, lines are separated by '\n'.
+ * @return 0 if the grid was correctly loaded,
+ * @return -2 if the grid size is not 6, 9, 12, 16, 25, 36, 49 or 64,
  * @return -3 if the cells data are bad.
  */
-int GridLoadFromFile(char *String_File_Name, unsigned int *Pointer_Grid_Size);
+int GridLoadFromString(TGrid *Pointer_Grid, const char *String_Grid);
 
 /** Remove a number from the cell missing ones lists.
+ * @param Pointer_Grid The grid.
  * @param Cell_Row Row coordinate of the cell.
  * @param Cell_Column Column coordinate of the cell.
  * @param Number The number to remove from the cell missing numbers.
  */
-void GridRemoveCellMissingNumber(unsigned int Cell_Row, unsigned int Cell_Column, int Number);
+void GridRemoveCellMissingNumber(TGrid *Pointer_Grid, unsigned int Cell_Row, unsigned int Cell_Column, int Number);
 
 /** Restore a number into the cell missing ones lists.
+ * @param Pointer_Grid The grid.
  * @param Cell_Row Row coordinate of the cell.
  * @param Cell_Column Column coordinate of the cell.
  * @param Number The number to restore to the cell missing numbers.
  */
-void GridRestoreCellMissingNumber(unsigned int Cell_Row, unsigned int Cell_Column, int Number);
+void GridRestoreCellMissingNumber(TGrid *Pointer_Grid, unsigned int Cell_Row, unsigned int Cell_Column, int Number);
 
 /** Show a bitmask in binary representation.
+ * @param Pointer_Grid The grid the bitmask belongs to.
  * @param Bitmask The bitmask to visualize.
  */
-void GridShowBitmask(unsigned int Bitmask);
+void GridShowBitmask(TGrid *Pointer_Grid, TGridBitmask Bitmask);
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,97 @@
+/** @file Instrumentation.h
+ * Detailed measures of the backtracking search, telling which search tree depths and which phases of a solving take the time : the nodes and backtracks count of each depth, the histogram of the allowed numbers count of the branching cells, the propagation results and the duration of each solving phase.
+ * The instrumentation is built only when CONFIGURATION_SOLVER_INSTRUMENTATION is set to 1 (see Configuration.h). Otherwise the solver context has no instrumentation data and the search has no instrumentation code, so it costs nothing.
+ * @author Adrien RICCIARDI
+ * @version 1.0 : 17/10/2026
+ * @version 1.1 : 17/10/2026, the phases durations are read from the shared monotonic clock (see Clock.h).
+ */
+#ifndef H_INSTRUMENTATION_H
+#define H_INSTRUMENTATION_H
+
+#include <Cells_Stack.h>
+#include <Clock.h>
+#include <Configuration.h>
+#include <stdio.h>
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+/** How many search tree depths can be measured (a search tree has one level per empty cell, plus the level reached when all cells are filled). */
+#define INSTRUMENTATION_DEPTHS_COUNT (CELLS_STACK_SIZE + 1)
+
+/** The grid loading, which indexes the empty cells or builds the dancing links matrix. */
+#define INSTRUMENTATION_PHASE_PREPARATION 0
+/** The constraints propagation done at each search tree node (it is part of the search phase). */
+#define INSTRUMENTATION_PHASE_PROPAGATION 1
+/** The whole search, propagation included. */
+#define INSTRUMENTATION_PHASE_SEARCH 2
+/** How many phases are measured. */
+#define INSTRUMENTATION_PHASES_COUNT 3
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** The measures of a solving. */
+typedef struct
+{
+	unsigned long long Depths_Nodes_Counts[INSTRUMENTATION_DEPTHS_COUNT]; //! How many search tree nodes were entered at each depth.
+	unsigned long long Depths_Backtracks_Counts[INSTRUMENTATION_DEPTHS_COUNT]; //! How many times the search went back from each depth because no number of the level cell led to a solution.
+	int Maximum_Depth; //! The deepest entered depth.
+	unsigned long long Branching_Counts[CONFIGURATION_GRID_MAXIMUM_SIZE + 1]; //! How many branching cells had each count of allowed numbers (a count of 1 can only happen without propagation).
+	unsigned long long Propagations_Count; //! How many times the propagation was run.
+	unsigned long long Contradictions_Count; //! How many propagations found a contradiction.
+	unsigned long long Naked_Singles_Count; //! How many cells were filled because they allowed a single number.
+	unsigned long long Hidden_Singles_Count; //! How many cells were filled because they were the only place of a number in a row, a column or a square.
+	unsigned long long Phases_Durations[INSTRUMENTATION_PHASES_COUNT]; //! The time spent in each phase, in nanoseconds.
+} TInstrumentation;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Count a search tree node.
+ * @param Pointer_Instrumentation The measures.
+ * @param Depth The node depth.
+ */
+static inline void InstrumentationRecordNode(TInstrumentation *Pointer_Instrumentation, int Depth)
+{
+	Pointer_Instrumentation->Depths_Nodes_Counts[Depth]++;
+	if (Depth > Pointer_Instrumentation->Maximum_Depth) Pointer_Instrumentation->Maximum_Depth = Depth;
+}
+
+/** Count a backtrack.
+ * @param Pointer_Instrumentation The measures.
+ * @param Depth The depth of the level the search goes back from.
+ */
+static inline void InstrumentationRecordBacktrack(TInstrumentation *Pointer_Instrumentation, int Depth)
+{
+	Pointer_Instrumentation->Depths_Backtracks_Counts[Depth]++;
+}
+
+/** Count a branching cell.
+ * @param Pointer_Instrumentation The measures.
+ * @param Numbers_Count How many numbers the cell allows.
+ */
+static inline void InstrumentationRecordBranching(TInstrumentation *Pointer_Instrumentation, int Numbers_Count)
+{
+	Pointer_Instrumentation->Branching_Counts[Numbers_Count]++;
+}
+
+/** Clear all measures, this is done when a grid is loaded.
+ * @param Pointer_Instrumentation The measures.
+ */
+void InstrumentationReset(TInstrumentation *Pointer_Instrumentation);
+
+/** Add measures to other ones, to gather the measures of several solvers.
+ * @param Pointer_Destination The measures to add to.
+ * @param Pointer_Source The measures to add.
+ */
+void InstrumentationAdd(TInstrumentation *Pointer_Destination, TInstrumentation *Pointer_Source);
+
+/** Write the measures as JSON members, each one preceded by a comma, so they can be appended to a JSON object. The depths arrays stop at the maximum depth and the branching histogram stops at the grid size.
+ * @param Pointer_Instrumentation The measures.
+ * @param Grid_Size The side size of the measured grid.
+ * @param File The stream to write to.
+ */
+void InstrumentationWriteMembers(TInstrumentation *Pointer_Instrumentation, unsigned int Grid_Size, FILE *File);
+
+#endif
@@ -0,0 +1,51 @@
+/** @file Lanes_Solver.h
+ * Propagate the constraints of many 9x9 grids at once. The grids are stored as a structure of arrays : a vector holds the same cell of all grids, one grid per vector lane, so the naked and hidden singles of all grids are found by the same instructions, without any branch depending on a single grid.
+ * The grids that are not solved by the propagation alone need a guess, they are left to the backtracking solver with all their forced cells filled.
+ * @author Adrien RICCIARDI
+ * @version 1.0 : 17/10/2026
+ */
+#ifndef H_LANES_SOLVER_H
+#define H_LANES_SOLVER_H
+
+#include <Grid.h>
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+/** How many grids are propagated at once (a 256-bit vector holds a 16-bit bitmask for each one). */
+#define LANES_SOLVER_LANES_COUNT 16
+
+/** The only grid size the lanes solver handles. */
+#define LANES_SOLVER_GRID_SIZE 9
+/** How many cells a grid has. */
+#define LANES_SOLVER_CELLS_COUNT (LANES_SOLVER_GRID_SIZE * LANES_SOLVER_GRID_SIZE)
+
+/** The grid was solved by the propagation. */
+#define LANES_SOLVER_RESULT_SOLVED 1
+/** The grid has no solution. */
+#define LANES_SOLVER_RESULT_UNSOLVABLE 0
+/** The propagation did not solve the grid, a guess is needed (the forced cells of the grid have been filled). */
+#define LANES_SOLVER_RESULT_GUESS_NEEDED 2
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** The propagation state of all lanes. */
+typedef struct
+{
+	_Alignas(32) unsigned short Cells_Candidates[LANES_SOLVER_CELLS_COUNT][LANES_SOLVER_LANES_COUNT]; //! The allowed numbers of each cell in each lane, a filled cell allows only its number.
+	_Alignas(32) unsigned short Cells_Propagated[LANES_SOLVER_CELLS_COUNT][LANES_SOLVER_LANES_COUNT]; //! All bits of a lane are set when the single number of the cell has been removed from the cell peers.
+} TLanesSolver;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Fill the forced cells of several 9x9 grids at once, until all grids are solved, are found unsolvable or need a guess. The AVX2 instructions are used when they are selected for the candidates computation (see CandidatesSetInstructionSet()).
+ * @param Pointer_Lanes_Solver The lanes solver context.
+ * @param Pointer_Grids The grids, they must all be 9x9. On output, the forced cells of the solved grids and of the grids needing a guess are filled (the unsolvable grids are not modified).
+ * @param Grids_Count How many grids to propagate, from 1 to LANES_SOLVER_LANES_COUNT.
+ * @param Pointer_Results On output, contain the LANES_SOLVER_RESULT_XXX value of each grid.
+ */
+void LanesSolverPropagate(TLanesSolver *Pointer_Lanes_Solver, TGrid *Pointer_Grids[], int Grids_Count, int *Pointer_Results);
+
+#endif
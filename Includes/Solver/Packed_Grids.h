@@ -0,0 +1,165 @@
+/** @file Packed_Grids.h
+ * Store many grids of the same size in a compact binary file. Each cell uses as few bits as its grid size allows, the code 0 is an empty cell and the code N + 1 is the number N, so a cell uses the bit length of the grid size (3 bits for the 6x6 grids, 4 bits for the 9x9 and 12x12 grids, 5 bits for the 16x16 and 25x25 grids, 6 bits for the 36x36 and 49x49 grids, 7 bits for the 64x64 grids). All records have the same size, so any record can be directly read, and a record can hold the solution of its grid beside the grid.
+ * The file starts with a 32-byte header, all multi-bytes values are little-endian :
+ * - bytes 0 to 7 : the "SUDOKUPK" magic,
+ * - byte 8 : the format version (1),
+ * - byte 9 : the grid size,
+ * - bytes 10 and 11 : the width and the height of a square,
+ * - byte 12 : how many bits a cell uses,
+ * - byte 13 : the flags, bit 0 is set when each record holds a solution column,
+ * - bytes 14 and 15 : reserved (0),
+ * - bytes 16 to 23 : the records count, or 0xFFFFFFFFFFFFFFFF if the file was written to a stream that could not be rewound (the records are then read up to the file end),
+ * - bytes 24 to 31 : reserved (0).
+ * The records follow the header. A record holds the packed grid, followed by the packed solution when the file has a solution column (a solution made of empty cells means that the grid was not solved).
+ * @author Adrien RICCIARDI
+ * @version 1.0 : 17/10/2026
+ * @version 1.1 : 17/10/2026, the headers and the records can be decoded from memory.
+ */
+#ifndef H_PACKED_GRIDS_H
+#define H_PACKED_GRIDS_H
+
+#include <Grid.h>
+#include <stdio.h>
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+/** The size of the file header in bytes. */
+#define PACKED_GRIDS_HEADER_SIZE 32
+
+/** The records count of a file whose records are read up to the file end. */
+#define PACKED_GRIDS_UNKNOWN_RECORDS_COUNT 0xFFFFFFFFFFFFFFFFULL
+
+/** The widest cell, the 64x64 grids need 7 bits to store the 65 codes. */
+#define PACKED_GRIDS_MAXIMUM_BITS_PER_CELL 7
+/** The size in bytes of the biggest packed grid. */
+#define PACKED_GRIDS_MAXIMUM_GRID_BYTES_COUNT ((GRID_MAXIMUM_CELLS_COUNT * PACKED_GRIDS_MAXIMUM_BITS_PER_CELL + 7) / 8)
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** A packed grids file opened for reading or for writing. */
+typedef struct
+{
+	FILE *File; //! The file stream, it is not closed by the packed grids functions.
+	unsigned int Grid_Size; //! The size of all grids of the file.
+	unsigned int Grid_Bytes_Count; //! The size of a packed grid in bytes.
+	int Is_Solutions_Column_Present; //! Set to 1 if each record holds a solution beside its grid.
+	unsigned long long Records_Count; //! How many records the file holds, or PACKED_GRIDS_UNKNOWN_RECORDS_COUNT.
+	unsigned long long Record_Index; //! The index of the next record to read, or how many records were written.
+	unsigned char Record[2 * PACKED_GRIDS_MAXIMUM_GRID_BYTES_COUNT]; //! The record being read or written.
+} TPackedGrids;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Tell how many bytes a packed grid uses.
+ * @param Grid_Size The grid size.
+ * @return The packed grid size in bytes.
+ */
+unsigned int PackedGridsGetGridBytesCount(unsigned int Grid_Size);
+
+/** Tell how many bytes a record of a packed grids file uses.
+ * @param Pointer_Packed_Grids The packed grids file.
+ * @return The record size in bytes.
+ */
+unsigned int PackedGridsGetRecordBytesCount(TPackedGrids *Pointer_Packed_Grids);
+
+/** Pack the cells of a grid.
+ * @param Pointer_Grid The grid.
+ * @param Pointer_Packed_Grid On output, contain the packed grid (see PackedGridsGetGridBytesCount() for its size).
+ */
+void PackedGridsPackGrid(TGrid *Pointer_Grid, unsigned char *Pointer_Packed_Grid);
+
+/** Unpack a grid and compute its bitmasks.
+ * @param Pointer_Packed_Grid The packed grid.
+ * @param Grid_Size The grid size.
+ * @param Pointer_Grid On output, contain the unpacked grid.
+ * @return 0 if the grid was correctly unpacked,
+ * @return -2 if the grid size is not supported,
+ * @return -3 if a cell code is too big for the grid.
+ */
+int PackedGridsUnpackGrid(const unsigned char *Pointer_Packed_Grid, unsigned int Grid_Size, TGrid *Pointer_Grid);
+
+/** Tell whether a file is a packed grids file.
+ * @param String_File_Name The file.
+ * @return 1 if the file is a regular file starting with the packed grids file magic,
+ * @return 0 if the file is not a packed grids file or could not be read.
+ */
+int PackedGridsIsPackedFile(char *String_File_Name);
+
+/** Start writing a packed grids file, the header is written immediately.
+ * @param Pointer_Packed_Grids On output, contain the file opened for writing.
+ * @param File The stream to write to.
+ * @param Pointer_Grid All grids of the file have the size and the squares shape of this grid.
+ * @param Is_Solutions_Column_Present Set to 1 to write a solution beside each grid.
+ * @return 0 if the header was written,
+ * @return -1 if the header could not be written.
+ */
+int PackedGridsCreate(TPackedGrids *Pointer_Packed_Grids, FILE *File, TGrid *Pointer_Grid, int Is_Solutions_Column_Present);
+
+/** Append a record to a packed grids file.
+ * @param Pointer_Packed_Grids The file opened for writing.
+ * @param Pointer_Packed_Grid The packed grid.
+ * @param Pointer_Packed_Solution The packed solution, or NULL if the grid has no solution (it is ignored if the file has no solution column).
+ * @return 0 if the record was written,
+ * @return -1 if the record could not be written.
+ */
+int PackedGridsWriteRecord(TPackedGrids *Pointer_Packed_Grids, const unsigned char *Pointer_Packed_Grid, const unsigned char *Pointer_Packed_Solution);
+
+/** Finish writing a packed grids file, the records count is written to the header if the stream can be rewound. The stream is flushed but not closed.
+ * @param Pointer_Packed_Grids The file opened for writing.
+ * @return 0 if the file was successfully written,
+ * @return -1 if the file could not be written.
+ */
+int PackedGridsFinishWriting(TPackedGrids *Pointer_Packed_Grids);
+
+/** Decode and check a packed grids file header which was read by the caller, the records can then be decoded with PackedGridsUnpackRecord().
+ * @param Pointer_Packed_Grids On output, contain the file description (its stream is set to NULL).
+ * @param Pointer_Header The PACKED_GRIDS_HEADER_SIZE bytes of the header.
+ * @return 0 if the header was decoded,
+ * @return -1 if the bytes are not a packed grids file header,
+ * @return -2 if the header is not supported (newer format version or unsupported grid size).
+ */
+int PackedGridsDecodeHeader(TPackedGrids *Pointer_Packed_Grids, const unsigned char *Pointer_Header);
+
+/** Start reading a packed grids file, its header is read and checked.
+ * @param Pointer_Packed_Grids On output, contain the file opened for reading.
+ * @param File The stream to read from, positioned at the file start.
+ * @return 0 if the header was read,
+ * @return -1 if the stream does not start with a packed grids file header,
+ * @return -2 if the header is not supported (newer format version or unsupported grid size).
+ */
+int PackedGridsOpen(TPackedGrids *Pointer_Packed_Grids, FILE *File);
+
+/** Go to a record of a packed grids file, so it is the next read record.
+ * @param Pointer_Packed_Grids The file opened for reading.
+ * @param Record_Index The record index, starting from 0.
+ * @return 0 on success,
+ * @return -1 if the record does not exist or if the stream can't be positioned.
+ */
+int PackedGridsSeekRecord(TPackedGrids *Pointer_Packed_Grids, unsigned long long Record_Index);
+
+/** Read the next record of a packed grids file.
+ * @param Pointer_Packed_Grids The file opened for reading.
+ * @param Pointer_Grid On output, contain the record grid.
+ * @param Pointer_Solution On output, contain the record solution if the record has one. Use NULL to ignore the solution.
+ * @param Pointer_Is_Solution_Present On output, set to 1 if the record has a solution, set to 0 if the grid was not solved or if the file has no solution column. Can be NULL when the solution is ignored.
+ * @return 0 if the record was read,
+ * @return 1 if there is no more record,
+ * @return -3 if a cell code is bad.
+ */
+int PackedGridsReadRecord(TPackedGrids *Pointer_Packed_Grids, TGrid *Pointer_Grid, TGrid *Pointer_Solution, int *Pointer_Is_Solution_Present);
+
+/** Unpack a record which was read by the caller.
+ * @param Pointer_Packed_Grids The file description.
+ * @param Pointer_Record The PackedGridsGetRecordBytesCount() bytes of the record.
+ * @param Pointer_Grid On output, contain the record grid.
+ * @param Pointer_Solution On output, contain the record solution if the record has one. Use NULL to ignore the solution.
+ * @param Pointer_Is_Solution_Present On output, set to 1 if the record has a solution, set to 0 if the grid was not solved or if the file has no solution column. Can be NULL when the solution is ignored.
+ * @return 0 if the record was unpacked,
+ * @return -3 if a cell code is bad.
+ */
+int PackedGridsUnpackRecord(TPackedGrids *Pointer_Packed_Grids, const unsigned char *Pointer_Record, TGrid *Pointer_Grid, TGrid *Pointer_Solution, int *Pointer_Is_Solution_Present);
+
+#endif
@@ -0,0 +1,30 @@
+/** @file Parallel_Solver.h
+ * Solve a single grid with several threads. The top levels of the search tree are split into independent grids solved by a pool of work-stealing threads, and the threads hand out parts of their search tree when other threads have nothing to do.
+ * @author Adrien RICCIARDI
+ * @version 1.0 : 17/10/2026
+ * @version 1.1 : 17/10/2026, the threads use the solver context configuration.
+ * @version 1.2 : 17/10/2026, the dancing links engine always uses a single thread.
+ * @version 1.3 : 17/10/2026, the threads use the cancellation flag and the time limit of the solver context.
+ * @version 1.4 : 17/10/2026, the threads share the loops limit of the solver context.
+ */
+#ifndef H_PARALLEL_SOLVER_H
+#define H_PARALLEL_SOLVER_H
+
+#include <Solver.h>
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Solve the grid loaded in a solver context with several threads, all threads use the solver context configuration. The solution and the statistics of all threads are stored in the solver context. The solver context cancellation flag, time limit and loops limit stop all threads, they are checked every SOLVER_POLLING_PERIOD search iterations of each thread (the loops limit counts the loops of all threads together).
+ * @param Pointer_Solver The solver context.
+ * @param Threads_Count How many threads solve the grid (use 0 to have one thread per processor core).
+ * @return SOLVER_RESULT_SOLVED if the grid was solved,
+ * @return SOLVER_RESULT_UNSOLVABLE if the grid has no solution (all threads explored all their subtrees),
+ * @return SOLVER_RESULT_CANCELLED if the solving was cancelled or if the threads could not be started,
+ * @return SOLVER_RESULT_TIMED_OUT if the solving reached its time limit or its loops limit.
+ * @note The dancing links engine can't split its search tree, so the grid is solved by the calling thread when this engine is selected.
+ * @note Unlike SolverSolve(), this function allocates memory for the threads contexts and the handed out grids.
+ */
+int ParallelSolverSolve(TSolver *Pointer_Solver, int Threads_Count);
+
+#endif
@@ -0,0 +1,57 @@
+/** @file Progress_Reporter.h
+ * Report the progress of a long solving on a status line, periodically and on request (a signal handler can request a report). The reports are printed by a dedicated thread reading the progress published by the solver (see SolverSetProgress()), so the search is never slowed down by the reports.
+ * @author Adrien RICCIARDI
+ * @version 1.0 : 17/10/2026
+ */
+#ifndef H_PROGRESS_REPORTER_H
+#define H_PROGRESS_REPORTER_H
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <Solver.h>
+#include <stdatomic.h>
+#include <stdio.h>
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** A progress reporter. */
+typedef struct
+{
+	TSolverProgress Progress; //! The progress published by the solver.
+	unsigned long long Period; //! How many microseconds between two periodic reports (0 means that the reports are only printed on request).
+	FILE *File; //! The stream the reports are printed to.
+	sem_t Semaphore; //! Posted to wake the reporting thread up before its period is elapsed.
+	atomic_int Is_Stop_Requested; //! Set to 1 to stop the reporting thread.
+	pthread_t Thread; //! The reporting thread.
+	unsigned long long Start_Time; //! When the reporter was started, in nanoseconds of the monotonic clock.
+	unsigned long long Previous_Report_Time; //! When the previous report was printed, in nanoseconds of the monotonic clock.
+	unsigned long long Previous_Loops_Count; //! The loops count of the previous report.
+} TProgressReporter;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Start reporting the progress of a solver. Each report tells how long the solving lasts, how many loops were done and how many loops per second were done since the previous report, the current and deepest search tree depths, and an estimate of the explored fraction of the search tree.
+ * @param Pointer_Reporter The progress reporter.
+ * @param Pointer_Solver The solver context, it publishes its progress to the reporter until the reporter is stopped.
+ * @param Period How many microseconds between two reports. Use 0 to print the reports only on request.
+ * @param File The stream to print the reports to.
+ * @return 0 if the reporter was started,
+ * @return -1 if the reporting thread could not be started.
+ */
+int ProgressReporterStart(TProgressReporter *Pointer_Reporter, TSolver *Pointer_Solver, unsigned long long Period, FILE *File);
+
+/** Print a report as soon as possible.
+ * @param Pointer_Reporter The progress reporter.
+ * @note This function is async-signal-safe, so it can be called from a signal handler.
+ */
+void ProgressReporterRequestReport(TProgressReporter *Pointer_Reporter);
+
+/** Stop the reports, the solver does not publish its progress anymore.
+ * @param Pointer_Reporter The progress reporter.
+ * @param Pointer_Solver The solver context given to ProgressReporterStart().
+ */
+void ProgressReporterStop(TProgressReporter *Pointer_Reporter, TSolver *Pointer_Solver);
+
+#endif
@@ -0,0 +1,346 @@
+/** @file Solver.h
+ * The solving engine. All the state of a solving is stored in a caller-provided context, so several grids can be solved simultaneously (from different threads too) and the engine never allocates memory.
+ * @author Adrien RICCIARDI
+ * @version 1.0 : 17/10/2026
+ * @version 1.1 : 17/10/2026, the solving can be cancelled and parts of the search tree can be handed out to other solvers.
+ * @version 1.2 : 17/10/2026, the solver can branch on the most constrained cell and the numbers order can be configured.
+ * @version 1.3 : 17/10/2026, the naked and hidden singles are propagated at each search tree node.
+ * @version 1.4 : 17/10/2026, added the dancing links engine.
+ * @version 1.5 : 17/10/2026, the search is iterative and its whole state is stored in the solver context.
+ * @version 1.6 : 17/10/2026, grids can be up to 64x64.
+ * @version 1.7 : 17/10/2026, the search uses a kernel specialized for the grid shape.
+ * @version 1.8 : 17/10/2026, the allowed numbers of all cells are computed at once with SIMD instructions for the propagation.
+ * @version 1.9 : 17/10/2026, the solutions can be counted up to a limit and each solution can be received by a callback.
+ * @version 1.10 : 17/10/2026, the backtracking search can be cancelled after a loops count.
+ * @version 1.11 : 17/10/2026, the statistics of a solving can be written as a JSON record, with the search instrumentation when it is built.
+ * @version 1.12 : 17/10/2026, the solving can be stopped after a time limit, the limits stop the solving with a result distinct from the cancellation, the dancing links engine uses the limits too.
+ * @version 1.13 : 17/10/2026, the backtracking search state can be saved as the grids of its unexplored subtrees, so the search can be resumed later.
+ * @version 1.14 : 17/10/2026, the backtracking search can publish its progress, so another thread can report it while the search runs.
+ */
+#ifndef H_SOLVER_H
+#define H_SOLVER_H
+
+#include <Candidates.h>
+#include <Cells_Buckets.h>
+#include <Cells_Stack.h>
+#include <Dancing_Links.h>
+#include <Grid.h>
+#include <Instrumentation.h>
+#include <stdatomic.h>
+#include <stdio.h>
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+/** The grid was solved. */
+#define SOLVER_RESULT_SOLVED 1
+/** The grid has no solution. */
+#define SOLVER_RESULT_UNSOLVABLE 0
+/** The solving was cancelled before it could be completed. */
+#define SOLVER_RESULT_CANCELLED -1
+/** The solving was stopped because it reached its time limit or its loops limit. */
+#define SOLVER_RESULT_TIMED_OUT -2
+
+/** How many backtracking search iterations (entering a node, trying a number or going back into the tree) are done between two checks of the cancellation flag, of the limits and of the split requests. */
+#define SOLVER_POLLING_PERIOD 1024
+
+/** The explored fraction of the search tree is published in units of this value (so 1 quadrillionth of the search tree is the finest measured fraction). */
+#define SOLVER_PROGRESS_FRACTION_UNIT 1000000000000000ULL
+/** How many search tree levels, from the root, are used to estimate the explored fraction of the search tree (the deeper levels weigh too little to change the estimate). */
+#define SOLVER_PROGRESS_LEVELS_COUNT 64
+
+/** Solve the grids with the bitmasks backtracking algorithm. */
+#define SOLVER_ENGINE_BACKTRACKING 0
+/** Solve the grids as an exact cover problem with the dancing links algorithm. */
+#define SOLVER_ENGINE_DANCING_LINKS 1
+
+/** Fill the empty cells in a fixed order, from the top-left cell to the bottom-right one. */
+#define SOLVER_CELL_ORDER_FIXED 0
+/** Always fill the empty cell having the fewest allowed numbers. */
+#define SOLVER_CELL_ORDER_MOST_CONSTRAINED 1
+
+/** Try the allowed numbers of a cell from the smallest to the biggest. */
+#define SOLVER_NUMBER_ORDER_ASCENDING 0
+/** Try the allowed numbers of a cell from the biggest to the smallest. */
+#define SOLVER_NUMBER_ORDER_DESCENDING 1
+/** Try the allowed numbers of a cell in a random order (the order only depends on the random seed, so a solving can be reproduced). */
+#define SOLVER_NUMBER_ORDER_RANDOM 2
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** Statistics about a solving. */
+typedef struct
+{
+	unsigned long long Loops_Count; //! How many loops were done.
+	unsigned long long Bad_Solutions_Found_Count; //! How many bad solutions were found before the good one (or before crashing...).
+	unsigned long long Avoided_Bad_Solutions_Count; //! How many impossible solutions were avoided.
+	unsigned long long Propagated_Cells_Count; //! How many cells were filled by the constraints propagation.
+} TSolverStatistics;
+
+/** How the solver explores the search tree. */
+typedef struct
+{
+	int Engine; //! The solving algorithm (use SOLVER_ENGINE_XXX). The cells order, the numbers order and the propagation only apply to the backtracking engine.
+	int Cell_Order; //! How the next cell to fill is chosen (use SOLVER_CELL_ORDER_XXX).
+	int Number_Order; //! In which order the allowed numbers of a cell are tried (use SOLVER_NUMBER_ORDER_XXX).
+	unsigned int Random_Seed; //! The seed of the random numbers order, it is used again each time a grid is loaded.
+	int Is_Propagation_Enabled; //! Set to 1 to fill the cells having a single allowed number (naked singles) and the only cell of a row, a column or a square allowing a number (hidden singles) at each search tree node.
+} TSolverConfiguration;
+
+/** The state of a search tree level. */
+typedef struct
+{
+	int Trail_Size; //! The trail size when the level was entered, the cells filled since then are emptied when the level is left.
+	int Cells_Stack_Pointer; //! The cells stack pointer when the level was entered.
+	int Branch_Trail_Index; //! The trail index of the cell chosen on this level (the cells before it were forced by the propagation).
+	int Cell_Index; //! The cell chosen on this level.
+	TGridBitmask Remaining_Numbers; //! The numbers still to try on the chosen cell.
+	int Numbers_Count; //! How many numbers the chosen cell allowed when the level was entered.
+} TSolverLevel;
+
+/** The progress of a backtracking search, published at each polling of the search so another thread can read it at any time without slowing the search down. All values are written and read with relaxed atomic accesses, so they are not consistent with each other but each one is a recent value. */
+typedef struct
+{
+	atomic_ullong Loops_Count; //! How many loops were done by all searches using this progress since it was cleared.
+	atomic_int Depth; //! The search tree depth at the last polling.
+	atomic_int Maximum_Depth; //! The deepest search tree depth seen at a polling since the progress was cleared.
+	atomic_ullong Explored_Fraction; //! An estimate of the explored fraction of the current search tree, in SOLVER_PROGRESS_FRACTION_UNIT units. It is computed from the numbers already tried on the shallowest levels, as if all subtrees of a level had the same size.
+} TSolverProgress;
+
+/** Tell whether a part of the search tree should be handed out to another solver.
+ * @param Pointer_Argument The callbacks argument.
+ * @return 1 if a split is requested,
+ * @return 0 if no split is needed.
+ */
+typedef int (*TSolverIsSplitRequestedCallback)(void *Pointer_Argument);
+
+/** Take a part of the search tree, represented by a grid with some more cells filled than the original one.
+ * @param Pointer_Argument The callbacks argument.
+ * @param Pointer_Grid The grid to solve, it must be copied as it is destroyed after the call.
+ * @return 0 if the grid was taken,
+ * @return -1 if the grid could not be taken, in this case the solver keeps searching this part of the tree.
+ */
+typedef int (*TSolverSplitCallback)(void *Pointer_Argument, TGrid *Pointer_Grid);
+
+/** Receive a solution found by the solver.
+ * @param Pointer_Argument The callback argument.
+ * @param Pointer_Grid The solved grid, it must be copied as it is modified after the call.
+ */
+typedef void (*TSolverSolutionCallback)(void *Pointer_Argument, TGrid *Pointer_Grid);
+
+struct TSolver;
+
+/** Called each time the backtracking search polls its flags, the callback can save the search state with SolverWriteCheckpoint().
+ * @param Pointer_Argument The callback argument.
+ * @param Pointer_Solver The solver context.
+ * @param Is_Search_Stopping Set to 1 when the search is about to stop because of a cancellation or a limit, this is the last chance to save its state. Set to 0 when the search goes on.
+ */
+typedef void (*TSolverCheckpointCallback)(void *Pointer_Argument, struct TSolver *Pointer_Solver, int Is_Search_Stopping);
+
+/** A solver context. */
+typedef struct TSolver
+{
+	TGrid Grid; //! The grid being solved.
+	TSolverConfiguration Configuration; //! How the search tree is explored.
+	TCellsStack Cells_Stack; //! All empty cells, when they are filled in a fixed order.
+	TCellsBuckets Cells_Buckets; //! All empty cells sorted by allowed numbers count, when the most constrained cell is filled first.
+	TCandidates Candidates; //! The allowed numbers of all cells, computed at once by the propagation.
+	TSolverStatistics Statistics; //! The current solving statistics.
+	int Depth; //! The current search tree depth (how many cells have been chosen by the solver).
+	int Is_Level_Branching; //! Set to 1 at a polling when the search is trying the next number of the current level cell (the current grid is then not an unexplored node), set to 0 when the current level was just entered.
+	int Trail[CELLS_STACK_SIZE]; //! The indexes of all cells filled by the solver, in the filling order.
+	int Trail_Size; //! How many cells are in the trail.
+	TSolverLevel Levels[CELLS_STACK_SIZE + 1]; //! The state of each search tree level (the last level is entered when all cells are filled).
+	unsigned int Random_State; //! The random numbers generator state.
+	int Is_Cancelled; //! Set to 1 when the solving stops because of a cancellation.
+	int Is_Timed_Out; //! Set to 1 when the solving stops because it reached a limit.
+	atomic_int *Pointer_Cancellation_Flag; //! When not NULL, the solving stops as soon as possible after the pointed value becomes different from 0.
+	unsigned long long Loops_Limit; //! The search is stopped when it has done this many loops (0 means no limit).
+	unsigned long long Time_Limit; //! The search is stopped when it has lasted this many microseconds (0 means no limit).
+	unsigned long long Deadline; //! When the current search must stop, in nanoseconds of the monotonic clock (0 means no limit).
+	TSolverIsSplitRequestedCallback Is_Split_Requested_Callback; //! When not NULL, periodically called to know whether a part of the search tree should be handed out.
+	TSolverSplitCallback Split_Callback; //! Receive the parts of the search tree handed out by the solver.
+	void *Pointer_Split_Callbacks_Argument; //! The argument given to the split callbacks.
+	unsigned long long Solutions_Limit; //! The search stops when this many solutions are found (0 means that all solutions are searched).
+	unsigned long long Solutions_Count; //! How many solutions were found by the current search.
+	TSolverSolutionCallback Solution_Callback; //! When not NULL, receive each found solution.
+	void *Pointer_Solution_Callback_Argument; //! The argument given to the solution callback.
+	TSolverCheckpointCallback Checkpoint_Callback; //! When not NULL, called at each polling of the backtracking search.
+	void *Pointer_Checkpoint_Callback_Argument; //! The argument given to the checkpoint callback.
+	TSolverProgress *Pointer_Progress; //! When not NULL, the backtracking search publishes its progress here at each polling.
+	unsigned long long Published_Loops_Count; //! The loops count of the current search when its progress was last published.
+	TDancingLinks *Pointer_Dancing_Links; //! The dancing links engine storage, or NULL if it was not provided.
+	#if CONFIGURATION_SOLVER_INSTRUMENTATION
+		TInstrumentation Instrumentation; //! The detailed measures of the current solving (the dancing links engine only measures the phases durations).
+	#endif
+	int (*Backtrack_Function)(struct TSolver *Pointer_Solver); //! The search kernel specialized for the loaded grid shape.
+} TSolver;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Initialize a solver context with the default configuration (most constrained cell first, ascending numbers order, propagation enabled). This must be done once before using the context.
+ * @param Pointer_Solver The solver context.
+ */
+void SolverInitialize(TSolver *Pointer_Solver);
+
+/** Fill a configuration with the default values.
+ * @param Pointer_Configuration On output, contain the default configuration.
+ */
+void SolverGetDefaultConfiguration(TSolverConfiguration *Pointer_Configuration);
+
+/** Change the way the search tree is explored. The new configuration is used from the next grid loading.
+ * @param Pointer_Solver The solver context.
+ * @param Pointer_Configuration The configuration to copy into the solver context.
+ */
+void SolverSetConfiguration(TSolver *Pointer_Solver, TSolverConfiguration *Pointer_Configuration);
+
+/** Provide the storage needed by the dancing links engine (it is too big to be always part of the solver context). The dancing links engine is used only when it is selected in the configuration and when its storage is provided, the backtracking engine is used otherwise.
+ * @param Pointer_Solver The solver context.
+ * @param Pointer_Dancing_Links The dancing links engine storage, it must stay valid as long as the solver context is used. Use NULL to remove the storage.
+ */
+void SolverSetDancingLinks(TSolver *Pointer_Solver, TDancingLinks *Pointer_Dancing_Links);
+
+/** Allow the solving to be cancelled by another thread.
+ * @param Pointer_Solver The solver context.
+ * @param Pointer_Cancellation_Flag The solving stops as soon as possible after the pointed value becomes different from 0. Use NULL to disable the cancellation.
+ */
+void SolverSetCancellationFlag(TSolver *Pointer_Solver, atomic_int *Pointer_Cancellation_Flag);
+
+/** Stop the search when it takes too many loops, the solving then returns SOLVER_RESULT_TIMED_OUT with the statistics of the loops done so far. The limit is checked every SOLVER_POLLING_PERIOD search iterations only, so the search can do a little more loops than the limit.
+ * @param Pointer_Solver The solver context.
+ * @param Loops_Limit The maximum loops count of each solving. Use 0 to remove the limit.
+ */
+void SolverSetLoopsLimit(TSolver *Pointer_Solver, unsigned long long Loops_Limit);
+
+/** Stop the search when it takes too long, the solving then returns SOLVER_RESULT_TIMED_OUT with the statistics of the loops done so far. The clock is read every SOLVER_POLLING_PERIOD search iterations only, so the limit costs nothing to the search but the search can last a little longer than the limit.
+ * @param Pointer_Solver The solver context.
+ * @param Time_Limit The maximum duration of each search in microseconds (the grid loading is not counted). Use 0 to remove the limit.
+ */
+void SolverSetTimeLimit(TSolver *Pointer_Solver, unsigned long long Time_Limit);
+
+/** Allow the solver to hand out parts of its search tree to other solvers. When a split is requested, all untried numbers of the shallowest search tree level that still has some are handed out.
+ * @param Pointer_Solver The solver context.
+ * @param Is_Split_Requested_Callback Periodically called to know whether a part of the search tree should be handed out. Use NULL to disable the splitting.
+ * @param Split_Callback Receive each handed out part of the search tree.
+ * @param Pointer_Argument The argument given to both callbacks.
+ */
+void SolverSetSplitCallbacks(TSolver *Pointer_Solver, TSolverIsSplitRequestedCallback Is_Split_Requested_Callback, TSolverSplitCallback Split_Callback, void *Pointer_Argument);
+
+/** Receive each solution found by SolverSolve() or SolverCountSolutions().
+ * @param Pointer_Solver The solver context.
+ * @param Solution_Callback Called for each found solution. Use NULL to disable the callback.
+ * @param Pointer_Argument The argument given to the callback.
+ */
+void SolverSetSolutionCallback(TSolver *Pointer_Solver, TSolverSolutionCallback Solution_Callback, void *Pointer_Argument);
+
+/** Receive the pollings of the backtracking search, to save its state from time to time. The callback is called every SOLVER_POLLING_PERIOD search iterations.
+ * @param Pointer_Solver The solver context.
+ * @param Checkpoint_Callback Called at each polling. Use NULL to disable the callback.
+ * @param Pointer_Argument The argument given to the callback.
+ * @note The dancing links engine search state can't be saved, so the callback is not called by this engine.
+ */
+void SolverSetCheckpointCallback(TSolver *Pointer_Solver, TSolverCheckpointCallback Checkpoint_Callback, void *Pointer_Argument);
+
+/** Clear a progress before giving it to a solver.
+ * @param Pointer_Progress The progress.
+ */
+void SolverClearProgress(TSolverProgress *Pointer_Progress);
+
+/** Publish the progress of the backtracking search every SOLVER_POLLING_PERIOD search iterations, so another thread can report it. The loops count is added to the progress, so the progress of several successive solvings can be accumulated.
+ * @param Pointer_Solver The solver context.
+ * @param Pointer_Progress The progress to publish to, it must stay valid as long as the solver context uses it. Use NULL to stop publishing the progress.
+ * @note The dancing links engine does not publish its progress.
+ */
+void SolverSetProgress(TSolver *Pointer_Solver, TSolverProgress *Pointer_Progress);
+
+/** Load the grid to solve from a file.
+ * @param Pointer_Solver The solver context.
+ * @param String_File_Name Name of the file describing the grid.
+ * @return 0 if the grid was correctly loaded,
+ * @return -1 if the file was not found,
+ * @return -2 if the grid size is not 6, 9, 12, 16, 25, 36, 49 or 64,
+ * @return -3 if the cells data are bad.
+ */
+int SolverLoadFromFile(TSolver *Pointer_Solver, char *String_File_Name);
+
+/** Load the next grid to solve from a stream containing several grids (see GridLoadFromStream() for the accepted formats).
+ * @param Pointer_Solver The solver context.
+ * @param File The stream to read from.
+ * @return 0 if the grid was correctly loaded,
+ * @return 1 if the end of the stream was reached,
+ * @return -2 if the grid size is not 6, 9, 12, 16, 25, 36, 49 or 64,
+ * @return -3 if the cells data are bad.
+ */
+int SolverLoadFromStream(TSolver *Pointer_Solver, FILE *File);
+
+/** Load the grid to solve from a string (see GridLoadFromString() for the accepted formats).
+ * @param Pointer_Solver The solver context.
+ * @param String_Grid The grid text.
+ * @return 0 if the grid was correctly loaded,
+ * @return -2 if the grid size is not 6, 9, 12, 16, 25, 36, 49 or 64,
+ * @return -3 if the cells data are bad.
+ */
+int SolverLoadFromString(TSolver *Pointer_Solver, const char *String_Grid);
+
+/** Load the grid to solve from an already loaded grid.
+ * @param Pointer_Solver The solver context.
+ * @param Pointer_Grid The grid to copy into the solver context.
+ */
+void SolverLoadFromGrid(TSolver *Pointer_Solver, TGrid *Pointer_Grid);
+
+/** Solve the loaded grid.
+ * @param Pointer_Solver The solver context.
+ * @return SOLVER_RESULT_SOLVED if the grid was solved,
+ * @return SOLVER_RESULT_UNSOLVABLE if the grid has no solution,
+ * @return SOLVER_RESULT_CANCELLED if the solving was cancelled,
+ * @return SOLVER_RESULT_TIMED_OUT if the solving reached its time limit or its loops limit.
+ */
+int SolverSolve(TSolver *Pointer_Solver);
+
+/** Count the solutions of the loaded grid. The search goes on after each solution and stops as soon as the limit is reached, so a limit of 2 is enough to tell whether a grid has a single solution and is much faster than finding all solutions.
+ * @param Pointer_Solver The solver context.
+ * @param Solutions_Limit The search stops when this many solutions are found, use 0 to find all solutions.
+ * @param Pointer_Solutions_Count On output, contain how many solutions were found. It is the exact solutions count when it is lower than the limit and when the counting was not stopped.
+ * @return SOLVER_RESULT_SOLVED if at least one solution was found (the grid holds the last found solution only when the limit was reached),
+ * @return SOLVER_RESULT_UNSOLVABLE if the grid has no solution,
+ * @return SOLVER_RESULT_CANCELLED if the counting was cancelled,
+ * @return SOLVER_RESULT_TIMED_OUT if the counting reached its time limit or its loops limit.
+ * @note The search tree is not split, so the split callbacks must not be set.
+ */
+int SolverCountSolutions(TSolver *Pointer_Solver, unsigned long long Solutions_Limit, unsigned long long *Pointer_Solutions_Count);
+
+/** Retrieve the grid content (the solution after a successful solving) as a single line string using the grid file characters.
+ * @param Pointer_Solver The solver context.
+ * @param String_Solution On output, contain the grid string.
+ * @param Buffer_Size Size of the String_Solution buffer in bytes.
+ * @return The string length,
+ * @return -1 if the buffer is too small.
+ */
+int SolverGetSolution(TSolver *Pointer_Solver, char *String_Solution, int Buffer_Size);
+
+/** Retrieve the statistics of the last solving.
+ * @param Pointer_Solver The solver context.
+ * @param Pointer_Statistics On output, contain the statistics.
+ */
+void SolverGetStatistics(TSolver *Pointer_Solver, TSolverStatistics *Pointer_Statistics);
+
+/** Save the state of the backtracking search as the grids of all unexplored subtrees, one grid per line : the grid of the current search tree node first (when its cell numbers are not being tried yet), then a grid for each untried number of each level, from the deepest level to the shallowest one. The grid has a solution only if one of these grids has a solution, so the search can be resumed by solving them one after the other (or independently on several computers).
+ * @param Pointer_Solver The solver context.
+ * @param File The stream to write to.
+ * @return 0 if the grids were written,
+ * @return -1 if the stream could not be written.
+ * @warning This function must only be called by the checkpoint callback, when the search state is consistent, or right after a grid was loaded (only the loaded grid is then written).
+ */
+int SolverWriteCheckpoint(TSolver *Pointer_Solver, FILE *File);
+
+/** Write the statistics of the last solving as a JSON object on a single line, followed by the instrumentation measures when the instrumentation is built. The line is written at once, so several threads can write their records to the same stream.
+ * @param Pointer_Solver The solver context.
+ * @param Grid_Index The index of the solved grid, to find it among the records.
+ * @param Result The result of the solving (a SOLVER_RESULT_XXX value).
+ * @param File The stream to write to.
+ */
+void SolverWriteStatisticsRecord(TSolver *Pointer_Solver, unsigned long long Grid_Index, int Result, FILE *File);
+
+#endif
@@ -0,0 +1,503 @@
+/** @file Solver_Kernel.h
+ * The search functions of the backtracking engine, written once and specialized for each grid shape. Solver.c includes this file once for each supported shape after defining the shape parameters, so the grid size, the peers count and the bitmasks width are compile-time constants in each kernel : the loops on the cells of a unit or on the peers of a cell have a constant length and are unrolled, and the small grids use 32-bit bitmasks.
+ * The parameters to define before including this file (they are undefined at the end of the file) are :
+ * - SOLVER_KERNEL_SUFFIX : the shape name appended to the kernel functions names (for example 9x9 gives SolverBacktrack9x9()),
+ * - SOLVER_KERNEL_SIZE : the grid side size in cells,
+ * - SOLVER_KERNEL_SQUARE_WIDTH : the width of a square in cells,
+ * - SOLVER_KERNEL_SQUARE_HEIGHT : the height of a square in cells.
+ * @author Adrien RICCIARDI
+ * @version 1.0 : 17/10/2026
+ * @version 1.1 : 17/10/2026, the search can go on after a solution to count the solutions.
+ * @version 1.2 : 17/10/2026, the search can be instrumented.
+ * @version 1.3 : 17/10/2026, each level remembers how many numbers its cell allowed, to estimate the search progress.
+ * @warning This file must only be included by Solver.c, it has no include guard on purpose.
+ */
+
+//-------------------------------------------------------------------------------------------------
+// Private macros
+//-------------------------------------------------------------------------------------------------
+/** Build a kernel function name (two levels are needed to expand the suffix macro before pasting it). */
+#define SOLVER_KERNEL_CONCATENATE_EXPANDED(Name, Suffix) Name##Suffix
+#define SOLVER_KERNEL_CONCATENATE(Name, Suffix) SOLVER_KERNEL_CONCATENATE_EXPANDED(Name, Suffix)
+#define SOLVER_KERNEL_NAME(Name) SOLVER_KERNEL_CONCATENATE(Name, SOLVER_KERNEL_SUFFIX)
+
+/** How many peers each cell has : the other cells of its row and of its column, and the cells of its square that are not on its row or on its column. */
+#define SOLVER_KERNEL_PEERS_COUNT (2 * (SOLVER_KERNEL_SIZE - 1) + (SOLVER_KERNEL_SQUARE_WIDTH - 1) * (SOLVER_KERNEL_SQUARE_HEIGHT - 1))
+
+/** Unroll the next constant length loop (the biggest grids loops are only partially unrolled). */
+#define SOLVER_KERNEL_UNROLL _Pragma("GCC unroll 16")
+
+// The bitmasks are only as wide as the kernel grid size needs (the grid stores them in TGridBitmask variables, which are at least as wide)
+#if SOLVER_KERNEL_SIZE <= 32
+	#define SOLVER_KERNEL_BITMASK unsigned int
+	#define SOLVER_KERNEL_BITMASK_NUMBER(Number) (1U << (Number))
+	#define SOLVER_KERNEL_COUNT_NUMBERS(Bitmask) __builtin_popcount(Bitmask)
+	#define SOLVER_KERNEL_GET_SMALLEST_NUMBER(Bitmask) __builtin_ctz(Bitmask)
+	#define SOLVER_KERNEL_GET_BIGGEST_NUMBER(Bitmask) (31 - __builtin_clz(Bitmask))
+#else
+	#define SOLVER_KERNEL_BITMASK TGridBitmask
+	#define SOLVER_KERNEL_BITMASK_NUMBER(Number) GRID_BITMASK_NUMBER(Number)
+	#define SOLVER_KERNEL_COUNT_NUMBERS(Bitmask) GRID_BITMASK_COUNT_NUMBERS(Bitmask)
+	#define SOLVER_KERNEL_GET_SMALLEST_NUMBER(Bitmask) GRID_BITMASK_GET_SMALLEST_NUMBER(Bitmask)
+	#define SOLVER_KERNEL_GET_BIGGEST_NUMBER(Bitmask) GRID_BITMASK_GET_BIGGEST_NUMBER(Bitmask)
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Get the allowed numbers of a cell from its index.
+ * @param Pointer_Grid The grid.
+ * @param Cell_Index The cell index.
+ * @return A bitmask containing all allowed numbers.
+ */
+static inline SOLVER_KERNEL_BITMASK SOLVER_KERNEL_NAME(SolverGetCellMissingNumbers)(TGrid *Pointer_Grid, int Cell_Index)
+{
+	const TGridGeometry *Pointer_Geometry = Pointer_Grid->Pointer_Geometry;
+	
+	return Pointer_Grid->Bitmask_Rows[Pointer_Geometry->Cells_Row[Cell_Index]] & Pointer_Grid->Bitmask_Columns[Pointer_Geometry->Cells_Column[Cell_Index]] & Pointer_Grid->Bitmask_Squares[Pointer_Geometry->Cells_Square[Cell_Index]];
+}
+
+/** Choose the next number to try among the untried allowed numbers of a cell, according to the configured numbers order.
+ * @param Pointer_Solver The solver context.
+ * @param Bitmask_Numbers The untried numbers (it must not be zero).
+ * @return The number to try.
+ */
+static inline unsigned int SOLVER_KERNEL_NAME(SolverSelectNumber)(TSolver *Pointer_Solver, SOLVER_KERNEL_BITMASK Bitmask_Numbers)
+{
+	unsigned int Skipped_Numbers_Count;
+	
+	switch (Pointer_Solver->Configuration.Number_Order)
+	{
+		case SOLVER_NUMBER_ORDER_DESCENDING:
+			return SOLVER_KERNEL_GET_BIGGEST_NUMBER(Bitmask_Numbers);
+			
+		case SOLVER_NUMBER_ORDER_RANDOM:
+			// Remove as many smallest numbers as needed to reach the randomly chosen one
+			Skipped_Numbers_Count = SolverGetRandomNumber(Pointer_Solver) % SOLVER_KERNEL_COUNT_NUMBERS(Bitmask_Numbers);
+			for ( ; Skipped_Numbers_Count > 0; Skipped_Numbers_Count--) Bitmask_Numbers &= Bitmask_Numbers - 1;
+			return SOLVER_KERNEL_GET_SMALLEST_NUMBER(Bitmask_Numbers);
+			
+		default:
+			return SOLVER_KERNEL_GET_SMALLEST_NUMBER(Bitmask_Numbers);
+	}
+}
+
+/** Put a number in an empty cell, remove the cell from the empty cells and record it in the trail.
+ * @param Pointer_Solver The solver context.
+ * @param Cell_Index The cell index.
+ * @param Number The number to put in the cell.
+ */
+static inline void SOLVER_KERNEL_NAME(SolverFillCell)(TSolver *Pointer_Solver, int Cell_Index, unsigned int Number)
+{
+	TGrid *Pointer_Grid = &Pointer_Solver->Grid;
+	const TGridGeometry *Pointer_Geometry = Pointer_Grid->Pointer_Geometry;
+	const unsigned short *Pointer_Peers;
+	unsigned int i;
+	int Peer_Index;
+	SOLVER_KERNEL_BITMASK Bitmask_Number;
+	
+	Bitmask_Number = SOLVER_KERNEL_BITMASK_NUMBER(Number);
+	
+	// The filled cells are removed from the cells stack when they reach its top
+	if (Pointer_Solver->Configuration.Cell_Order == SOLVER_CELL_ORDER_MOST_CONSTRAINED)
+	{
+		CellsBucketsRemove(&Pointer_Solver->Cells_Buckets, Cell_Index);
+		
+		// The number is no more allowed in the empty peers that still allowed it (this must be checked before the bitmasks are updated)
+		Pointer_Peers = Pointer_Geometry->Peers[Cell_Index];
+		SOLVER_KERNEL_UNROLL
+		for (i = 0; i < SOLVER_KERNEL_PEERS_COUNT; i++)
+		{
+			Peer_Index = Pointer_Peers[i];
+			if (Pointer_Grid->Cells[Peer_Index] != GRID_EMPTY_CELL_VALUE) continue;
+			if (SOLVER_KERNEL_NAME(SolverGetCellMissingNumbers)(Pointer_Grid, Peer_Index) & Bitmask_Number) CellsBucketsDecrement(&Pointer_Solver->Cells_Buckets, Peer_Index);
+		}
+	}
+	
+	// Update the grid directly, this is called for each search step
+	Pointer_Grid->Cells[Cell_Index] = Number;
+	Pointer_Grid->Bitmask_Rows[Pointer_Geometry->Cells_Row[Cell_Index]] &= ~Bitmask_Number;
+	Pointer_Grid->Bitmask_Columns[Pointer_Geometry->Cells_Column[Cell_Index]] &= ~Bitmask_Number;
+	Pointer_Grid->Bitmask_Squares[Pointer_Geometry->Cells_Square[Cell_Index]] &= ~Bitmask_Number;
+	
+	Pointer_Solver->Trail[Pointer_Solver->Trail_Size] = Cell_Index;
+	Pointer_Solver->Trail_Size++;
+}
+
+/** Empty all cells filled since the trail had the provided size, in the reverse filling order, and put them back in the empty cells.
+ * @param Pointer_Solver The solver context.
+ * @param Trail_Size The trail size to go back to.
+ */
+static inline void SOLVER_KERNEL_NAME(SolverUndo)(TSolver *Pointer_Solver, int Trail_Size)
+{
+	TGrid *Pointer_Grid = &Pointer_Solver->Grid;
+	const TGridGeometry *Pointer_Geometry = Pointer_Grid->Pointer_Geometry;
+	const unsigned short *Pointer_Peers;
+	unsigned int i;
+	int Cell_Index, Peer_Index, *Pointer_Cell;
+	SOLVER_KERNEL_BITMASK Bitmask_Number;
+	
+	while (Pointer_Solver->Trail_Size > Trail_Size)
+	{
+		Pointer_Solver->Trail_Size--;
+		Cell_Index = Pointer_Solver->Trail[Pointer_Solver->Trail_Size];
+		Pointer_Cell = &Pointer_Grid->Cells[Cell_Index];
+		Bitmask_Number = SOLVER_KERNEL_BITMASK_NUMBER(*Pointer_Cell);
+		
+		*Pointer_Cell = GRID_EMPTY_CELL_VALUE;
+		Pointer_Grid->Bitmask_Rows[Pointer_Geometry->Cells_Row[Cell_Index]] |= Bitmask_Number;
+		Pointer_Grid->Bitmask_Columns[Pointer_Geometry->Cells_Column[Cell_Index]] |= Bitmask_Number;
+		Pointer_Grid->Bitmask_Squares[Pointer_Geometry->Cells_Square[Cell_Index]] |= Bitmask_Number;
+		
+		if (Pointer_Solver->Configuration.Cell_Order == SOLVER_CELL_ORDER_MOST_CONSTRAINED)
+		{
+			// The number is allowed again in the empty peers that allow it now that the bitmasks are restored
+			Pointer_Peers = Pointer_Geometry->Peers[Cell_Index];
+			SOLVER_KERNEL_UNROLL
+			for (i = 0; i < SOLVER_KERNEL_PEERS_COUNT; i++)
+			{
+				Peer_Index = Pointer_Peers[i];
+				if (Pointer_Grid->Cells[Peer_Index] != GRID_EMPTY_CELL_VALUE) continue;
+				if (SOLVER_KERNEL_NAME(SolverGetCellMissingNumbers)(Pointer_Grid, Peer_Index) & Bitmask_Number) CellsBucketsIncrement(&Pointer_Solver->Cells_Buckets, Peer_Index);
+			}
+			
+			CellsBucketsAdd(&Pointer_Solver->Cells_Buckets, Cell_Index, SOLVER_KERNEL_COUNT_NUMBERS(SOLVER_KERNEL_NAME(SolverGetCellMissingNumbers)(Pointer_Grid, Cell_Index)));
+		}
+	}
+}
+
+/** Fill all cells having a single allowed number (naked singles).
+ * @param Pointer_Solver The solver context.
+ * @return -1 if an empty cell has no allowed number,
+ * @return The filled cells count.
+ */
+static int SOLVER_KERNEL_NAME(SolverFillNakedSingles)(TSolver *Pointer_Solver)
+{
+	TGrid *Pointer_Grid = &Pointer_Solver->Grid;
+	TCandidates *Pointer_Candidates = &Pointer_Solver->Candidates;
+	int Cell_Index, i, Filled_Cells_Count = 0;
+	SOLVER_KERNEL_BITMASK Bitmask_Missing_Numbers;
+	
+	// The buckets directly give the cells with zero or one allowed number
+	if (Pointer_Solver->Configuration.Cell_Order == SOLVER_CELL_ORDER_MOST_CONSTRAINED)
+	{
+		while (CellsBucketsGetMostConstrainedCell(&Pointer_Solver->Cells_Buckets, &Cell_Index))
+		{
+			Bitmask_Missing_Numbers = SOLVER_KERNEL_NAME(SolverGetCellMissingNumbers)(Pointer_Grid, Cell_Index);
+			if (Bitmask_Missing_Numbers == 0) return -1;
+			if (Bitmask_Missing_Numbers & (Bitmask_Missing_Numbers - 1)) break; // More than one number is allowed
+			
+			SOLVER_KERNEL_NAME(SolverFillCell)(Pointer_Solver, Cell_Index, SOLVER_KERNEL_GET_SMALLEST_NUMBER(Bitmask_Missing_Numbers));
+			Filled_Cells_Count++;
+		}
+		return Filled_Cells_Count;
+	}
+	
+	// Otherwise all empty cells must be checked, this is done for all cells at once
+	if (CandidatesCompute(Pointer_Candidates, Pointer_Grid) != 0) return -1;
+	for (i = 0; i < Pointer_Candidates->Naked_Singles_Count; i++)
+	{
+		// A previous single of the list may have taken the number of this one
+		Cell_Index = Pointer_Candidates->Naked_Singles[i];
+		Bitmask_Missing_Numbers = SOLVER_KERNEL_NAME(SolverGetCellMissingNumbers)(Pointer_Grid, Cell_Index);
+		if (Bitmask_Missing_Numbers == 0) return -1;
+		
+		SOLVER_KERNEL_NAME(SolverFillCell)(Pointer_Solver, Cell_Index, SOLVER_KERNEL_GET_SMALLEST_NUMBER(Bitmask_Missing_Numbers));
+		Filled_Cells_Count++;
+	}
+	return Filled_Cells_Count;
+}
+
+/** Fill all cells that are the only place of a number in a row, a column or a square (hidden singles).
+ * @param Pointer_Solver The solver context.
+ * @return -1 if a number missing in a row, a column or a square can't be placed anywhere in it,
+ * @return The filled cells count.
+ */
+static int SOLVER_KERNEL_NAME(SolverFillHiddenSingles)(TSolver *Pointer_Solver)
+{
+	TGrid *Pointer_Grid = &Pointer_Solver->Grid;
+	const TGridGeometry *Pointer_Geometry = Pointer_Grid->Pointer_Geometry;
+	const unsigned short *Pointer_Unit_Cells, *Pointer_Peers;
+	TGridBitmask *Pointer_Cells_Candidates;
+	unsigned int Unit, Units_Count, i, j, Size;
+	SOLVER_KERNEL_BITMASK Bitmask_Unit_Missing_Numbers, Bitmask_Once, Bitmask_Twice, Bitmask_Cell_Numbers, Bitmask_Singles, Bitmask_Number;
+	int Cell_Index, Filled_Cells_Count = 0;
+	
+	// Get the allowed numbers of all cells at once (they are updated for each filled cell), an empty cell allowing no number is already a contradiction
+	if (CandidatesCompute(&Pointer_Solver->Candidates, Pointer_Grid) != 0) return -1;
+	Pointer_Cells_Candidates = Pointer_Solver->Candidates.Cells_Candidates;
+	
+	Size = SOLVER_KERNEL_SIZE;
+	Units_Count = 3 * Size;
+	for (Unit = 0; Unit < Units_Count; Unit++)
+	{
+		if (Unit < Size) Bitmask_Unit_Missing_Numbers = Pointer_Grid->Bitmask_Rows[Unit];
+		else if (Unit < 2 * Size) Bitmask_Unit_Missing_Numbers = Pointer_Grid->Bitmask_Columns[Unit - Size];
+		else Bitmask_Unit_Missing_Numbers = Pointer_Grid->Bitmask_Squares[Unit - 2 * Size];
+		if (Bitmask_Unit_Missing_Numbers == 0) continue; // The unit is full
+		
+		// Find the numbers allowed in at least one cell and the ones allowed in at least two cells (the filled cells allow no number)
+		Pointer_Unit_Cells = Pointer_Geometry->Units_Cells[Unit];
+		Bitmask_Once = 0;
+		Bitmask_Twice = 0;
+		SOLVER_KERNEL_UNROLL
+		for (i = 0; i < Size; i++)
+		{
+			Bitmask_Cell_Numbers = Pointer_Cells_Candidates[Pointer_Unit_Cells[i]];
+			Bitmask_Twice |= Bitmask_Once & Bitmask_Cell_Numbers;
+			Bitmask_Once |= Bitmask_Cell_Numbers;
+		}
+		if (Bitmask_Once != Bitmask_Unit_Missing_Numbers) return -1;
+		
+		// Fill the cell of each number allowed in a single cell
+		Bitmask_Singles = Bitmask_Once & ~Bitmask_Twice;
+		while (Bitmask_Singles != 0)
+		{
+			Bitmask_Number = Bitmask_Singles & -Bitmask_Singles;
+			Bitmask_Singles &= ~Bitmask_Number;
+			
+			SOLVER_KERNEL_UNROLL
+			for (i = 0; i < Size; i++)
+			{
+				Cell_Index = Pointer_Unit_Cells[i];
+				if (!(Pointer_Cells_Candidates[Cell_Index] & Bitmask_Number)) continue;
+				
+				SOLVER_KERNEL_NAME(SolverFillCell)(Pointer_Solver, Cell_Index, SOLVER_KERNEL_GET_SMALLEST_NUMBER(Bitmask_Number));
+				Filled_Cells_Count++;
+				
+				// Keep the allowed numbers of the next units up to date
+				Pointer_Cells_Candidates[Cell_Index] = 0;
+				Pointer_Peers = Pointer_Geometry->Peers[Cell_Index];
+				SOLVER_KERNEL_UNROLL
+				for (j = 0; j < SOLVER_KERNEL_PEERS_COUNT; j++) Pointer_Cells_Candidates[Pointer_Peers[j]] &= ~((TGridBitmask) Bitmask_Number);
+				break;
+			}
+			// When a previous single of this unit filled the only cell allowing this number, the next propagation pass reports the contradiction
+		}
+	}
+	return Filled_Cells_Count;
+}
+
+/** Fill the naked and hidden singles until no more cell is forced.
+ * @param Pointer_Solver The solver context.
+ * @return 0 if the grid is still consistent,
+ * @return -1 if a contradiction was found.
+ */
+static int SOLVER_KERNEL_NAME(SolverPropagate)(TSolver *Pointer_Solver)
+{
+	int Filled_Cells_Count, Result = 0;
+	#if CONFIGURATION_SOLVER_INSTRUMENTATION
+		unsigned long long Start_Time = ClockGetTime();
+	#endif
+	
+	do
+	{
+		// Naked singles are cheaper to find, so look for hidden singles only when there is no more naked single
+		Filled_Cells_Count = SOLVER_KERNEL_NAME(SolverFillNakedSingles)(Pointer_Solver);
+		if (Filled_Cells_Count < 0)
+		{
+			Result = -1;
+			break;
+		}
+		if (Filled_Cells_Count == 0)
+		{
+			Filled_Cells_Count = SOLVER_KERNEL_NAME(SolverFillHiddenSingles)(Pointer_Solver);
+			if (Filled_Cells_Count < 0)
+			{
+				Result = -1;
+				break;
+			}
+			
+			#if CONFIGURATION_SOLVER_INSTRUMENTATION
+				Pointer_Solver->Instrumentation.Hidden_Singles_Count += Filled_Cells_Count;
+			#endif
+		}
+		#if CONFIGURATION_SOLVER_INSTRUMENTATION
+			else Pointer_Solver->Instrumentation.Naked_Singles_Count += Filled_Cells_Count;
+		#endif
+		Pointer_Solver->Statistics.Propagated_Cells_Count += Filled_Cells_Count;
+	} while (Filled_Cells_Count > 0);
+	
+	#if CONFIGURATION_SOLVER_INSTRUMENTATION
+		Pointer_Solver->Instrumentation.Phases_Durations[INSTRUMENTATION_PHASE_PROPAGATION] += ClockGetTime() - Start_Time;
+		Pointer_Solver->Instrumentation.Propagations_Count++;
+		if (Result != 0) Pointer_Solver->Instrumentation.Contradictions_Count++;
+	#endif
+	return Result;
+}
+
+/** Find the next cell to fill.
+ * @param Pointer_Solver The solver context.
+ * @param Pointer_Cell_Index On output, contain the cell index.
+ * @return 1 if an empty cell was found,
+ * @return 0 if the grid is full.
+ */
+static inline int SOLVER_KERNEL_NAME(SolverChooseCell)(TSolver *Pointer_Solver, int *Pointer_Cell_Index)
+{
+	TGrid *Pointer_Grid = &Pointer_Solver->Grid;
+	TCellsStack *Pointer_Cells_Stack = &Pointer_Solver->Cells_Stack;
+	TCellCoordinates *Pointer_Cell_Coordinates;
+	
+	if (Pointer_Solver->Configuration.Cell_Order == SOLVER_CELL_ORDER_MOST_CONSTRAINED) return CellsBucketsGetMostConstrainedCell(&Pointer_Solver->Cells_Buckets, Pointer_Cell_Index);
+	
+	// Remove the cells already filled from the stack top, the first empty one is the next cell in the fixed order (it is removed from the stack when a deeper level is entered)
+	while (Pointer_Cells_Stack->Pointer > 0)
+	{
+		Pointer_Cell_Coordinates = &Pointer_Cells_Stack->Cells[Pointer_Cells_Stack->Pointer - 1];
+		*Pointer_Cell_Index = Pointer_Cell_Coordinates->Row * SOLVER_KERNEL_SIZE + Pointer_Cell_Coordinates->Column;
+		if (Pointer_Grid->Cells[*Pointer_Cell_Index] == GRID_EMPTY_CELL_VALUE) return 1;
+		Pointer_Cells_Stack->Pointer--;
+	}
+	return 0;
+}
+
+/** The backtrack algorithm. The search is iterative and all its state is stored in the solver context : each level remembers the chosen cell, the numbers still to try on it and what must be emptied when the level is left. The search stops when the solver solutions limit is reached.
+ * @param Pointer_Solver The solver context.
+ * @return 1 if the solutions limit was reached (the grid holds the last solution) or 0 if not (in this case all cells filled by the solver have been emptied).
+ */
+static int SOLVER_KERNEL_NAME(SolverBacktrack)(TSolver *Pointer_Solver)
+{
+	int Cell_Index, Is_Level_Entered = 1;
+	unsigned int Tested_Number, Polling_Countdown = SOLVER_POLLING_PERIOD;
+	SOLVER_KERNEL_BITMASK Bitmask_Missing_Numbers;
+	TGrid *Pointer_Grid = &Pointer_Solver->Grid;
+	TSolverLevel *Pointer_Level;
+	#if CONFIGURATION_SOLVER_INSTRUMENTATION
+		TInstrumentation *Pointer_Instrumentation = &Pointer_Solver->Instrumentation;
+	#endif
+	
+	// The geometry tables must match the kernel shape
+	assert(Pointer_Grid->Size == SOLVER_KERNEL_SIZE);
+	assert(Pointer_Grid->Pointer_Geometry->Peers_Count == SOLVER_KERNEL_PEERS_COUNT);
+	
+	while (1)
+	{
+		// Poll every SOLVER_POLLING_PERIOD iterations whatever they do (enter a node, try a number or go back into the tree), so no polling period is skipped
+		Polling_Countdown--;
+		if (Polling_Countdown == 0)
+		{
+			Polling_Countdown = SOLVER_POLLING_PERIOD;
+			Pointer_Solver->Is_Level_Branching = !Is_Level_Entered;
+			
+			// Stop the search if requested, all levels are left at once
+			if (SolverPoll(Pointer_Solver))
+			{
+				SOLVER_KERNEL_NAME(SolverUndo)(Pointer_Solver, Pointer_Solver->Levels[0].Trail_Size);
+				Pointer_Solver->Cells_Stack.Pointer = Pointer_Solver->Levels[0].Cells_Stack_Pointer;
+				Pointer_Solver->Depth = 0;
+				return 0;
+			}
+		}
+		
+		Pointer_Level = &Pointer_Solver->Levels[Pointer_Solver->Depth];
+		
+		// Prepare the level just entered
+		if (Is_Level_Entered)
+		{
+			Is_Level_Entered = 0;
+			
+			// Remember what to restore if this part of the search tree has no solution
+			Pointer_Level->Trail_Size = Pointer_Solver->Trail_Size;
+			Pointer_Level->Cells_Stack_Pointer = Pointer_Solver->Cells_Stack.Pointer;
+			Pointer_Level->Remaining_Numbers = 0; // Nothing to try if the level is a dead end
+			
+			// Fill the forced cells first, a contradiction means that the previous choices were wrong
+			#if CONFIGURATION_SOLVER_INSTRUMENTATION
+				InstrumentationRecordNode(Pointer_Instrumentation, Pointer_Solver->Depth);
+			#endif
+			if (!Pointer_Solver->Configuration.Is_Propagation_Enabled || (SOLVER_KERNEL_NAME(SolverPropagate)(Pointer_Solver) == 0))
+			{
+				if (!SOLVER_KERNEL_NAME(SolverChooseCell)(Pointer_Solver, &Cell_Index))
+				{
+					// No empty cell remain and there is no error in the grid : a solution has been found, go back into the tree to find the next one if more solutions are needed
+					if (GridIsCorrectlyFilled(Pointer_Grid))
+					{
+						if (SolverRecordSolution(Pointer_Solver)) return 1;
+					}
+					// A bad grid was generated...
+					#ifdef DEBUG
+						else printf("[%s] Bad grid generated !\n", __FUNCTION__);
+					#endif
+				}
+				else
+				{
+					// Get available numbers for this cell (if no number is available a bad grid has been generated...)
+					Bitmask_Missing_Numbers = SOLVER_KERNEL_NAME(SolverGetCellMissingNumbers)(Pointer_Grid, Cell_Index);
+					Pointer_Solver->Statistics.Avoided_Bad_Solutions_Count += SOLVER_KERNEL_SIZE - SOLVER_KERNEL_COUNT_NUMBERS(Bitmask_Missing_Numbers);
+					#if CONFIGURATION_SOLVER_INSTRUMENTATION
+						InstrumentationRecordBranching(Pointer_Instrumentation, SOLVER_KERNEL_COUNT_NUMBERS(Bitmask_Missing_Numbers));
+					#endif
+					
+					#ifdef DEBUG
+						printf("[%s] Available numbers for (row %d ; column %d) : ", __FUNCTION__, Pointer_Grid->Pointer_Geometry->Cells_Row[Cell_Index], Pointer_Grid->Pointer_Geometry->Cells_Column[Cell_Index]);
+						GridShowBitmask(Pointer_Grid, Bitmask_Missing_Numbers);
+					#endif
+					
+					// Keep the cell and the numbers to try where a split can find them (a split removes the numbers it hands out)
+					Pointer_Level->Branch_Trail_Index = Pointer_Solver->Trail_Size;
+					Pointer_Level->Cell_Index = Cell_Index;
+					Pointer_Level->Remaining_Numbers = Bitmask_Missing_Numbers;
+					Pointer_Level->Numbers_Count = SOLVER_KERNEL_COUNT_NUMBERS(Bitmask_Missing_Numbers);
+				}
+			}
+		}
+		
+		// All numbers were tested unsuccessfully, empty the forced cells and go back into the tree
+		if (Pointer_Level->Remaining_Numbers == 0)
+		{
+			#if CONFIGURATION_SOLVER_INSTRUMENTATION
+				InstrumentationRecordBacktrack(Pointer_Instrumentation, Pointer_Solver->Depth);
+			#endif
+			SOLVER_KERNEL_NAME(SolverUndo)(Pointer_Solver, Pointer_Level->Trail_Size);
+			Pointer_Solver->Cells_Stack.Pointer = Pointer_Level->Cells_Stack_Pointer;
+			if (Pointer_Solver->Depth == 0) return 0;
+			
+			// Bad solution found, restore the cell chosen by the previous level
+			Pointer_Solver->Depth--;
+			Pointer_Level = &Pointer_Solver->Levels[Pointer_Solver->Depth];
+			SOLVER_KERNEL_NAME(SolverUndo)(Pointer_Solver, Pointer_Level->Branch_Trail_Index);
+			Pointer_Solver->Statistics.Bad_Solutions_Found_Count++;
+			
+			#ifdef DEBUG
+				printf("[%s] Restored grid :\n", __FUNCTION__);
+				GridShowDifferences(Pointer_Grid, GRID_COLOR_CODE_RED);
+				putchar('\n');
+			#endif
+			continue;
+		}
+		
+		// Try the next number
+		Tested_Number = SOLVER_KERNEL_NAME(SolverSelectNumber)(Pointer_Solver, Pointer_Level->Remaining_Numbers);
+		Pointer_Level->Remaining_Numbers &= ~SOLVER_KERNEL_BITMASK_NUMBER(Tested_Number);
+		SOLVER_KERNEL_NAME(SolverFillCell)(Pointer_Solver, Pointer_Level->Cell_Index, Tested_Number);
+		Pointer_Solver->Statistics.Loops_Count++;
+		
+		#ifdef DEBUG
+			printf("[%s] Modified grid :\n", __FUNCTION__);
+			GridShowDifferences(Pointer_Grid, GRID_COLOR_CODE_BLUE);
+			putchar('\n');
+		#endif
+		
+		// Simulate next state
+		Pointer_Solver->Depth++;
+		Is_Level_Entered = 1;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+// The next kernel has its own parameters
+//-------------------------------------------------------------------------------------------------
+#undef SOLVER_KERNEL_SUFFIX
+#undef SOLVER_KERNEL_SIZE
+#undef SOLVER_KERNEL_SQUARE_WIDTH
+#undef SOLVER_KERNEL_SQUARE_HEIGHT
+#undef SOLVER_KERNEL_CONCATENATE_EXPANDED
+#undef SOLVER_KERNEL_CONCATENATE
+#undef SOLVER_KERNEL_NAME
+#undef SOLVER_KERNEL_PEERS_COUNT
+#undef SOLVER_KERNEL_UNROLL
+#undef SOLVER_KERNEL_BITMASK
+#undef SOLVER_KERNEL_BITMASK_NUMBER
+#undef SOLVER_KERNEL_COUNT_NUMBERS
+#undef SOLVER_KERNEL_GET_SMALLEST_NUMBER
+#undef SOLVER_KERNEL_GET_BIGGEST_NUMBER
@@ -0,0 +1,76 @@
+/** @file Tasks_Deque.h
+ * A fixed size work-stealing deque (Chase-Lev algorithm). Only the deque owner thread can push and pop tasks at the deque bottom, while all other threads can steal tasks from the deque top without any lock.
+ * @author Adrien RICCIARDI
+ * @version 1.0 : 17/10/2026
+ */
+#ifndef H_TASKS_DEQUE_H
+#define H_TASKS_DEQUE_H
+
+#include <stdatomic.h>
+
+//-------------------------------------------------------------------------------------------------
+// Constants
+//-------------------------------------------------------------------------------------------------
+/** How many tasks a deque can hold. This must be a power of 2. */
+#define TASKS_DEQUE_SIZE 4096
+
+/** Size of a cache line in bytes, used to keep the deque indexes written by different threads in different cache lines. */
+#define TASKS_DEQUE_CACHE_LINE_SIZE 64
+
+/** A task was stolen. */
+#define TASKS_DEQUE_STEAL_RESULT_SUCCESS 0
+/** The deque was empty. */
+#define TASKS_DEQUE_STEAL_RESULT_EMPTY 1
+/** Another thread took the task first, the steal can be tried again. */
+#define TASKS_DEQUE_STEAL_RESULT_ABORT 2
+
+//-------------------------------------------------------------------------------------------------
+// Types
+//-------------------------------------------------------------------------------------------------
+/** A work-stealing deque. */
+typedef struct
+{
+	_Alignas(TASKS_DEQUE_CACHE_LINE_SIZE) atomic_long Top; //! Index of the oldest task, incremented by the thieves.
+	_Alignas(TASKS_DEQUE_CACHE_LINE_SIZE) atomic_long Bottom; //! Index of the next free slot, only modified by the owner.
+	_Alignas(TASKS_DEQUE_CACHE_LINE_SIZE) void * _Atomic Tasks[TASKS_DEQUE_SIZE]; //! The tasks circular buffer.
+} TTasksDeque;
+
+//-------------------------------------------------------------------------------------------------
+// Functions
+//-------------------------------------------------------------------------------------------------
+/** Set the deque as empty.
+ * @param Pointer_Deque The deque.
+ * @warning No other thread must access the deque during the initialization.
+ */
+void TasksDequeInitialize(TTasksDeque *Pointer_Deque);
+
+/** Add a task at the deque bottom. Only the deque owner can call this function.
+ * @param Pointer_Deque The deque.
+ * @param Pointer_Task The task, it must not be NULL.
+ * @return 0 if the task was added,
+ * @return -1 if the deque is full.
+ */
+int TasksDequePush(TTasksDeque *Pointer_Deque, void *Pointer_Task);
+
+/** Remove the most recent task from the deque bottom. Only the deque owner can call this function.
+ * @param Pointer_Deque The deque.
+ * @return The task,
+ * @return NULL if the deque is empty.
+ */
+void *TasksDequePop(TTasksDeque *Pointer_Deque);
+
+/** Remove the oldest task from the deque top. Any thread can call this function.
+ * @param Pointer_Deque The deque.
+ * @param Pointer_Task On output, contain the stolen task if the function succeeded.
+ * @return A TASKS_DEQUE_STEAL_RESULT_XXX value.
+ */
+int TasksDequeSteal(TTasksDeque *Pointer_Deque, void **Pointer_Task);
+
+/** Tell whether the deque is empty. The result is only an estimation if other threads are using the deque.
+ * @param Pointer_Deque The deque.
+ * @return 1 if the deque is empty,
+ * @return 0 if the deque contains tasks.
+ */
+int TasksDequeIsEmpty(TTasksDeque *Pointer_Deque);
+
+#endif
@@ -0,0 +1,520 @@
+/** @file Main.c
+ * Measure the solver speed. All grids are loaded into memory before the measure (the test grids and the grids generated with fixed seeds), then each grid is solved several times after a warm-up, so the measure does not include the program startup, the grid parsing or the display. The results can be written to a JSON file and compared with a stored baseline to catch the solver regressions.
+ * @author Adrien RICCIARDI
+ * @version 1.0 : 17/10/2026
+ */
+#include <Candidates.h>
+#include <Clock.h>
+#include <Generator.h>
+#include <Grid.h>
+#include <Solver.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** How many groups of grids can be measured. */
+#define MAIN_MAXIMUM_GROUPS_COUNT 32
+/** The maximum length of a group name, including the terminating zero. */
+#define MAIN_GROUP_NAME_SIZE 64
+
+/** The seed of the generated grids, it never changes so the generated grids are the same for all runs. */
+#define MAIN_GENERATOR_SEED 2026
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** A group of grids measured together. */
+typedef struct
+{
+	char String_Name[MAIN_GROUP_NAME_SIZE]; //! The group name, it identifies the group in the baseline.
+	TGrid *Pointer_Grids; //! The group grids.
+	int Grids_Count; //! How many grids the group contains.
+	int Grids_Capacity; //! How many grids the grids array can hold.
+} TMainGroup;
+
+/** The measures of a group. */
+typedef struct
+{
+	int Grids_Count; //! How many grids were measured.
+	int Unsolved_Grids_Count; //! How many grids could not be solved.
+	unsigned long long Solvings_Count; //! How many solvings were measured (each grid is solved several times).
+	double Mean_Nanoseconds; //! The mean solving time of a grid.
+	double Mean_Of_Medians_Nanoseconds; //! The mean of each grid median solving time. Unlike the mean time, it is not disturbed by the few solvings slowed down by the operating system, so it is compared with the baseline.
+	unsigned long long Median_Nanoseconds; //! Half of the solvings were faster than this time.
+	unsigned long long Percentile_99_Nanoseconds; //! 99% of the solvings were faster than this time.
+	unsigned long long Maximum_Nanoseconds; //! The slowest solving time.
+	double Nodes_Per_Second; //! How many search tree nodes (solver loops) were explored per second.
+	unsigned long long Loops_Count; //! The solver loops of a single solving of all grids (this does not depend on the machine, so a change means that the search itself changed).
+	unsigned long long Bad_Solutions_Found_Count; //! The bad solutions found by a single solving of all grids.
+} TMainGroupResult;
+
+/** A measure read from the baseline file. */
+typedef struct
+{
+	char String_Name[MAIN_GROUP_NAME_SIZE]; //! The group name.
+	double Mean_Of_Medians_Nanoseconds; //! The mean of each grid median solving time.
+	unsigned long long Loops_Count; //! The solver loops of a single solving of all grids.
+} TMainBaselineResult;
+
+//-------------------------------------------------------------------------------------------------
+// Private variables
+//-------------------------------------------------------------------------------------------------
+/** All groups of grids. */
+static TMainGroup Main_Groups[MAIN_MAXIMUM_GROUPS_COUNT];
+/** How many groups are used. */
+static int Main_Groups_Count = 0;
+/** The measures of all groups. */
+static TMainGroupResult Main_Results[MAIN_MAXIMUM_GROUPS_COUNT];
+
+/** The solver of all measures. */
+static TSolver Main_Solver;
+/** The dancing links engine storage. */
+static TDancingLinks Main_Dancing_Links;
+/** Generate the grids (it is big, so it is not on the stack). */
+static TGenerator Main_Generator;
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Find a group by its name, create it if it does not exist.
+ * @param String_Name The group name.
+ * @return The group,
+ * @return NULL if there is no more room for a new group.
+ */
+static TMainGroup *MainGetGroup(char *String_Name)
+{
+	int i;
+	
+	for (i = 0; i < Main_Groups_Count; i++)
+	{
+		if (strcmp(Main_Groups[i].String_Name, String_Name) == 0) return &Main_Groups[i];
+	}
+	
+	if (Main_Groups_Count == MAIN_MAXIMUM_GROUPS_COUNT) return NULL;
+	snprintf(Main_Groups[i].String_Name, MAIN_GROUP_NAME_SIZE, "%s", String_Name);
+	Main_Groups_Count++;
+	return &Main_Groups[i];
+}
+
+/** Append a grid to a group.
+ * @param Pointer_Group The group.
+ * @param Pointer_Grid The grid to copy into the group.
+ * @return 0 if the grid was added,
+ * @return -1 if there is not enough memory.
+ */
+static int MainAddGrid(TMainGroup *Pointer_Group, TGrid *Pointer_Grid)
+{
+	TGrid *Pointer_Grids;
+	int Capacity;
+	
+	// Make room for more grids
+	if (Pointer_Group->Grids_Count == Pointer_Group->Grids_Capacity)
+	{
+		if (Pointer_Group->Grids_Capacity == 0) Capacity = 16;
+		else Capacity = Pointer_Group->Grids_Capacity * 2;
+		Pointer_Grids = realloc(Pointer_Group->Pointer_Grids, Capacity * sizeof(TGrid));
+		if (Pointer_Grids == NULL) return -1;
+		Pointer_Group->Pointer_Grids = Pointer_Grids;
+		Pointer_Group->Grids_Capacity = Capacity;
+	}
+	
+	GridCopy(&Pointer_Group->Pointer_Grids[Pointer_Group->Grids_Count], Pointer_Grid);
+	Pointer_Group->Grids_Count++;
+	return 0;
+}
+
+/** Load all grids of a file, each grid is added to the group of the grids of its size.
+ * @param String_File_Name The file name.
+ * @return 0 if the file was loaded,
+ * @return -1 if the file could not be opened, if a grid is bad or if there is not enough memory.
+ */
+static int MainLoadFile(char *String_File_Name)
+{
+	FILE *File;
+	TGrid Grid;
+	TMainGroup *Pointer_Group;
+	char String_Name[MAIN_GROUP_NAME_SIZE];
+	int Result;
+	
+	File = fopen(String_File_Name, "rb");
+	if (File == NULL)
+	{
+		printf("Error : can't open file %s.\n", String_File_Name);
+		return -1;
+	}
+	
+	while ((Result = GridLoadFromStream(&Grid, File)) != 1)
+	{
+		if (Result != 0)
+		{
+			printf("Error : file %s contains a bad grid.\n", String_File_Name);
+			fclose(File);
+			return -1;
+		}
+		
+		snprintf(String_Name, sizeof(String_Name), "files-%ux%u", Grid.Size, Grid.Size);
+		Pointer_Group = MainGetGroup(String_Name);
+		if ((Pointer_Group == NULL) || (MainAddGrid(Pointer_Group, &Grid) != 0))
+		{
+			printf("Error : not enough memory to load file %s.\n", String_File_Name);
+			fclose(File);
+			return -1;
+		}
+	}
+	
+	fclose(File);
+	return 0;
+}
+
+/** Generate a group of grids. The grids only depend on their size, their givens count and their index, so they are the same for all runs.
+ * @param Size The grids side size.
+ * @param Givens_Target Stop removing the givens when a grid has this many givens (use 0 to generate minimal grids).
+ * @param Grids_Count How many grids to generate.
+ * @return 0 if the grids were generated,
+ * @return -1 if there is not enough memory.
+ */
+static int MainGenerateGroup(unsigned int Size, unsigned int Givens_Target, int Grids_Count)
+{
+	TGrid Grid;
+	TMainGroup *Pointer_Group;
+	char String_Name[MAIN_GROUP_NAME_SIZE];
+	int i;
+	
+	if (Grids_Count == 0) return 0;
+	
+	if (Givens_Target == 0) snprintf(String_Name, sizeof(String_Name), "generated-%ux%u-minimal", Size, Size);
+	else snprintf(String_Name, sizeof(String_Name), "generated-%ux%u-%u-givens", Size, Size, Givens_Target);
+	Pointer_Group = MainGetGroup(String_Name);
+	if (Pointer_Group == NULL) return -1;
+	
+	for (i = 0; i < Grids_Count; i++)
+	{
+		GeneratorSetSeed(&Main_Generator, ((unsigned long long) MAIN_GENERATOR_SEED << 32) + i);
+		if (GeneratorGenerate(&Main_Generator, Size, Givens_Target, &Grid, NULL) != 0) return 0; // This size is not supported by this build, the group stays empty
+		if (MainAddGrid(Pointer_Group, &Grid) != 0) return -1;
+	}
+	return 0;
+}
+
+/** Compare two solving times, this is the qsort() callback.
+ * @param Pointer_A The first time.
+ * @param Pointer_B The second time.
+ * @return A negative value if the first time is lower, 0 if both times are equal or a positive value if the first time is greater.
+ */
+static int MainCompareTimes(const void *Pointer_A, const void *Pointer_B)
+{
+	unsigned long long A = *(const unsigned long long *) Pointer_A, B = *(const unsigned long long *) Pointer_B;
+	
+	if (A < B) return -1;
+	if (A > B) return 1;
+	return 0;
+}
+
+/** Solve all grids of a group several times and compute the measures.
+ * @param Pointer_Group The group.
+ * @param Warm_Up_Count How many times each grid is solved before the measure.
+ * @param Repetitions_Count How many times each grid is solved during the measure.
+ * @param Pointer_Result On output, contain the group measures.
+ * @return 0 if the group was measured,
+ * @return -1 if there is not enough memory.
+ */
+static int MainMeasureGroup(TMainGroup *Pointer_Group, int Warm_Up_Count, int Repetitions_Count, TMainGroupResult *Pointer_Result)
+{
+	unsigned long long *Pointer_Times, Start_Time, Total_Time = 0, Total_Loops_Count = 0, Total_Medians_Time = 0;
+	int i, j, Result;
+	TSolverStatistics Statistics;
+	
+	memset(Pointer_Result, 0, sizeof(TMainGroupResult));
+	Pointer_Result->Grids_Count = Pointer_Group->Grids_Count;
+	Pointer_Result->Solvings_Count = (unsigned long long) Pointer_Group->Grids_Count * Repetitions_Count;
+	if (Pointer_Result->Solvings_Count == 0) return 0;
+	
+	Pointer_Times = malloc(Pointer_Result->Solvings_Count * sizeof(unsigned long long));
+	if (Pointer_Times == NULL) return -1;
+	
+	for (i = 0; i < Pointer_Group->Grids_Count; i++)
+	{
+		// Bring the grid and the solver code into the caches
+		for (j = 0; j < Warm_Up_Count; j++)
+		{
+			SolverLoadFromGrid(&Main_Solver, &Pointer_Group->Pointer_Grids[i]);
+			SolverSolve(&Main_Solver);
+		}
+		
+		for (j = 0; j < Repetitions_Count; j++)
+		{
+			Start_Time = ClockGetTime();
+			SolverLoadFromGrid(&Main_Solver, &Pointer_Group->Pointer_Grids[i]);
+			Result = SolverSolve(&Main_Solver);
+			Pointer_Times[i * Repetitions_Count + j] = ClockGetTime() - Start_Time;
+			Total_Time += Pointer_Times[i * Repetitions_Count + j];
+			
+			SolverGetStatistics(&Main_Solver, &Statistics);
+			Total_Loops_Count += Statistics.Loops_Count;
+		}
+		
+		qsort(&Pointer_Times[i * Repetitions_Count], Repetitions_Count, sizeof(unsigned long long), MainCompareTimes);
+		Total_Medians_Time += Pointer_Times[i * Repetitions_Count + (Repetitions_Count - 1) / 2];
+		
+		// The search does not depend on the repetition, so the statistics of the last one are kept
+		if (Result != SOLVER_RESULT_SOLVED) Pointer_Result->Unsolved_Grids_Count++;
+		Pointer_Result->Loops_Count += Statistics.Loops_Count;
+		Pointer_Result->Bad_Solutions_Found_Count += Statistics.Bad_Solutions_Found_Count;
+	}
+	
+	qsort(Pointer_Times, Pointer_Result->Solvings_Count, sizeof(unsigned long long), MainCompareTimes);
+	Pointer_Result->Mean_Nanoseconds = (double) Total_Time / Pointer_Result->Solvings_Count;
+	Pointer_Result->Mean_Of_Medians_Nanoseconds = (double) Total_Medians_Time / Pointer_Group->Grids_Count;
+	Pointer_Result->Median_Nanoseconds = Pointer_Times[(Pointer_Result->Solvings_Count - 1) / 2];
+	Pointer_Result->Percentile_99_Nanoseconds = Pointer_Times[(Pointer_Result->Solvings_Count - 1) * 99 / 100];
+	Pointer_Result->Maximum_Nanoseconds = Pointer_Times[Pointer_Result->Solvings_Count - 1];
+	if (Total_Time > 0) Pointer_Result->Nodes_Per_Second = Total_Loops_Count * 1e9 / Total_Time;
+	
+	free(Pointer_Times);
+	return 0;
+}
+
+/** Write the measures of all groups to a JSON file. Each group is written on its own line, so the file can be read back without a full JSON parser (see MainCompareWithBaseline()).
+ * @param String_File_Name The file name.
+ * @return 0 if the file was written,
+ * @return -1 if the file could not be created.
+ */
+static int MainWriteJSON(char *String_File_Name)
+{
+	FILE *File;
+	int i;
+	TMainGroupResult *Pointer_Result;
+	
+	File = fopen(String_File_Name, "w");
+	if (File == NULL)
+	{
+		printf("Error : can't create file %s.\n", String_File_Name);
+		return -1;
+	}
+	
+	fprintf(File, "{\n\t\"groups\": [\n");
+	for (i = 0; i < Main_Groups_Count; i++)
+	{
+		Pointer_Result = &Main_Results[i];
+		fprintf(File, "\t\t{\"name\": \"%s\", \"grids\": %d, \"unsolved_grids\": %d, \"solvings\": %llu, \"mean_ns\": %.0f, \"mean_of_medians_ns\": %.0f, \"p50_ns\": %llu, \"p99_ns\": %llu, \"max_ns\": %llu, \"nodes_per_second\": %.0f, \"loops_count\": %llu, \"bad_solutions_found_count\": %llu}%s\n", Main_Groups[i].String_Name, Pointer_Result->Grids_Count,
+			Pointer_Result->Unsolved_Grids_Count, Pointer_Result->Solvings_Count, Pointer_Result->Mean_Nanoseconds, Pointer_Result->Mean_Of_Medians_Nanoseconds, Pointer_Result->Median_Nanoseconds, Pointer_Result->Percentile_99_Nanoseconds, Pointer_Result->Maximum_Nanoseconds, Pointer_Result->Nodes_Per_Second,
+			Pointer_Result->Loops_Count, Pointer_Result->Bad_Solutions_Found_Count, (i < Main_Groups_Count - 1) ? "," : "");
+	}
+	fprintf(File, "\t]\n}\n");
+	
+	fclose(File);
+	return 0;
+}
+
+/** Compare the measures with a baseline written by MainWriteJSON(). A group is slower when the mean of its grids median times is more than the tolerance above the baseline one, and its search changed when its loops count is not the same.
+ * @param String_File_Name The baseline file name.
+ * @param Tolerance_Percentage How much slower than the baseline a group can be, in percents of the baseline time.
+ * @return How many groups are slower than the baseline,
+ * @return -1 if the baseline could not be read.
+ */
+static int MainCompareWithBaseline(char *String_File_Name, double Tolerance_Percentage)
+{
+	FILE *File;
+	char String_Line[1024], *Pointer_Field;
+	TMainBaselineResult Baseline;
+	int i, Slower_Groups_Count = 0;
+	double Ratio;
+	
+	File = fopen(String_File_Name, "r");
+	if (File == NULL)
+	{
+		printf("Error : can't open baseline file %s.\n", String_File_Name);
+		return -1;
+	}
+	
+	printf("\nComparison with baseline %s (tolerance %.1f%%) :\n", String_File_Name, Tolerance_Percentage);
+	while (fgets(String_Line, sizeof(String_Line), File) != NULL)
+	{
+		// Only the group lines are needed
+		if (sscanf(String_Line, " {\"name\": \"%63[^\"]\"", Baseline.String_Name) != 1) continue;
+		Pointer_Field = strstr(String_Line, "\"mean_of_medians_ns\": ");
+		if ((Pointer_Field == NULL) || (sscanf(Pointer_Field, "\"mean_of_medians_ns\": %lf", &Baseline.Mean_Of_Medians_Nanoseconds) != 1)) continue;
+		Pointer_Field = strstr(String_Line, "\"loops_count\": ");
+		if ((Pointer_Field == NULL) || (sscanf(Pointer_Field, "\"loops_count\": %llu", &Baseline.Loops_Count) != 1)) continue;
+		
+		for (i = 0; i < Main_Groups_Count; i++)
+		{
+			if (strcmp(Main_Groups[i].String_Name, Baseline.String_Name) == 0) break;
+		}
+		if ((i == Main_Groups_Count) || (Main_Results[i].Solvings_Count == 0) || (Baseline.Mean_Of_Medians_Nanoseconds <= 0))
+		{
+			printf("  %-32s : not measured\n", Baseline.String_Name);
+			continue;
+		}
+		
+		Ratio = Main_Results[i].Mean_Of_Medians_Nanoseconds / Baseline.Mean_Of_Medians_Nanoseconds;
+		printf("  %-32s : %+6.1f%%", Baseline.String_Name, (Ratio - 1) * 100);
+		if (Ratio > 1 + Tolerance_Percentage / 100)
+		{
+			printf(" SLOWER");
+			Slower_Groups_Count++;
+		}
+		if (Main_Results[i].Loops_Count != Baseline.Loops_Count) printf(" (search changed : %llu loops instead of %llu)", Main_Results[i].Loops_Count, Baseline.Loops_Count);
+		putchar('\n');
+	}
+	
+	fclose(File);
+	return Slower_Groups_Count;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Entry point
+//-------------------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+	char *String_JSON_File_Name = NULL, *String_Baseline_File_Name = NULL;
+	int i, Warm_Up_Count = 1, Repetitions_Count = 10, Generated_Grids_Count = 100, Is_Parameter_Bad = 0, Instruction_Set = CANDIDATES_INSTRUCTION_SET_AUTOMATIC, Result;
+	double Tolerance_Percentage = 10;
+	TSolverConfiguration Configuration;
+	TMainGroupResult *Pointer_Result;
+	
+	SolverGetDefaultConfiguration(&Configuration);
+	
+	// Parse the command line
+	for (i = 1; i < argc; i++)
+	{
+		if ((strcmp(argv[i], "--repetitions") == 0) && (i + 1 < argc))
+		{
+			i++;
+			Repetitions_Count = atoi(argv[i]);
+		}
+		else if ((strcmp(argv[i], "--warm-up") == 0) && (i + 1 < argc))
+		{
+			i++;
+			Warm_Up_Count = atoi(argv[i]);
+		}
+		else if ((strcmp(argv[i], "--generated") == 0) && (i + 1 < argc))
+		{
+			i++;
+			Generated_Grids_Count = atoi(argv[i]);
+		}
+		else if ((strcmp(argv[i], "--json") == 0) && (i + 1 < argc))
+		{
+			i++;
+			String_JSON_File_Name = argv[i];
+		}
+		else if ((strcmp(argv[i], "--baseline") == 0) && (i + 1 < argc))
+		{
+			i++;
+			String_Baseline_File_Name = argv[i];
+		}
+		else if ((strcmp(argv[i], "--tolerance") == 0) && (i + 1 < argc))
+		{
+			i++;
+			Tolerance_Percentage = atof(argv[i]);
+		}
+		else if ((strcmp(argv[i], "--engine") == 0) && (i + 1 < argc))
+		{
+			i++;
+			if (strcmp(argv[i], "backtracking") == 0) Configuration.Engine = SOLVER_ENGINE_BACKTRACKING;
+			else if (strcmp(argv[i], "dlx") == 0) Configuration.Engine = SOLVER_ENGINE_DANCING_LINKS;
+			else
+			{
+				Is_Parameter_Bad = 1;
+				break;
+			}
+		}
+		else if ((strcmp(argv[i], "--cell-order") == 0) && (i + 1 < argc))
+		{
+			i++;
+			if (strcmp(argv[i], "fixed") == 0) Configuration.Cell_Order = SOLVER_CELL_ORDER_FIXED;
+			else if (strcmp(argv[i], "constrained") == 0) Configuration.Cell_Order = SOLVER_CELL_ORDER_MOST_CONSTRAINED;
+			else
+			{
+				Is_Parameter_Bad = 1;
+				break;
+			}
+		}
+		else if (strcmp(argv[i], "--no-propagation") == 0) Configuration.Is_Propagation_Enabled = 0;
+		else if ((strcmp(argv[i], "--instruction-set") == 0) && (i + 1 < argc))
+		{
+			i++;
+			if (strcmp(argv[i], "scalar") == 0) Instruction_Set = CANDIDATES_INSTRUCTION_SET_SCALAR;
+			else if (strcmp(argv[i], "sse4") == 0) Instruction_Set = CANDIDATES_INSTRUCTION_SET_SSE4;
+			else if (strcmp(argv[i], "avx2") == 0) Instruction_Set = CANDIDATES_INSTRUCTION_SET_AVX2;
+			else
+			{
+				Is_Parameter_Bad = 1;
+				break;
+			}
+		}
+		else if (argv[i][0] == '-')
+		{
+			Is_Parameter_Bad = 1;
+			break;
+		}
+		// Any other argument is a grids file
+		else if (MainLoadFile(argv[i]) != 0) return EXIT_FAILURE;
+	}
+	
+	// Check parameters
+	if (Is_Parameter_Bad || (Repetitions_Count <= 0) || (Warm_Up_Count < 0) || (Generated_Grids_Count < 0))
+	{
+		printf("Error : bad parameters.\n");
+		printf("Usage : %s [Options] [Grids_File_Name...]\n", argv[0]);
+		printf("Options : --repetitions Count : how many times each grid is solved during the measure (default is 10).\n");
+		printf("          --warm-up Count : how many times each grid is solved before the measure (default is 1).\n");
+		printf("          --generated Count : how many grids are generated for each generated group (default is 100, use 0 to measure the files grids only).\n");
+		printf("          --json File_Name : write the measures to a JSON file.\n");
+		printf("          --baseline File_Name : compare the measures with a JSON file written by a previous run, the program fails if a group is slower.\n");
+		printf("          --tolerance Percentage : how much slower than the baseline a group can be (default is 10).\n");
+		printf("          --engine backtracking|dlx, --cell-order fixed|constrained, --no-propagation, --instruction-set scalar|sse4|avx2 : the solver configuration (see Sudoku_Solver).\n");
+		return EXIT_FAILURE;
+	}
+	if (CandidatesSetInstructionSet(Instruction_Set) != 0)
+	{
+		printf("Error : the processor does not support this instruction set.\n");
+		return EXIT_FAILURE;
+	}
+	
+	// Generate the grids with fixed seeds, from the easiest to the hardest
+	GeneratorInitialize(&Main_Generator);
+	if (Generated_Grids_Count > 0)
+	{
+		if ((MainGenerateGroup(9, 36, Generated_Grids_Count) != 0) || (MainGenerateGroup(9, 0, Generated_Grids_Count) != 0) || (MainGenerateGroup(16, 140, Generated_Grids_Count) != 0) || (MainGenerateGroup(25, 400, Generated_Grids_Count / 10) != 0))
+		{
+			printf("Error : not enough memory to generate the grids.\n");
+			return EXIT_FAILURE;
+		}
+	}
+	
+	SolverInitialize(&Main_Solver);
+	SolverSetConfiguration(&Main_Solver, &Configuration);
+	SolverSetDancingLinks(&Main_Solver, &Main_Dancing_Links);
+	
+	// Measure all groups
+	printf("%-32s %6s %12s %12s %12s %12s %14s %14s %14s\n", "Group", "Grids", "Mean (ns)", "p50 (ns)", "p99 (ns)", "Max (ns)", "Nodes/s", "Loops", "Bad solutions");
+	for (i = 0; i < Main_Groups_Count; i++)
+	{
+		Pointer_Result = &Main_Results[i];
+		if (MainMeasureGroup(&Main_Groups[i], Warm_Up_Count, Repetitions_Count, Pointer_Result) != 0)
+		{
+			printf("Error : not enough memory to measure the group %s.\n", Main_Groups[i].String_Name);
+			return EXIT_FAILURE;
+		}
+		printf("%-32s %6d %12.0f %12llu %12llu %12llu %14.0f %14llu %14llu\n", Main_Groups[i].String_Name, Pointer_Result->Grids_Count, Pointer_Result->Mean_Nanoseconds, Pointer_Result->Median_Nanoseconds, Pointer_Result->Percentile_99_Nanoseconds, Pointer_Result->Maximum_Nanoseconds,
+			Pointer_Result->Nodes_Per_Second, Pointer_Result->Loops_Count, Pointer_Result->Bad_Solutions_Found_Count);
+		if (Pointer_Result->Unsolved_Grids_Count > 0) printf("Warning : %d grids of group %s could not be solved.\n", Pointer_Result->Unsolved_Grids_Count, Main_Groups[i].String_Name);
+	}
+	
+	if ((String_JSON_File_Name != NULL) && (MainWriteJSON(String_JSON_File_Name) != 0)) return EXIT_FAILURE;
+	
+	if (String_Baseline_File_Name != NULL)
+	{
+		Result = MainCompareWithBaseline(String_Baseline_File_Name, Tolerance_Percentage);
+		if (Result != 0)
+		{
+			if (Result > 0) printf("Failure : %d groups are slower than the baseline.\n", Result);
+			return EXIT_FAILURE;
+		}
+	}
+	return EXIT_SUCCESS;
+}
@@ -1,89 +1,1166 @@
 /** @file Converter.c
- * Convert e-sudoku web site sudokus to Sudoku_Solver format.
+ * Convert whole files of grids between the e-sudoku web site dumps, the Sudoku_Solver text format, the common single line format (81 characters for a 9x9 grid), the .sdk multi-lines format and the packed grids format.
+ * The input is read through a big buffer and the grids are converted with lookup tables, so the conversion goes at the disk speed. The grids size is found from each grid, a file can mix several sizes.
  * @author Adrien RICCIARDI
  * @version 1.0 : 26/12/2013
  * @version 1.1 : 29/08/2014, updated to the new grid format.
+ * @version 1.2 : 17/10/2026, added the conversions between the grids files and the packed grids files.
+ * @version 2.0 : 17/10/2026, rewritten as a streaming converter handling several formats and all grid sizes.
+ * @version 2.1 : 17/10/2026, added the grids deduplication under the Sudoku symmetries and the expansion of the unique grids solutions.
  */
+#include <Canonical.h>
+#include <Grid.h>
+#include <Packed_Grids.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include "Grid.h" // To have GRID_EMPTY_CELL_VALUE constant
 
 //-------------------------------------------------------------------------------------------------
 // Private constants
 //-------------------------------------------------------------------------------------------------
-/** Size of the token buffer in bytes. */
-#define BUFFER_SIZE 32
+/** The size of the input buffer and of the output stream buffer in bytes. */
+#define CONVERTER_BUFFER_SIZE (4 * 1024 * 1024)
+
+/** The longest text written for a single reservation of the output buffer : a whole grid with a line end after each row and a blank line, or a row of e-sudoku statements (up to 19 characters each, like sudoku[48][48]="n";). */
+#define CONVERTER_MAXIMUM_RESERVED_SIZE (GRID_MAXIMUM_CELLS_COUNT + 24 * CONFIGURATION_GRID_MAXIMUM_SIZE)
+
+/** The biggest grid of the formats numbering the cells from 1, the number 64 has no character. */
+#define CONVERTER_ONE_BASED_MAXIMUM_SIZE 49
+
+/** The longest map file line : the unique grid index, the transposition flag, the rows, the columns and the numbers permutations, the spaces and the line end. */
+#define CONVERTER_MAP_LINE_MAXIMUM_SIZE (32 + 3 * (CONFIGURATION_GRID_MAXIMUM_SIZE + 1))
+
+/** The slots count of the hash set when the first class is added, it must be a power of 2. */
+#define CONVERTER_HASH_SET_INITIAL_SLOTS_COUNT 4096
 
 //-------------------------------------------------------------------------------------------------
 // Private types
 //-------------------------------------------------------------------------------------------------
-/** List all the possible errors recognized by the tokens parser. */
+/** All converted formats. */
 typedef enum
 {
-	RESULT_READ_TOKEN_NO_ERROR, //! A token was successfully read.
-	RESULT_READ_TOKEN_ERROR_BUFFER_OVERFLOW, //! The destination buffer overflowed before ';' was found.
-	RESULT_READ_TOKEN_EOF //! The end of the file was reached before a ';' was found.
-} TResultReadToken;
+	CONVERTER_FORMAT_AUTOMATIC, //! Find the input format from the beginning of the input.
+	CONVERTER_FORMAT_ESUDOKU, //! The sudoku[Row][Column]="Number"; statements of the e-sudoku web pages, the numbers start from 1 and a space is an empty cell.
+	CONVERTER_FORMAT_TEXT, //! The Sudoku_Solver grids files, the numbers start from 0.
+	CONVERTER_FORMAT_LINE, //! A whole grid on a single line, the numbers start from 1 and a '.' or a '0' is an empty cell.
+	CONVERTER_FORMAT_SDK, //! A grid row per line, the numbers start from 1, a '.' or a '0' is an empty cell and the lines starting with '#' are comments.
+	CONVERTER_FORMAT_PACKED //! The packed grids files (see Packed_Grids.h).
+} TConverterFormat;
+
+/** The buffered input, the lines are handed out as views of the buffer. */
+typedef struct
+{
+	FILE *File; //! The input stream.
+	unsigned char Buffer[CONVERTER_BUFFER_SIZE]; //! The read bytes.
+	size_t Start; //! The first byte not handed out yet.
+	size_t End; //! The end of the read bytes.
+	int Is_End_Reached; //! Set to 1 when the stream has no more bytes.
+	unsigned long long Line; //! The number of the last handed out line (the first line is 1).
+	unsigned long long Grid_Line; //! The line of the last loaded grid first row.
+	unsigned long long Grids_Count; //! How many grids were found, including the bad ones.
+	TPackedGrids Packed_Grids; //! The header of a packed grids input.
+	int Is_ESudoku_Cell_Pending; //! Set to 1 when the first cell of the next e-sudoku grid was already read.
+	int ESudoku_Pending_Cell_Value; //! The value of the first cell of the next e-sudoku grid.
+} TConverterReader;
+
+/** The buffered output, the text formats are written to the buffer and the packed grids are directly written to the stream. */
+typedef struct
+{
+	FILE *File; //! The output stream.
+	TConverterFormat Format; //! The written format.
+	unsigned long long Grids_Count; //! How many grids were written.
+	TPackedGrids Packed_Grids; //! The packed grids output, created when the first grid is written.
+	size_t Used; //! How many bytes of the buffer are waiting to be written.
+	char Buffer[CONVERTER_BUFFER_SIZE]; //! The text waiting to be written.
+} TConverterWriter;
+
+/** A class of grids, which are the same puzzle under the Sudoku symmetries. Its bytes are the canonical grid cells when deduplicating, and the canonical grid solution (or the solving result line when it is not a grid) when expanding. */
+typedef struct
+{
+	unsigned long long Hash; //! The hash of the class bytes and of the grid size.
+	size_t Offset; //! Where the class bytes are in the classes bytes storage.
+	unsigned int Bytes_Count; //! How many bytes the class has.
+	unsigned int Size; //! The grid size, or 0 when the class bytes are a solving result line.
+} TConverterClass;
 
 //-------------------------------------------------------------------------------------------------
 // Private variables
 //-------------------------------------------------------------------------------------------------
-static FILE *File;
-static char Buffer[BUFFER_SIZE];
-static int Grid[BUFFER_SIZE * BUFFER_SIZE];
+/** The input, it is too big for the stack. */
+static TConverterReader Reader;
+/** The output. */
+static TConverterWriter Writer;
+/** The converted grid. */
+static TGrid Grid;
+/** The solution of a packed grids file record. */
+static TGrid Solution;
+
+/** The value of each character of the formats numbering the cells from 0, -1 for the bad characters. */
+static int Character_Values_Zero_Based[256];
+/** The value of each character of the formats numbering the cells from 1, -1 for the bad characters. */
+static int Character_Values_One_Based[256];
+/** The character of each cell of the formats numbering the cells from 0, at index 0 for an empty cell and at index N + 1 for the number N (so the characters are selected without branch). */
+static char Cell_Characters_Zero_Based[CONFIGURATION_GRID_MAXIMUM_SIZE + 1];
+/** The character of each cell of the formats numbering the cells from 1, indexed like Cell_Characters_Zero_Based. */
+static char Cell_Characters_One_Based[CONFIGURATION_GRID_MAXIMUM_SIZE + 1];
+
+/** The canonical form of the deduplicated grid, or the canonical solution of the expanded grid. */
+static TGrid Canonical_Grid;
+
+/** The classes found so far, a class index is its unique grid index. */
+static TConverterClass *Pointer_Classes = NULL;
+/** How many classes were found. */
+static unsigned int Classes_Count = 0;
+/** How many classes the classes array can hold. */
+static unsigned int Classes_Capacity = 0;
+/** The bytes of all classes, one after the other. */
+static unsigned char *Pointer_Classes_Bytes = NULL;
+/** How many bytes the classes use. */
+static size_t Classes_Bytes_Count = 0;
+/** How many bytes the classes bytes storage can hold. */
+static size_t Classes_Bytes_Capacity = 0;
+/** The open addressing hash set finding the class of a canonical grid, each slot holds a class index plus 1 (0 for a free slot). */
+static unsigned int *Pointer_Hash_Slots = NULL;
+/** How many slots the hash set has, a power of 2. */
+static unsigned int Hash_Slots_Count = 0;
 
 //-------------------------------------------------------------------------------------------------
 // Private functions
 //-------------------------------------------------------------------------------------------------
-/** Read the file until the ';' character is found.
- * @return A TResultReadToken.
+/** Fill the characters conversion tables from the grid files characters. */
+static void ConverterInitializeTables(void)
+{
+	int Character, Value;
+	
+	for (Character = 0; Character < 256; Character++)
+	{
+		Value = GridConvertCharacterToValue((char) Character);
+		Character_Values_Zero_Based[Character] = Value;
+		
+		// The '0' character is an empty cell when the numbers start from 1
+		if ((Value == GRID_EMPTY_CELL_VALUE) || (Value == 0)) Character_Values_One_Based[Character] = GRID_EMPTY_CELL_VALUE;
+		else if (Value > 0) Character_Values_One_Based[Character] = Value - 1;
+		else Character_Values_One_Based[Character] = -1;
+		
+		if ((Value >= 0) && (Value < CONFIGURATION_GRID_MAXIMUM_SIZE)) Cell_Characters_Zero_Based[Value + 1] = (char) Character;
+		if ((Value > 0) && (Value <= CONFIGURATION_GRID_MAXIMUM_SIZE)) Cell_Characters_One_Based[Value] = (char) Character;
+	}
+	Cell_Characters_Zero_Based[0] = '.';
+	Cell_Characters_One_Based[0] = '.';
+}
+
+/** Tell where the character of a cell is in the cells characters tables.
+ * @param Value The cell value.
+ * @return The character index.
+ */
+static inline unsigned int ConverterGetCellCharacterIndex(int Value)
+{
+	// Computed with a mask, the compiler turns a condition into a branch which is mispredicted on each empty cell
+	return ((unsigned int) Value + 1) & -(unsigned int) (Value != GRID_EMPTY_CELL_VALUE);
+}
+
+/** Read more bytes, the bytes not handed out yet are moved to the buffer beginning.
+ * @param Pointer_Reader The input.
+ * @return 0 if bytes were read,
+ * @return 1 if the end of the input was reached,
+ * @return -1 if the buffer is full.
+ */
+static int ConverterReaderFill(TConverterReader *Pointer_Reader)
+{
+	size_t Count;
+	
+	if (Pointer_Reader->Is_End_Reached) return 1;
+	
+	if (Pointer_Reader->Start > 0)
+	{
+		memmove(Pointer_Reader->Buffer, &Pointer_Reader->Buffer[Pointer_Reader->Start], Pointer_Reader->End - Pointer_Reader->Start);
+		Pointer_Reader->End -= Pointer_Reader->Start;
+		Pointer_Reader->Start = 0;
+	}
+	if (Pointer_Reader->End == sizeof(Pointer_Reader->Buffer)) return -1;
+	
+	// A short read happens only at the end of the input (or on a read error, reported when the conversion is finished)
+	Count = fread(&Pointer_Reader->Buffer[Pointer_Reader->End], 1, sizeof(Pointer_Reader->Buffer) - Pointer_Reader->End, Pointer_Reader->File);
+	Pointer_Reader->End += Count;
+	if (Pointer_Reader->End < sizeof(Pointer_Reader->Buffer)) Pointer_Reader->Is_End_Reached = 1;
+	if (Count == 0) return 1;
+	return 0;
+}
+
+/** Hand out the bytes up to the next delimiter character, the delimiter is skipped. The last bytes of the input are handed out even if they are not followed by a delimiter.
+ * @param Pointer_Reader The input.
+ * @param Delimiter The delimiter character.
+ * @param Pointer_Pointer_Bytes On output, contain the first handed out byte. The bytes are valid until the next reading.
+ * @param Pointer_Length On output, contain how many bytes are handed out.
+ * @return 0 if bytes were handed out,
+ * @return 1 if the end of the input was reached,
+ * @return -1 if no delimiter was found in a full buffer.
  */
-static TResultReadToken ReadToken(void)
+static int ConverterReaderReadUntil(TConverterReader *Pointer_Reader, int Delimiter, const char **Pointer_Pointer_Bytes, size_t *Pointer_Length)
 {
-	int i;
+	unsigned char *Pointer_Delimiter;
+	int Result;
 	
-	// Read up to BUFFER_SIZE characters
-	for (i = 0; i < BUFFER_SIZE - 1; i++)
+	while (1)
 	{
-		if (fread(&Buffer[i], 1, 1, File) != 1)
+		Pointer_Delimiter = memchr(&Pointer_Reader->Buffer[Pointer_Reader->Start], Delimiter, Pointer_Reader->End - Pointer_Reader->Start);
+		if (Pointer_Delimiter != NULL)
 		{
-			Buffer[i] = 0;
-			return RESULT_READ_TOKEN_EOF;
+			*Pointer_Pointer_Bytes = (const char *) &Pointer_Reader->Buffer[Pointer_Reader->Start];
+			*Pointer_Length = Pointer_Delimiter - &Pointer_Reader->Buffer[Pointer_Reader->Start];
+			Pointer_Reader->Start += *Pointer_Length + 1;
+			return 0;
 		}
 		
-		// Exit when ';' is found
-		if (Buffer[i] == ';')
+		Result = ConverterReaderFill(Pointer_Reader);
+		if (Result == -1) return -1;
+		if (Result == 1)
+		{
+			if (Pointer_Reader->Start == Pointer_Reader->End) return 1;
+			*Pointer_Pointer_Bytes = (const char *) &Pointer_Reader->Buffer[Pointer_Reader->Start];
+			*Pointer_Length = Pointer_Reader->End - Pointer_Reader->Start;
+			Pointer_Reader->Start = Pointer_Reader->End;
+			return 0;
+		}
+	}
+}
+
+/** Hand out the next line, without its line end and its trailing spaces.
+ * @param Pointer_Reader The input.
+ * @param Pointer_Pointer_Line On output, contain the line first character. The line is valid until the next reading.
+ * @param Pointer_Length On output, contain the line length.
+ * @return 0 if a line was handed out,
+ * @return 1 if the end of the input was reached,
+ * @return -1 if the line is longer than the buffer.
+ */
+static int ConverterReaderReadLine(TConverterReader *Pointer_Reader, const char **Pointer_Pointer_Line, size_t *Pointer_Length)
+{
+	const char *Pointer_Line;
+	size_t Length;
+	int Result;
+	
+	Result = ConverterReaderReadUntil(Pointer_Reader, '\n', &Pointer_Line, &Length);
+	if (Result != 0) return Result;
+	Pointer_Reader->Line++;
+	
+	while ((Length > 0) && ((Pointer_Line[Length - 1] == '\r') || (Pointer_Line[Length - 1] == ' ') || (Pointer_Line[Length - 1] == '\t'))) Length--;
+	*Pointer_Pointer_Line = Pointer_Line;
+	*Pointer_Length = Length;
+	return 0;
+}
+
+/** Hand out a fixed amount of bytes.
+ * @param Pointer_Reader The input.
+ * @param Count How many bytes to hand out, it must not be bigger than the buffer.
+ * @param Pointer_Pointer_Bytes On output, contain the first handed out byte. The bytes are valid until the next reading.
+ * @return 0 if the bytes were handed out,
+ * @return 1 if the input has not enough bytes left (the remaining bytes are dropped).
+ */
+static int ConverterReaderReadBytes(TConverterReader *Pointer_Reader, size_t Count, const unsigned char **Pointer_Pointer_Bytes)
+{
+	while (Pointer_Reader->End - Pointer_Reader->Start < Count)
+	{
+		if (ConverterReaderFill(Pointer_Reader) != 0)
+		{
+			Pointer_Reader->Start = Pointer_Reader->End;
+			return 1;
+		}
+	}
+	
+	*Pointer_Pointer_Bytes = &Pointer_Reader->Buffer[Pointer_Reader->Start];
+	Pointer_Reader->Start += Count;
+	return 0;
+}
+
+/** Tell the size of the grids whose rows or whole content have a given length.
+ * @param Length The line length.
+ * @param Pointer_Is_Single_Line On output, set to 1 if the line holds a whole grid, set to 0 if it holds a grid row.
+ * @return The grid size, or 0 if no grid has such lines.
+ */
+static unsigned int ConverterGetLineGridSize(size_t Length, int *Pointer_Is_Single_Line)
+{
+	unsigned int Size;
+	
+	// A 36 characters line is a whole 6x6 grid, like when the solver reads it
+	for (Size = 1; Size * Size < Length; Size++);
+	if ((Size * Size == Length) && GridIsSizeSupported(Size))
+	{
+		*Pointer_Is_Single_Line = 1;
+		return Size;
+	}
+	
+	*Pointer_Is_Single_Line = 0;
+	if ((Length <= CONFIGURATION_GRID_MAXIMUM_SIZE) && GridIsSizeSupported((unsigned int) Length)) return (unsigned int) Length;
+	return 0;
+}
+
+/** Convert the characters of a grid part to cells values.
+ * @param Pointer_Character_Values The conversion table of the format.
+ * @param Pointer_Characters The characters.
+ * @param Count How many characters to convert.
+ * @param Size The grid size.
+ * @param Pointer_Cells On output, contain the cells values.
+ * @return 0 if all characters are the numbers of a grid of this size or empty cells,
+ * @return -3 if a character is bad.
+ */
+static inline int ConverterConvertCharacters(const int *Pointer_Character_Values, const char *Pointer_Characters, size_t Count, unsigned int Size, int *Pointer_Cells)
+{
+	size_t i;
+	int Value, Is_Bad = 0;
+	
+	// The bad characters are checked once for all characters, so the loop has no branch
+	for (i = 0; i < Count; i++)
+	{
+		Value = Pointer_Character_Values[(unsigned char) Pointer_Characters[i]];
+		Is_Bad |= ((unsigned int) Value >= Size) & (Value != GRID_EMPTY_CELL_VALUE);
+		Pointer_Cells[i] = Value;
+	}
+	
+	if (Is_Bad) return -3;
+	return 0;
+}
+
+/** Configure the size of a grid whose cells were converted. The converted grids bitmasks are never used, so the grid is loaded only when its size changes.
+ * @param Pointer_Grid The grid.
+ * @param Size The grid size.
+ * @return 0 if the grid size was configured,
+ * @return -2 if the grid size is not supported.
+ */
+static inline int ConverterSetGridSize(TGrid *Pointer_Grid, unsigned int Size)
+{
+	if (Pointer_Grid->Size == Size) return 0;
+	return GridLoadFromCells(Pointer_Grid, Size);
+}
+
+/** Skip the remaining lines of a bad multi-lines grid, up to the next blank line.
+ * @param Pointer_Reader The input.
+ */
+static void ConverterReaderSkipGrid(TConverterReader *Pointer_Reader)
+{
+	const char *Pointer_Line;
+	size_t Length;
+	
+	while ((ConverterReaderReadLine(Pointer_Reader, &Pointer_Line, &Length) == 0) && (Length > 0));
+}
+
+/** Load the next grid of a text format, stored on a single line or on one line per row. The blank lines are skipped.
+ * @param Pointer_Reader The input.
+ * @param Format The text format (CONVERTER_FORMAT_TEXT, CONVERTER_FORMAT_LINE or CONVERTER_FORMAT_SDK).
+ * @param Pointer_Grid On output, contain the loaded grid.
+ * @return 0 if the grid was loaded,
+ * @return 1 if the end of the input was reached,
+ * @return -1 if a line is too long,
+ * @return -2 if the lines have not the shape of a grid,
+ * @return -3 if the grid has bad characters.
+ */
+static int ConverterLoadTextGrid(TConverterReader *Pointer_Reader, TConverterFormat Format, TGrid *Pointer_Grid)
+{
+	const int *Pointer_Character_Values;
+	const char *Pointer_Line;
+	size_t Length;
+	unsigned int Size, Row;
+	int Result, Is_Single_Line, Is_Comment_Allowed;
+	
+	if (Format == CONVERTER_FORMAT_TEXT)
+	{
+		Pointer_Character_Values = Character_Values_Zero_Based;
+		Is_Comment_Allowed = 0;
+	}
+	else
+	{
+		Pointer_Character_Values = Character_Values_One_Based;
+		Is_Comment_Allowed = 1;
+	}
+	
+	// Find the grid first line
+	do
+	{
+		Result = ConverterReaderReadLine(Pointer_Reader, &Pointer_Line, &Length);
+		if (Result != 0) return Result;
+	} while ((Length == 0) || (Is_Comment_Allowed && (Pointer_Line[0] == '#')));
+	Pointer_Reader->Grid_Line = Pointer_Reader->Line;
+	Pointer_Reader->Grids_Count++;
+	
+	// The .sdk grids have a row per line, the line format grids have a single line
+	if (Format == CONVERTER_FORMAT_SDK)
+	{
+		if ((Length > CONFIGURATION_GRID_MAXIMUM_SIZE) || !GridIsSizeSupported((unsigned int) Length)) return -2;
+		Size = (unsigned int) Length;
+		Is_Single_Line = 0;
+	}
+	else
+	{
+		Size = ConverterGetLineGridSize(Length, &Is_Single_Line);
+		if ((Size == 0) || ((Format == CONVERTER_FORMAT_LINE) && !Is_Single_Line)) return -2;
+	}
+	
+	if (Is_Single_Line)
+	{
+		if (ConverterConvertCharacters(Pointer_Character_Values, Pointer_Line, Length, Size, Pointer_Grid->Cells) != 0) return -3;
+		return ConverterSetGridSize(Pointer_Grid, Size);
+	}
+	
+	// Convert all rows, the lines of a bad grid are skipped up to the next blank line
+	for (Row = 0; Row < Size; Row++)
+	{
+		if (Row > 0)
+		{
+			Result = ConverterReaderReadLine(Pointer_Reader, &Pointer_Line, &Length);
+			if (Result == -1) return -1;
+			if ((Result == 1) || (Length == 0)) return -2;
+			if (Length != Size)
+			{
+				ConverterReaderSkipGrid(Pointer_Reader);
+				return -2;
+			}
+		}
+		if (ConverterConvertCharacters(Pointer_Character_Values, Pointer_Line, Length, Size, &Pointer_Grid->Cells[Row * Size]) != 0)
 		{
-			Buffer[i + 1] = 0;
-			return RESULT_READ_TOKEN_NO_ERROR;
+			ConverterReaderSkipGrid(Pointer_Reader);
+			return -3;
 		}
 	}
-	Buffer[i] = 0;
-	return RESULT_READ_TOKEN_ERROR_BUFFER_OVERFLOW;	
+	return ConverterSetGridSize(Pointer_Grid, Size);
 }
 
-/** Read the cell value from a token.
- * @return The cell value or -1 if an error occured.
+/** Load the next grid of an e-sudoku dump. The statements are separated by ';' characters, the sudoku[Row][Column]="Number" statements give the cells in the rows order, the solution[Row][Column] statements and the other statements are ignored. A grid ends when the sudoku[0][0] cell of the next grid is found.
+ * @param Pointer_Reader The input.
+ * @param Pointer_Grid On output, contain the loaded grid.
+ * @return 0 if the grid was loaded,
+ * @return 1 if the end of the input was reached,
+ * @return -1 if a statement is too long,
+ * @return -2 if the cells count is not the one of a supported grid,
+ * @return -3 if a cell value is bad.
  */
-static int ReadCellValue(void)
+static int ConverterLoadESudokuGrid(TConverterReader *Pointer_Reader, TGrid *Pointer_Grid)
 {
-	int i = 0, Cell_Value;
+	const char *Pointer_Token, *Pointer_Quote;
+	size_t Length;
+	unsigned int Cells_Count = 0, Size, i;
+	int Result, Value;
+	
+	if (Pointer_Reader->Is_ESudoku_Cell_Pending)
+	{
+		Pointer_Grid->Cells[0] = Pointer_Reader->ESudoku_Pending_Cell_Value;
+		Cells_Count = 1;
+		Pointer_Reader->Is_ESudoku_Cell_Pending = 0;
+	}
 	
-	// Search for '"' character
-	while ((Buffer[i] != '\"') && (Buffer[i] != 0)) i++;
-	if (Buffer[i] == 0) return -1; // No '"' found
+	while (1)
+	{
+		Result = ConverterReaderReadUntil(Pointer_Reader, ';', &Pointer_Token, &Length);
+		if (Result == -1) return -1;
+		if (Result == 1) break;
+		
+		// Keep only the cells statements
+		while ((Length > 0) && ((*Pointer_Token == ' ') || (*Pointer_Token == '\t') || (*Pointer_Token == '\r') || (*Pointer_Token == '\n')))
+		{
+			Pointer_Token++;
+			Length--;
+		}
+		if ((Length < 7) || (memcmp(Pointer_Token, "sudoku[", 7) != 0)) continue;
 		
-	// Extract cell value
-	Cell_Value = Buffer[i + 1];
+		// The value is the character following the quote, a space is an empty cell
+		Pointer_Quote = memchr(Pointer_Token, '"', Length);
+		if ((Pointer_Quote == NULL) || (Pointer_Quote + 1 >= Pointer_Token + Length)) Value = -1;
+		else if (Pointer_Quote[1] == ' ') Value = GRID_EMPTY_CELL_VALUE;
+		else Value = Character_Values_One_Based[(unsigned char) Pointer_Quote[1]];
+		
+		// The first cell of the next grid ends the current grid
+		if ((Length >= 12) && (memcmp(Pointer_Token, "sudoku[0][0]", 12) == 0) && (Cells_Count > 0))
+		{
+			Pointer_Reader->Is_ESudoku_Cell_Pending = 1;
+			Pointer_Reader->ESudoku_Pending_Cell_Value = Value;
+			break;
+		}
+		
+		// The cells of a too big grid are counted but not stored
+		if (Cells_Count < GRID_MAXIMUM_CELLS_COUNT) Pointer_Grid->Cells[Cells_Count] = Value;
+		Cells_Count++;
+	}
+	if (Cells_Count == 0) return 1;
+	Pointer_Reader->Grids_Count++;
 	
-	// Convert to number
-	if (Cell_Value == ' ') Cell_Value = GRID_EMPTY_CELL_VALUE;
-	else if ((Cell_Value >= '0') && (Cell_Value <= '9')) Cell_Value -= '0';
-	else if ((Cell_Value >= 'A') && (Cell_Value <= 'G')) Cell_Value = Cell_Value - 'A' + 10;
-	else Cell_Value = -1;
+	for (Size = 1; Size * Size < Cells_Count; Size++);
+	if ((Size * Size != Cells_Count) || !GridIsSizeSupported(Size)) return -2;
+	for (i = 0; i < Cells_Count; i++)
+	{
+		Value = Pointer_Grid->Cells[i];
+		if (((unsigned int) Value >= Size) && (Value != GRID_EMPTY_CELL_VALUE)) return -3;
+	}
+	return ConverterSetGridSize(Pointer_Grid, Size);
+}
+
+/** Load the next record of a packed grids file.
+ * @param Pointer_Reader The input, its packed grids header must have been decoded.
+ * @param Pointer_Grid On output, contain the record grid.
+ * @param Pointer_Solution On output, contain the record solution if the record has one.
+ * @param Pointer_Is_Solution_Present On output, set to 1 if the record has a solution.
+ * @return 0 if the record was loaded,
+ * @return 1 if the end of the input was reached,
+ * @return -3 if a cell code is bad.
+ */
+static int ConverterLoadPackedGrid(TConverterReader *Pointer_Reader, TGrid *Pointer_Grid, TGrid *Pointer_Solution, int *Pointer_Is_Solution_Present)
+{
+	TPackedGrids *Pointer_Packed_Grids = &Pointer_Reader->Packed_Grids;
+	const unsigned char *Pointer_Record;
+	
+	// A truncated last record is ignored
+	if (Pointer_Packed_Grids->Record_Index >= Pointer_Packed_Grids->Records_Count) return 1;
+	if (ConverterReaderReadBytes(Pointer_Reader, PackedGridsGetRecordBytesCount(Pointer_Packed_Grids), &Pointer_Record) != 0) return 1;
+	Pointer_Packed_Grids->Record_Index++;
+	Pointer_Reader->Grids_Count++;
+	
+	return PackedGridsUnpackRecord(Pointer_Packed_Grids, Pointer_Record, Pointer_Grid, Pointer_Solution, Pointer_Is_Solution_Present);
+}
+
+/** Find the input format from the first bytes of the input, without handing them out.
+ * A packed grids file starts with its header, an e-sudoku dump starts with a sudoku[ or solution[ statement and a .sdk file may start with a comment. The other inputs are text grids, which are read with the numbers starting from 1 when a grid of the read bytes has a number too big to start from 0 (like a '9' in a 9x9 grid).
+ * @param Pointer_Reader The input, its buffer must have been filled.
+ * @return The input format.
+ */
+static TConverterFormat ConverterDetectFormat(TConverterReader *Pointer_Reader)
+{
+	const char *Pointer_Characters, *Pointer_End, *Pointer_Line_End;
+	size_t Length, i;
+	unsigned int Size;
+	int Is_Single_Line, Value_Zero_Based;
+	TPackedGrids Packed_Grids;
+	
+	Pointer_Characters = (const char *) &Pointer_Reader->Buffer[Pointer_Reader->Start];
+	Pointer_End = (const char *) &Pointer_Reader->Buffer[Pointer_Reader->End];
+	if ((Pointer_End - Pointer_Characters >= PACKED_GRIDS_HEADER_SIZE) && (PackedGridsDecodeHeader(&Packed_Grids, (const unsigned char *) Pointer_Characters) != -1)) return CONVERTER_FORMAT_PACKED;
+	
+	// Skip the blank lines
+	while ((Pointer_Characters < Pointer_End) && ((*Pointer_Characters == ' ') || (*Pointer_Characters == '\t') || (*Pointer_Characters == '\r') || (*Pointer_Characters == '\n'))) Pointer_Characters++;
+	if ((Pointer_End - Pointer_Characters >= 7) && (memcmp(Pointer_Characters, "sudoku[", 7) == 0)) return CONVERTER_FORMAT_ESUDOKU;
+	if ((Pointer_End - Pointer_Characters >= 9) && (memcmp(Pointer_Characters, "solution[", 9) == 0)) return CONVERTER_FORMAT_ESUDOKU;
+	if ((Pointer_Characters < Pointer_End) && (*Pointer_Characters == '#')) return CONVERTER_FORMAT_SDK;
+	
+	// Look for a number which can only start from 1 in the lines of the read bytes
+	while (Pointer_Characters < Pointer_End)
+	{
+		Pointer_Line_End = memchr(Pointer_Characters, '\n', Pointer_End - Pointer_Characters);
+		if (Pointer_Line_End == NULL) Pointer_Line_End = Pointer_End;
+		Length = Pointer_Line_End - Pointer_Characters;
+		while ((Length > 0) && ((Pointer_Characters[Length - 1] == '\r') || (Pointer_Characters[Length - 1] == ' ') || (Pointer_Characters[Length - 1] == '\t'))) Length--;
+		
+		Size = ConverterGetLineGridSize(Length, &Is_Single_Line);
+		for (i = 0; (Size > 0) && (i < Length); i++)
+		{
+			Value_Zero_Based = Character_Values_Zero_Based[(unsigned char) Pointer_Characters[i]];
+			if ((Value_Zero_Based == GRID_EMPTY_CELL_VALUE) || (Value_Zero_Based < 0)) continue;
+			
+			// A 36x36 grid can't have a row per line in the text format, so a 36 characters line with a number above 6 is a .sdk grid row
+			if ((Length == 36) && (Value_Zero_Based > 6) && (Value_Zero_Based <= 36)) return CONVERTER_FORMAT_SDK;
+			if (Value_Zero_Based == (int) Size)
+			{
+				if (Is_Single_Line) return CONVERTER_FORMAT_LINE;
+				return CONVERTER_FORMAT_SDK;
+			}
+		}
+		Pointer_Characters = Pointer_Line_End + 1;
+	}
+	return CONVERTER_FORMAT_TEXT;
+}
+
+/** Tell the format matching a name.
+ * @param String_Name The format name.
+ * @return The format, or CONVERTER_FORMAT_AUTOMATIC if the name is unknown.
+ */
+static TConverterFormat ConverterGetFormat(char *String_Name)
+{
+	if (strcmp(String_Name, "esudoku") == 0) return CONVERTER_FORMAT_ESUDOKU;
+	if (strcmp(String_Name, "text") == 0) return CONVERTER_FORMAT_TEXT;
+	if (strcmp(String_Name, "line") == 0) return CONVERTER_FORMAT_LINE;
+	if (strcmp(String_Name, "sdk") == 0) return CONVERTER_FORMAT_SDK;
+	if (strcmp(String_Name, "packed") == 0) return CONVERTER_FORMAT_PACKED;
+	return CONVERTER_FORMAT_AUTOMATIC;
+}
+
+/** Append a decimal number to a string.
+ * @param Pointer_String Where to write the number.
+ * @param Number The number.
+ * @return The end of the written number.
+ */
+static char *ConverterAppendNumber(char *Pointer_String, unsigned int Number)
+{
+	if (Number >= 10)
+	{
+		*Pointer_String = (char) ('0' + Number / 10);
+		Pointer_String++;
+	}
+	*Pointer_String = (char) ('0' + Number % 10);
+	return Pointer_String + 1;
+}
+
+/** Write the text waiting in the output buffer.
+ * @param Pointer_Writer The output.
+ * @return 0 if the text was written,
+ * @return -1 if the output could not be written.
+ */
+static int ConverterWriterFlush(TConverterWriter *Pointer_Writer)
+{
+	if ((Pointer_Writer->Used > 0) && (fwrite(Pointer_Writer->Buffer, Pointer_Writer->Used, 1, Pointer_Writer->File) != 1)) return -1;
+	Pointer_Writer->Used = 0;
+	return 0;
+}
+
+/** Get room for some text at the end of the output buffer, the buffer is written when it is too full.
+ * @param Pointer_Writer The output.
+ * @return Where to write up to CONVERTER_MAXIMUM_RESERVED_SIZE characters (Used must then be increased by the written characters count), or NULL if the output could not be written.
+ */
+static inline char *ConverterWriterReserve(TConverterWriter *Pointer_Writer)
+{
+	if ((Pointer_Writer->Used + CONVERTER_MAXIMUM_RESERVED_SIZE > sizeof(Pointer_Writer->Buffer)) && (ConverterWriterFlush(Pointer_Writer) != 0)) return NULL;
+	return &Pointer_Writer->Buffer[Pointer_Writer->Used];
+}
+
+/** Write the e-sudoku statements of a grid, a grid per line.
+ * @param Pointer_Writer The output.
+ * @param Pointer_Grid The grid.
+ * @return 0 if the grid was written,
+ * @return -1 if the output could not be written.
+ */
+static int ConverterWriteESudokuGrid(TConverterWriter *Pointer_Writer, TGrid *Pointer_Grid)
+{
+	char *Pointer_String, *Pointer_String_Start;
+	unsigned int Size = Pointer_Grid->Size, Row, Column;
+	int Value;
 	
-	return Cell_Value;
+	// A row is reserved at a time, the statements of a whole grid are too long
+	for (Row = 0; Row < Size; Row++)
+	{
+		Pointer_String_Start = ConverterWriterReserve(Pointer_Writer);
+		if (Pointer_String_Start == NULL) return -1;
+		Pointer_String = Pointer_String_Start;
+		
+		for (Column = 0; Column < Size; Column++)
+		{
+			memcpy(Pointer_String, "sudoku[", 7);
+			Pointer_String = ConverterAppendNumber(Pointer_String + 7, Row);
+			memcpy(Pointer_String, "][", 2);
+			Pointer_String = ConverterAppendNumber(Pointer_String + 2, Column);
+			memcpy(Pointer_String, "]=\"", 3);
+			Pointer_String += 3;
+			
+			Value = Pointer_Grid->Cells[Row * Size + Column];
+			if (Value == GRID_EMPTY_CELL_VALUE) *Pointer_String = ' ';
+			else *Pointer_String = Cell_Characters_One_Based[Value + 1];
+			memcpy(Pointer_String + 1, "\";", 2);
+			Pointer_String += 3;
+		}
+		if (Row == Size - 1)
+		{
+			*Pointer_String = '\n';
+			Pointer_String++;
+		}
+		Pointer_Writer->Used += Pointer_String - Pointer_String_Start;
+	}
+	return 0;
+}
+
+/** Write a grid with the output format.
+ * @param Pointer_Writer The output.
+ * @param Pointer_Grid The grid.
+ * @param Grid_Index The index of the grid in the input, to locate the grids that are not written.
+ * @return 0 if the grid was written,
+ * @return 1 if the grid can't be stored with the output format (a warning is printed),
+ * @return -1 if the output could not be written.
+ */
+static int ConverterWriteGrid(TConverterWriter *Pointer_Writer, TGrid *Pointer_Grid, unsigned long long Grid_Index)
+{
+	unsigned char Packed_Cells[PACKED_GRIDS_MAXIMUM_GRID_BYTES_COUNT];
+	char *Pointer_String, *Pointer_String_Start;
+	const char *Pointer_Cell_Characters = Cell_Characters_Zero_Based;
+	unsigned int Size = Pointer_Grid->Size, Row, Column;
+	int *Pointer_Cells = Pointer_Grid->Cells;
+	
+	if (Pointer_Writer->Format == CONVERTER_FORMAT_PACKED)
+	{
+		// The file holds the grids of the first grid size
+		if (Pointer_Writer->Grids_Count == 0)
+		{
+			if (PackedGridsCreate(&Pointer_Writer->Packed_Grids, Pointer_Writer->File, Pointer_Grid, 0) != 0) return -1;
+		}
+		else if (Size != Pointer_Writer->Packed_Grids.Grid_Size)
+		{
+			fprintf(stderr, "Warning : grid %llu has not the size of the first grid, it is not written.\n", Grid_Index);
+			return 1;
+		}
+		PackedGridsPackGrid(Pointer_Grid, Packed_Cells);
+		if (PackedGridsWriteRecord(&Pointer_Writer->Packed_Grids, Packed_Cells, NULL) != 0) return -1;
+		Pointer_Writer->Grids_Count++;
+		return 0;
+	}
+	
+	// The formats numbering the cells from 1 have their own characters
+	if (Pointer_Writer->Format != CONVERTER_FORMAT_TEXT)
+	{
+		if (Size > CONVERTER_ONE_BASED_MAXIMUM_SIZE)
+		{
+			fprintf(stderr, "Warning : grid %llu is too big for the output format, it is not written.\n", Grid_Index);
+			return 1;
+		}
+		Pointer_Cell_Characters = Cell_Characters_One_Based;
+	}
+	
+	if (Pointer_Writer->Format == CONVERTER_FORMAT_ESUDOKU)
+	{
+		if (ConverterWriteESudokuGrid(Pointer_Writer, Pointer_Grid) != 0) return -1;
+		Pointer_Writer->Grids_Count++;
+		return 0;
+	}
+	
+	Pointer_String_Start = ConverterWriterReserve(Pointer_Writer);
+	if (Pointer_String_Start == NULL) return -1;
+	Pointer_String = Pointer_String_Start;
+	
+	// The .sdk grids are separated by a blank line and have a row per line, the other grids are written on a single line
+	if ((Pointer_Writer->Format == CONVERTER_FORMAT_SDK) && (Pointer_Writer->Grids_Count > 0))
+	{
+		*Pointer_String = '\n';
+		Pointer_String++;
+	}
+	for (Row = 0; Row < Size; Row++)
+	{
+		for (Column = 0; Column < Size; Column++) Pointer_String[Column] = Pointer_Cell_Characters[ConverterGetCellCharacterIndex(Pointer_Cells[Column])];
+		Pointer_Cells += Size;
+		Pointer_String += Size;
+		
+		if (Pointer_Writer->Format == CONVERTER_FORMAT_SDK)
+		{
+			*Pointer_String = '\n';
+			Pointer_String++;
+		}
+	}
+	if (Pointer_Writer->Format != CONVERTER_FORMAT_SDK)
+	{
+		*Pointer_String = '\n';
+		Pointer_String++;
+	}
+	
+	Pointer_Writer->Used += Pointer_String - Pointer_String_Start;
+	Pointer_Writer->Grids_Count++;
+	return 0;
+}
+
+/** Write the "Unsolved" line in place of the missing solution of a packed grids file record.
+ * @param Pointer_Writer The output.
+ * @param Grid_Index The index of the grid in the input, to locate the grids that are not written.
+ * @return 0 if the line was written,
+ * @return 1 if the output format can't store it (a warning is printed),
+ * @return -1 if the output could not be written.
+ */
+static int ConverterWriteUnsolved(TConverterWriter *Pointer_Writer, unsigned long long Grid_Index)
+{
+	char *Pointer_String;
+	
+	if (Pointer_Writer->Format == CONVERTER_FORMAT_PACKED)
+	{
+		fprintf(stderr, "Warning : grid %llu has no solution, it is not written.\n", Grid_Index);
+		return 1;
+	}
+	
+	Pointer_String = ConverterWriterReserve(Pointer_Writer);
+	if (Pointer_String == NULL) return -1;
+	if ((Pointer_Writer->Format == CONVERTER_FORMAT_SDK) && (Pointer_Writer->Grids_Count > 0))
+	{
+		*Pointer_String = '\n';
+		Pointer_String++;
+		Pointer_Writer->Used++;
+	}
+	memcpy(Pointer_String, "Unsolved\n", 9);
+	Pointer_Writer->Used += 9;
+	Pointer_Writer->Grids_Count++;
+	return 0;
+}
+
+/** Compute the FNV-1a hash of a class bytes and of its grid size.
+ * @param Pointer_Bytes The class bytes.
+ * @param Bytes_Count How many bytes the class has.
+ * @param Size The grid size.
+ * @return The hash.
+ */
+static unsigned long long ConverterHashClass(const unsigned char *Pointer_Bytes, unsigned int Bytes_Count, unsigned int Size)
+{
+	unsigned long long Hash = 14695981039346656037ULL;
+	unsigned int i;
+	
+	Hash = (Hash ^ Size) * 1099511628211ULL;
+	for (i = 0; i < Bytes_Count; i++) Hash = (Hash ^ Pointer_Bytes[i]) * 1099511628211ULL;
+	return Hash;
+}
+
+/** Add a class after the other classes, its bytes are copied to the classes bytes storage.
+ * @param Pointer_Bytes The class bytes.
+ * @param Bytes_Count How many bytes the class has.
+ * @param Size The grid size, or 0 when the bytes are a solving result line.
+ * @param Hash The class hash (it is not used when expanding).
+ * @return 0 if the class was added,
+ * @return -1 if there is not enough memory.
+ */
+static int ConverterAddClass(const unsigned char *Pointer_Bytes, unsigned int Bytes_Count, unsigned int Size, unsigned long long Hash)
+{
+	TConverterClass *Pointer_New_Classes;
+	unsigned char *Pointer_New_Bytes;
+	size_t Capacity;
+	
+	// The storages grow by doubling their capacity, so a huge corpus does not copy them too often
+	if (Classes_Count == Classes_Capacity)
+	{
+		if (Classes_Capacity == 0) Capacity = 1024;
+		else Capacity = 2 * (size_t) Classes_Capacity;
+		if (Capacity > 0xFFFFFFFE) return -1;
+		Pointer_New_Classes = realloc(Pointer_Classes, Capacity * sizeof(TConverterClass));
+		if (Pointer_New_Classes == NULL) return -1;
+		Pointer_Classes = Pointer_New_Classes;
+		Classes_Capacity = (unsigned int) Capacity;
+	}
+	if (Classes_Bytes_Count + Bytes_Count > Classes_Bytes_Capacity)
+	{
+		Capacity = Classes_Bytes_Capacity;
+		if (Capacity == 0) Capacity = 1024 * 1024;
+		while (Classes_Bytes_Count + Bytes_Count > Capacity) Capacity *= 2;
+		Pointer_New_Bytes = realloc(Pointer_Classes_Bytes, Capacity);
+		if (Pointer_New_Bytes == NULL) return -1;
+		Pointer_Classes_Bytes = Pointer_New_Bytes;
+		Classes_Bytes_Capacity = Capacity;
+	}
+	
+	memcpy(&Pointer_Classes_Bytes[Classes_Bytes_Count], Pointer_Bytes, Bytes_Count);
+	Pointer_Classes[Classes_Count].Hash = Hash;
+	Pointer_Classes[Classes_Count].Offset = Classes_Bytes_Count;
+	Pointer_Classes[Classes_Count].Bytes_Count = Bytes_Count;
+	Pointer_Classes[Classes_Count].Size = Size;
+	Classes_Bytes_Count += Bytes_Count;
+	Classes_Count++;
+	return 0;
+}
+
+/** Find the hash set slot of a class, which is the slot holding the class or the free slot where it would be added.
+ * @param Pointer_Bytes The class bytes.
+ * @param Bytes_Count How many bytes the class has.
+ * @param Size The grid size.
+ * @param Hash The class hash.
+ * @return The slot index.
+ */
+static unsigned int ConverterFindHashSlot(const unsigned char *Pointer_Bytes, unsigned int Bytes_Count, unsigned int Size, unsigned long long Hash)
+{
+	TConverterClass *Pointer_Class;
+	unsigned int Slot = (unsigned int) Hash & (Hash_Slots_Count - 1);
+	
+	// The slots are probed one after the other, the hash set is never more than half full
+	while (Pointer_Hash_Slots[Slot] != 0)
+	{
+		Pointer_Class = &Pointer_Classes[Pointer_Hash_Slots[Slot] - 1];
+		if ((Pointer_Class->Hash == Hash) && (Pointer_Class->Size == Size) && (Pointer_Class->Bytes_Count == Bytes_Count) && (memcmp(&Pointer_Classes_Bytes[Pointer_Class->Offset], Pointer_Bytes, Bytes_Count) == 0)) break;
+		Slot = (Slot + 1) & (Hash_Slots_Count - 1);
+	}
+	return Slot;
+}
+
+/** Put the last added class in the hash set, the hash set grows when it becomes half full.
+ * @return 0 if the class was put in the hash set,
+ * @return -1 if there is not enough memory.
+ */
+static int ConverterHashLastClass(void)
+{
+	unsigned int *Pointer_Old_Slots = Pointer_Hash_Slots, Old_Slots_Count = Hash_Slots_Count, i;
+	TConverterClass *Pointer_Class;
+	
+	if (2 * (unsigned long long) Classes_Count > Hash_Slots_Count)
+	{
+		if (Hash_Slots_Count == 0) Hash_Slots_Count = CONVERTER_HASH_SET_INITIAL_SLOTS_COUNT;
+		else if (Hash_Slots_Count >= 0x80000000) return -1;
+		else Hash_Slots_Count *= 2;
+		Pointer_Hash_Slots = calloc(Hash_Slots_Count, sizeof(unsigned int));
+		if (Pointer_Hash_Slots == NULL) return -1;
+		
+		// Put the older classes in the new slots
+		for (i = 0; i < Old_Slots_Count; i++)
+		{
+			if (Pointer_Old_Slots[i] == 0) continue;
+			Pointer_Class = &Pointer_Classes[Pointer_Old_Slots[i] - 1];
+			Pointer_Hash_Slots[ConverterFindHashSlot(&Pointer_Classes_Bytes[Pointer_Class->Offset], Pointer_Class->Bytes_Count, Pointer_Class->Size, Pointer_Class->Hash)] = Pointer_Old_Slots[i];
+		}
+		free(Pointer_Old_Slots);
+	}
+	
+	Pointer_Class = &Pointer_Classes[Classes_Count - 1];
+	Pointer_Hash_Slots[ConverterFindHashSlot(&Pointer_Classes_Bytes[Pointer_Class->Offset], Pointer_Class->Bytes_Count, Pointer_Class->Size, Pointer_Class->Hash)] = Classes_Count;
+	return 0;
+}
+
+/** Write the map file line of a grid : the index of its unique grid, 1 if the grid is transposed (0 otherwise), then its rows, its columns and its numbers permutations written with the grid file characters (see TCanonicalTransformation).
+ * @param Pointer_Map_File The map file.
+ * @param Unique_Index The unique grid index.
+ * @param Pointer_Transformation The transformation turning the grid into its canonical form.
+ * @param Size The grid size.
+ */
+static void ConverterWriteMapLine(FILE *Pointer_Map_File, unsigned int Unique_Index, TCanonicalTransformation *Pointer_Transformation, unsigned int Size)
+{
+	char String_Permutations[3 * (CONFIGURATION_GRID_MAXIMUM_SIZE + 1)];
+	unsigned int i;
+	
+	for (i = 0; i < Size; i++)
+	{
+		String_Permutations[i] = Cell_Characters_Zero_Based[Pointer_Transformation->Rows[i] + 1];
+		String_Permutations[Size + 1 + i] = Cell_Characters_Zero_Based[Pointer_Transformation->Columns[i] + 1];
+		String_Permutations[2 * (Size + 1) + i] = Cell_Characters_Zero_Based[Pointer_Transformation->Numbers[i] + 1];
+	}
+	String_Permutations[Size] = ' ';
+	String_Permutations[2 * Size + 1] = ' ';
+	String_Permutations[3 * Size + 2] = 0;
+	fprintf(Pointer_Map_File, "%u %d %s\n", Unique_Index, Pointer_Transformation->Is_Transposed, String_Permutations);
+}
+
+/** Convert a permutation of a map file line.
+ * @param Pointer_Characters The permutation characters.
+ * @param Size The grid size, which is the permutation length.
+ * @param Pointer_Permutation On output, contain the permutation.
+ * @return 0 if the characters are a permutation of the grid lines or numbers,
+ * @return -1 if they are not.
+ */
+static int ConverterReadPermutation(const char *Pointer_Characters, unsigned int Size, unsigned char *Pointer_Permutation)
+{
+	unsigned long long Used_Values_Mask = 0;
+	unsigned int i;
+	int Value;
+	
+	for (i = 0; i < Size; i++)
+	{
+		Value = Character_Values_Zero_Based[(unsigned char) Pointer_Characters[i]];
+		if (((unsigned int) Value >= Size) || (Used_Values_Mask & (1ULL << Value))) return -1;
+		Used_Values_Mask |= 1ULL << Value;
+		Pointer_Permutation[i] = (unsigned char) Value;
+	}
+	return 0;
+}
+
+/** Read the next line of a map file written by the deduplication.
+ * @param Pointer_Map_File The map file.
+ * @param Pointer_Unique_Index On output, contain the index of the grid unique grid.
+ * @param Pointer_Transformation On output, contain the transformation turning the grid into its canonical form.
+ * @param Pointer_Size On output, contain the grid size.
+ * @return 0 if a grid line was read,
+ * @return 1 if the end of the map file was reached,
+ * @return 2 if the line is the one of a grid that was not deduplicated (a bad grid or a grid that could not be written),
+ * @return -1 if the line is bad.
+ */
+static int ConverterReadMapLine(FILE *Pointer_Map_File, unsigned int *Pointer_Unique_Index, TCanonicalTransformation *Pointer_Transformation, unsigned int *Pointer_Size)
+{
+	char String_Line[CONVERTER_MAP_LINE_MAXIMUM_SIZE + 2], *Pointer_Characters, *Pointer_Space;
+	unsigned long long Unique_Index;
+	unsigned int Size;
+	
+	if (fgets(String_Line, sizeof(String_Line), Pointer_Map_File) == NULL) return 1;
+	if (strcmp(String_Line, "-\n") == 0) return 2;
+	
+	// Read the unique grid index and the transposition flag
+	Unique_Index = strtoull(String_Line, &Pointer_Characters, 10);
+	if ((Pointer_Characters == String_Line) || (Unique_Index >= 0xFFFFFFFF) || (Pointer_Characters[0] != ' ') || ((Pointer_Characters[1] != '0') && (Pointer_Characters[1] != '1')) || (Pointer_Characters[2] != ' ')) return -1;
+	*Pointer_Unique_Index = (unsigned int) Unique_Index;
+	Pointer_Transformation->Is_Transposed = Pointer_Characters[1] - '0';
+	Pointer_Characters += 3;
+	
+	// The permutations length is the grid size
+	Pointer_Space = strchr(Pointer_Characters, ' ');
+	if (Pointer_Space == NULL) return -1;
+	Size = (unsigned int) (Pointer_Space - Pointer_Characters);
+	if ((Size > CONFIGURATION_GRID_MAXIMUM_SIZE) || !GridIsSizeSupported(Size)) return -1;
+	if ((Pointer_Characters[2 * Size + 1] != ' ') || (Pointer_Characters[3 * Size + 2] != '\n')) return -1;
+	if ((ConverterReadPermutation(Pointer_Characters, Size, Pointer_Transformation->Rows) != 0) || (ConverterReadPermutation(&Pointer_Characters[Size + 1], Size, Pointer_Transformation->Columns) != 0) || (ConverterReadPermutation(&Pointer_Characters[2 * (Size + 1)], Size, Pointer_Transformation->Numbers) != 0)) return -1;
+	*Pointer_Size = Size;
+	return 0;
+}
+
+/** Write a grid only if no grid of its class was written before, and write its map file line.
+ * @param Pointer_Writer The output.
+ * @param Pointer_Map_File The map file.
+ * @param Pointer_Grid The grid.
+ * @param Grid_Index The index of the grid in the input, to locate the grids that are not written.
+ * @return 0 if the grid was written or if it is a duplicate,
+ * @return 1 if the grid can't be stored with the output format (a warning is printed),
+ * @return -1 if the output could not be written,
+ * @return -2 if there is not enough memory.
+ */
+static int ConverterDeduplicateGrid(TConverterWriter *Pointer_Writer, FILE *Pointer_Map_File, TGrid *Pointer_Grid, unsigned long long Grid_Index)
+{
+	TCanonicalTransformation Transformation;
+	TGrid *Pointer_Class_Grid = &Canonical_Grid;
+	unsigned char Class_Cells[GRID_MAXIMUM_CELLS_COUNT];
+	unsigned long long Hash;
+	unsigned int Size = Pointer_Grid->Size, Cells_Count = Size * Size, Slot, Unique_Index, i;
+	int Result;
+	
+	// A grid whose canonical form can't be found is its own canonical form, so only its identical copies are found
+	if (CanonicalGetForm(Pointer_Grid, &Canonical_Grid, &Transformation) != 0)
+	{
+		fprintf(stderr, "Warning : grid %llu has too few empty cells to find its duplicates under the symmetries, only its identical copies are dropped.\n", Grid_Index);
+		Transformation.Is_Transposed = 0;
+		for (i = 0; i < Size; i++)
+		{
+			Transformation.Rows[i] = (unsigned char) i;
+			Transformation.Columns[i] = (unsigned char) i;
+			Transformation.Numbers[i] = (unsigned char) i;
+		}
+		Pointer_Class_Grid = Pointer_Grid;
+	}
+	
+	// A duplicate is only mapped to the unique grid of its class
+	for (i = 0; i < Cells_Count; i++) Class_Cells[i] = (unsigned char) ConverterGetCellCharacterIndex(Pointer_Class_Grid->Cells[i]);
+	Hash = ConverterHashClass(Class_Cells, Cells_Count, Size);
+	if (Hash_Slots_Count > 0)
+	{
+		Slot = ConverterFindHashSlot(Class_Cells, Cells_Count, Size, Hash);
+		if (Pointer_Hash_Slots[Slot] != 0)
+		{
+			ConverterWriteMapLine(Pointer_Map_File, Pointer_Hash_Slots[Slot] - 1, &Transformation, Size);
+			return 0;
+		}
+	}
+	
+	// The grid is the first of its class, so it is the unique grid of its class
+	Unique_Index = Classes_Count;
+	Result = ConverterWriteGrid(Pointer_Writer, Pointer_Grid, Grid_Index);
+	if (Result == -1) return -1;
+	if (Result == 1)
+	{
+		fputs("-\n", Pointer_Map_File);
+		return 1;
+	}
+	
+	if ((ConverterAddClass(Class_Cells, Cells_Count, Size, Hash) != 0) || (ConverterHashLastClass() != 0)) return -2;
+	ConverterWriteMapLine(Pointer_Map_File, Unique_Index, &Transformation, Size);
+	return 0;
+}
+
+/** Write a solving result line of the expanded solutions as it is.
+ * @param Pointer_Writer The output.
+ * @param Pointer_Line The line characters.
+ * @param Length The line length.
+ * @return 0 if the line was written,
+ * @return -1 if the output could not be written.
+ */
+static int ConverterWriteLine(TConverterWriter *Pointer_Writer, const char *Pointer_Line, size_t Length)
+{
+	char *Pointer_String;
+	
+	Pointer_String = ConverterWriterReserve(Pointer_Writer);
+	if (Pointer_String == NULL) return -1;
+	memcpy(Pointer_String, Pointer_Line, Length);
+	Pointer_String[Length] = '\n';
+	Pointer_Writer->Used += Length + 1;
+	return 0;
+}
+
+/** Write the solution of each grid of a deduplicated corpus from the solutions of the unique grids : the map file tells the unique grid of each grid, and the solution of the unique grid is brought to the grid through their transformations.
+ * @param Pointer_Reader The batch mode output of the unique grids file, a line per unique grid.
+ * @param Pointer_Writer The output, a line per grid of the map file.
+ * @param Pointer_Map_File The map file written by the deduplication.
+ * @return 0 if all solutions were written,
+ * @return -1 if an error occurred (an error message is printed).
+ */
+static int ConverterExpandSolutions(TConverterReader *Pointer_Reader, TConverterWriter *Pointer_Writer, FILE *Pointer_Map_File)
+{
+	TCanonicalTransformation Transformation;
+	TConverterClass *Pointer_Class;
+	const char *Pointer_Line;
+	size_t Length;
+	unsigned char Canonical_Cells[GRID_MAXIMUM_CELLS_COUNT];
+	unsigned int Unique_Index, Size, Cells_Count, i;
+	unsigned long long Map_Line = 0;
+	int Result;
+	
+	while (1)
+	{
+		Result = ConverterReadMapLine(Pointer_Map_File, &Unique_Index, &Transformation, &Size);
+		if (Result == 1) break;
+		Map_Line++;
+		if ((Result == -1) || ((Result == 0) && (Unique_Index > Classes_Count)))
+		{
+			fprintf(stderr, "Error : bad map file line %llu.\n", Map_Line);
+			return -1;
+		}
+		
+		// The grid was not written to the unique grids file, so the batch mode did not solve it
+		if (Result == 2)
+		{
+			if (ConverterWriteLine(Pointer_Writer, "Bad grid", 8) != 0) return -1;
+			continue;
+		}
+		
+		// The first grid of a class is its unique grid, its solution is the next solutions line and it is kept in the canonical form of its class
+		if (Unique_Index == Classes_Count)
+		{
+			Result = ConverterReaderReadLine(Pointer_Reader, &Pointer_Line, &Length);
+			if (Result == -1)
+			{
+				fprintf(stderr, "Error : the solutions have a too long line.\n");
+				return -1;
+			}
+			if (Result == 1)
+			{
+				fprintf(stderr, "Error : the solutions have less lines than the unique grids of the map file.\n");
+				return -1;
+			}
+			
+			Cells_Count = Size * Size;
+			if ((Length == Cells_Count) && (ConverterConvertCharacters(Character_Values_Zero_Based, Pointer_Line, Length, Size, Solution.Cells) == 0))
+			{
+				ConverterSetGridSize(&Solution, Size);
+				CanonicalTransformGrid(&Solution, &Transformation, &Canonical_Grid);
+				for (i = 0; i < Cells_Count; i++) Canonical_Cells[i] = (unsigned char) ConverterGetCellCharacterIndex(Canonical_Grid.Cells[i]);
+				Result = ConverterAddClass(Canonical_Cells, Cells_Count, Size, 0);
+			}
+			else if (Length + 1 > CONVERTER_MAXIMUM_RESERVED_SIZE)
+			{
+				fprintf(stderr, "Error : the solutions have a too long line.\n");
+				return -1;
+			}
+			else Result = ConverterAddClass((const unsigned char *) Pointer_Line, (unsigned int) Length, 0, 0);
+			if (Result != 0)
+			{
+				fprintf(stderr, "Error : not enough memory to keep the solutions.\n");
+				return -1;
+			}
+		}
+		
+		// A result which is not a solution (like an unsolvable grid) is the same for all grids of the class
+		Pointer_Class = &Pointer_Classes[Unique_Index];
+		if (Pointer_Class->Size == 0)
+		{
+			if (ConverterWriteLine(Pointer_Writer, (const char *) &Pointer_Classes_Bytes[Pointer_Class->Offset], Pointer_Class->Bytes_Count) != 0) return -1;
+			continue;
+		}
+		if (Pointer_Class->Size != Size)
+		{
+			fprintf(stderr, "Error : map file line %llu has not the size of the solution of its unique grid.\n", Map_Line);
+			return -1;
+		}
+		
+		for (i = 0; i < Pointer_Class->Bytes_Count; i++)
+		{
+			Canonical_Grid.Cells[i] = (int) Pointer_Classes_Bytes[Pointer_Class->Offset + i] - 1;
+			if (Canonical_Grid.Cells[i] < 0) Canonical_Grid.Cells[i] = GRID_EMPTY_CELL_VALUE;
+		}
+		ConverterSetGridSize(&Canonical_Grid, Size);
+		CanonicalRestoreGrid(&Canonical_Grid, &Transformation, &Solution);
+		if (ConverterWriteGrid(Pointer_Writer, &Solution, Map_Line - 1) != 0) return -1;
+	}
+	
+	if (ferror(Pointer_Map_File))
+	{
+		fprintf(stderr, "Error : can't read the map file.\n");
+		return -1;
+	}
+	if (ConverterReaderReadLine(Pointer_Reader, &Pointer_Line, &Length) == 0)
+	{
+		fprintf(stderr, "Error : the solutions have more lines than the unique grids of the map file.\n");
+		return -1;
+	}
+	return 0;
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -91,86 +1168,205 @@ static int ReadCellValue(void)
 //-------------------------------------------------------------------------------------------------
 int main(int argc, char *argv[])
 {
-	TResultReadToken Result_Read_Token;
-	int Cell_Value, i = 0, Grid_Size, Row, Column;
-	char *String_Input_File, *String_Output_File;
+	TConverterFormat Input_Format = CONVERTER_FORMAT_AUTOMATIC;
+	char *String_Input_File_Name = NULL, *String_Output_File_Name = NULL, *String_Map_File_Name = NULL;
+	const unsigned char *Pointer_Header;
+	unsigned long long Bad_Grids_Count = 0;
+	int i, Is_Solutions_Conversion_Enabled = 0, Result, Is_Solution_Present = 0, Is_Write_Error = 0, Return_Value = 0, Is_Deduplication_Enabled = 0, Is_Expansion_Enabled = 0, Is_Format_Provided = 0;
+	FILE *Pointer_Map_File = NULL;
 	
 	// Check parameters
-	if (argc != 4)
+	Writer.Format = CONVERTER_FORMAT_TEXT;
+	for (i = 1; i < argc; i++)
 	{
-		printf("Usage : %s InputFile OutputFile GridSize\nThe input file must contain only the sudoku[0][0]=... line extracted from web page source code.\n", argv[0]);
-		return -1;
+		if ((strcmp(argv[i], "--from") == 0) && (i + 1 < argc))
+		{
+			i++;
+			Input_Format = ConverterGetFormat(argv[i]);
+			if (Input_Format == CONVERTER_FORMAT_AUTOMATIC) break;
+			Is_Format_Provided = 1;
+		}
+		else if ((strcmp(argv[i], "--to") == 0) && (i + 1 < argc))
+		{
+			i++;
+			Writer.Format = ConverterGetFormat(argv[i]);
+			if (Writer.Format == CONVERTER_FORMAT_AUTOMATIC) break;
+			Is_Format_Provided = 1;
+		}
+		else if (strcmp(argv[i], "--solutions") == 0) Is_Solutions_Conversion_Enabled = 1;
+		else if ((strcmp(argv[i], "--dedup") == 0) && (i + 1 < argc) && (String_Map_File_Name == NULL))
+		{
+			i++;
+			String_Map_File_Name = argv[i];
+			Is_Deduplication_Enabled = 1;
+		}
+		else if ((strcmp(argv[i], "--expand") == 0) && (i + 1 < argc) && (String_Map_File_Name == NULL))
+		{
+			i++;
+			String_Map_File_Name = argv[i];
+			Is_Expansion_Enabled = 1;
+		}
+		else if ((argv[i][0] == '-') && (argv[i][1] != 0)) break;
+		else if (String_Input_File_Name == NULL) String_Input_File_Name = argv[i];
+		else if (String_Output_File_Name == NULL) String_Output_File_Name = argv[i];
+		else break;
 	}
-	String_Input_File = argv[1];
-	String_Output_File = argv[2];
-	Grid_Size = atoi(argv[3]);
-
-	// Open file
-	File = fopen(String_Input_File, "r");
-	if (File == NULL)
+	// The solutions are expanded from the batch mode output and written like it
+	if ((i < argc) || (Writer.Format == CONVERTER_FORMAT_AUTOMATIC) || (Is_Deduplication_Enabled && Is_Solutions_Conversion_Enabled) || (Is_Expansion_Enabled && (Is_Solutions_Conversion_Enabled || Is_Format_Provided)))
 	{
-		printf("Error : input file not found.\n");
+		fprintf(stderr, "Usage : %s [--from esudoku|text|line|sdk|packed] [--to text|line|sdk|esudoku|packed] [--solutions | --dedup Map_File] [Input_File [Output_File]]\n", argv[0]);
+		fprintf(stderr, "        %s --expand Map_File [Solutions_File [Output_File]]\n", argv[0]);
+		fprintf(stderr, "Convert all grids of the input file (or of the standard input if no file or '-' is provided) to the output file (or to the standard output).\n");
+		fprintf(stderr, "The input format is found from the input beginning when --from is not provided, the default output format is text.\n");
+		fprintf(stderr, "Formats : esudoku : the sudoku[0][0]=\"5\";... statements extracted from the e-sudoku web pages source code.\n");
+		fprintf(stderr, "          text : the grids files read by Sudoku_Solver (numbers from 0), written with a grid per line.\n");
+		fprintf(stderr, "          line : a grid per line (numbers from 1, '.' or '0' for an empty cell).\n");
+		fprintf(stderr, "          sdk : a grid row per line (numbers from 1, '.' or '0' for an empty cell, '#' starts a comment line), the grids are separated by a blank line.\n");
+		fprintf(stderr, "          packed : the packed grids files (all grids of the output file have the size of the first grid).\n");
+		fprintf(stderr, "--solutions : write the solutions of a packed grids file instead of its grids (\"Unsolved\" is written for a grid without solution).\n");
+		fprintf(stderr, "--dedup : write only the first grid of the grids that are the same puzzle under the Sudoku symmetries (numbers relabeling, rows and columns permutations inside the bands and the stacks, bands and stacks permutations, transposition), and write to the map file a line per input grid telling its unique grid and how it was transformed.\n");
+		fprintf(stderr, "--expand : write a solution line per grid of a map file, from the batch mode output of the unique grids (the lines that are not a solution are copied).\n");
 		return -1;
 	}
+	ConverterInitializeTables();
 	
-	while (1)
+	// Open the files
+	if ((String_Input_File_Name == NULL) || (strcmp(String_Input_File_Name, "-") == 0)) Reader.File = stdin;
+	else
 	{
-		// Read next token
-		Result_Read_Token = ReadToken();
-		if (Result_Read_Token == RESULT_READ_TOKEN_ERROR_BUFFER_OVERFLOW)
+		Reader.File = fopen(String_Input_File_Name, "rb");
+		if (Reader.File == NULL)
 		{
-			printf("Error : token too large.\n");
-			fclose(File);
+			fprintf(stderr, "Error : can't open the input file %s.\n", String_Input_File_Name);
 			return -1;
 		}
-		else if (Result_Read_Token == RESULT_READ_TOKEN_EOF)
+	}
+	if ((String_Output_File_Name == NULL) || (strcmp(String_Output_File_Name, "-") == 0)) Writer.File = stdout;
+	else
+	{
+		Writer.File = fopen(String_Output_File_Name, "wb");
+		if (Writer.File == NULL)
 		{
-			fclose(File);
-			break;
+			fprintf(stderr, "Error : can't open the output file %s.\n", String_Output_File_Name);
+			return -1;
 		}
-		#ifdef DEBUG
-			printf("[DEBUG ReadToken] Token : %s\n", Buffer);
-		#endif
-		
-		// Discard tokens starting with "solution"
-		if (strncmp(Buffer, "solution", 8) == 0) continue;
-		
-		// Get cell value
-		Cell_Value = ReadCellValue();
-		if (Cell_Value == -1)
+	}
+	if (Writer.Format == CONVERTER_FORMAT_PACKED) setvbuf(Writer.File, NULL, _IOFBF, CONVERTER_BUFFER_SIZE);
+	if (String_Map_File_Name != NULL)
+	{
+		if (Is_Deduplication_Enabled) Pointer_Map_File = fopen(String_Map_File_Name, "w");
+		else Pointer_Map_File = fopen(String_Map_File_Name, "r");
+		if (Pointer_Map_File == NULL)
 		{
-			printf("Error : invalid cell value.\n");
-			fclose(File);
+			fprintf(stderr, "Error : can't open the map file %s.\n", String_Map_File_Name);
 			return -1;
 		}
-		#ifdef DEBUG
-			printf("[DEBUG ReadCellValue] Value : %d\n", Cell_Value);
-		#endif
-		
-		// Add to grid
-		Grid[i] = Cell_Value;
-		i++;
 	}
 	
-	// Write output file
-	File = fopen(String_Output_File, "wb");
-	if (File == NULL)
+	// The solutions lines are read as they are
+	if (Is_Expansion_Enabled)
+	{
+		if (ConverterExpandSolutions(&Reader, &Writer, Pointer_Map_File) != 0) Return_Value = -1;
+		if (ferror(Reader.File))
+		{
+			fprintf(stderr, "Error : can't read the solutions file.\n");
+			Return_Value = -1;
+		}
+		if ((ConverterWriterFlush(&Writer) != 0) || (fclose(Writer.File) != 0))
+		{
+			fprintf(stderr, "Error : can't write the output file.\n");
+			Return_Value = -1;
+		}
+		fclose(Pointer_Map_File);
+		if (Reader.File != stdin) fclose(Reader.File);
+		return Return_Value;
+	}
+	
+	// Find the input format
+	ConverterReaderFill(&Reader);
+	if (Input_Format == CONVERTER_FORMAT_AUTOMATIC) Input_Format = ConverterDetectFormat(&Reader);
+	if (Input_Format == CONVERTER_FORMAT_PACKED)
 	{
-		printf("Error : can't open output file.\n");
+		if ((ConverterReaderReadBytes(&Reader, PACKED_GRIDS_HEADER_SIZE, &Pointer_Header) != 0) || (PackedGridsDecodeHeader(&Reader.Packed_Grids, Pointer_Header) != 0))
+		{
+			fprintf(stderr, "Error : the input is not a supported packed grids file.\n");
+			return -1;
+		}
+	}
+	else if (Is_Solutions_Conversion_Enabled)
+	{
+		fprintf(stderr, "Error : only the packed grids files hold solutions.\n");
 		return -1;
 	}
 	
-	for (Row = 0; Row < Grid_Size; Row++)
+	// Convert all grids
+	while (1)
 	{
-		for (Column = 0; Column < Grid_Size; Column++)
+		if (Input_Format == CONVERTER_FORMAT_ESUDOKU) Result = ConverterLoadESudokuGrid(&Reader, &Grid);
+		else if (Input_Format == CONVERTER_FORMAT_PACKED) Result = ConverterLoadPackedGrid(&Reader, &Grid, &Solution, &Is_Solution_Present);
+		else Result = ConverterLoadTextGrid(&Reader, Input_Format, &Grid);
+		if (Result == 1) break;
+		if (Result == -1)
+		{
+			fprintf(stderr, "Error : the input has a too long line or statement.\n");
+			Return_Value = -1;
+			break;
+		}
+		if (Result != 0)
+		{
+			if ((Input_Format == CONVERTER_FORMAT_TEXT) || (Input_Format == CONVERTER_FORMAT_LINE) || (Input_Format == CONVERTER_FORMAT_SDK)) fprintf(stderr, "Warning : bad grid at line %llu.\n", Reader.Grid_Line);
+			else fprintf(stderr, "Warning : bad grid %llu.\n", Reader.Grids_Count - 1);
+			Bad_Grids_Count++;
+			if (Is_Deduplication_Enabled) fputs("-\n", Pointer_Map_File);
+			continue;
+		}
+		
+		if (Is_Deduplication_Enabled)
 		{
-			Cell_Value = Grid[Row * Grid_Size + Column];
-			if (Cell_Value == GRID_EMPTY_CELL_VALUE) fprintf(File, ".");
-			else fprintf(File, "%01X", Cell_Value - 1); // -1 because e-sudoku grids start from 1
+			Result = ConverterDeduplicateGrid(&Writer, Pointer_Map_File, &Grid, Reader.Grids_Count - 1);
+			if (Result == -2)
+			{
+				fprintf(stderr, "Error : not enough memory to deduplicate the grids.\n");
+				Return_Value = -1;
+				break;
+			}
 		}
-		fprintf(File, "\n");
+		else if (!Is_Solutions_Conversion_Enabled) Result = ConverterWriteGrid(&Writer, &Grid, Reader.Grids_Count - 1);
+		else if (Is_Solution_Present) Result = ConverterWriteGrid(&Writer, &Solution, Reader.Grids_Count - 1);
+		else Result = ConverterWriteUnsolved(&Writer, Reader.Grids_Count - 1);
+		if (Result == -1)
+		{
+			Is_Write_Error = 1;
+			break;
+		}
+		if (Result == 1) Bad_Grids_Count++;
 	}
-	fclose(File);
 	
-	return 0;
+	// Check that all grids were read and written
+	if (ferror(Reader.File))
+	{
+		fprintf(stderr, "Error : can't read the input file.\n");
+		Return_Value = -1;
+	}
+	if ((Writer.Format == CONVERTER_FORMAT_PACKED) && (Writer.Grids_Count > 0) && (PackedGridsFinishWriting(&Writer.Packed_Grids) != 0)) Is_Write_Error = 1;
+	if (ConverterWriterFlush(&Writer) != 0) Is_Write_Error = 1;
+	if (fclose(Writer.File) != 0) Is_Write_Error = 1;
+	if (Is_Write_Error)
+	{
+		fprintf(stderr, "Error : can't write the output file.\n");
+		Return_Value = -1;
+	}
+	if ((Pointer_Map_File != NULL) && (ferror(Pointer_Map_File) || (fclose(Pointer_Map_File) != 0)))
+	{
+		fprintf(stderr, "Error : can't write the map file.\n");
+		Return_Value = -1;
+	}
+	if (Reader.File != stdin) fclose(Reader.File);
+	
+	if (Bad_Grids_Count > 0)
+	{
+		fprintf(stderr, "%llu grids were not converted.\n", Bad_Grids_Count);
+		Return_Value = -1;
+	}
+	return Return_Value;
 }
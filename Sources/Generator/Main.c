@@ -0,0 +1,262 @@
+/** @file Main.c
+ * Generate random grids having a single solution, built on the solver library. The grids are printed on a single line each, so they can be directly solved by the Sudoku Solver batch mode.
+ * @author Adrien RICCIARDI
+ * @version 1.0 : 17/10/2026
+ */
+#include <errno.h>
+#include <Generator.h>
+#include <Grid.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** How many grids are generated before being printed. */
+#define MAIN_CHUNK_SIZE 256
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** All data shared by the generating threads. */
+typedef struct
+{
+	TGrid Grids[MAIN_CHUNK_SIZE]; //! The generated grids of the current chunk.
+	int Grids_Count; //! How many grids the current chunk contains.
+	unsigned long long First_Grid_Index; //! The index of the chunk first grid among all generated grids.
+	atomic_int Next_Grid_Index; //! The next chunk grid to generate.
+	unsigned int Grid_Size; //! The side size of the grids.
+	unsigned int Givens_Target; //! Stop removing the givens when a grid has this many givens (0 to generate minimal grids).
+	unsigned long long Seed; //! The seed all grids seeds are built from.
+} TMainContext;
+
+/** A generating thread. */
+typedef struct
+{
+	TGenerator Generator; //! This thread generator context.
+	pthread_t Thread; //! The thread identifier.
+	TMainContext *Pointer_Context; //! The data shared by all threads.
+} TMainWorker;
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Generate grids of the current chunk until all of them are generated.
+ * @param Pointer_Argument The worker.
+ * @return Always NULL.
+ */
+static void *MainWorkerThread(void *Pointer_Argument)
+{
+	TMainWorker *Pointer_Worker = Pointer_Argument;
+	TMainContext *Pointer_Context = Pointer_Worker->Pointer_Context;
+	int Grid_Index;
+	
+	while (1)
+	{
+		Grid_Index = atomic_fetch_add_explicit(&Pointer_Context->Next_Grid_Index, 1, memory_order_relaxed);
+		if (Grid_Index >= Pointer_Context->Grids_Count) break;
+		
+		// Each grid has its own seed, so the grids do not depend on the threads count
+		GeneratorSetSeed(&Pointer_Worker->Generator, (Pointer_Context->Seed << 32) + Pointer_Context->First_Grid_Index + Grid_Index);
+		GeneratorGenerate(&Pointer_Worker->Generator, Pointer_Context->Grid_Size, Pointer_Context->Givens_Target, &Pointer_Context->Grids[Grid_Index], NULL);
+	}
+	return NULL;
+}
+
+/** Convert a threads count command line argument.
+ * @param String The argument.
+ * @param Pointer_Threads_Count On output, contain the threads count.
+ * @return 0 if the argument is a non-negative integer,
+ * @return -1 if the argument is not a threads count.
+ */
+static int MainParseThreadsCount(char *String, int *Pointer_Threads_Count)
+{
+	char *Pointer_End;
+	long Value;
+	
+	errno = 0;
+	Value = strtol(String, &Pointer_End, 10);
+	if ((Pointer_End == String) || (*Pointer_End != 0) || (errno != 0) || (Value < 0) || (Value > INT_MAX)) return -1;
+	*Pointer_Threads_Count = (int) Value;
+	return 0;
+}
+
+/** Convert a non-negative integer command line argument.
+ * @param String The argument.
+ * @param Maximum_Value The biggest accepted value.
+ * @param Pointer_Value On output, contain the number.
+ * @return 0 if the argument is a non-negative integer not bigger than Maximum_Value,
+ * @return -1 if the argument is not a number or if it is too big.
+ */
+static int MainParseNumber(char *String, unsigned long long Maximum_Value, unsigned long long *Pointer_Value)
+{
+	char *Pointer_End;
+	
+	// strtoull() would accept the leading spaces and a sign
+	if ((String[0] < '0') || (String[0] > '9')) return -1;
+	
+	errno = 0;
+	*Pointer_Value = strtoull(String, &Pointer_End, 10);
+	if ((*Pointer_End != 0) || (errno != 0) || (*Pointer_Value > Maximum_Value)) return -1;
+	return 0;
+}
+
+/** Print the grid sizes this build can generate, like "6, 9, 12, 16 or 25" (the bigger sizes depend on CONFIGURATION_GRID_MAXIMUM_SIZE). */
+static void MainPrintSupportedSizes(void)
+{
+	unsigned int Sizes[CONFIGURATION_GRID_MAXIMUM_SIZE], Sizes_Count = 0, Size, i;
+	
+	for (Size = 1; Size <= CONFIGURATION_GRID_MAXIMUM_SIZE; Size++)
+	{
+		if (GridIsSizeSupported(Size)) Sizes[Sizes_Count++] = Size;
+	}
+	
+	for (i = 0; i < Sizes_Count; i++)
+	{
+		if (i > 0) printf((i == Sizes_Count - 1) ? " or " : ", ");
+		printf("%u", Sizes[i]);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+// Entry point
+//-------------------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+	TMainContext *Pointer_Context;
+	TMainWorker *Pointer_Workers;
+	TGrid Grid;
+	unsigned long long Grids_Count = 1, Generated_Grids_Count, Value;
+	int i, Threads_Count = 1, Is_Parameter_Bad = 0;
+	
+	Pointer_Context = malloc(sizeof(TMainContext));
+	if (Pointer_Context == NULL)
+	{
+		printf("Error : not enough memory.\n");
+		return EXIT_FAILURE;
+	}
+	Pointer_Context->Grid_Size = 9;
+	Pointer_Context->Givens_Target = 0;
+	Pointer_Context->Seed = 1;
+	
+	// Parse the command line
+	for (i = 1; i < argc; i++)
+	{
+		if ((strcmp(argv[i], "--size") == 0) && (i + 1 < argc))
+		{
+			i++;
+			if (MainParseNumber(argv[i], UINT_MAX, &Value) != 0)
+			{
+				Is_Parameter_Bad = 1;
+				break;
+			}
+			Pointer_Context->Grid_Size = (unsigned int) Value;
+		}
+		else if ((strcmp(argv[i], "--count") == 0) && (i + 1 < argc))
+		{
+			i++;
+			if (MainParseNumber(argv[i], ULLONG_MAX, &Grids_Count) != 0)
+			{
+				Is_Parameter_Bad = 1;
+				break;
+			}
+		}
+		else if ((strcmp(argv[i], "--givens") == 0) && (i + 1 < argc))
+		{
+			i++;
+			if (MainParseNumber(argv[i], UINT_MAX, &Value) != 0)
+			{
+				Is_Parameter_Bad = 1;
+				break;
+			}
+			Pointer_Context->Givens_Target = (unsigned int) Value;
+		}
+		else if ((strcmp(argv[i], "--seed") == 0) && (i + 1 < argc))
+		{
+			i++;
+			if (MainParseNumber(argv[i], ULLONG_MAX, &Pointer_Context->Seed) != 0)
+			{
+				Is_Parameter_Bad = 1;
+				break;
+			}
+		}
+		else if ((strcmp(argv[i], "--threads") == 0) && (i + 1 < argc))
+		{
+			i++;
+			if (MainParseThreadsCount(argv[i], &Threads_Count) != 0)
+			{
+				Is_Parameter_Bad = 1;
+				break;
+			}
+		}
+		else
+		{
+			Is_Parameter_Bad = 1;
+			break;
+		}
+	}
+	
+	// Check parameters
+	if (Is_Parameter_Bad || (GridInitialize(&Grid, Pointer_Context->Grid_Size) != 0))
+	{
+		printf("Error : bad parameters.\n");
+		printf("Usage : %s [--size Grid_Size] [--count Grids_Count] [--givens Givens_Count] [--seed Seed] [--threads Threads_Count]\n", argv[0]);
+		printf("Options : --size Grid_Size : the side size of the grids, it can be ");
+		MainPrintSupportedSizes();
+		printf(" (default is 9).\n");
+		printf("          --count Grids_Count : how many grids to generate (default is 1).\n");
+		printf("          --givens Givens_Count : stop removing the givens when a grid has this many givens (default is to generate minimal grids, from which no given can be removed).\n");
+		printf("          --seed Seed : the generated grids only depend on the seed and the grid size (default is 1).\n");
+		printf("          --threads Threads_Count : how many threads generate the grids (use 0 to have one thread per processor core, default is 1).\n");
+		free(Pointer_Context);
+		return EXIT_FAILURE;
+	}
+	
+	// Use all processor cores if no threads count is provided
+	if (Threads_Count <= 0) Threads_Count = sysconf(_SC_NPROCESSORS_ONLN);
+	Pointer_Workers = malloc(Threads_Count * sizeof(TMainWorker));
+	if (Pointer_Workers == NULL)
+	{
+		printf("Error : not enough memory to generate the grids with %d threads.\n", Threads_Count);
+		free(Pointer_Context);
+		return EXIT_FAILURE;
+	}
+	for (i = 0; i < Threads_Count; i++)
+	{
+		GeneratorInitialize(&Pointer_Workers[i].Generator);
+		Pointer_Workers[i].Pointer_Context = Pointer_Context;
+	}
+	
+	for (Generated_Grids_Count = 0; Generated_Grids_Count < Grids_Count; Generated_Grids_Count += Pointer_Context->Grids_Count)
+	{
+		// Prepare the next chunk
+		if (Grids_Count - Generated_Grids_Count < MAIN_CHUNK_SIZE) Pointer_Context->Grids_Count = Grids_Count - Generated_Grids_Count;
+		else Pointer_Context->Grids_Count = MAIN_CHUNK_SIZE;
+		Pointer_Context->First_Grid_Index = Generated_Grids_Count;
+		atomic_store(&Pointer_Context->Next_Grid_Index, 0);
+		
+		// Generate the chunk grids, the calling thread is the last worker
+		for (i = 0; i < Threads_Count - 1; i++)
+		{
+			if (pthread_create(&Pointer_Workers[i].Thread, NULL, MainWorkerThread, &Pointer_Workers[i]) != 0) break; // The grids of the missing workers are generated by the running ones
+		}
+		MainWorkerThread(&Pointer_Workers[Threads_Count - 1]);
+		while (i > 0)
+		{
+			i--;
+			pthread_join(Pointer_Workers[i].Thread, NULL);
+		}
+		
+		// Show the grids in their generation order
+		for (i = 0; i < Pointer_Context->Grids_Count; i++) GridShowLine(&Pointer_Context->Grids[i]);
+	}
+	
+	free(Pointer_Workers);
+	free(Pointer_Context);
+	return EXIT_SUCCESS;
+}
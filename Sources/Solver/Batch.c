@@ -0,0 +1,696 @@
+/** @file Batch.c
+ * @see Batch.h for description.
+ * @author Adrien RICCIARDI
+ */
+#define _GNU_SOURCE // To have the threads affinity functions
+#include <Batch.h>
+#include <Corpus.h>
+#include <Lanes_Solver.h>
+#include <Packed_Grids.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <Solver.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** How many grids a block holds at most. The 9x9 grids going to the lanes solver are grouped by blocks so they are propagated together, a block ends with the first grid that does not go to the lanes solver, so such a grid is never solved after another one by the same thread. */
+#define BATCH_BLOCK_GRIDS_COUNT LANES_SOLVER_LANES_COUNT
+/** How many grids the pipeline holds per solving thread, the grids go on being read while a very long grid is solved until the pipeline is full. */
+#define BATCH_PIPELINE_GRIDS_PER_THREAD 128
+/** The size of the writing stage buffer, the results are formatted into it and written by big blocks. */
+#define BATCH_OUTPUT_BUFFER_SIZE (1024 * 1024)
+/** The longest result line, a solution of the biggest grid followed by a new line character (the terminating zero written by the formatting is not part of the line). */
+#define BATCH_MAXIMUM_LINE_SIZE (GRID_MAXIMUM_CELLS_COUNT + 1)
+
+/** The grid is waiting to be solved. */
+#define BATCH_GRID_RESULT_PENDING 0
+/** The grid was solved. */
+#define BATCH_GRID_RESULT_SOLVED 1
+/** The grid has no solution. */
+#define BATCH_GRID_RESULT_UNSOLVABLE 2
+/** The grid could not be loaded. */
+#define BATCH_GRID_RESULT_BAD_GRID 3
+/** The grid solving reached a limit. */
+#define BATCH_GRID_RESULT_TIMED_OUT 4
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** A grid of the batch. */
+typedef struct
+{
+	TGrid Grid; //! The grid to solve, replaced by its solution when the grid is solved.
+	int Result; //! A BATCH_GRID_RESULT_XXX value.
+	unsigned long long Index; //! The grid index in the stream, starting from 0.
+	unsigned long long Solutions_Count; //! How many solutions were found when counting.
+	unsigned char Packed_Grid[PACKED_GRIDS_MAXIMUM_GRID_BYTES_COUNT]; //! The grid packed before being solved, when the grids are written to a packed grids file.
+} TBatchGrid;
+
+/** Where the grids of the batch are read from. */
+typedef struct
+{
+	FILE *File; //! The stream to read grids from, when the grids are not read from a mapped file or from a packed grids file.
+	TCorpus *Pointer_Corpus; //! The mapped file to read grids from, or NULL.
+	TPackedGrids *Pointer_Packed_Grids; //! The packed grids file to read grids from, or NULL.
+} TBatchSource;
+
+/** Successive grids of the batch going through the pipeline stages. */
+typedef struct
+{
+	TBatchGrid *Pointer_Grids[BATCH_BLOCK_GRIDS_COUNT]; //! The grids, in the stream order.
+	int Grids_Count; //! How many grids the block holds, only the last block of the stream is not full (an empty block tells the writing stage that the stream end is reached).
+	sem_t Solved_Semaphore; //! Posted when all grids of the block are solved.
+} TBatchBlock;
+
+/** Connect the reading stage, the solving threads and the writing stage. The grids and the blocks are rings used in the stream order : the reading stage fills the grids one after the other and groups them by blocks, the solving threads take the filled blocks in the same order, and the writing stage writes the solved blocks in the same order before giving their grids back to the reading stage. A block holds at least one grid, so there are never more blocks than grids in the pipeline. Each hand-off is a semaphore post matched by a semaphore wait : no mutex is taken, but each hand-off updates the semaphore count with an atomic operation, and a system call is made when a stage must sleep because its semaphore count is zero or when a sleeping stage must be woken up. The solving threads share the loaded blocks by taking their numbers from an atomic counter. These costs are paid once per block, so once per grid when the lanes solver is not used. */
+typedef struct
+{
+	TBatchGrid *Pointer_Grids; //! The ring of grids.
+	TBatchBlock *Pointer_Blocks; //! The ring of blocks.
+	unsigned int Grids_Count; //! How many grids the ring holds, the ring of blocks holds as many blocks.
+	sem_t Free_Grids_Semaphore; //! Count the grids the reading stage can fill, so the reading stage waits when the solving threads or the writing stage are late.
+	sem_t Loaded_Blocks_Semaphore; //! Count the blocks waiting for a solving thread.
+	atomic_ullong Next_Block_Number; //! The number of the next block taken by a solving thread.
+	atomic_ullong Stream_Blocks_Count; //! How many blocks hold the stream grids, it is ULLONG_MAX until the stream end is reached.
+	char *Pointer_Output_Buffer; //! The writing stage buffer.
+	const TBatchConfiguration *Pointer_Configuration; //! How the grids are solved.
+	TPackedGrids *Pointer_Packed_Output; //! The packed grids file receiving the grids and their solutions, or NULL.
+	int Exit_Code; //! EXIT_FAILURE if the writing stage found a grid that could not be solved, EXIT_SUCCESS otherwise.
+} TBatchPipeline;
+
+/** A solving thread. */
+typedef struct
+{
+	TSolver Solver; //! This thread solver context.
+	TLanesSolver Lanes_Solver; //! Propagate the 9x9 grids of a block at once.
+	TBatchPipeline *Pointer_Pipeline; //! Where the blocks to solve are taken from.
+	pthread_t Thread; //! The thread identifier.
+} TBatchWorker;
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Solve a batch grid and keep its solution, or count its solutions.
+ * @param Pointer_Solver The solver context to use.
+ * @param Pointer_Batch_Grid The grid to solve.
+ * @param Pointer_Configuration How the grids are solved.
+ */
+static void BatchSolveGrid(TSolver *Pointer_Solver, TBatchGrid *Pointer_Batch_Grid, const TBatchConfiguration *Pointer_Configuration)
+{
+	int Result;
+	
+	SolverLoadFromGrid(Pointer_Solver, &Pointer_Batch_Grid->Grid);
+	if (Pointer_Configuration->Is_Counting_Enabled) Result = SolverCountSolutions(Pointer_Solver, Pointer_Configuration->Solutions_Limit, &Pointer_Batch_Grid->Solutions_Count);
+	else
+	{
+		Result = SolverSolve(Pointer_Solver);
+		if (Result == SOLVER_RESULT_SOLVED) GridCopy(&Pointer_Batch_Grid->Grid, &Pointer_Solver->Grid);
+	}
+	
+	if (Result == SOLVER_RESULT_SOLVED) Pointer_Batch_Grid->Result = BATCH_GRID_RESULT_SOLVED;
+	else if (Result == SOLVER_RESULT_TIMED_OUT) Pointer_Batch_Grid->Result = BATCH_GRID_RESULT_TIMED_OUT;
+	else Pointer_Batch_Grid->Result = BATCH_GRID_RESULT_UNSOLVABLE;
+	
+	if (Pointer_Configuration->Statistics_File != NULL) SolverWriteStatisticsRecord(Pointer_Solver, Pointer_Batch_Grid->Index, Result, Pointer_Configuration->Statistics_File);
+}
+
+/** Propagate several 9x9 batch grids at once, then solve the grids needing a guess with the backtracking solver.
+ * @param Pointer_Solver The solver context solving the grids needing a guess.
+ * @param Pointer_Lanes_Solver The lanes solver context.
+ * @param Pointer_Batch_Grids The 9x9 grids to solve.
+ * @param Grids_Count How many grids to solve, from 1 to LANES_SOLVER_LANES_COUNT.
+ * @param Pointer_Configuration How the grids are solved.
+ */
+static void BatchSolveLanesGrids(TSolver *Pointer_Solver, TLanesSolver *Pointer_Lanes_Solver, TBatchGrid *Pointer_Batch_Grids[], int Grids_Count, const TBatchConfiguration *Pointer_Configuration)
+{
+	TGrid *Pointer_Grids[LANES_SOLVER_LANES_COUNT];
+	int Results[LANES_SOLVER_LANES_COUNT], i;
+	
+	for (i = 0; i < Grids_Count; i++) Pointer_Grids[i] = &Pointer_Batch_Grids[i]->Grid;
+	LanesSolverPropagate(Pointer_Lanes_Solver, Pointer_Grids, Grids_Count, Results);
+	
+	for (i = 0; i < Grids_Count; i++)
+	{
+		switch (Results[i])
+		{
+			// All cells were forced, so this is the only solution
+			case LANES_SOLVER_RESULT_SOLVED:
+				Pointer_Batch_Grids[i]->Result = BATCH_GRID_RESULT_SOLVED;
+				Pointer_Batch_Grids[i]->Solutions_Count = 1;
+				break;
+				
+			case LANES_SOLVER_RESULT_UNSOLVABLE:
+				Pointer_Batch_Grids[i]->Result = BATCH_GRID_RESULT_UNSOLVABLE;
+				Pointer_Batch_Grids[i]->Solutions_Count = 0;
+				break;
+				
+			// The forced cells are already filled, so the search starts from a smaller grid (the forced cells are the same in all solutions, so the solutions count is not changed)
+			default:
+				BatchSolveGrid(Pointer_Solver, Pointer_Batch_Grids[i], Pointer_Configuration);
+				break;
+		}
+	}
+}
+
+/** Solve the grids of a block, the 9x9 ones being propagated together when the lanes solver is enabled.
+ * @param Pointer_Solver The solver context.
+ * @param Pointer_Lanes_Solver The lanes solver context.
+ * @param Pointer_Batch_Grids The grids, the grids that could not be loaded are skipped.
+ * @param Grids_Count How many grids to solve, from 0 to BATCH_BLOCK_GRIDS_COUNT.
+ * @param Pointer_Configuration How the grids are solved.
+ */
+static void BatchSolveBlock(TSolver *Pointer_Solver, TLanesSolver *Pointer_Lanes_Solver, TBatchGrid *Pointer_Batch_Grids[], int Grids_Count, const TBatchConfiguration *Pointer_Configuration)
+{
+	TBatchGrid *Pointer_Lanes_Grids[LANES_SOLVER_LANES_COUNT];
+	int i, Lanes_Grids_Count = 0;
+	
+	for (i = 0; i < Grids_Count; i++)
+	{
+		if (Pointer_Batch_Grids[i]->Result == BATCH_GRID_RESULT_BAD_GRID) continue;
+		
+		if (Pointer_Configuration->Is_Lanes_Solver_Enabled && (Pointer_Batch_Grids[i]->Grid.Size == LANES_SOLVER_GRID_SIZE))
+		{
+			Pointer_Lanes_Grids[Lanes_Grids_Count] = Pointer_Batch_Grids[i];
+			Lanes_Grids_Count++;
+		}
+		else BatchSolveGrid(Pointer_Solver, Pointer_Batch_Grids[i], Pointer_Configuration);
+	}
+	if (Lanes_Grids_Count > 0) BatchSolveLanesGrids(Pointer_Solver, Pointer_Lanes_Solver, Pointer_Lanes_Grids, Lanes_Grids_Count, Pointer_Configuration);
+}
+
+/** Print a solution on a single line, this is the solution callback used to display all solutions when counting.
+ * @param Pointer_Argument Not used.
+ * @param Pointer_Grid The solved grid.
+ */
+static void BatchShowSolution(void __attribute__((unused)) *Pointer_Argument, TGrid *Pointer_Grid)
+{
+	GridShowLine(Pointer_Grid);
+}
+
+/** Format the result line of a batch grid.
+ * @param Pointer_Batch_Grid The grid.
+ * @param Is_Counting_Enabled Set to 1 to format the grid solutions count instead of its solution.
+ * @param Pointer_Line On output, contain the line with its new line character (it is not terminated by a zero). The buffer must be at least BATCH_MAXIMUM_LINE_SIZE + 1 bytes long.
+ * @param Pointer_Is_Solved On output, set to 1 if the grid was solved (or has at least one solution when counting), set to 0 if the grid was not solved.
+ * @return The line length.
+ */
+static int BatchFormatGridResult(TBatchGrid *Pointer_Batch_Grid, int Is_Counting_Enabled, char *Pointer_Line, int *Pointer_Is_Solved)
+{
+	unsigned int Length;
+	
+	*Pointer_Is_Solved = 0;
+	
+	// A grid that could be loaded always has a solutions count, unless its counting was stopped
+	if (Is_Counting_Enabled && (Pointer_Batch_Grid->Result != BATCH_GRID_RESULT_BAD_GRID) && (Pointer_Batch_Grid->Result != BATCH_GRID_RESULT_TIMED_OUT))
+	{
+		*Pointer_Is_Solved = Pointer_Batch_Grid->Solutions_Count > 0;
+		return sprintf(Pointer_Line, "%llu\n", Pointer_Batch_Grid->Solutions_Count);
+	}
+	
+	switch (Pointer_Batch_Grid->Result)
+	{
+		case BATCH_GRID_RESULT_SOLVED:
+			GridConvertToString(&Pointer_Batch_Grid->Grid, Pointer_Line);
+			Length = Pointer_Batch_Grid->Grid.Size * Pointer_Batch_Grid->Grid.Size;
+			Pointer_Line[Length] = '\n';
+			*Pointer_Is_Solved = 1;
+			return Length + 1;
+			
+		case BATCH_GRID_RESULT_UNSOLVABLE:
+			return sprintf(Pointer_Line, "Unsolvable\n");
+			
+		case BATCH_GRID_RESULT_TIMED_OUT:
+			return sprintf(Pointer_Line, "Timed out\n");
+			
+		default:
+			return sprintf(Pointer_Line, "Bad grid\n");
+	}
+}
+
+/** Print the result line of a batch grid.
+ * @param Pointer_Batch_Grid The grid.
+ * @param Is_Counting_Enabled Set to 1 to print the grid solutions count instead of its solution.
+ * @return 1 if the grid was solved (or has at least one solution when counting),
+ * @return 0 if the grid was not solved.
+ */
+static int BatchShowGridResult(TBatchGrid *Pointer_Batch_Grid, int Is_Counting_Enabled)
+{
+	char Line[BATCH_MAXIMUM_LINE_SIZE + 1];
+	int Length, Is_Solved;
+	
+	Length = BatchFormatGridResult(Pointer_Batch_Grid, Is_Counting_Enabled, Line, &Is_Solved);
+	fwrite(Line, 1, Length, stdout);
+	return Is_Solved;
+}
+
+/** A solving thread, it solves the blocks loaded by the reading stage until the stream end is reached.
+ * @param Pointer_Argument The worker.
+ * @return Always NULL.
+ */
+static void *BatchWorkerThread(void *Pointer_Argument)
+{
+	TBatchWorker *Pointer_Worker = Pointer_Argument;
+	TBatchPipeline *Pointer_Pipeline = Pointer_Worker->Pointer_Pipeline;
+	TBatchBlock *Pointer_Block;
+	unsigned long long Block_Number;
+	
+	while (1)
+	{
+		while (sem_wait(&Pointer_Pipeline->Loaded_Blocks_Semaphore) != 0); // Retry when interrupted by a signal
+		
+		// Each pass through the semaphore gives the right to take the next block, the threads woken up when the stream end is reached get a number beyond the last block
+		Block_Number = atomic_fetch_add(&Pointer_Pipeline->Next_Block_Number, 1);
+		if (Block_Number >= atomic_load(&Pointer_Pipeline->Stream_Blocks_Count)) break;
+		
+		Pointer_Block = &Pointer_Pipeline->Pointer_Blocks[Block_Number % Pointer_Pipeline->Grids_Count];
+		BatchSolveBlock(&Pointer_Worker->Solver, &Pointer_Worker->Lanes_Solver, Pointer_Block->Pointer_Grids, Pointer_Block->Grids_Count, Pointer_Pipeline->Pointer_Configuration);
+		sem_post(&Pointer_Block->Solved_Semaphore);
+	}
+	return NULL;
+}
+
+/** Load the next grid of the batch. A bad grid of a mapped file or of a packed grids file is reported on the error output with its location, so it can be easily found in a huge file.
+ * @param Pointer_Source Where the grids are read from.
+ * @param Pointer_Grid On output, contain the loaded grid.
+ * @return 0 if the grid was correctly loaded,
+ * @return 1 if there is no more grid,
+ * @return A negative value if the grid could not be loaded.
+ */
+static int BatchLoadNextGrid(TBatchSource *Pointer_Source, TGrid *Pointer_Grid)
+{
+	TCorpusRecord Record;
+	int Result;
+	
+	if (Pointer_Source->Pointer_Packed_Grids != NULL)
+	{
+		Result = PackedGridsReadRecord(Pointer_Source->Pointer_Packed_Grids, Pointer_Grid, NULL, NULL);
+		if (Result < 0) fprintf(stderr, "Warning : bad grid in record %llu.\n", Pointer_Source->Pointer_Packed_Grids->Record_Index - 1);
+		return Result;
+	}
+	if (Pointer_Source->Pointer_Corpus == NULL) return GridLoadFromStream(Pointer_Grid, Pointer_Source->File);
+	
+	Result = CorpusLoadNextGrid(Pointer_Source->Pointer_Corpus, Pointer_Grid, &Record);
+	if (Result < 0) fprintf(stderr, "Warning : bad grid at line %llu (byte offset %llu).\n", Record.Line, Record.Offset);
+	return Result;
+}
+
+/** Load the next grids of the batch as a block. The block ends with the first grid that does not go to the lanes solver, so only the grids propagated together are solved one after the other.
+ * @param Pointer_Source Where the grids are read from.
+ * @param Pointer_Batch_Grids On output, contain the loaded grids.
+ * @param Maximum_Grids_Count How many grids to load at most.
+ * @param Pointer_Grid_Index The stream index of the next grid, it is updated.
+ * @param Is_Packing_Enabled Set to 1 to pack the grids before they are solved.
+ * @param Is_Lanes_Solver_Enabled Set to 1 when the 9x9 grids go to the lanes solver.
+ * @param Pointer_Is_End_Reached On output, set to 1 if the stream end is reached, it is not modified otherwise.
+ * @return How many grids were loaded.
+ */
+static int BatchLoadGrids(TBatchSource *Pointer_Source, TBatchGrid *Pointer_Batch_Grids[], int Maximum_Grids_Count, unsigned long long *Pointer_Grid_Index, int Is_Packing_Enabled, int Is_Lanes_Solver_Enabled, int *Pointer_Is_End_Reached)
+{
+	TBatchGrid *Pointer_Batch_Grid;
+	int Grids_Count = 0, Result;
+	
+	while (Grids_Count < Maximum_Grids_Count)
+	{
+		Pointer_Batch_Grid = Pointer_Batch_Grids[Grids_Count];
+		Result = BatchLoadNextGrid(Pointer_Source, &Pointer_Batch_Grid->Grid);
+		if (Result == 1) // No more grid to solve
+		{
+			*Pointer_Is_End_Reached = 1;
+			break;
+		}
+		
+		Pointer_Batch_Grid->Index = *Pointer_Grid_Index;
+		(*Pointer_Grid_Index)++;
+		Grids_Count++;
+		if (Result != 0)
+		{
+			Pointer_Batch_Grid->Result = BATCH_GRID_RESULT_BAD_GRID;
+			continue;
+		}
+		
+		Pointer_Batch_Grid->Result = BATCH_GRID_RESULT_PENDING;
+		if (Is_Packing_Enabled) PackedGridsPackGrid(&Pointer_Batch_Grid->Grid, Pointer_Batch_Grid->Packed_Grid);
+		if (!Is_Lanes_Solver_Enabled || (Pointer_Batch_Grid->Grid.Size != LANES_SOLVER_GRID_SIZE)) break;
+	}
+	return Grids_Count;
+}
+
+/** Write a batch grid and its solution to the packed grids file. The file is created when the first grid is written, all its grids have the size of the first one : the grids of other sizes and the grids that could not be loaded are reported on the error output and not written.
+ * @param Pointer_Packed_Grids The packed grids file, its stream is NULL until the first grid is written.
+ * @param Pointer_Batch_Grid The grid, its packed grid must be set.
+ * @param File The stream to write the file to.
+ * @return 0 if the grid was written or skipped,
+ * @return -1 if the file could not be written.
+ */
+static int BatchWritePackedGrid(TPackedGrids *Pointer_Packed_Grids, TBatchGrid *Pointer_Batch_Grid, FILE *File)
+{
+	unsigned char Packed_Solution[PACKED_GRIDS_MAXIMUM_GRID_BYTES_COUNT], *Pointer_Packed_Solution = NULL;
+	
+	if ((Pointer_Batch_Grid->Result != BATCH_GRID_RESULT_BAD_GRID) && (Pointer_Packed_Grids->File == NULL))
+	{
+		if (PackedGridsCreate(Pointer_Packed_Grids, File, &Pointer_Batch_Grid->Grid, 1) != 0) return -1;
+	}
+	
+	if ((Pointer_Batch_Grid->Result == BATCH_GRID_RESULT_BAD_GRID) || (Pointer_Batch_Grid->Grid.Size != Pointer_Packed_Grids->Grid_Size))
+	{
+		fprintf(stderr, "Warning : grid %llu is not written to the packed grids file.\n", Pointer_Batch_Grid->Index);
+		return 0;
+	}
+	
+	// The grid of a solved batch grid has been replaced by its solution
+	if (Pointer_Batch_Grid->Result == BATCH_GRID_RESULT_SOLVED)
+	{
+		PackedGridsPackGrid(&Pointer_Batch_Grid->Grid, Packed_Solution);
+		Pointer_Packed_Solution = Packed_Solution;
+	}
+	return PackedGridsWriteRecord(Pointer_Packed_Grids, Pointer_Batch_Grid->Packed_Grid, Pointer_Packed_Solution);
+}
+
+/** Solve all grids of a source with a single thread, showing each solution as soon as it is found (or as soon as the grids propagated together with it are solved).
+ * @param Pointer_Source Where the grids are read from.
+ * @param Pointer_Configuration How the grids are solved.
+ * @param Pointer_Packed_Output The packed grids file receiving the grids and their solutions, or NULL.
+ * @return EXIT_SUCCESS if all grids were solved,
+ * @return EXIT_FAILURE if at least one grid could not be solved.
+ */
+static int BatchSolveSingleThreaded(TBatchSource *Pointer_Source, const TBatchConfiguration *Pointer_Configuration, TPackedGrids *Pointer_Packed_Output)
+{
+	static TSolver Solver;
+	static TDancingLinks Dancing_Links;
+	static TLanesSolver Lanes_Solver;
+	static TBatchGrid Batch_Grids[BATCH_BLOCK_GRIDS_COUNT];
+	TBatchGrid *Pointer_Batch_Grids[BATCH_BLOCK_GRIDS_COUNT];
+	int i, Grids_Count, Is_End_Reached = 0, Exit_Code = EXIT_SUCCESS;
+	unsigned long long Grid_Index = 0;
+	
+	SolverInitialize(&Solver);
+	SolverSetConfiguration(&Solver, (TSolverConfiguration *) &Pointer_Configuration->Solver_Configuration);
+	SolverSetTimeLimit(&Solver, Pointer_Configuration->Time_Limit);
+	SolverSetLoopsLimit(&Solver, Pointer_Configuration->Loops_Limit);
+	SolverSetDancingLinks(&Solver, &Dancing_Links);
+	if (Pointer_Configuration->Is_Counting_Enabled && Pointer_Configuration->Is_Solutions_Display_Enabled) SolverSetSolutionCallback(&Solver, BatchShowSolution, NULL);
+	
+	for (i = 0; i < BATCH_BLOCK_GRIDS_COUNT; i++) Pointer_Batch_Grids[i] = &Batch_Grids[i];
+	
+	// Load up to as many grids as lanes, so the 9x9 ones can be propagated together
+	while (!Is_End_Reached)
+	{
+		Grids_Count = BatchLoadGrids(Pointer_Source, Pointer_Batch_Grids, BATCH_BLOCK_GRIDS_COUNT, &Grid_Index, Pointer_Packed_Output != NULL, Pointer_Configuration->Is_Lanes_Solver_Enabled, &Is_End_Reached);
+		BatchSolveBlock(&Solver, &Lanes_Solver, Pointer_Batch_Grids, Grids_Count, Pointer_Configuration);
+		
+		// Show the results in the grids order
+		for (i = 0; i < Grids_Count; i++)
+		{
+			if (!BatchShowGridResult(&Batch_Grids[i], Pointer_Configuration->Is_Counting_Enabled)) Exit_Code = EXIT_FAILURE;
+			if ((Pointer_Packed_Output != NULL) && (BatchWritePackedGrid(Pointer_Packed_Output, &Batch_Grids[i], Pointer_Configuration->Packed_Output_File) != 0)) Exit_Code = EXIT_FAILURE;
+		}
+	}
+	
+	return Exit_Code;
+}
+
+/** The writing stage thread, it formats the results of the solved blocks in the stream order and writes them by big blocks. The formatted results are written before waiting for a block, so the results of a slowly read stream are not delayed.
+ * @param Pointer_Argument The pipeline.
+ * @return Always NULL.
+ */
+static void *BatchWriterThread(void *Pointer_Argument)
+{
+	TBatchPipeline *Pointer_Pipeline = Pointer_Argument;
+	TBatchBlock *Pointer_Block;
+	const TBatchConfiguration *Pointer_Configuration = Pointer_Pipeline->Pointer_Configuration;
+	char *Pointer_Buffer = Pointer_Pipeline->Pointer_Output_Buffer;
+	size_t Buffer_Size = 0;
+	unsigned long long Block_Number;
+	int i, Is_Solved;
+	
+	for (Block_Number = 0; ; Block_Number++)
+	{
+		Pointer_Block = &Pointer_Pipeline->Pointer_Blocks[Block_Number % Pointer_Pipeline->Grids_Count];
+		if (sem_trywait(&Pointer_Block->Solved_Semaphore) != 0)
+		{
+			fwrite(Pointer_Buffer, 1, Buffer_Size, stdout);
+			fflush(stdout);
+			Buffer_Size = 0;
+			while (sem_wait(&Pointer_Block->Solved_Semaphore) != 0); // Retry when interrupted by a signal
+		}
+		if (Pointer_Block->Grids_Count == 0) break; // The stream end is reached
+		
+		for (i = 0; i < Pointer_Block->Grids_Count; i++)
+		{
+			if (Buffer_Size + BATCH_MAXIMUM_LINE_SIZE >= BATCH_OUTPUT_BUFFER_SIZE)
+			{
+				fwrite(Pointer_Buffer, 1, Buffer_Size, stdout);
+				Buffer_Size = 0;
+			}
+			Buffer_Size += BatchFormatGridResult(Pointer_Block->Pointer_Grids[i], Pointer_Configuration->Is_Counting_Enabled, &Pointer_Buffer[Buffer_Size], &Is_Solved);
+			if (!Is_Solved) Pointer_Pipeline->Exit_Code = EXIT_FAILURE;
+			if ((Pointer_Pipeline->Pointer_Packed_Output != NULL) && (BatchWritePackedGrid(Pointer_Pipeline->Pointer_Packed_Output, Pointer_Block->Pointer_Grids[i], Pointer_Configuration->Packed_Output_File) != 0)) Pointer_Pipeline->Exit_Code = EXIT_FAILURE;
+		}
+		
+		// Give the block grids back to the reading stage
+		for (i = 0; i < Pointer_Block->Grids_Count; i++) sem_post(&Pointer_Pipeline->Free_Grids_Semaphore);
+	}
+	
+	fwrite(Pointer_Buffer, 1, Buffer_Size, stdout);
+	return NULL;
+}
+
+/** Stop the solving threads when they have solved all blocks of the stream.
+ * @param Pointer_Pipeline The pipeline.
+ * @param Pointer_Workers The solving threads.
+ * @param Workers_Count How many solving threads are running.
+ * @param Stream_Blocks_Count How many blocks hold the stream grids.
+ */
+static void BatchStopWorkers(TBatchPipeline *Pointer_Pipeline, TBatchWorker *Pointer_Workers, int Workers_Count, unsigned long long Stream_Blocks_Count)
+{
+	int i;
+	
+	// Each thread passing through the semaphore without a block to solve gets a number beyond the last block and stops
+	atomic_store(&Pointer_Pipeline->Stream_Blocks_Count, Stream_Blocks_Count);
+	for (i = 0; i < Workers_Count; i++) sem_post(&Pointer_Pipeline->Loaded_Blocks_Semaphore);
+	for (i = 0; i < Workers_Count; i++) pthread_join(Pointer_Workers[i].Thread, NULL);
+}
+
+/** Solve all grids of a source with several threads. The grids go through a pipeline made of three stages running at the same time : this thread reads the grids and groups them by blocks, the solving threads take the blocks in the stream order (a grid that does not go to the lanes solver is alone in its block, so a very long grid only holds its own thread), and the writing thread writes the results in the stream order.
+ * @param Pointer_Source Where the grids are read from.
+ * @param Pointer_Configuration How the grids are solved.
+ * @param Pointer_Packed_Output The packed grids file receiving the grids and their solutions, or NULL.
+ * @return EXIT_SUCCESS if all grids were solved,
+ * @return EXIT_FAILURE if at least one grid could not be solved or if the threads could not be started.
+ */
+static int BatchSolveMultiThreaded(TBatchSource *Pointer_Source, const TBatchConfiguration *Pointer_Configuration, TPackedGrids *Pointer_Packed_Output)
+{
+	TBatchPipeline Pipeline;
+	TBatchWorker *Pointer_Workers;
+	TBatchBlock *Pointer_Block;
+	TDancingLinks *Pointer_Dancing_Links = NULL;
+	pthread_t Writer_Thread;
+	pthread_attr_t Thread_Attributes;
+	cpu_set_t Processors_Set;
+	int i, Grids_Count, Maximum_Grids_Count, Workers_Count, Processors_Count, Is_End_Reached = 0, Threads_Count = Pointer_Configuration->Threads_Count;
+	unsigned int Ring_Grids_Count = Threads_Count * BATCH_PIPELINE_GRIDS_PER_THREAD;
+	unsigned long long Grid_Index = 0, Grid_Number = 0, Block_Number = 0;
+	
+	// Allocate the pipeline rings and the workers (the lanes solver must be aligned)
+	Pipeline.Pointer_Grids = malloc(Ring_Grids_Count * sizeof(TBatchGrid));
+	Pipeline.Pointer_Blocks = malloc(Ring_Grids_Count * sizeof(TBatchBlock));
+	Pipeline.Pointer_Output_Buffer = malloc(BATCH_OUTPUT_BUFFER_SIZE);
+	Pointer_Workers = aligned_alloc(_Alignof(TBatchWorker), Threads_Count * sizeof(TBatchWorker));
+	if (Pointer_Configuration->Solver_Configuration.Engine == SOLVER_ENGINE_DANCING_LINKS) Pointer_Dancing_Links = malloc(Threads_Count * sizeof(TDancingLinks)); // Each worker needs its own dancing links storage
+	if ((Pipeline.Pointer_Grids == NULL) || (Pipeline.Pointer_Blocks == NULL) || (Pipeline.Pointer_Output_Buffer == NULL) || (Pointer_Workers == NULL) || ((Pointer_Configuration->Solver_Configuration.Engine == SOLVER_ENGINE_DANCING_LINKS) && (Pointer_Dancing_Links == NULL)))
+	{
+		printf("Error : not enough memory to solve the grids with %d threads.\n", Threads_Count);
+		free(Pipeline.Pointer_Grids);
+		free(Pipeline.Pointer_Blocks);
+		free(Pipeline.Pointer_Output_Buffer);
+		free(Pointer_Workers);
+		free(Pointer_Dancing_Links);
+		return EXIT_FAILURE;
+	}
+	
+	Pipeline.Grids_Count = Ring_Grids_Count;
+	sem_init(&Pipeline.Free_Grids_Semaphore, 0, Ring_Grids_Count);
+	sem_init(&Pipeline.Loaded_Blocks_Semaphore, 0, 0);
+	for (i = 0; i < (int) Ring_Grids_Count; i++) sem_init(&Pipeline.Pointer_Blocks[i].Solved_Semaphore, 0, 0);
+	atomic_init(&Pipeline.Next_Block_Number, 0);
+	atomic_init(&Pipeline.Stream_Blocks_Count, ULLONG_MAX);
+	Pipeline.Pointer_Configuration = Pointer_Configuration;
+	Pipeline.Pointer_Packed_Output = Pointer_Packed_Output;
+	Pipeline.Exit_Code = EXIT_SUCCESS;
+	Processors_Count = sysconf(_SC_NPROCESSORS_ONLN);
+	
+	// Start the solving threads, the blocks of the missing threads are solved by the running ones but at least one thread is needed
+	for (Workers_Count = 0; Workers_Count < Threads_Count; Workers_Count++)
+	{
+		Pointer_Workers[Workers_Count].Pointer_Pipeline = &Pipeline;
+		SolverInitialize(&Pointer_Workers[Workers_Count].Solver);
+		SolverSetConfiguration(&Pointer_Workers[Workers_Count].Solver, (TSolverConfiguration *) &Pointer_Configuration->Solver_Configuration);
+		SolverSetTimeLimit(&Pointer_Workers[Workers_Count].Solver, Pointer_Configuration->Time_Limit);
+		SolverSetLoopsLimit(&Pointer_Workers[Workers_Count].Solver, Pointer_Configuration->Loops_Limit);
+		if (Pointer_Dancing_Links != NULL) SolverSetDancingLinks(&Pointer_Workers[Workers_Count].Solver, &Pointer_Dancing_Links[Workers_Count]);
+		
+		pthread_attr_init(&Thread_Attributes);
+		if (Pointer_Configuration->Is_Threads_Pinning_Enabled)
+		{
+			CPU_ZERO(&Processors_Set);
+			CPU_SET(Workers_Count % Processors_Count, &Processors_Set);
+			pthread_attr_setaffinity_np(&Thread_Attributes, sizeof(Processors_Set), &Processors_Set);
+		}
+		i = pthread_create(&Pointer_Workers[Workers_Count].Thread, &Thread_Attributes, BatchWorkerThread, &Pointer_Workers[Workers_Count]);
+		pthread_attr_destroy(&Thread_Attributes);
+		if (i != 0) break;
+	}
+	if ((Workers_Count == 0) || (pthread_create(&Writer_Thread, NULL, BatchWriterThread, &Pipeline) != 0))
+	{
+		printf("Error : could not start the solving threads.\n");
+		BatchStopWorkers(&Pipeline, Pointer_Workers, Workers_Count, 0);
+		Pipeline.Exit_Code = EXIT_FAILURE;
+	}
+	else
+	{
+		// Only the 9x9 grids going to the lanes solver are grouped, the other grids are handed to the solving threads one by one
+		if (Pointer_Configuration->Is_Lanes_Solver_Enabled) Maximum_Grids_Count = BATCH_BLOCK_GRIDS_COUNT;
+		else Maximum_Grids_Count = 1;
+		
+		// Read the grids until the stream end, waiting for free grids when the pipeline is full
+		do
+		{
+			// Take enough free grids for a whole block, the unused ones are given back (the empty block telling the stream end keeps one, so there are never more blocks than grids in the pipeline)
+			Pointer_Block = &Pipeline.Pointer_Blocks[Block_Number % Ring_Grids_Count];
+			for (i = 0; i < Maximum_Grids_Count; i++)
+			{
+				while (sem_wait(&Pipeline.Free_Grids_Semaphore) != 0); // Retry when interrupted by a signal
+				Pointer_Block->Pointer_Grids[i] = &Pipeline.Pointer_Grids[(Grid_Number + i) % Ring_Grids_Count];
+			}
+			if (Is_End_Reached) Grids_Count = 0;
+			else Grids_Count = BatchLoadGrids(Pointer_Source, Pointer_Block->Pointer_Grids, Maximum_Grids_Count, &Grid_Index, Pointer_Packed_Output != NULL, Pointer_Configuration->Is_Lanes_Solver_Enabled, &Is_End_Reached);
+			for (i = (Grids_Count > 0) ? Grids_Count : 1; i < Maximum_Grids_Count; i++) sem_post(&Pipeline.Free_Grids_Semaphore);
+			Grid_Number += Grids_Count;
+			Pointer_Block->Grids_Count = Grids_Count;
+			
+			// An empty block is not solved, it tells the writing stage that the stream end is reached
+			if (Grids_Count == 0) sem_post(&Pointer_Block->Solved_Semaphore);
+			else
+			{
+				sem_post(&Pipeline.Loaded_Blocks_Semaphore);
+				Block_Number++;
+			}
+		} while (Grids_Count > 0);
+		
+		BatchStopWorkers(&Pipeline, Pointer_Workers, Workers_Count, Block_Number);
+		pthread_join(Writer_Thread, NULL);
+	}
+	
+	sem_destroy(&Pipeline.Free_Grids_Semaphore);
+	sem_destroy(&Pipeline.Loaded_Blocks_Semaphore);
+	for (i = 0; i < (int) Ring_Grids_Count; i++) sem_destroy(&Pipeline.Pointer_Blocks[i].Solved_Semaphore);
+	free(Pipeline.Pointer_Grids);
+	free(Pipeline.Pointer_Blocks);
+	free(Pipeline.Pointer_Output_Buffer);
+	free(Pointer_Workers);
+	free(Pointer_Dancing_Links);
+	return Pipeline.Exit_Code;
+}
+
+/** Solve all grids of a source, choosing how according to the configuration.
+ * @param Pointer_Source Where the grids are read from.
+ * @param Pointer_Configuration How to solve the grids.
+ * @return EXIT_SUCCESS if all grids were solved (or have at least one solution when counting),
+ * @return EXIT_FAILURE if at least one grid could not be solved or if the threads could not be started.
+ */
+static int BatchSolveSource(TBatchSource *Pointer_Source, TBatchConfiguration *Pointer_Configuration)
+{
+	TBatchConfiguration Configuration;
+	TPackedGrids Packed_Output, *Pointer_Packed_Output = NULL;
+	int Exit_Code;
+	
+	// Adapt a copy of the configuration to the options that can't be used together
+	Configuration = *Pointer_Configuration;
+	
+	// Use all processor cores if no threads count is provided
+	if (Configuration.Threads_Count <= 0) Configuration.Threads_Count = sysconf(_SC_NPROCESSORS_ONLN);
+	
+	// The lanes solver is a constraints propagation, it is used only when the backtracking engine propagates the constraints too
+	if ((Configuration.Solver_Configuration.Engine != SOLVER_ENGINE_BACKTRACKING) || !Configuration.Solver_Configuration.Is_Propagation_Enabled) Configuration.Is_Lanes_Solver_Enabled = 0;
+	// The grids fully solved by the lanes solver would have no statistics
+	if (Configuration.Statistics_File != NULL) Configuration.Is_Lanes_Solver_Enabled = 0;
+	
+	// The solutions are printed while they are found, so the grids must be solved one after the other
+	if (Configuration.Is_Counting_Enabled && Configuration.Is_Solutions_Display_Enabled)
+	{
+		Configuration.Threads_Count = 1;
+		Configuration.Is_Lanes_Solver_Enabled = 0;
+	}
+	
+	// The packed grids file is created when the first grid is written
+	if (Configuration.Packed_Output_File != NULL)
+	{
+		Packed_Output.File = NULL;
+		Pointer_Packed_Output = &Packed_Output;
+	}
+	
+	if (Configuration.Threads_Count <= 1) Exit_Code = BatchSolveSingleThreaded(Pointer_Source, &Configuration, Pointer_Packed_Output);
+	else Exit_Code = BatchSolveMultiThreaded(Pointer_Source, &Configuration, Pointer_Packed_Output);
+	
+	if ((Pointer_Packed_Output != NULL) && (Packed_Output.File != NULL) && ((PackedGridsFinishWriting(&Packed_Output) != 0) || ferror(Packed_Output.File)))
+	{
+		printf("Error : could not write the packed grids file.\n");
+		Exit_Code = EXIT_FAILURE;
+	}
+	return Exit_Code;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+void BatchGetDefaultConfiguration(TBatchConfiguration *Pointer_Configuration)
+{
+	Pointer_Configuration->Threads_Count = 1;
+	Pointer_Configuration->Is_Threads_Pinning_Enabled = 0;
+	Pointer_Configuration->Is_Lanes_Solver_Enabled = 1;
+	Pointer_Configuration->Is_Counting_Enabled = 0;
+	Pointer_Configuration->Solutions_Limit = 0;
+	Pointer_Configuration->Is_Solutions_Display_Enabled = 0;
+	Pointer_Configuration->Time_Limit = 0;
+	Pointer_Configuration->Loops_Limit = 0;
+	Pointer_Configuration->Statistics_File = NULL;
+	Pointer_Configuration->Packed_Output_File = NULL;
+	SolverGetDefaultConfiguration(&Pointer_Configuration->Solver_Configuration);
+}
+
+int BatchSolve(FILE *File, TBatchConfiguration *Pointer_Configuration)
+{
+	TBatchSource Source;
+	
+	Source.File = File;
+	Source.Pointer_Corpus = NULL;
+	Source.Pointer_Packed_Grids = NULL;
+	return BatchSolveSource(&Source, Pointer_Configuration);
+}
+
+int BatchSolveCorpus(TCorpus *Pointer_Corpus, TBatchConfiguration *Pointer_Configuration)
+{
+	TBatchSource Source;
+	
+	Source.File = NULL;
+	Source.Pointer_Corpus = Pointer_Corpus;
+	Source.Pointer_Packed_Grids = NULL;
+	return BatchSolveSource(&Source, Pointer_Configuration);
+}
+
+int BatchSolvePacked(TPackedGrids *Pointer_Packed_Grids, TBatchConfiguration *Pointer_Configuration)
+{
+	TBatchSource Source;
+	
+	Source.File = NULL;
+	Source.Pointer_Corpus = NULL;
+	Source.Pointer_Packed_Grids = Pointer_Packed_Grids;
+	return BatchSolveSource(&Source, Pointer_Configuration);
+}
@@ -0,0 +1,490 @@
+/** @file Candidates.c
+ * @see Candidates.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Candidates.h>
+#include <stdatomic.h>
+#include <string.h>
+
+// The SIMD versions are compiled for the x86 processors only, the functions using them are built for their instruction set whatever the compiler flags, so the program still runs on older processors
+#if defined(__x86_64__) || defined(__i386__)
+	#include <immintrin.h>
+	#define CANDIDATES_IS_SIMD_AVAILABLE
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+#ifdef CANDIDATES_IS_SIMD_AVAILABLE
+	/** How many cells are computed at once by the AVX2 version. */
+	#define CANDIDATES_AVX2_LANES_COUNT (32 / sizeof(TGridBitmask))
+	/** How many cells are computed at once by the SSE4.2 version. */
+	#define CANDIDATES_SSE4_LANES_COUNT (16 / sizeof(TGridBitmask))
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Private macros
+//-------------------------------------------------------------------------------------------------
+#ifdef CANDIDATES_IS_SIMD_AVAILABLE
+	/** Build a function for the AVX2 instruction set. */
+	#define CANDIDATES_AVX2_FUNCTION __attribute__((target("avx2")))
+	/** Build a function for the SSE4.2 instruction set (the processors having it also have the bits counting instruction). */
+	#define CANDIDATES_SSE4_FUNCTION __attribute__((target("sse4.2,popcnt")))
+	/** Build a function using the bits counting instruction. */
+	#define CANDIDATES_POPCNT_FUNCTION __attribute__((target("popcnt")))
+	
+	// The vector operations depend on the bitmasks width
+	#if CONFIGURATION_GRID_MAXIMUM_SIZE <= 32
+		#define CANDIDATES_AVX2_BROADCAST(Bitmask) _mm256_set1_epi32((int) (Bitmask))
+		#define CANDIDATES_AVX2_COMPARE_EQUAL(Vector_1, Vector_2) _mm256_cmpeq_epi32(Vector_1, Vector_2)
+		#define CANDIDATES_AVX2_GET_LANES_MASK(Vector) _mm256_movemask_ps(_mm256_castsi256_ps(Vector))
+		#define CANDIDATES_SSE4_BROADCAST(Bitmask) _mm_set1_epi32((int) (Bitmask))
+		#define CANDIDATES_SSE4_COMPARE_EQUAL(Vector_1, Vector_2) _mm_cmpeq_epi32(Vector_1, Vector_2)
+		#define CANDIDATES_SSE4_GET_LANES_MASK(Vector) _mm_movemask_ps(_mm_castsi128_ps(Vector))
+		#define CANDIDATES_AVX2_COMPARE_GREATER(Vector_1, Vector_2) _mm256_cmpgt_epi32(Vector_1, Vector_2)
+		#define CANDIDATES_SSE4_COMPARE_GREATER(Vector_1, Vector_2) _mm_cmpgt_epi32(Vector_1, Vector_2)
+		#define CANDIDATES_AVX2_LANES_INDEXES _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)
+		#define CANDIDATES_SSE4_LANES_INDEXES _mm_setr_epi32(0, 1, 2, 3)
+	#else
+		#define CANDIDATES_AVX2_BROADCAST(Bitmask) _mm256_set1_epi64x((long long) (Bitmask))
+		#define CANDIDATES_AVX2_COMPARE_EQUAL(Vector_1, Vector_2) _mm256_cmpeq_epi64(Vector_1, Vector_2)
+		#define CANDIDATES_AVX2_GET_LANES_MASK(Vector) _mm256_movemask_pd(_mm256_castsi256_pd(Vector))
+		#define CANDIDATES_SSE4_BROADCAST(Bitmask) _mm_set1_epi64x((long long) (Bitmask))
+		#define CANDIDATES_SSE4_COMPARE_EQUAL(Vector_1, Vector_2) _mm_cmpeq_epi64(Vector_1, Vector_2)
+		#define CANDIDATES_SSE4_GET_LANES_MASK(Vector) _mm_movemask_pd(_mm_castsi128_pd(Vector))
+		#define CANDIDATES_AVX2_COMPARE_GREATER(Vector_1, Vector_2) _mm256_cmpgt_epi64(Vector_1, Vector_2)
+		#define CANDIDATES_SSE4_COMPARE_GREATER(Vector_1, Vector_2) _mm_cmpgt_epi64(Vector_1, Vector_2)
+		#define CANDIDATES_AVX2_LANES_INDEXES _mm256_setr_epi64x(0, 1, 2, 3)
+		#define CANDIDATES_SSE4_LANES_INDEXES _mm_set_epi64x(1, 0)
+	#endif
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Private variables
+//-------------------------------------------------------------------------------------------------
+/** The selected instruction set, it is automatically chosen on first use. */
+static atomic_int Candidates_Instruction_Set = CANDIDATES_INSTRUCTION_SET_AUTOMATIC;
+/** Set to 1 when the processor has the bits counting instruction. */
+static atomic_int Candidates_Is_Popcnt_Available = 0;
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Combine each column bitmask with the bitmask of its square, for all horizontal bands of squares. A row of cells then only needs its row bitmask and the bitmasks of its band.
+ * @param Pointer_Candidates The candidates holding the bands bitmasks.
+ * @param Pointer_Grid The grid.
+ */
+static inline void CandidatesCombineColumnsAndSquares(TCandidates *Pointer_Candidates, TGrid *Pointer_Grid)
+{
+	unsigned int Band, Column, Square = 0, i;
+	TGridBitmask Bitmask_Square;
+	
+	// Parse the squares in the order of their indexes, so no division is needed
+	for (Band = 0; Band < Pointer_Grid->Squares_Vertical_Count; Band++)
+	{
+		Column = 0;
+		while (Column < Pointer_Grid->Size)
+		{
+			Bitmask_Square = Pointer_Grid->Bitmask_Squares[Square];
+			for (i = 0; i < Pointer_Grid->Square_Width; i++)
+			{
+				Pointer_Candidates->Bands_Bitmasks[Band][Column] = Pointer_Grid->Bitmask_Columns[Column] & Bitmask_Square;
+				Column++;
+			}
+			Square++;
+		}
+	}
+}
+
+/** Store the allowed numbers of a single cell.
+ * @param Pointer_Candidates The candidates.
+ * @param Pointer_Grid The grid.
+ * @param Cell_Index The cell index.
+ * @param Bitmask_Numbers The numbers allowed by the cell row, column and square.
+ * @return 1 if the cell is empty and allows no number or 0 if not.
+ */
+static inline int CandidatesComputeCell(TCandidates *Pointer_Candidates, TGrid *Pointer_Grid, int Cell_Index, TGridBitmask Bitmask_Numbers)
+{
+	int Count;
+	
+	// A filled cell allows no number
+	if (Pointer_Grid->Cells[Cell_Index] != GRID_EMPTY_CELL_VALUE)
+	{
+		Pointer_Candidates->Cells_Candidates[Cell_Index] = 0;
+		Pointer_Candidates->Cells_Candidates_Count[Cell_Index] = 0;
+		return 0;
+	}
+	
+	Count = GRID_BITMASK_COUNT_NUMBERS(Bitmask_Numbers);
+	Pointer_Candidates->Cells_Candidates[Cell_Index] = Bitmask_Numbers;
+	Pointer_Candidates->Cells_Candidates_Count[Cell_Index] = Count;
+	if (Count == 1)
+	{
+		Pointer_Candidates->Naked_Singles[Pointer_Candidates->Naked_Singles_Count] = Cell_Index;
+		Pointer_Candidates->Naked_Singles_Count++;
+	}
+	return Count == 0;
+}
+
+/** Compute the allowed numbers one cell at a time.
+ * @param Pointer_Candidates On output, contain the allowed numbers of all cells.
+ * @param Pointer_Grid The grid.
+ * @return 0 if all empty cells allow at least one number or -1 if not.
+ * @note This function is inlined in the scalar versions built with and without the bits counting instruction.
+ */
+static inline __attribute__((always_inline)) int CandidatesComputeOneCellAtATime(TCandidates *Pointer_Candidates, TGrid *Pointer_Grid)
+{
+	unsigned int Row, Column, Row_In_Band = 0;
+	int Cell_Index = 0, Is_Contradiction_Found = 0;
+	TGridBitmask Bitmask_Row, *Pointer_Band_Bitmasks = Pointer_Candidates->Bands_Bitmasks[0];
+	
+	CandidatesCombineColumnsAndSquares(Pointer_Candidates, Pointer_Grid);
+	Pointer_Candidates->Naked_Singles_Count = 0;
+	
+	for (Row = 0; Row < Pointer_Grid->Size; Row++)
+	{
+		// The rows of a band are consecutive
+		if (Row_In_Band == Pointer_Grid->Square_Height)
+		{
+			Pointer_Band_Bitmasks += CONFIGURATION_GRID_MAXIMUM_SIZE + CANDIDATES_PADDING_CELLS_COUNT;
+			Row_In_Band = 0;
+		}
+		Row_In_Band++;
+		
+		Bitmask_Row = Pointer_Grid->Bitmask_Rows[Row];
+		for (Column = 0; Column < Pointer_Grid->Size; Column++)
+		{
+			Is_Contradiction_Found |= CandidatesComputeCell(Pointer_Candidates, Pointer_Grid, Cell_Index, Bitmask_Row & Pointer_Band_Bitmasks[Column]);
+			Cell_Index++;
+		}
+	}
+	
+	if (Is_Contradiction_Found) return -1;
+	return 0;
+}
+
+/** Compute the allowed numbers one cell at a time, with instructions available on all processors.
+ * @param Pointer_Candidates On output, contain the allowed numbers of all cells.
+ * @param Pointer_Grid The grid.
+ * @return 0 if all empty cells allow at least one number or -1 if not.
+ */
+static int CandidatesComputeScalar(TCandidates *Pointer_Candidates, TGrid *Pointer_Grid)
+{
+	return CandidatesComputeOneCellAtATime(Pointer_Candidates, Pointer_Grid);
+}
+
+#ifdef CANDIDATES_IS_SIMD_AVAILABLE
+	/** Compute the allowed numbers one cell at a time, the bits are counted with a single instruction instead of a library call.
+	 * @param Pointer_Candidates On output, contain the allowed numbers of all cells.
+	 * @param Pointer_Grid The grid.
+	 * @return 0 if all empty cells allow at least one number or -1 if not.
+	 */
+	static CANDIDATES_POPCNT_FUNCTION int CandidatesComputeScalarPopcnt(TCandidates *Pointer_Candidates, TGrid *Pointer_Grid)
+	{
+		return CandidatesComputeOneCellAtATime(Pointer_Candidates, Pointer_Grid);
+	}
+	
+	/** Count the bits of each bitmask of a vector. The bits of each byte are counted with a lookup table of the nibbles bits count, then the bytes counts of each bitmask are added.
+	 * @param Bitmasks The bitmasks.
+	 * @return The bits count of each bitmask, in a vector lane as wide as a bitmask.
+	 */
+	static inline CANDIDATES_AVX2_FUNCTION __m256i CandidatesAVX2CountBits(__m256i Bitmasks)
+	{
+		const __m256i Nibbles_Bits_Count = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4), Nibble_Mask = _mm256_set1_epi8(0x0F);
+		__m256i Bytes_Bits_Count;
+		
+		Bytes_Bits_Count = _mm256_add_epi8(_mm256_shuffle_epi8(Nibbles_Bits_Count, _mm256_and_si256(Bitmasks, Nibble_Mask)), _mm256_shuffle_epi8(Nibbles_Bits_Count, _mm256_and_si256(_mm256_srli_epi16(Bitmasks, 4), Nibble_Mask)));
+		#if CONFIGURATION_GRID_MAXIMUM_SIZE <= 32
+			return _mm256_madd_epi16(_mm256_maddubs_epi16(Bytes_Bits_Count, _mm256_set1_epi8(1)), _mm256_set1_epi16(1));
+		#else
+			return _mm256_sad_epu8(Bytes_Bits_Count, _mm256_setzero_si256());
+		#endif
+	}
+	
+	/** Store the bits counts of a vector as bytes.
+	 * @param Pointer_Counts On output, contain the counts.
+	 * @param Counts The counts, in a vector lane as wide as a bitmask.
+	 */
+	static inline CANDIDATES_AVX2_FUNCTION void CandidatesAVX2StoreCounts(unsigned char *Pointer_Counts, __m256i Counts)
+	{
+		#if CONFIGURATION_GRID_MAXIMUM_SIZE <= 32
+			// Gather the low byte of the 4 counts of each 128-bit half, then put both halves side by side
+			Counts = _mm256_shuffle_epi8(Counts, _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1));
+			_mm_storel_epi64((__m128i *) Pointer_Counts, _mm_unpacklo_epi32(_mm256_castsi256_si128(Counts), _mm256_extracti128_si256(Counts, 1)));
+		#else
+			int Packed_Counts;
+			
+			// Gather the low byte of the 2 counts of each 128-bit half, then put both halves side by side
+			Counts = _mm256_shuffle_epi8(Counts, _mm256_setr_epi8(0, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1));
+			Packed_Counts = _mm_cvtsi128_si32(_mm_unpacklo_epi16(_mm256_castsi256_si128(Counts), _mm256_extracti128_si256(Counts, 1)));
+			memcpy(Pointer_Counts, &Packed_Counts, sizeof(Packed_Counts));
+		#endif
+	}
+	
+	/** Tell which cells are empty.
+	 * @param Pointer_Cells The first cell.
+	 * @return A vector with all bits of a lane set when its cell is empty.
+	 */
+	static inline CANDIDATES_AVX2_FUNCTION __m256i CandidatesAVX2LoadEmptyCells(const int *Pointer_Cells)
+	{
+		#if CONFIGURATION_GRID_MAXIMUM_SIZE <= 32
+			return _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *) Pointer_Cells), _mm256_set1_epi32(GRID_EMPTY_CELL_VALUE));
+		#else
+			// The cells are narrower than the bitmasks, so extend the comparison result to the bitmasks width
+			return _mm256_cvtepi32_epi64(_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) Pointer_Cells), _mm_set1_epi32(GRID_EMPTY_CELL_VALUE)));
+		#endif
+	}
+	
+	/** Compute the allowed numbers of several cells at once with the AVX2 instructions.
+	 * @param Pointer_Candidates On output, contain the allowed numbers of all cells.
+	 * @param Pointer_Grid The grid.
+	 * @return 0 if all empty cells allow at least one number or -1 if not.
+	 */
+	static CANDIDATES_AVX2_FUNCTION int CandidatesComputeAVX2(TCandidates *Pointer_Candidates, TGrid *Pointer_Grid)
+	{
+		unsigned int Row, Column, Size, Lanes_Mask, Row_In_Band = 0;
+		int Cell_Index;
+		TGridBitmask *Pointer_Band_Bitmasks = Pointer_Candidates->Bands_Bitmasks[0];
+		__m256i Bitmasks_Row, Empty_Cells, Candidates, Counts, Last_Lanes, Contradictions = _mm256_setzero_si256(), Zero = _mm256_setzero_si256(), One = CANDIDATES_AVX2_BROADCAST(1);
+		
+		// The last vector of the last row would read beyond the cells (this only happens when the grid size is the maximum one and is not a multiple of the lanes count)
+		Size = Pointer_Grid->Size;
+		if ((Size % CANDIDATES_AVX2_LANES_COUNT != 0) && (Size * Size + CANDIDATES_AVX2_LANES_COUNT > GRID_MAXIMUM_CELLS_COUNT)) return CandidatesComputeOneCellAtATime(Pointer_Candidates, Pointer_Grid);
+		
+		CandidatesCombineColumnsAndSquares(Pointer_Candidates, Pointer_Grid);
+		Pointer_Candidates->Naked_Singles_Count = 0;
+		
+		// The lanes of the last vector of a row that are beyond the row end are handled like filled cells
+		Last_Lanes = CANDIDATES_AVX2_COMPARE_GREATER(CANDIDATES_AVX2_BROADCAST(Size % CANDIDATES_AVX2_LANES_COUNT), CANDIDATES_AVX2_LANES_INDEXES);
+		
+		for (Row = 0; Row < Size; Row++)
+		{
+			if (Row_In_Band == Pointer_Grid->Square_Height)
+			{
+				Pointer_Band_Bitmasks += CONFIGURATION_GRID_MAXIMUM_SIZE + CANDIDATES_PADDING_CELLS_COUNT;
+				Row_In_Band = 0;
+			}
+			Row_In_Band++;
+			
+			Bitmasks_Row = CANDIDATES_AVX2_BROADCAST(Pointer_Grid->Bitmask_Rows[Row]);
+			Cell_Index = Row * Size; // The last vector of the previous row may have gone beyond its end
+			
+			for (Column = 0; Column < Size; Column += CANDIDATES_AVX2_LANES_COUNT)
+			{
+				Empty_Cells = CandidatesAVX2LoadEmptyCells(&Pointer_Grid->Cells[Cell_Index]);
+				if (Column + CANDIDATES_AVX2_LANES_COUNT > Size) Empty_Cells = _mm256_and_si256(Empty_Cells, Last_Lanes);
+				Candidates = _mm256_and_si256(_mm256_and_si256(Bitmasks_Row, _mm256_loadu_si256((const __m256i *) &Pointer_Band_Bitmasks[Column])), Empty_Cells);
+				_mm256_storeu_si256((__m256i *) &Pointer_Candidates->Cells_Candidates[Cell_Index], Candidates);
+				
+				Counts = CandidatesAVX2CountBits(Candidates);
+				CandidatesAVX2StoreCounts(&Pointer_Candidates->Cells_Candidates_Count[Cell_Index], Counts);
+				
+				// An empty cell allowing no number is a contradiction, all of them are checked at the end
+				Contradictions = _mm256_or_si256(Contradictions, _mm256_and_si256(Empty_Cells, CANDIDATES_AVX2_COMPARE_EQUAL(Counts, Zero)));
+				
+				// Append the cells allowing a single number to the naked singles
+				Lanes_Mask = CANDIDATES_AVX2_GET_LANES_MASK(CANDIDATES_AVX2_COMPARE_EQUAL(Counts, One));
+				while (Lanes_Mask != 0)
+				{
+					Pointer_Candidates->Naked_Singles[Pointer_Candidates->Naked_Singles_Count] = Cell_Index + __builtin_ctz(Lanes_Mask);
+					Pointer_Candidates->Naked_Singles_Count++;
+					Lanes_Mask &= Lanes_Mask - 1;
+				}
+				Cell_Index += CANDIDATES_AVX2_LANES_COUNT;
+			}
+		}
+		
+		if (!_mm256_testz_si256(Contradictions, Contradictions)) return -1;
+		return 0;
+	}
+	
+	/** Count the bits of each bitmask of a vector (see CandidatesAVX2CountBits()).
+	 * @param Bitmasks The bitmasks.
+	 * @return The bits count of each bitmask, in a vector lane as wide as a bitmask.
+	 */
+	static inline CANDIDATES_SSE4_FUNCTION __m128i CandidatesSSE4CountBits(__m128i Bitmasks)
+	{
+		const __m128i Nibbles_Bits_Count = _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4), Nibble_Mask = _mm_set1_epi8(0x0F);
+		__m128i Bytes_Bits_Count;
+		
+		Bytes_Bits_Count = _mm_add_epi8(_mm_shuffle_epi8(Nibbles_Bits_Count, _mm_and_si128(Bitmasks, Nibble_Mask)), _mm_shuffle_epi8(Nibbles_Bits_Count, _mm_and_si128(_mm_srli_epi16(Bitmasks, 4), Nibble_Mask)));
+		#if CONFIGURATION_GRID_MAXIMUM_SIZE <= 32
+			return _mm_madd_epi16(_mm_maddubs_epi16(Bytes_Bits_Count, _mm_set1_epi8(1)), _mm_set1_epi16(1));
+		#else
+			return _mm_sad_epu8(Bytes_Bits_Count, _mm_setzero_si128());
+		#endif
+	}
+	
+	/** Store the bits counts of a vector as bytes.
+	 * @param Pointer_Counts On output, contain the counts.
+	 * @param Counts The counts, in a vector lane as wide as a bitmask.
+	 */
+	static inline CANDIDATES_SSE4_FUNCTION void CandidatesSSE4StoreCounts(unsigned char *Pointer_Counts, __m128i Counts)
+	{
+		#if CONFIGURATION_GRID_MAXIMUM_SIZE <= 32
+			int Packed_Counts;
+			
+			Packed_Counts = _mm_cvtsi128_si32(_mm_shuffle_epi8(Counts, _mm_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)));
+		#else
+			short Packed_Counts;
+			
+			Packed_Counts = (short) _mm_cvtsi128_si32(_mm_shuffle_epi8(Counts, _mm_setr_epi8(0, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)));
+		#endif
+		memcpy(Pointer_Counts, &Packed_Counts, sizeof(Packed_Counts));
+	}
+	
+	/** Tell which cells are empty.
+	 * @param Pointer_Cells The first cell.
+	 * @return A vector with all bits of a lane set when its cell is empty.
+	 */
+	static inline CANDIDATES_SSE4_FUNCTION __m128i CandidatesSSE4LoadEmptyCells(const int *Pointer_Cells)
+	{
+		#if CONFIGURATION_GRID_MAXIMUM_SIZE <= 32
+			return _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) Pointer_Cells), _mm_set1_epi32(GRID_EMPTY_CELL_VALUE));
+		#else
+			return _mm_cvtepi32_epi64(_mm_cmpeq_epi32(_mm_loadl_epi64((const __m128i *) Pointer_Cells), _mm_set1_epi32(GRID_EMPTY_CELL_VALUE)));
+		#endif
+	}
+	
+	/** Compute the allowed numbers of several cells at once with the SSE4.2 instructions.
+	 * @param Pointer_Candidates On output, contain the allowed numbers of all cells.
+	 * @param Pointer_Grid The grid.
+	 * @return 0 if all empty cells allow at least one number or -1 if not.
+	 */
+	static CANDIDATES_SSE4_FUNCTION int CandidatesComputeSSE4(TCandidates *Pointer_Candidates, TGrid *Pointer_Grid)
+	{
+		unsigned int Row, Column, Size, Lanes_Mask, Row_In_Band = 0;
+		int Cell_Index;
+		TGridBitmask *Pointer_Band_Bitmasks = Pointer_Candidates->Bands_Bitmasks[0];
+		__m128i Bitmasks_Row, Empty_Cells, Candidates, Counts, Last_Lanes, Contradictions = _mm_setzero_si128(), Zero = _mm_setzero_si128(), One = CANDIDATES_SSE4_BROADCAST(1);
+		
+		// The last vector of the last row would read beyond the cells (this only happens when the grid size is the maximum one and is not a multiple of the lanes count)
+		Size = Pointer_Grid->Size;
+		if ((Size % CANDIDATES_SSE4_LANES_COUNT != 0) && (Size * Size + CANDIDATES_SSE4_LANES_COUNT > GRID_MAXIMUM_CELLS_COUNT)) return CandidatesComputeOneCellAtATime(Pointer_Candidates, Pointer_Grid);
+		
+		CandidatesCombineColumnsAndSquares(Pointer_Candidates, Pointer_Grid);
+		Pointer_Candidates->Naked_Singles_Count = 0;
+		
+		// The lanes of the last vector of a row that are beyond the row end are handled like filled cells
+		Last_Lanes = CANDIDATES_SSE4_COMPARE_GREATER(CANDIDATES_SSE4_BROADCAST(Size % CANDIDATES_SSE4_LANES_COUNT), CANDIDATES_SSE4_LANES_INDEXES);
+		
+		for (Row = 0; Row < Size; Row++)
+		{
+			if (Row_In_Band == Pointer_Grid->Square_Height)
+			{
+				Pointer_Band_Bitmasks += CONFIGURATION_GRID_MAXIMUM_SIZE + CANDIDATES_PADDING_CELLS_COUNT;
+				Row_In_Band = 0;
+			}
+			Row_In_Band++;
+			
+			Bitmasks_Row = CANDIDATES_SSE4_BROADCAST(Pointer_Grid->Bitmask_Rows[Row]);
+			Cell_Index = Row * Size; // The last vector of the previous row may have gone beyond its end
+			
+			for (Column = 0; Column < Size; Column += CANDIDATES_SSE4_LANES_COUNT)
+			{
+				Empty_Cells = CandidatesSSE4LoadEmptyCells(&Pointer_Grid->Cells[Cell_Index]);
+				if (Column + CANDIDATES_SSE4_LANES_COUNT > Size) Empty_Cells = _mm_and_si128(Empty_Cells, Last_Lanes);
+				Candidates = _mm_and_si128(_mm_and_si128(Bitmasks_Row, _mm_loadu_si128((const __m128i *) &Pointer_Band_Bitmasks[Column])), Empty_Cells);
+				_mm_storeu_si128((__m128i *) &Pointer_Candidates->Cells_Candidates[Cell_Index], Candidates);
+				
+				Counts = CandidatesSSE4CountBits(Candidates);
+				CandidatesSSE4StoreCounts(&Pointer_Candidates->Cells_Candidates_Count[Cell_Index], Counts);
+				
+				Contradictions = _mm_or_si128(Contradictions, _mm_and_si128(Empty_Cells, CANDIDATES_SSE4_COMPARE_EQUAL(Counts, Zero)));
+				
+				Lanes_Mask = CANDIDATES_SSE4_GET_LANES_MASK(CANDIDATES_SSE4_COMPARE_EQUAL(Counts, One));
+				while (Lanes_Mask != 0)
+				{
+					Pointer_Candidates->Naked_Singles[Pointer_Candidates->Naked_Singles_Count] = Cell_Index + __builtin_ctz(Lanes_Mask);
+					Pointer_Candidates->Naked_Singles_Count++;
+					Lanes_Mask &= Lanes_Mask - 1;
+				}
+				Cell_Index += CANDIDATES_SSE4_LANES_COUNT;
+			}
+		}
+		
+		if (!_mm_testz_si128(Contradictions, Contradictions)) return -1;
+		return 0;
+	}
+#endif
+
+/** Tell whether the processor can run an instruction set.
+ * @param Instruction_Set The instruction set (it can't be CANDIDATES_INSTRUCTION_SET_AUTOMATIC).
+ * @return 1 if the instruction set is supported or 0 if not.
+ */
+static int CandidatesIsInstructionSetSupported(int Instruction_Set)
+{
+	switch (Instruction_Set)
+	{
+		case CANDIDATES_INSTRUCTION_SET_SCALAR:
+			return 1;
+		
+		#ifdef CANDIDATES_IS_SIMD_AVAILABLE
+			case CANDIDATES_INSTRUCTION_SET_SSE4:
+				__builtin_cpu_init();
+				return __builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt");
+			
+			case CANDIDATES_INSTRUCTION_SET_AVX2:
+				__builtin_cpu_init();
+				return __builtin_cpu_supports("avx2");
+		#endif
+		
+		default:
+			return 0;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int CandidatesSetInstructionSet(int Instruction_Set)
+{
+	// Find the best instruction set the first time it is needed
+	if (Instruction_Set == CANDIDATES_INSTRUCTION_SET_AUTOMATIC)
+	{
+		if (CandidatesIsInstructionSetSupported(CANDIDATES_INSTRUCTION_SET_AVX2)) Instruction_Set = CANDIDATES_INSTRUCTION_SET_AVX2;
+		else if (CandidatesIsInstructionSetSupported(CANDIDATES_INSTRUCTION_SET_SSE4)) Instruction_Set = CANDIDATES_INSTRUCTION_SET_SSE4;
+		else Instruction_Set = CANDIDATES_INSTRUCTION_SET_SCALAR;
+	}
+	else if (!CandidatesIsInstructionSetSupported(Instruction_Set)) return -1;
+	
+	#ifdef CANDIDATES_IS_SIMD_AVAILABLE
+		atomic_store_explicit(&Candidates_Is_Popcnt_Available, __builtin_cpu_supports("popcnt"), memory_order_relaxed);
+	#endif
+	// All threads would select the same instruction set at the same time, so there is no need for a lock
+	atomic_store_explicit(&Candidates_Instruction_Set, Instruction_Set, memory_order_relaxed);
+	return 0;
+}
+
+int CandidatesGetInstructionSet(void)
+{
+	int Instruction_Set;
+	
+	Instruction_Set = atomic_load_explicit(&Candidates_Instruction_Set, memory_order_relaxed);
+	if (Instruction_Set == CANDIDATES_INSTRUCTION_SET_AUTOMATIC)
+	{
+		CandidatesSetInstructionSet(CANDIDATES_INSTRUCTION_SET_AUTOMATIC);
+		Instruction_Set = atomic_load_explicit(&Candidates_Instruction_Set, memory_order_relaxed);
+	}
+	return Instruction_Set;
+}
+
+int CandidatesCompute(TCandidates *Pointer_Candidates, TGrid *Pointer_Grid)
+{
+	switch (CandidatesGetInstructionSet())
+	{
+		#ifdef CANDIDATES_IS_SIMD_AVAILABLE
+			case CANDIDATES_INSTRUCTION_SET_AVX2:
+				return CandidatesComputeAVX2(Pointer_Candidates, Pointer_Grid);
+			
+			case CANDIDATES_INSTRUCTION_SET_SSE4:
+				return CandidatesComputeSSE4(Pointer_Candidates, Pointer_Grid);
+		#endif
+		
+		default:
+			#ifdef CANDIDATES_IS_SIMD_AVAILABLE
+				if (atomic_load_explicit(&Candidates_Is_Popcnt_Available, memory_order_relaxed)) return CandidatesComputeScalarPopcnt(Pointer_Candidates, Pointer_Grid);
+			#endif
+			return CandidatesComputeScalar(Pointer_Candidates, Pointer_Grid);
+	}
+}
@@ -0,0 +1,657 @@
+/** @file Canonical.c
+ * @see Canonical.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Canonical.h>
+#include <string.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** The biggest grids whose canonical form is searched without the pattern, the numbers orders to try grow too fast past this size. */
+#define CANONICAL_NUMBERS_SEARCH_MAXIMUM_SIZE 12
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** The state of a canonical form search. The cells hold 0 for an empty cell and the number plus 1 otherwise, so an empty cell is smaller than any number. The pattern cells hold 0 for an empty cell and 1 otherwise. */
+typedef struct
+{
+	unsigned int Size; //! The grid size.
+	unsigned int Band_Height; //! How many rows a band has.
+	unsigned int Stack_Width; //! How many columns a stack has.
+	int Is_Transposed; //! Set to 1 when the searched cells are the transposed grid.
+	unsigned char Cells[GRID_MAXIMUM_CELLS_COUNT]; //! The searched cells, the grid or its transposition.
+	unsigned char Rows_Class[CONFIGURATION_GRID_MAXIMUM_SIZE]; //! The first row having the same cells as each row.
+	unsigned char Bands_Class[CONFIGURATION_GRID_MAXIMUM_SIZE]; //! The first band having the same cells as each band.
+	unsigned char Columns_Class[CONFIGURATION_GRID_MAXIMUM_SIZE]; //! The first column having the same cells as each column.
+	unsigned char Stacks_Class[CONFIGURATION_GRID_MAXIMUM_SIZE]; //! The first stack having the same cells as each stack.
+	unsigned char Rows[CONFIGURATION_GRID_MAXIMUM_SIZE]; //! The searched cells row placed at each row of the transformed grid.
+	unsigned char Columns[CONFIGURATION_GRID_MAXIMUM_SIZE]; //! The searched cells column placed at each column of the transformed grid, the columns of a run can still be swapped.
+	unsigned char Is_Run_Start[CONFIGURATION_GRID_MAXIMUM_SIZE + 1]; //! Set to 1 when a transformed grid column starts a run, the columns of a run have the same cells in all placed rows so their order is not decided yet. The entry after the last column is always set.
+	unsigned char Is_Row_Used[CONFIGURATION_GRID_MAXIMUM_SIZE]; //! Set to 1 when a row is placed in the transformed grid.
+	unsigned char Is_Stack_Used[CONFIGURATION_GRID_MAXIMUM_SIZE]; //! Set to 1 when a stack is placed in the transformed grid.
+	unsigned char Labels[CONFIGURATION_GRID_MAXIMUM_SIZE + 1]; //! The transformed value of each cell value, 0 for an empty cell and for a number that did not appear yet.
+	unsigned char Labeled_Values[CONFIGURATION_GRID_MAXIMUM_SIZE]; //! The cells values in the order they got their label, to undo the labeling.
+	unsigned int Labels_Count; //! How many numbers got a label.
+	unsigned char Current_Cells[GRID_MAXIMUM_CELLS_COUNT]; //! The transformed grid being built, up to the row being searched.
+	unsigned char Best_Cells[GRID_MAXIMUM_CELLS_COUNT]; //! The smallest transformed grid found so far.
+	int Is_Best_Found; //! Set to 1 when a whole transformed grid was built.
+	int Is_Smaller; //! Set to 1 when the transformed grid being built is already smaller than the best one, until it becomes the best one.
+	int Is_Pattern_Compared; //! Set to 1 when the transformed grids are compared by their pattern first, then by their numbers.
+	int Is_Pattern_Search; //! Set to 1 while the rows are placed by comparing the patterns, the numbers are compared once all rows are placed (the rows are then kept, only the columns of the runs are ordered).
+	unsigned char Current_Pattern_Cells[GRID_MAXIMUM_CELLS_COUNT]; //! The pattern of the transformed grid being built.
+	unsigned char Best_Pattern_Cells[GRID_MAXIMUM_CELLS_COUNT]; //! The pattern of the best grid.
+	int Is_Best_Pattern_Found; //! Set to 1 when a whole pattern was built.
+	int Is_Pattern_Smaller; //! Set to 1 when the pattern being built is already smaller than the best one, until it becomes the best one.
+	TCanonicalTransformation *Pointer_Best_Transformation; //! The transformation giving the best grid.
+} TCanonicalSearch;
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Find the rows, the bands, the columns and the stacks having the same cells, swapping them leaves the searched cells unchanged.
+ * @param Pointer_Search The search.
+ */
+static void CanonicalFindClasses(TCanonicalSearch *Pointer_Search)
+{
+	unsigned int Size = Pointer_Search->Size, Line, Other_Line, Row, i;
+	
+	for (Line = 0; Line < Size; Line++)
+	{
+		Pointer_Search->Rows_Class[Line] = (unsigned char) Line;
+		for (Other_Line = 0; Other_Line < Line; Other_Line++)
+		{
+			if (memcmp(&Pointer_Search->Cells[Line * Size], &Pointer_Search->Cells[Other_Line * Size], Size) == 0)
+			{
+				Pointer_Search->Rows_Class[Line] = (unsigned char) Other_Line;
+				break;
+			}
+		}
+		
+		Pointer_Search->Columns_Class[Line] = (unsigned char) Line;
+		for (Other_Line = 0; Other_Line < Line; Other_Line++)
+		{
+			for (Row = 0; Row < Size; Row++)
+			{
+				if (Pointer_Search->Cells[Row * Size + Line] != Pointer_Search->Cells[Row * Size + Other_Line]) break;
+			}
+			if (Row == Size)
+			{
+				Pointer_Search->Columns_Class[Line] = (unsigned char) Other_Line;
+				break;
+			}
+		}
+	}
+	
+	// The bands and the stacks are the same when their lines are the same in the same order
+	for (Line = 0; Line < Size / Pointer_Search->Band_Height; Line++)
+	{
+		Pointer_Search->Bands_Class[Line] = (unsigned char) Line;
+		for (Other_Line = 0; Other_Line < Line; Other_Line++)
+		{
+			for (i = 0; i < Pointer_Search->Band_Height; i++)
+			{
+				if (Pointer_Search->Rows_Class[Line * Pointer_Search->Band_Height + i] != Pointer_Search->Rows_Class[Other_Line * Pointer_Search->Band_Height + i]) break;
+			}
+			if (i == Pointer_Search->Band_Height)
+			{
+				Pointer_Search->Bands_Class[Line] = (unsigned char) Other_Line;
+				break;
+			}
+		}
+	}
+	for (Line = 0; Line < Size / Pointer_Search->Stack_Width; Line++)
+	{
+		Pointer_Search->Stacks_Class[Line] = (unsigned char) Line;
+		for (Other_Line = 0; Other_Line < Line; Other_Line++)
+		{
+			for (i = 0; i < Pointer_Search->Stack_Width; i++)
+			{
+				if (Pointer_Search->Columns_Class[Line * Pointer_Search->Stack_Width + i] != Pointer_Search->Columns_Class[Other_Line * Pointer_Search->Stack_Width + i]) break;
+			}
+			if (i == Pointer_Search->Stack_Width)
+			{
+				Pointer_Search->Stacks_Class[Line] = (unsigned char) Other_Line;
+				break;
+			}
+		}
+	}
+}
+
+/** Tell whether placing a line would give the same transformed grids than placing an already tried line : both lines have the same cells and are in the same group, or both lines are at the same place of two groups having the same cells.
+ * @param Line The line (a row or a column).
+ * @param Pointer_Tried_Lines The lines already tried at this place.
+ * @param Tried_Lines_Count How many lines were tried.
+ * @param Pointer_Lines_Class The class of each line.
+ * @param Pointer_Groups_Class The class of each group of lines (the bands or the stacks).
+ * @param Group_Size How many lines a group has.
+ * @return 1 if the line needs not to be tried,
+ * @return 0 if the line must be tried.
+ */
+static inline int CanonicalIsLineTried(unsigned int Line, const unsigned char *Pointer_Tried_Lines, unsigned int Tried_Lines_Count, const unsigned char *Pointer_Lines_Class, const unsigned char *Pointer_Groups_Class, unsigned int Group_Size)
+{
+	unsigned int i, Tried_Line;
+	
+	for (i = 0; i < Tried_Lines_Count; i++)
+	{
+		Tried_Line = Pointer_Tried_Lines[i];
+		if (Tried_Line / Group_Size == Line / Group_Size)
+		{
+			if (Pointer_Lines_Class[Tried_Line] == Pointer_Lines_Class[Line]) return 1;
+		}
+		else if ((Pointer_Groups_Class[Tried_Line / Group_Size] == Pointer_Groups_Class[Line / Group_Size]) && (Tried_Line % Group_Size == Line % Group_Size)) return 1;
+	}
+	return 0;
+}
+
+/** Get the transformed value of a cell, a number that did not appear yet gets the next label.
+ * @param Pointer_Search The search.
+ * @param Value The cell value.
+ * @return The transformed value.
+ */
+static inline unsigned char CanonicalLabelCell(TCanonicalSearch *Pointer_Search, unsigned char Value)
+{
+	if ((Value != 0) && (Pointer_Search->Labels[Value] == 0))
+	{
+		Pointer_Search->Labeled_Values[Pointer_Search->Labels_Count] = Value;
+		Pointer_Search->Labels_Count++;
+		Pointer_Search->Labels[Value] = (unsigned char) Pointer_Search->Labels_Count;
+	}
+	return Pointer_Search->Labels[Value];
+}
+
+/** Remove the labels given after a point of the search.
+ * @param Pointer_Search The search.
+ * @param Labels_Count How many labels to keep.
+ */
+static inline void CanonicalUndoLabels(TCanonicalSearch *Pointer_Search, unsigned int Labels_Count)
+{
+	while (Pointer_Search->Labels_Count > Labels_Count)
+	{
+		Pointer_Search->Labels_Count--;
+		Pointer_Search->Labels[Pointer_Search->Labeled_Values[Pointer_Search->Labels_Count]] = 0;
+	}
+}
+
+/** Keep the transformed grid that was just built if it is smaller than the best one.
+ * @param Pointer_Search The search.
+ */
+static void CanonicalKeepGrid(TCanonicalSearch *Pointer_Search)
+{
+	TCanonicalTransformation *Pointer_Transformation = Pointer_Search->Pointer_Best_Transformation;
+	unsigned int Size = Pointer_Search->Size, Value, Missing_Number;
+	
+	// The grids having symmetries of their own are built several times, the first one is kept
+	if (Pointer_Search->Is_Best_Found && !Pointer_Search->Is_Smaller) return;
+	
+	memcpy(Pointer_Search->Best_Cells, Pointer_Search->Current_Cells, Size * Size);
+	Pointer_Transformation->Is_Transposed = Pointer_Search->Is_Transposed;
+	memcpy(Pointer_Transformation->Rows, Pointer_Search->Rows, Size);
+	memcpy(Pointer_Transformation->Columns, Pointer_Search->Columns, Size);
+	
+	// The numbers missing from the grid get the remaining labels
+	Missing_Number = Pointer_Search->Labels_Count;
+	for (Value = 1; Value <= Size; Value++)
+	{
+		if (Pointer_Search->Labels[Value] != 0) Pointer_Transformation->Numbers[Value - 1] = Pointer_Search->Labels[Value] - 1;
+		else
+		{
+			Pointer_Transformation->Numbers[Value - 1] = (unsigned char) Missing_Number;
+			Missing_Number++;
+		}
+	}
+	
+	Pointer_Search->Is_Best_Found = 1;
+	Pointer_Search->Is_Smaller = 0;
+	
+	if (Pointer_Search->Is_Pattern_Compared)
+	{
+		memcpy(Pointer_Search->Best_Pattern_Cells, Pointer_Search->Current_Pattern_Cells, Size * Size);
+		Pointer_Search->Is_Best_Pattern_Found = 1;
+		Pointer_Search->Is_Pattern_Smaller = 0;
+	}
+}
+
+/** Compare the transformed cells (or their pattern during the patterns search) that were just built with the same cells of the best grid, when the transformed grid is not already known to be smaller.
+ * @param Pointer_Search The search.
+ * @param Pointer_Cells The transformed cells.
+ * @param Cell_Index The index of the first transformed cell in the grid.
+ * @param Count How many cells to compare.
+ * @return 1 if the transformed grid is bigger than the best one,
+ * @return 0 if the search must go on.
+ */
+static inline int CanonicalIsBigger(TCanonicalSearch *Pointer_Search, const unsigned char *Pointer_Cells, unsigned int Cell_Index, unsigned int Count)
+{
+	unsigned char *Pointer_Best_Cells;
+	int Comparison, *Pointer_Is_Best_Found, *Pointer_Is_Smaller;
+	
+	if (Pointer_Search->Is_Pattern_Search)
+	{
+		Pointer_Best_Cells = Pointer_Search->Best_Pattern_Cells;
+		Pointer_Is_Best_Found = &Pointer_Search->Is_Best_Pattern_Found;
+		Pointer_Is_Smaller = &Pointer_Search->Is_Pattern_Smaller;
+	}
+	else
+	{
+		Pointer_Best_Cells = Pointer_Search->Best_Cells;
+		Pointer_Is_Best_Found = &Pointer_Search->Is_Best_Found;
+		Pointer_Is_Smaller = &Pointer_Search->Is_Smaller;
+	}
+	if (!*Pointer_Is_Best_Found || *Pointer_Is_Smaller) return 0;
+	
+	Comparison = memcmp(Pointer_Cells, &Pointer_Best_Cells[Cell_Index], Count);
+	if (Comparison > 0) return 1;
+	if (Comparison < 0) *Pointer_Is_Smaller = 1;
+	return 0;
+}
+
+/** Sort the columns of a run in the order giving the smallest transformed cells for a row : the empty cells first, then the numbers that already have a label by increasing label, then the numbers that did not appear yet (they get the next labels whatever their order, they are kept in the run order). During the patterns search, the empty cells come first and the numbers keep the run order.
+ * @param Pointer_Search The search.
+ * @param Row The row of the searched cells.
+ * @param Start The first transformed grid column of the run.
+ * @param End The transformed grid column following the run.
+ * @param Pointer_Sorted_Columns On output, contain the sorted run columns.
+ * @param Pointer_Keys On output, contain the sort key of each sorted column (0 for an empty cell, the label of a number, or the grid size plus 1 for a number without label, or the pattern cell during the patterns search).
+ */
+static inline void CanonicalSortRun(TCanonicalSearch *Pointer_Search, unsigned int Row, unsigned int Start, unsigned int End, unsigned char *Pointer_Sorted_Columns, unsigned char *Pointer_Keys)
+{
+	unsigned int i, j, Count = End - Start;
+	unsigned char Column, Key, Value;
+	
+	// The runs are not wider than a square, an insertion sort is enough and keeps the numbers without label in their order
+	for (i = 0; i < Count; i++)
+	{
+		Column = Pointer_Search->Columns[Start + i];
+		Value = Pointer_Search->Cells[Row * Pointer_Search->Size + Column];
+		if (Value == 0) Key = 0;
+		else if (Pointer_Search->Is_Pattern_Search) Key = 1;
+		else if (Pointer_Search->Labels[Value] != 0) Key = Pointer_Search->Labels[Value];
+		else Key = (unsigned char) (Pointer_Search->Size + 1);
+		
+		for (j = i; (j > 0) && (Pointer_Keys[j - 1] > Key); j--)
+		{
+			Pointer_Sorted_Columns[j] = Pointer_Sorted_Columns[j - 1];
+			Pointer_Keys[j] = Pointer_Keys[j - 1];
+		}
+		Pointer_Sorted_Columns[j] = Column;
+		Pointer_Keys[j] = Key;
+	}
+}
+
+/** Build the smallest transformed row (or pattern row during the patterns search) a row can give with the placed columns. The numbers that did not appear yet get labels, the caller must remove them.
+ * @param Pointer_Search The search.
+ * @param Row The row of the searched cells.
+ * @param Pointer_Transformed_Cells On output, contain the transformed row cells.
+ */
+static void CanonicalTransformRow(TCanonicalSearch *Pointer_Search, unsigned int Row, unsigned char *Pointer_Transformed_Cells)
+{
+	unsigned char Sorted_Columns[CONFIGURATION_GRID_MAXIMUM_SIZE], Keys[CONFIGURATION_GRID_MAXIMUM_SIZE], *Pointer_Row_Cells = &Pointer_Search->Cells[Row * Pointer_Search->Size];
+	unsigned int Start, End, Empty_Cells_Count, i;
+	
+	for (Start = 0; Start < Pointer_Search->Size; Start = End)
+	{
+		for (End = Start + 1; !Pointer_Search->Is_Run_Start[End]; End++);
+		if (End - Start == 1)
+		{
+			if (Pointer_Search->Is_Pattern_Search) Pointer_Transformed_Cells[Start] = Pointer_Row_Cells[Pointer_Search->Columns[Start]] != 0;
+			else Pointer_Transformed_Cells[Start] = CanonicalLabelCell(Pointer_Search, Pointer_Row_Cells[Pointer_Search->Columns[Start]]);
+			continue;
+		}
+		
+		// The pattern of a run only depends on its empty cells count
+		if (Pointer_Search->Is_Pattern_Search)
+		{
+			Empty_Cells_Count = 0;
+			for (i = Start; i < End; i++) Empty_Cells_Count += Pointer_Row_Cells[Pointer_Search->Columns[i]] == 0;
+			memset(&Pointer_Transformed_Cells[Start], 0, Empty_Cells_Count);
+			memset(&Pointer_Transformed_Cells[Start + Empty_Cells_Count], 1, End - Start - Empty_Cells_Count);
+			continue;
+		}
+		
+		CanonicalSortRun(Pointer_Search, Row, Start, End, Sorted_Columns, Keys);
+		for (i = 0; i < End - Start; i++) Pointer_Transformed_Cells[Start + i] = CanonicalLabelCell(Pointer_Search, Pointer_Row_Cells[Sorted_Columns[i]]);
+	}
+}
+
+static void CanonicalSearchRow(TCanonicalSearch *Pointer_Search, unsigned int Transformed_Row);
+
+/** Try all orders of the columns whose numbers appear for the first time in a run of the row that was just placed, each order gives other labels to these numbers. The rows following the placed row are then searched.
+ * @param Pointer_Search The search.
+ * @param Transformed_Row The placed row.
+ * @param Pointer_Blocks_Start The first column of each group of such columns.
+ * @param Pointer_Blocks_Length How many columns each group has.
+ * @param Blocks_Count How many groups there are.
+ * @param Block_Index The group being ordered.
+ * @param Column The column of the group to choose.
+ */
+static void CanonicalOrderNewNumbers(TCanonicalSearch *Pointer_Search, unsigned int Transformed_Row, const unsigned char *Pointer_Blocks_Start, const unsigned char *Pointer_Blocks_Length, unsigned int Blocks_Count, unsigned int Block_Index, unsigned int Column)
+{
+	unsigned int Block_End, Labels_Count, i;
+	unsigned char Swapped_Column, *Pointer_Row_Cells;
+	
+	// All orders are chosen, give the labels
+	if (Block_Index == Blocks_Count)
+	{
+		Labels_Count = Pointer_Search->Labels_Count;
+		Pointer_Row_Cells = &Pointer_Search->Cells[Pointer_Search->Rows[Transformed_Row] * Pointer_Search->Size];
+		for (i = 0; i < Pointer_Search->Size; i++) CanonicalLabelCell(Pointer_Search, Pointer_Row_Cells[Pointer_Search->Columns[i]]);
+		CanonicalSearchRow(Pointer_Search, Transformed_Row + 1);
+		CanonicalUndoLabels(Pointer_Search, Labels_Count);
+		return;
+	}
+	
+	Block_End = Pointer_Blocks_Start[Block_Index] + Pointer_Blocks_Length[Block_Index];
+	if (Column == Block_End - 1)
+	{
+		if (Block_Index + 1 < Blocks_Count) Column = Pointer_Blocks_Start[Block_Index + 1];
+		CanonicalOrderNewNumbers(Pointer_Search, Transformed_Row, Pointer_Blocks_Start, Pointer_Blocks_Length, Blocks_Count, Block_Index + 1, Column);
+		return;
+	}
+	
+	for (i = Column; i < Block_End; i++)
+	{
+		Swapped_Column = Pointer_Search->Columns[Column];
+		Pointer_Search->Columns[Column] = Pointer_Search->Columns[i];
+		Pointer_Search->Columns[i] = Swapped_Column;
+		CanonicalOrderNewNumbers(Pointer_Search, Transformed_Row, Pointer_Blocks_Start, Pointer_Blocks_Length, Blocks_Count, Block_Index, Column + 1);
+		Pointer_Search->Columns[i] = Pointer_Search->Columns[Column];
+		Pointer_Search->Columns[Column] = Swapped_Column;
+	}
+}
+
+/** Place a row of the transformed grid : the runs are split so their columns give the smallest transformed row, then the orders of the numbers appearing for the first time are tried (the numbers stay in runs during the patterns search).
+ * @param Pointer_Search The search.
+ * @param Transformed_Row The transformed grid row.
+ * @param Row The placed row of the searched cells.
+ */
+static void CanonicalPlaceRow(TCanonicalSearch *Pointer_Search, unsigned int Transformed_Row, unsigned int Row)
+{
+	unsigned char Saved_Columns[CONFIGURATION_GRID_MAXIMUM_SIZE], Saved_Is_Run_Start[CONFIGURATION_GRID_MAXIMUM_SIZE + 1], Keys[CONFIGURATION_GRID_MAXIMUM_SIZE], Blocks_Start[CONFIGURATION_GRID_MAXIMUM_SIZE], Blocks_Length[CONFIGURATION_GRID_MAXIMUM_SIZE];
+	unsigned int Size = Pointer_Search->Size, Start, End, Blocks_Count = 0, New_Numbers_Count, i;
+	unsigned char Is_Row_Used = Pointer_Search->Is_Row_Used[Row];
+	
+	memcpy(Saved_Columns, Pointer_Search->Columns, Size);
+	memcpy(Saved_Is_Run_Start, Pointer_Search->Is_Run_Start, Size);
+	
+	// The empty cells stay in a run, each number gets its own column
+	for (Start = 0; Start < Size; Start = End)
+	{
+		for (End = Start + 1; !Pointer_Search->Is_Run_Start[End]; End++);
+		if (End - Start == 1) continue;
+		
+		CanonicalSortRun(Pointer_Search, Row, Start, End, &Pointer_Search->Columns[Start], Keys);
+		New_Numbers_Count = 0;
+		for (i = 0; i < End - Start; i++)
+		{
+			Pointer_Search->Is_Run_Start[Start + i] = (i == 0) || (Keys[i] != Keys[i - 1]) || (Keys[i] == Size + 1);
+			if (Keys[i] == Size + 1) New_Numbers_Count++;
+		}
+		if (New_Numbers_Count > 1)
+		{
+			Blocks_Start[Blocks_Count] = (unsigned char) (End - New_Numbers_Count);
+			Blocks_Length[Blocks_Count] = (unsigned char) New_Numbers_Count;
+			Blocks_Count++;
+		}
+	}
+	
+	// The rows placed by the patterns search are already used when their numbers are compared
+	Pointer_Search->Rows[Transformed_Row] = (unsigned char) Row;
+	Pointer_Search->Is_Row_Used[Row] = 1;
+	if (Pointer_Search->Is_Pattern_Search) CanonicalSearchRow(Pointer_Search, Transformed_Row + 1);
+	else if (Blocks_Count == 0) CanonicalOrderNewNumbers(Pointer_Search, Transformed_Row, Blocks_Start, Blocks_Length, 0, 0, 0);
+	else CanonicalOrderNewNumbers(Pointer_Search, Transformed_Row, Blocks_Start, Blocks_Length, Blocks_Count, 0, Blocks_Start[0]);
+	Pointer_Search->Is_Row_Used[Row] = Is_Row_Used;
+	
+	memcpy(Pointer_Search->Columns, Saved_Columns, Size);
+	memcpy(Pointer_Search->Is_Run_Start, Saved_Is_Run_Start, Size);
+}
+
+/** Place the rows of the transformed grid from a row to the last one, the first row and the stacks are already placed.
+ * @param Pointer_Search The search.
+ * @param Transformed_Row The row to place.
+ */
+static void CanonicalSearchRow(TCanonicalSearch *Pointer_Search, unsigned int Transformed_Row)
+{
+	unsigned char Row_Cells[CONFIGURATION_GRID_MAXIMUM_SIZE], Candidate_Rows[CONFIGURATION_GRID_MAXIMUM_SIZE], Tried_Rows[CONFIGURATION_GRID_MAXIMUM_SIZE], *Pointer_Smallest_Cells;
+	unsigned int Size = Pointer_Search->Size, First_Row, Last_Row, Row, Candidate_Rows_Count = 0, Tried_Rows_Count = 0, Labels_Count = Pointer_Search->Labels_Count, i;
+	int Comparison, Is_Row_Placed;
+	
+	if (Transformed_Row == Size)
+	{
+		if (!Pointer_Search->Is_Pattern_Search)
+		{
+			CanonicalKeepGrid(Pointer_Search);
+			return;
+		}
+		
+		// Compare the numbers of the grids having the smallest pattern, a smaller pattern makes the best grid obsolete
+		if (!Pointer_Search->Is_Best_Pattern_Found || Pointer_Search->Is_Pattern_Smaller) Pointer_Search->Is_Best_Found = 0;
+		Pointer_Search->Is_Pattern_Search = 0;
+		CanonicalSearchRow(Pointer_Search, 0);
+		Pointer_Search->Is_Pattern_Search = 1;
+		return;
+	}
+	
+	// The rows are kept when the numbers are compared after the patterns
+	Is_Row_Placed = Pointer_Search->Is_Pattern_Compared && !Pointer_Search->Is_Pattern_Search;
+	if (Is_Row_Placed)
+	{
+		First_Row = Pointer_Search->Rows[Transformed_Row];
+		Last_Row = First_Row + 1;
+	}
+	// A band starts with any row of the remaining bands, its next rows are the remaining rows of the same band
+	else if (Transformed_Row % Pointer_Search->Band_Height == 0)
+	{
+		First_Row = 0;
+		Last_Row = Size;
+	}
+	else
+	{
+		First_Row = Pointer_Search->Rows[Transformed_Row - 1] - Pointer_Search->Rows[Transformed_Row - 1] % Pointer_Search->Band_Height;
+		Last_Row = First_Row + Pointer_Search->Band_Height;
+	}
+	
+	// Keep the rows giving the smallest transformed row
+	if (Pointer_Search->Is_Pattern_Search) Pointer_Smallest_Cells = &Pointer_Search->Current_Pattern_Cells[Transformed_Row * Size];
+	else Pointer_Smallest_Cells = &Pointer_Search->Current_Cells[Transformed_Row * Size];
+	for (Row = First_Row; Row < Last_Row; Row++)
+	{
+		if (Pointer_Search->Is_Row_Used[Row] && !Is_Row_Placed) continue;
+		
+		CanonicalTransformRow(Pointer_Search, Row, Row_Cells);
+		CanonicalUndoLabels(Pointer_Search, Labels_Count);
+		
+		if (Candidate_Rows_Count == 0) Comparison = -1;
+		else Comparison = memcmp(Row_Cells, Pointer_Smallest_Cells, Size);
+		if (Comparison < 0)
+		{
+			memcpy(Pointer_Smallest_Cells, Row_Cells, Size);
+			Candidate_Rows_Count = 0;
+		}
+		if (Comparison <= 0)
+		{
+			Candidate_Rows[Candidate_Rows_Count] = (unsigned char) Row;
+			Candidate_Rows_Count++;
+		}
+	}
+	if (CanonicalIsBigger(Pointer_Search, Pointer_Smallest_Cells, Transformed_Row * Size, Size)) return;
+	
+	for (i = 0; i < Candidate_Rows_Count; i++)
+	{
+		Row = Candidate_Rows[i];
+		if (CanonicalIsLineTried(Row, Tried_Rows, Tried_Rows_Count, Pointer_Search->Rows_Class, Pointer_Search->Bands_Class, Pointer_Search->Band_Height)) continue;
+		Tried_Rows[Tried_Rows_Count] = (unsigned char) Row;
+		Tried_Rows_Count++;
+		
+		CanonicalPlaceRow(Pointer_Search, Transformed_Row, Row);
+	}
+}
+
+/** Place the stacks of the transformed grid from a stack to the last one, the stacks having the most empty cells in the first row come first. The first row is then placed.
+ * @param Pointer_Search The search.
+ * @param First_Row The searched cells row placed first.
+ * @param Transformed_Stack The stack to place.
+ */
+static void CanonicalSearchStack(TCanonicalSearch *Pointer_Search, unsigned int First_Row, unsigned int Transformed_Stack)
+{
+	unsigned char Candidate_Stacks[CONFIGURATION_GRID_MAXIMUM_SIZE], Tried_Stacks[CONFIGURATION_GRID_MAXIMUM_SIZE], *Pointer_Row_Cells = &Pointer_Search->Cells[First_Row * Pointer_Search->Size], *Pointer_Transformed_Cells;
+	unsigned int Size = Pointer_Search->Size, Stack_Width = Pointer_Search->Stack_Width, Stack, Column, Empty_Cells_Count, Most_Empty_Cells_Count = 0, Candidate_Stacks_Count = 0, Tried_Stacks_Count = 0, Labels_Count, i;
+	
+	// All stacks are placed, each stack is a run until the first row is placed
+	if (Transformed_Stack == Size / Stack_Width)
+	{
+		for (Column = 0; Column < Size; Column++) Pointer_Search->Is_Run_Start[Column] = Column % Stack_Width == 0;
+		
+		if (Pointer_Search->Is_Pattern_Search) Pointer_Transformed_Cells = Pointer_Search->Current_Pattern_Cells;
+		else Pointer_Transformed_Cells = Pointer_Search->Current_Cells;
+		Labels_Count = Pointer_Search->Labels_Count;
+		CanonicalTransformRow(Pointer_Search, First_Row, Pointer_Transformed_Cells);
+		CanonicalUndoLabels(Pointer_Search, Labels_Count);
+		if (CanonicalIsBigger(Pointer_Search, Pointer_Transformed_Cells, 0, Size)) return;
+		
+		CanonicalPlaceRow(Pointer_Search, 0, First_Row);
+		return;
+	}
+	
+	for (Stack = 0; Stack < Size / Stack_Width; Stack++)
+	{
+		if (Pointer_Search->Is_Stack_Used[Stack]) continue;
+		
+		Empty_Cells_Count = 0;
+		for (Column = Stack * Stack_Width; Column < (Stack + 1) * Stack_Width; Column++) Empty_Cells_Count += Pointer_Row_Cells[Column] == 0;
+		
+		if ((Candidate_Stacks_Count == 0) || (Empty_Cells_Count > Most_Empty_Cells_Count))
+		{
+			Most_Empty_Cells_Count = Empty_Cells_Count;
+			Candidate_Stacks_Count = 0;
+		}
+		if (Empty_Cells_Count == Most_Empty_Cells_Count)
+		{
+			Candidate_Stacks[Candidate_Stacks_Count] = (unsigned char) Stack;
+			Candidate_Stacks_Count++;
+		}
+	}
+	
+	for (i = 0; i < Candidate_Stacks_Count; i++)
+	{
+		Stack = Candidate_Stacks[i];
+		if (CanonicalIsLineTried(Stack, Tried_Stacks, Tried_Stacks_Count, Pointer_Search->Stacks_Class, Pointer_Search->Stacks_Class, Size)) continue;
+		Tried_Stacks[Tried_Stacks_Count] = (unsigned char) Stack;
+		Tried_Stacks_Count++;
+		
+		for (Column = 0; Column < Stack_Width; Column++) Pointer_Search->Columns[Transformed_Stack * Stack_Width + Column] = (unsigned char) (Stack * Stack_Width + Column);
+		Pointer_Search->Is_Stack_Used[Stack] = 1;
+		CanonicalSearchStack(Pointer_Search, First_Row, Transformed_Stack + 1);
+		Pointer_Search->Is_Stack_Used[Stack] = 0;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int CanonicalGetForm(TGrid *Pointer_Grid, TGrid *Pointer_Canonical_Grid, TCanonicalTransformation *Pointer_Transformation)
+{
+	TCanonicalSearch Search;
+	unsigned char Tried_Rows[CONFIGURATION_GRID_MAXIMUM_SIZE];
+	unsigned int Size = Pointer_Grid->Size, Row, Column, Orientations_Count, Tried_Rows_Count, Empty_Cells_Count = 0, i;
+	int Value;
+	
+	Search.Size = Size;
+	Search.Is_Best_Found = 0;
+	Search.Is_Smaller = 0;
+	Search.Is_Best_Pattern_Found = 0;
+	Search.Is_Pattern_Smaller = 0;
+	Search.Pointer_Best_Transformation = Pointer_Transformation;
+	
+	// The pattern tells the rows and the columns apart without trying the numbers orders, but the patterns of the grids with very few empty cells are almost all the same
+	for (i = 0; i < Size * Size; i++) Empty_Cells_Count += Pointer_Grid->Cells[i] == GRID_EMPTY_CELL_VALUE;
+	Search.Is_Pattern_Compared = Empty_Cells_Count >= Size;
+	if (!Search.Is_Pattern_Compared && (Size > CANONICAL_NUMBERS_SEARCH_MAXIMUM_SIZE)) return -1;
+	Search.Is_Pattern_Search = Search.Is_Pattern_Compared;
+	
+	// A transposed grid keeps its squares shape only when the squares are square
+	if (Pointer_Grid->Square_Width == Pointer_Grid->Square_Height) Orientations_Count = 2;
+	else Orientations_Count = 1;
+	
+	for (Search.Is_Transposed = 0; Search.Is_Transposed < (int) Orientations_Count; Search.Is_Transposed++)
+	{
+		Search.Band_Height = Pointer_Grid->Square_Height;
+		Search.Stack_Width = Pointer_Grid->Square_Width;
+		for (Row = 0; Row < Size; Row++)
+		{
+			for (Column = 0; Column < Size; Column++)
+			{
+				if (Search.Is_Transposed) Value = Pointer_Grid->Cells[Column * Size + Row];
+				else Value = Pointer_Grid->Cells[Row * Size + Column];
+				if (Value == GRID_EMPTY_CELL_VALUE) Search.Cells[Row * Size + Column] = 0;
+				else Search.Cells[Row * Size + Column] = (unsigned char) (Value + 1);
+			}
+		}
+		CanonicalFindClasses(&Search);
+		
+		memset(Search.Is_Row_Used, 0, sizeof(Search.Is_Row_Used));
+		memset(Search.Is_Stack_Used, 0, sizeof(Search.Is_Stack_Used));
+		Search.Is_Run_Start[Size] = 1;
+		memset(Search.Labels, 0, sizeof(Search.Labels));
+		Search.Labels_Count = 0;
+		
+		// Any row can become the first row
+		Tried_Rows_Count = 0;
+		for (Row = 0; Row < Size; Row++)
+		{
+			if (CanonicalIsLineTried(Row, Tried_Rows, Tried_Rows_Count, Search.Rows_Class, Search.Bands_Class, Search.Band_Height)) continue;
+			Tried_Rows[Tried_Rows_Count] = (unsigned char) Row;
+			Tried_Rows_Count++;
+			
+			CanonicalSearchStack(&Search, Row, 0);
+		}
+	}
+	
+	for (i = 0; i < Size * Size; i++)
+	{
+		if (Search.Best_Cells[i] == 0) Pointer_Canonical_Grid->Cells[i] = GRID_EMPTY_CELL_VALUE;
+		else Pointer_Canonical_Grid->Cells[i] = Search.Best_Cells[i] - 1;
+	}
+	GridLoadFromCells(Pointer_Canonical_Grid, Size);
+	return 0;
+}
+
+void CanonicalTransformGrid(TGrid *Pointer_Grid, TCanonicalTransformation *Pointer_Transformation, TGrid *Pointer_Transformed_Grid)
+{
+	unsigned int Size = Pointer_Grid->Size, Row, Column;
+	int Value;
+	
+	for (Row = 0; Row < Size; Row++)
+	{
+		for (Column = 0; Column < Size; Column++)
+		{
+			if (Pointer_Transformation->Is_Transposed) Value = Pointer_Grid->Cells[Pointer_Transformation->Columns[Column] * Size + Pointer_Transformation->Rows[Row]];
+			else Value = Pointer_Grid->Cells[Pointer_Transformation->Rows[Row] * Size + Pointer_Transformation->Columns[Column]];
+			if (Value != GRID_EMPTY_CELL_VALUE) Value = Pointer_Transformation->Numbers[Value];
+			Pointer_Transformed_Grid->Cells[Row * Size + Column] = Value;
+		}
+	}
+	GridLoadFromCells(Pointer_Transformed_Grid, Size);
+}
+
+void CanonicalRestoreGrid(TGrid *Pointer_Transformed_Grid, TCanonicalTransformation *Pointer_Transformation, TGrid *Pointer_Grid)
+{
+	unsigned char Original_Numbers[CONFIGURATION_GRID_MAXIMUM_SIZE] = {0};
+	unsigned int Size = Pointer_Transformed_Grid->Size, Row, Column, Number;
+	int Value;
+	
+	for (Number = 0; Number < Size; Number++) Original_Numbers[Pointer_Transformation->Numbers[Number]] = (unsigned char) Number;
+	
+	for (Row = 0; Row < Size; Row++)
+	{
+		for (Column = 0; Column < Size; Column++)
+		{
+			Value = Pointer_Transformed_Grid->Cells[Row * Size + Column];
+			if (Value != GRID_EMPTY_CELL_VALUE) Value = Original_Numbers[Value];
+			if (Pointer_Transformation->Is_Transposed) Pointer_Grid->Cells[Pointer_Transformation->Columns[Column] * Size + Pointer_Transformation->Rows[Row]] = Value;
+			else Pointer_Grid->Cells[Pointer_Transformation->Rows[Row] * Size + Pointer_Transformation->Columns[Column]] = Value;
+		}
+	}
+	GridLoadFromCells(Pointer_Grid, Size);
+}
@@ -0,0 +1,16 @@
+/** @file Cells_Buckets.c
+ * @see Cells_Buckets.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Cells_Buckets.h>
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+void CellsBucketsInitialize(TCellsBuckets *Pointer_Buckets)
+{
+	int i;
+	
+	for (i = 0; i < CELLS_BUCKETS_COUNT; i++) Pointer_Buckets->Buckets_Head[i] = CELLS_BUCKETS_NO_CELL;
+	Pointer_Buckets->Indexed_Cells_Count = 0;
+}
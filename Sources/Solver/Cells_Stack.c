@@ -4,94 +4,68 @@
  */
 #include <assert.h>
 #include <Cells_Stack.h>
-#include <Configuration.h>
 #include <stdio.h>
 
-//-------------------------------------------------------------------------------------------------
-// Private constants
-//-------------------------------------------------------------------------------------------------
-/** How many elements the stack can hold. */
-#define CELLS_STACK_SIZE (CONFIGURATION_GRID_MAXIMUM_SIZE * CONFIGURATION_GRID_MAXIMUM_SIZE)
-
-//-------------------------------------------------------------------------------------------------
-// Private types
-//-------------------------------------------------------------------------------------------------
-/** A cell coordinates. */
-typedef struct
-{
-	int Row; //! The cell row coordinate.
-	int Column; //! The cell column coordinate.
-} TCellCoordinates;
-
-//-------------------------------------------------------------------------------------------------
-// Private variables
-//-------------------------------------------------------------------------------------------------
-/** The stack content. */
-static TCellCoordinates Stack[CELLS_STACK_SIZE];
-
-/** The stack pointer. This is a fully ascending stack. */
-static int Stack_Pointer;
-
 //-------------------------------------------------------------------------------------------------
 // Private functions
 //-------------------------------------------------------------------------------------------------
 #ifdef DEBUG
-	static void CellsStackShow(void)
+	static void CellsStackShow(TCellsStack *Pointer_Stack)
 	{
 		int i;
 		
-		printf("Count = %d\n", Stack_Pointer);
-		for (i = Stack_Pointer - 1; i >= 0; i--) printf("Row = %d, Column = %d\n", Stack[i].Row, Stack[i].Column);
+		printf("Count = %d\n", Pointer_Stack->Pointer);
+		for (i = Pointer_Stack->Pointer - 1; i >= 0; i--) printf("Row = %d, Column = %d\n", Pointer_Stack->Cells[i].Row, Pointer_Stack->Cells[i].Column);
 	}
 #endif
 
 //-------------------------------------------------------------------------------------------------
 // Public functions
 //-------------------------------------------------------------------------------------------------
-void CellsStackInitialize(void)
+void CellsStackInitialize(TCellsStack *Pointer_Stack)
 {
-	Stack_Pointer = 0;
+	Pointer_Stack->Pointer = 0;
 }
 
-void CellsStackPush(int Cell_Row, int Cell_Column)
+void CellsStackPush(TCellsStack *Pointer_Stack, int Cell_Row, int Cell_Column)
 {
 	TCellCoordinates *Pointer_Cell_Coordinates;
 	
-	assert(Stack_Pointer < CELLS_STACK_SIZE);
+	assert(Pointer_Stack->Pointer < CELLS_STACK_SIZE);
 	
 	// Cache coordinates address
-	Pointer_Cell_Coordinates = &Stack[Stack_Pointer];
+	Pointer_Cell_Coordinates = &Pointer_Stack->Cells[Pointer_Stack->Pointer];
 	Pointer_Cell_Coordinates->Row = Cell_Row;
 	Pointer_Cell_Coordinates->Column = Cell_Column;
-	Stack_Pointer++;
+	Pointer_Stack->Pointer++;
 	
 	#ifdef DEBUG
 		printf("[%s] ", __FUNCTION__);
-		CellsStackShow();
+		CellsStackShow(Pointer_Stack);
 	#endif
 }
 
-int CellsStackReadTop(int *Pointer_Cell_Row, int *Pointer_Cell_Column)
+int CellsStackReadTop(TCellsStack *Pointer_Stack, int *Pointer_Cell_Row, int *Pointer_Cell_Column)
 {
 	TCellCoordinates *Pointer_Cell_Coordinates;
 	
-	if (Stack_Pointer <= 0) return 0;
+	if (Pointer_Stack->Pointer <= 0) return 0;
 	
 	// Cache coordinates address
-	Pointer_Cell_Coordinates = &Stack[Stack_Pointer - 1];
+	Pointer_Cell_Coordinates = &Pointer_Stack->Cells[Pointer_Stack->Pointer - 1];
 	*Pointer_Cell_Row = Pointer_Cell_Coordinates->Row;
 	*Pointer_Cell_Column = Pointer_Cell_Coordinates->Column;
 	
 	#ifdef DEBUG
 		printf("[%s] ", __FUNCTION__);
-		CellsStackShow();
+		CellsStackShow(Pointer_Stack);
 	#endif
 	return 1;
 }
 
-void CellsStackRemoveTop(void)
+void CellsStackRemoveTop(TCellsStack *Pointer_Stack)
 {
-	assert(Stack_Pointer > 0);
+	assert(Pointer_Stack->Pointer > 0);
 	
-	Stack_Pointer--;
+	Pointer_Stack->Pointer--;
 }
@@ -0,0 +1,178 @@
+/** @file Checkpoint.c
+ * @see Checkpoint.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Checkpoint.h>
+#include <Clock.h>
+#include <Solver.h>
+#include <stdio.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** The size of the buffer used to copy the pending grids. */
+#define CHECKPOINT_COPY_BUFFER_SIZE 65536
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Copy the pending grids to the checkpoint, the pending grids file is left where it was.
+ * @param Pending_Grids_File The pending grids.
+ * @param File The checkpoint.
+ * @return 0 if the grids were copied,
+ * @return -1 if a file could not be read or written.
+ */
+static int CheckpointCopyPendingGrids(FILE *Pending_Grids_File, FILE *File)
+{
+	static char Buffer[CHECKPOINT_COPY_BUFFER_SIZE];
+	long Position;
+	size_t Size;
+	int Result = 0;
+	
+	Position = ftell(Pending_Grids_File);
+	if (Position < 0) return -1;
+	
+	while ((Size = fread(Buffer, 1, sizeof(Buffer), Pending_Grids_File)) > 0)
+	{
+		if (fwrite(Buffer, 1, Size, File) != Size)
+		{
+			Result = -1;
+			break;
+		}
+	}
+	if (ferror(Pending_Grids_File)) Result = -1;
+	
+	clearerr(Pending_Grids_File);
+	if (fseek(Pending_Grids_File, Position, SEEK_SET) != 0) return -1;
+	return Result;
+}
+
+/** Write a checkpoint to a temporary file, then replace the previous checkpoint by it, so a checkpoint is never lost if the program is stopped while writing.
+ * @param Pointer_Checkpoint The checkpointed solving.
+ * @param Pointer_Solver The solver context, its search state is consistent.
+ * @return 0 if the checkpoint was written,
+ * @return -1 if the checkpoint could not be written.
+ */
+static int CheckpointWrite(TCheckpoint *Pointer_Checkpoint, TSolver *Pointer_Solver)
+{
+	char String_Temporary_File_Name[FILENAME_MAX];
+	FILE *File;
+	int Result;
+	
+	snprintf(String_Temporary_File_Name, sizeof(String_Temporary_File_Name), "%s.tmp", Pointer_Checkpoint->String_File_Name);
+	File = fopen(String_Temporary_File_Name, "w");
+	if (File == NULL) return -1;
+	
+	Result = SolverWriteCheckpoint(Pointer_Solver, File);
+	if ((Result == 0) && (Pointer_Checkpoint->Pending_Grids_File != NULL)) Result = CheckpointCopyPendingGrids(Pointer_Checkpoint->Pending_Grids_File, File);
+	if (fclose(File) != 0) Result = -1;
+	
+	if ((Result == 0) && (rename(String_Temporary_File_Name, Pointer_Checkpoint->String_File_Name) == 0))
+	{
+		Pointer_Checkpoint->Checkpoints_Count++;
+		return 0;
+	}
+	remove(String_Temporary_File_Name);
+	return -1;
+}
+
+/** The solver checkpoint callback, it writes a checkpoint when the period is elapsed, when a checkpoint is requested or when the search stops.
+ * @param Pointer_Argument The checkpointed solving.
+ * @param Pointer_Solver The solver context.
+ * @param Is_Search_Stopping Set to 1 when the search is about to stop.
+ */
+static void CheckpointPoll(void *Pointer_Argument, TSolver *Pointer_Solver, int Is_Search_Stopping)
+{
+	TCheckpoint *Pointer_Checkpoint = Pointer_Argument;
+	unsigned long long Current_Time;
+	int Is_Requested = 0;
+	
+	// Clear the request even if a checkpoint is due anyway, so a single checkpoint is written
+	if (Pointer_Checkpoint->Pointer_Request_Flag != NULL) Is_Requested = atomic_exchange(Pointer_Checkpoint->Pointer_Request_Flag, 0);
+	
+	Current_Time = ClockGetTime();
+	if (!Is_Search_Stopping && !Is_Requested && (Current_Time < Pointer_Checkpoint->Next_Checkpoint_Time)) return;
+	
+	Pointer_Checkpoint->Is_Write_Failed = CheckpointWrite(Pointer_Checkpoint, Pointer_Solver) != 0;
+	Pointer_Checkpoint->Next_Checkpoint_Time = Current_Time + Pointer_Checkpoint->Period * 1000;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+void CheckpointInitialize(TCheckpoint *Pointer_Checkpoint, char *String_File_Name, unsigned long long Period, atomic_int *Pointer_Request_Flag)
+{
+	Pointer_Checkpoint->String_File_Name = String_File_Name;
+	Pointer_Checkpoint->Period = Period;
+	Pointer_Checkpoint->Pointer_Request_Flag = Pointer_Request_Flag;
+	Pointer_Checkpoint->Pending_Grids_File = NULL;
+	Pointer_Checkpoint->Checkpoints_Count = 0;
+	Pointer_Checkpoint->Is_Write_Failed = 0;
+}
+
+int CheckpointSolve(TCheckpoint *Pointer_Checkpoint, TSolver *Pointer_Solver, FILE *Pending_Grids_File)
+{
+	TSolverStatistics Statistics = {0, 0, 0, 0};
+	int Result;
+	unsigned long long Current_Time, Deadline = 0, Time_Limit = Pointer_Solver->Time_Limit, Loops_Limit = Pointer_Solver->Loops_Limit;
+	
+	Pointer_Checkpoint->Pending_Grids_File = Pending_Grids_File;
+	Current_Time = ClockGetTime();
+	Pointer_Checkpoint->Next_Checkpoint_Time = Current_Time + Pointer_Checkpoint->Period * 1000;
+	if (Time_Limit != 0) Deadline = Current_Time + Time_Limit * 1000;
+	SolverSetCheckpointCallback(Pointer_Solver, CheckpointPoll, Pointer_Checkpoint);
+	
+	while (1)
+	{
+		// The limits apply to the whole solving, so each grid gets what the previous ones left
+		Result = 0;
+		if ((Pointer_Solver->Pointer_Cancellation_Flag != NULL) && atomic_load(Pointer_Solver->Pointer_Cancellation_Flag)) Result = SOLVER_RESULT_CANCELLED;
+		else if (Time_Limit != 0)
+		{
+			Current_Time = ClockGetTime();
+			if (Current_Time + 1000 > Deadline) Result = SOLVER_RESULT_TIMED_OUT;
+			else SolverSetTimeLimit(Pointer_Solver, (Deadline - Current_Time) / 1000);
+		}
+		if ((Result == 0) && (Loops_Limit != 0))
+		{
+			if (Statistics.Loops_Count >= Loops_Limit) Result = SOLVER_RESULT_TIMED_OUT;
+			else SolverSetLoopsLimit(Pointer_Solver, Loops_Limit - Statistics.Loops_Count);
+		}
+		// The loaded grid was not searched yet, so it is saved as is
+		if (Result != 0)
+		{
+			Pointer_Checkpoint->Is_Write_Failed = CheckpointWrite(Pointer_Checkpoint, Pointer_Solver) != 0;
+			break;
+		}
+		
+		Result = SolverSolve(Pointer_Solver);
+		Statistics.Loops_Count += Pointer_Solver->Statistics.Loops_Count;
+		Statistics.Bad_Solutions_Found_Count += Pointer_Solver->Statistics.Bad_Solutions_Found_Count;
+		Statistics.Avoided_Bad_Solutions_Count += Pointer_Solver->Statistics.Avoided_Bad_Solutions_Count;
+		Statistics.Propagated_Cells_Count += Pointer_Solver->Statistics.Propagated_Cells_Count;
+		if ((Result != SOLVER_RESULT_UNSOLVABLE) || (Pending_Grids_File == NULL)) break;
+		
+		// This subtree has no solution, explore the next one
+		Result = SolverLoadFromStream(Pointer_Solver, Pending_Grids_File);
+		if (Result == 1)
+		{
+			Result = SOLVER_RESULT_UNSOLVABLE;
+			break;
+		}
+		if (Result != 0)
+		{
+			Result = -3;
+			break;
+		}
+	}
+	
+	SolverSetCheckpointCallback(Pointer_Solver, NULL, NULL);
+	SolverSetTimeLimit(Pointer_Solver, Time_Limit);
+	SolverSetLoopsLimit(Pointer_Solver, Loops_Limit);
+	Pointer_Checkpoint->Pending_Grids_File = NULL;
+	Pointer_Solver->Statistics = Statistics;
+	
+	// The last checkpoint is useless when the whole search tree was explored
+	if ((Result == SOLVER_RESULT_SOLVED) || (Result == SOLVER_RESULT_UNSOLVABLE)) remove(Pointer_Checkpoint->String_File_Name);
+	return Result;
+}
@@ -0,0 +1,304 @@
+/** @file Corpus.c
+ * @see Corpus.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Candidates.h>
+#include <Corpus.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// The SIMD version is compiled for the x86 processors only, it is built for its instruction set whatever the compiler flags and it is used only when the processor supports it (see Candidates.h)
+#if defined(__x86_64__) || defined(__i386__)
+	#include <immintrin.h>
+	#define CORPUS_IS_SIMD_AVAILABLE
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+#ifdef CORPUS_IS_SIMD_AVAILABLE
+	/** How many characters are converted at once by the SSE4.2 version. */
+	#define CORPUS_SSE4_CHARACTERS_COUNT 16
+	/** The biggest grid the SSE4.2 version can convert, its values are the '0' to '9' digits and the 'A' to 'F' letters. */
+	#define CORPUS_SSE4_MAXIMUM_GRID_SIZE 16
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Read the next line of a mapped file.
+ * @param Pointer_Corpus The mapped file.
+ * @param Pointer_Pointer_Line On output, contain the line first character.
+ * @param Pointer_Length On output, contain the line length without the trailing '\n' and '\r'.
+ * @return 0 if a line was read,
+ * @return -1 if the end of the file was reached.
+ */
+static int CorpusReadNextLine(TCorpus *Pointer_Corpus, const char **Pointer_Pointer_Line, size_t *Pointer_Length)
+{
+	const char *Pointer_Line, *Pointer_Line_End;
+	size_t Length;
+	
+	if (Pointer_Corpus->Offset >= Pointer_Corpus->Size) return -1;
+	Pointer_Line = Pointer_Corpus->Pointer_Data + Pointer_Corpus->Offset;
+	
+	// The last line may have no '\n'
+	Pointer_Line_End = memchr(Pointer_Line, '\n', Pointer_Corpus->Size - Pointer_Corpus->Offset);
+	if (Pointer_Line_End == NULL)
+	{
+		Length = Pointer_Corpus->Size - Pointer_Corpus->Offset;
+		Pointer_Corpus->Offset = Pointer_Corpus->Size;
+	}
+	else
+	{
+		Length = Pointer_Line_End - Pointer_Line;
+		Pointer_Corpus->Offset += Length + 1;
+	}
+	Pointer_Corpus->Line++;
+	
+	// Remove any trailing '\r' (they are present in Windows files)
+	while ((Length > 0) && (Pointer_Line[Length - 1] == '\r')) Length--;
+	
+	*Pointer_Pointer_Line = Pointer_Line;
+	*Pointer_Length = Length;
+	return 0;
+}
+
+/** Discard the lines up to the next blank line or up to the file end, so the next record can be read after a bad multi-lines grid.
+ * @param Pointer_Corpus The mapped file.
+ */
+static void CorpusSkipRemainingLines(TCorpus *Pointer_Corpus)
+{
+	const char *Pointer_Line;
+	size_t Length;
+	
+	do
+	{
+		if (CorpusReadNextLine(Pointer_Corpus, &Pointer_Line, &Length) != 0) return;
+	} while (Length > 0);
+}
+
+/** Convert grid characters to cells values one character at a time.
+ * @param Pointer_Characters The characters to convert.
+ * @param Pointer_Cells On output, contain the cells values.
+ * @param Characters_Count How many characters to convert.
+ * @param Grid_Size The grid size, all values must be smaller.
+ * @return 0 if all characters were converted,
+ * @return -1 if a character is bad or if its value does not fit in the grid.
+ */
+static int CorpusConvertCharactersScalar(const char *Pointer_Characters, int *Pointer_Cells, size_t Characters_Count, unsigned int Grid_Size)
+{
+	size_t i;
+	int Value;
+	
+	for (i = 0; i < Characters_Count; i++)
+	{
+		Value = GridConvertCharacterToValue(Pointer_Characters[i]);
+		if (Value == -1) return -1;
+		if ((Value != GRID_EMPTY_CELL_VALUE) && (Value >= (int) Grid_Size)) return -1;
+		Pointer_Cells[i] = Value;
+	}
+	return 0;
+}
+
+#ifdef CORPUS_IS_SIMD_AVAILABLE
+	/** Convert the characters of a grid up to 16x16 to cells values, 16 characters at a time. Each character is split in two nibbles, the low nibble selects the classes the character can belong to (digit, 'A' to 'F' letter or dot) and the high nibble selects its class, so a character is valid when both selections have a common class. The value is the low nibble, plus 9 for the letters.
+	 * @param Pointer_Characters The characters to convert.
+	 * @param Pointer_Cells On output, contain the cells values.
+	 * @param Characters_Count How many characters to convert, the characters following the last ones are never read.
+	 * @param Grid_Size The grid size, all values must be smaller.
+	 * @return 0 if all characters were converted,
+	 * @return -1 if a character is bad or if its value does not fit in the grid.
+	 */
+	__attribute__((target("sse4.2"))) static int CorpusConvertCharactersSSE4(const char *Pointer_Characters, int *Pointer_Cells, size_t Characters_Count, unsigned int Grid_Size)
+	{
+		const __m128i Low_Nibble_Classes = _mm_setr_epi8(1, 3, 3, 3, 3, 3, 3, 1, 1, 1, 0, 0, 0, 0, 4, 0); // Bit 0 : '0' to '9', bit 1 : 'A' to 'F', bit 2 : '.'
+		const __m128i High_Nibble_Classes = _mm_setr_epi8(0, 0, 4, 1, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+		const __m128i High_Nibble_Offsets = _mm_setr_epi8(0, 0, 0, 0, 9, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0); // 'A' low nibble is 1 and its value is 10
+		const __m128i Nibble_Mask = _mm_set1_epi8(0x0F), Dot = _mm_set1_epi8('.'), Maximum_Value = _mm_set1_epi8(Grid_Size - 1), Empty_Cell = _mm_set1_epi32(GRID_EMPTY_CELL_VALUE), Zero = _mm_setzero_si128(), All_Ones = _mm_set1_epi8(-1);
+		__m128i Characters, Low_Nibbles, High_Nibbles, Classes, Values, Dots, Bad_Characters;
+		size_t i;
+		int j;
+		
+		for (i = 0; i + CORPUS_SSE4_CHARACTERS_COUNT <= Characters_Count; i += CORPUS_SSE4_CHARACTERS_COUNT)
+		{
+			Characters = _mm_loadu_si128((const __m128i *) &Pointer_Characters[i]);
+			Low_Nibbles = _mm_and_si128(Characters, Nibble_Mask);
+			High_Nibbles = _mm_and_si128(_mm_srli_epi16(Characters, 4), Nibble_Mask);
+			Classes = _mm_and_si128(_mm_shuffle_epi8(Low_Nibble_Classes, Low_Nibbles), _mm_shuffle_epi8(High_Nibble_Classes, High_Nibbles));
+			Values = _mm_add_epi8(Low_Nibbles, _mm_shuffle_epi8(High_Nibble_Offsets, High_Nibbles));
+			Dots = _mm_cmpeq_epi8(Characters, Dot);
+			
+			// A character is bad when it belongs to no class, or when it is not a dot and its value does not fit in the grid
+			Bad_Characters = _mm_or_si128(_mm_cmpeq_epi8(Classes, Zero), _mm_xor_si128(_mm_or_si128(_mm_cmpeq_epi8(_mm_min_epu8(Values, Maximum_Value), Values), Dots), All_Ones));
+			if (_mm_movemask_epi8(Bad_Characters) != 0) return -1;
+			
+			// Widen the values to the cells size, four cells at a time
+			for (j = 0; j < CORPUS_SSE4_CHARACTERS_COUNT; j += 4)
+			{
+				_mm_storeu_si128((__m128i *) &Pointer_Cells[i + j], _mm_blendv_epi8(_mm_cvtepu8_epi32(Values), Empty_Cell, _mm_cvtepi8_epi32(Dots)));
+				Values = _mm_srli_si128(Values, 4);
+				Dots = _mm_srli_si128(Dots, 4);
+			}
+		}
+		
+		// Convert the last characters
+		return CorpusConvertCharactersScalar(&Pointer_Characters[i], &Pointer_Cells[i], Characters_Count - i, Grid_Size);
+	}
+#endif
+
+/** Convert grid characters to cells values with the best available instruction set.
+ * @param Pointer_Characters The characters to convert.
+ * @param Pointer_Cells On output, contain the cells values.
+ * @param Characters_Count How many characters to convert.
+ * @param Grid_Size The grid size, all values must be smaller.
+ * @param Is_SIMD_Enabled Set to 1 to use the SIMD instructions when the grid allows it.
+ * @return 0 if all characters were converted,
+ * @return -1 if a character is bad or if its value does not fit in the grid.
+ */
+static inline int CorpusConvertCharacters(const char *Pointer_Characters, int *Pointer_Cells, size_t Characters_Count, unsigned int Grid_Size, int __attribute__((unused)) Is_SIMD_Enabled)
+{
+	#ifdef CORPUS_IS_SIMD_AVAILABLE
+		if (Is_SIMD_Enabled && (Grid_Size <= CORPUS_SSE4_MAXIMUM_GRID_SIZE)) return CorpusConvertCharactersSSE4(Pointer_Characters, Pointer_Cells, Characters_Count, Grid_Size);
+	#endif
+	return CorpusConvertCharactersScalar(Pointer_Characters, Pointer_Cells, Characters_Count, Grid_Size);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int CorpusOpen(TCorpus *Pointer_Corpus, char *String_File_Name)
+{
+	int File_Descriptor;
+	struct stat File_Status;
+	void *Pointer_Data = NULL;
+	
+	File_Descriptor = open(String_File_Name, O_RDONLY);
+	if (File_Descriptor < 0) return -1;
+	
+	// Only the regular files can be mapped, the pipes and the terminals must be read as streams
+	if ((fstat(File_Descriptor, &File_Status) != 0) || !S_ISREG(File_Status.st_mode))
+	{
+		close(File_Descriptor);
+		return -2;
+	}
+	
+	// An empty file can't be mapped, but it is a valid corpus without records
+	if (File_Status.st_size > 0)
+	{
+		Pointer_Data = mmap(NULL, File_Status.st_size, PROT_READ, MAP_PRIVATE, File_Descriptor, 0);
+		if (Pointer_Data == MAP_FAILED)
+		{
+			close(File_Descriptor);
+			return -2;
+		}
+		madvise(Pointer_Data, File_Status.st_size, MADV_SEQUENTIAL); // The records are read once from the file start, so the kernel can read ahead aggressively
+	}
+	close(File_Descriptor); // The mapping stays valid without the file descriptor
+	
+	Pointer_Corpus->Pointer_Data = Pointer_Data;
+	Pointer_Corpus->Size = File_Status.st_size;
+	Pointer_Corpus->Offset = 0;
+	Pointer_Corpus->Line = 0;
+	return 0;
+}
+
+void CorpusClose(TCorpus *Pointer_Corpus)
+{
+	if (Pointer_Corpus->Pointer_Data != NULL) munmap((void *) Pointer_Corpus->Pointer_Data, Pointer_Corpus->Size);
+	Pointer_Corpus->Pointer_Data = NULL;
+	Pointer_Corpus->Size = 0;
+}
+
+int CorpusReadNextRecord(TCorpus *Pointer_Corpus, TCorpusRecord *Pointer_Record)
+{
+	const char *Pointer_Line;
+	size_t Length, Size;
+	unsigned int Row;
+	
+	// Skip the blank lines separating the grids
+	do
+	{
+		if (CorpusReadNextLine(Pointer_Corpus, &Pointer_Line, &Length) != 0) return 1;
+	} while (Length == 0);
+	
+	Pointer_Record->Pointer_Characters = Pointer_Line;
+	Pointer_Record->Length = Length;
+	Pointer_Record->Offset = Pointer_Line - Pointer_Corpus->Pointer_Data;
+	Pointer_Record->Line = Pointer_Corpus->Line;
+	Pointer_Record->Grid_Size = 0;
+	
+	// The whole grid is stored on a single line when the line length is the square of a grid size (this is checked first because a 36x36 grid row has the length of a whole 6x6 grid)
+	for (Size = 1; Size * Size < Length; Size++);
+	if ((Size * Size == Length) && (Size <= CONFIGURATION_GRID_MAXIMUM_SIZE) && GridIsSizeSupported(Size))
+	{
+		Pointer_Record->Grid_Size = Size;
+		Pointer_Record->Is_Single_Line = 1;
+		return 0;
+	}
+	
+	// Or the grid is in the multi-lines format, the first line length is the grid size
+	Pointer_Record->Is_Single_Line = 0;
+	if ((Length > CONFIGURATION_GRID_MAXIMUM_SIZE) || !GridIsSizeSupported(Length)) return 0;
+	
+	for (Row = 1; Row < Length; Row++)
+	{
+		// All rows must have the same length, the lines of a bad grid are discarded up to the next blank line
+		if (CorpusReadNextLine(Pointer_Corpus, &Pointer_Line, &Size) != 0) return 0;
+		Pointer_Record->Length = Pointer_Line + Size - Pointer_Record->Pointer_Characters;
+		if (Size != Length)
+		{
+			if (Size > 0) CorpusSkipRemainingLines(Pointer_Corpus);
+			return 0;
+		}
+	}
+	Pointer_Record->Grid_Size = Length;
+	return 0;
+}
+
+int CorpusLoadGrid(TGrid *Pointer_Grid, const TCorpusRecord *Pointer_Record)
+{
+	const char *Pointer_Characters = Pointer_Record->Pointer_Characters;
+	unsigned int Size = Pointer_Record->Grid_Size, Row;
+	int Is_SIMD_Enabled;
+	
+	if (Size == 0) return -2;
+	Is_SIMD_Enabled = CandidatesGetInstructionSet() != CANDIDATES_INSTRUCTION_SET_SCALAR;
+	
+	// The cells are written in place, then the grid is configured for them
+	if (Pointer_Record->Is_Single_Line)
+	{
+		if (CorpusConvertCharacters(Pointer_Characters, Pointer_Grid->Cells, Size * Size, Size, Is_SIMD_Enabled) != 0) return -3;
+	}
+	else
+	{
+		for (Row = 0; Row < Size; Row++)
+		{
+			if (CorpusConvertCharacters(Pointer_Characters, &Pointer_Grid->Cells[Row * Size], Size, Size, Is_SIMD_Enabled) != 0) return -3;
+			
+			// Go to the next row start (the record ends with the last row characters)
+			if (Row < Size - 1)
+			{
+				Pointer_Characters += Size;
+				while (*Pointer_Characters == '\r') Pointer_Characters++;
+				Pointer_Characters++; // Bypass the '\n'
+			}
+		}
+	}
+	
+	return GridLoadFromCells(Pointer_Grid, Size);
+}
+
+int CorpusLoadNextGrid(TCorpus *Pointer_Corpus, TGrid *Pointer_Grid, TCorpusRecord *Pointer_Record)
+{
+	int Result;
+	
+	if (CorpusReadNextRecord(Pointer_Corpus, Pointer_Record) != 0) return 1;
+	
+	// The stream loader discards the lines following a multi-lines grid with a bad cell up to the next blank line, do the same so both loaders find the same grids
+	Result = CorpusLoadGrid(Pointer_Grid, Pointer_Record);
+	if ((Result == -3) && !Pointer_Record->Is_Single_Line) CorpusSkipRemainingLines(Pointer_Corpus);
+	return Result;
+}
@@ -0,0 +1,757 @@
+/** @file Daemon.c
+ * @see Daemon.h for description.
+ * @author Adrien RICCIARDI
+ */
+#define _GNU_SOURCE // To have ppoll() and the threads affinity functions
+#include <Clock.h>
+#include <Daemon.h>
+#include <errno.h>
+#include <Packed_Grids.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <Solver.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** The size of a request without its grid, including its length. */
+#define DAEMON_REQUEST_HEADER_SIZE 9
+/** The longest grid text of a request, so the biggest grid can be sent on several lines with separators. */
+#define DAEMON_MAXIMUM_GRID_TEXT_SIZE (2 * GRID_MAXIMUM_CELLS_COUNT)
+
+/** How many bytes are read from a client at once, several pipelined requests are read by a single read. */
+#define DAEMON_READ_BUFFER_SIZE 65536
+/** How many requests can wait to be solved, the clients are not read anymore while the queue is full. */
+#define DAEMON_QUEUE_SIZE 256
+/** The size of the longest response (a text line response holding a solution). */
+#define DAEMON_MAXIMUM_RESPONSE_SIZE (160 + GRID_STRING_SIZE)
+
+/** How many requests of a client can be queued, solved or waiting for their response to be written. The client is not read anymore while this count is reached, so all its responses always fit in its backlog and a client not reading its responses only stops its own requests. */
+#define DAEMON_CLIENT_MAXIMUM_PENDING_REQUESTS 64
+/** The size of a client responses backlog. */
+#define DAEMON_CLIENT_BACKLOG_SIZE (DAEMON_CLIENT_MAXIMUM_PENDING_REQUESTS * DAEMON_MAXIMUM_RESPONSE_SIZE)
+/** How long the responses writing waits for a socket to be writable before checking whether the daemon is stopping, in milliseconds. */
+#define DAEMON_WRITE_POLLING_PERIOD 100
+/** How many writing polling periods a client not reading its responses is waited for when the daemon is stopping, its remaining responses are then dropped. */
+#define DAEMON_STOPPING_WRITE_POLLINGS_COUNT 10
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** A client, its requests are read by a thread and its responses are written by another thread. The solving threads only add the responses to the client backlog, so they never wait for a client to read its responses. */
+typedef struct TDaemonClient
+{
+	int Input_File_Descriptor; //! Where the requests are read from.
+	int Output_File_Descriptor; //! Where the responses are written to.
+	int Is_Socket; //! Set to 1 when the client is a socket connection, the socket is written without blocking so a client not reading its responses can't delay the daemon stop forever.
+	pthread_t Thread; //! The thread serving a socket connection.
+	struct TDaemonClient *Pointer_Next_Client; //! The next socket connection, the connections list is used by the daemon main thread only.
+	int Is_Output_Failed; //! Set to 1 by the writing thread when a response could not be written, the next responses are then dropped.
+	pthread_mutex_t Mutex; //! Protect the following fields.
+	pthread_cond_t Response_Condition; //! Signaled when a response is added to the backlog or when the requests stream is closed.
+	pthread_cond_t Written_Condition; //! Signaled when responses are written, so more requests can be read.
+	unsigned char *Pointer_Backlog; //! The responses waiting to be written.
+	unsigned char *Pointer_Spare_Backlog; //! The responses being written, the next responses are added to the backlog meanwhile.
+	size_t Backlog_Size; //! How many bytes the backlog responses use.
+	int Backlog_Responses_Count; //! How many responses are in the backlog.
+	int Pending_Requests_Count; //! How many requests of this client are not written yet.
+	int Is_Input_Closed; //! Set to 1 when no more request will be read from this client.
+	int Is_Released; //! Set to 1 when all requests of the client are answered and its threads are over, the client can then be freed.
+} TDaemonClient;
+
+/** A request waiting to be solved. */
+typedef struct
+{
+	TDaemonClient *Pointer_Client; //! The client to send the response to.
+	unsigned int Identifier; //! The request identifier.
+	unsigned int Flags; //! The request flags (DAEMON_REQUEST_FLAG_XXX values).
+	char String_Grid[DAEMON_MAXIMUM_GRID_TEXT_SIZE + 1]; //! The grid text, terminated by a zero.
+} TDaemonRequest;
+
+/** The requests waiting to be solved, in the receiving order. */
+typedef struct
+{
+	TDaemonRequest Requests[DAEMON_QUEUE_SIZE]; //! The ring holding the requests.
+	int Head; //! The index of the oldest request.
+	int Count; //! How many requests are in the ring.
+	int Is_Stopping; //! Set to 1 to stop the solving threads when the ring is empty.
+	pthread_mutex_t Mutex; //! Protect the ring.
+	pthread_cond_t Not_Empty_Condition; //! Signaled when a request is added or when the solving threads must stop.
+	pthread_cond_t Not_Full_Condition; //! Signaled when a request is removed.
+} TDaemonQueue;
+
+/** A solving thread. */
+typedef struct
+{
+	TSolver Solver; //! This thread solver context, prepared once for all requests.
+	TDaemonRequest Request; //! The request being solved.
+	pthread_t Thread; //! The thread identifier.
+} TDaemonWorker;
+
+//-------------------------------------------------------------------------------------------------
+// Private variables
+//-------------------------------------------------------------------------------------------------
+/** The requests of all clients. */
+static TDaemonQueue Daemon_Queue = {.Mutex = PTHREAD_MUTEX_INITIALIZER, .Not_Empty_Condition = PTHREAD_COND_INITIALIZER, .Not_Full_Condition = PTHREAD_COND_INITIALIZER};
+/** How the grids are solved. */
+static const TBatchConfiguration *Daemon_Pointer_Configuration;
+/** Set by SIGINT and SIGTERM to stop the daemon, it cancels the solvings too. */
+static atomic_int Daemon_Is_Stop_Requested;
+
+/** The status words of the text line responses. */
+static const char *Daemon_String_Status_Names[] = {"solved", "unsolvable", "timed-out", "bad-grid", "cancelled"};
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Request the daemon to stop.
+ * @param Signal_Number Not used.
+ */
+static void DaemonHandleSignal(int __attribute__((unused)) Signal_Number)
+{
+	atomic_store(&Daemon_Is_Stop_Requested, 1);
+}
+
+/** Store a little-endian value.
+ * @param Pointer_Bytes On output, contain the value bytes.
+ * @param Value The value.
+ * @param Bytes_Count How many bytes the value uses.
+ */
+static void DaemonStoreValue(unsigned char *Pointer_Bytes, unsigned long long Value, int Bytes_Count)
+{
+	int i;
+	
+	for (i = 0; i < Bytes_Count; i++) Pointer_Bytes[i] = (unsigned char) (Value >> (i * 8));
+}
+
+/** Load a 32-bit little-endian value.
+ * @param Pointer_Bytes The value bytes.
+ * @return The value.
+ */
+static unsigned int DaemonLoadValue(const unsigned char *Pointer_Bytes)
+{
+	return Pointer_Bytes[0] | (Pointer_Bytes[1] << 8) | (Pointer_Bytes[2] << 16) | ((unsigned int) Pointer_Bytes[3] << 24);
+}
+
+/** Write a whole buffer to a client, even when the write is split by the system. A socket is written without blocking, so a client not reading its responses is given up when the daemon is stopping.
+ * @param Pointer_Client The client.
+ * @param Pointer_Buffer The bytes to write.
+ * @param Size How many bytes to write.
+ * @return 0 if all bytes were written,
+ * @return -1 if the client could not be written.
+ */
+static int DaemonWriteAll(TDaemonClient *Pointer_Client, const unsigned char *Pointer_Buffer, size_t Size)
+{
+	struct pollfd Poll_Descriptor = {.fd = Pointer_Client->Output_File_Descriptor, .events = POLLOUT};
+	ssize_t Written_Bytes_Count;
+	int Stopping_Pollings_Count = 0;
+	
+	while (Size > 0)
+	{
+		if (Pointer_Client->Is_Socket) Written_Bytes_Count = send(Pointer_Client->Output_File_Descriptor, Pointer_Buffer, Size, MSG_DONTWAIT);
+		else Written_Bytes_Count = write(Pointer_Client->Output_File_Descriptor, Pointer_Buffer, Size);
+		if (Written_Bytes_Count < 0)
+		{
+			if (errno == EINTR) continue;
+			if ((errno != EAGAIN) && (errno != EWOULDBLOCK)) return -1;
+			
+			// Wait for the client to read its responses, but not forever when the daemon is stopping
+			if ((poll(&Poll_Descriptor, 1, DAEMON_WRITE_POLLING_PERIOD) == 0) && atomic_load(&Daemon_Is_Stop_Requested))
+			{
+				Stopping_Pollings_Count++;
+				if (Stopping_Pollings_Count >= DAEMON_STOPPING_WRITE_POLLINGS_COUNT) return -1;
+			}
+			continue;
+		}
+		Pointer_Buffer += Written_Bytes_Count;
+		Size -= Written_Bytes_Count;
+	}
+	return 0;
+}
+
+/** Prepare a client.
+ * @param Pointer_Client The client.
+ * @param Input_File_Descriptor Where the requests are read from.
+ * @param Output_File_Descriptor Where the responses are written to.
+ * @param Is_Socket Set to 1 if the client is a socket connection.
+ * @return 0 if the client is ready,
+ * @return -1 if there is not enough memory for the client responses backlog.
+ */
+static int DaemonInitializeClient(TDaemonClient *Pointer_Client, int Input_File_Descriptor, int Output_File_Descriptor, int Is_Socket)
+{
+	Pointer_Client->Pointer_Backlog = malloc(DAEMON_CLIENT_BACKLOG_SIZE);
+	Pointer_Client->Pointer_Spare_Backlog = malloc(DAEMON_CLIENT_BACKLOG_SIZE);
+	if ((Pointer_Client->Pointer_Backlog == NULL) || (Pointer_Client->Pointer_Spare_Backlog == NULL))
+	{
+		free(Pointer_Client->Pointer_Backlog);
+		free(Pointer_Client->Pointer_Spare_Backlog);
+		return -1;
+	}
+	
+	Pointer_Client->Input_File_Descriptor = Input_File_Descriptor;
+	Pointer_Client->Output_File_Descriptor = Output_File_Descriptor;
+	Pointer_Client->Is_Socket = Is_Socket;
+	Pointer_Client->Pointer_Next_Client = NULL;
+	Pointer_Client->Is_Output_Failed = 0;
+	pthread_mutex_init(&Pointer_Client->Mutex, NULL);
+	pthread_cond_init(&Pointer_Client->Response_Condition, NULL);
+	pthread_cond_init(&Pointer_Client->Written_Condition, NULL);
+	Pointer_Client->Backlog_Size = 0;
+	Pointer_Client->Backlog_Responses_Count = 0;
+	Pointer_Client->Pending_Requests_Count = 0;
+	Pointer_Client->Is_Input_Closed = 0;
+	Pointer_Client->Is_Released = 0;
+	return 0;
+}
+
+/** Free the resources of a client (but not its file descriptors).
+ * @param Pointer_Client The client, its threads must be over.
+ */
+static void DaemonUninitializeClient(TDaemonClient *Pointer_Client)
+{
+	pthread_mutex_destroy(&Pointer_Client->Mutex);
+	pthread_cond_destroy(&Pointer_Client->Response_Condition);
+	pthread_cond_destroy(&Pointer_Client->Written_Condition);
+	free(Pointer_Client->Pointer_Backlog);
+	free(Pointer_Client->Pointer_Spare_Backlog);
+}
+
+/** Add a request to the queue, waiting for a free place if the queue is full.
+ * @param Pointer_Client The client which sent the request.
+ * @param Pointer_Request The request bytes, starting with the request length.
+ */
+static void DaemonQueuePush(TDaemonClient *Pointer_Client, const unsigned char *Pointer_Request)
+{
+	TDaemonRequest *Pointer_Queued_Request;
+	unsigned int Grid_Text_Size;
+	
+	// Do not take more requests than the client backlog can answer, the client must not be released while its request is waiting
+	pthread_mutex_lock(&Pointer_Client->Mutex);
+	while (Pointer_Client->Pending_Requests_Count == DAEMON_CLIENT_MAXIMUM_PENDING_REQUESTS) pthread_cond_wait(&Pointer_Client->Written_Condition, &Pointer_Client->Mutex);
+	Pointer_Client->Pending_Requests_Count++;
+	pthread_mutex_unlock(&Pointer_Client->Mutex);
+	
+	pthread_mutex_lock(&Daemon_Queue.Mutex);
+	while (Daemon_Queue.Count == DAEMON_QUEUE_SIZE) pthread_cond_wait(&Daemon_Queue.Not_Full_Condition, &Daemon_Queue.Mutex);
+	
+	Pointer_Queued_Request = &Daemon_Queue.Requests[(Daemon_Queue.Head + Daemon_Queue.Count) % DAEMON_QUEUE_SIZE];
+	Pointer_Queued_Request->Pointer_Client = Pointer_Client;
+	Pointer_Queued_Request->Identifier = DaemonLoadValue(&Pointer_Request[4]);
+	Pointer_Queued_Request->Flags = Pointer_Request[8];
+	Grid_Text_Size = DaemonLoadValue(Pointer_Request) + 4 - DAEMON_REQUEST_HEADER_SIZE;
+	memcpy(Pointer_Queued_Request->String_Grid, &Pointer_Request[DAEMON_REQUEST_HEADER_SIZE], Grid_Text_Size);
+	Pointer_Queued_Request->String_Grid[Grid_Text_Size] = 0;
+	Daemon_Queue.Count++;
+	
+	pthread_cond_signal(&Daemon_Queue.Not_Empty_Condition);
+	pthread_mutex_unlock(&Daemon_Queue.Mutex);
+}
+
+/** Take the oldest request of the queue, waiting for a request if the queue is empty.
+ * @param Pointer_Request On output, contain the request.
+ * @return 0 if a request was taken,
+ * @return -1 if the queue is empty and the solving threads must stop.
+ */
+static int DaemonQueuePop(TDaemonRequest *Pointer_Request)
+{
+	TDaemonRequest *Pointer_Queued_Request;
+	
+	pthread_mutex_lock(&Daemon_Queue.Mutex);
+	while (Daemon_Queue.Count == 0)
+	{
+		if (Daemon_Queue.Is_Stopping)
+		{
+			pthread_mutex_unlock(&Daemon_Queue.Mutex);
+			return -1;
+		}
+		pthread_cond_wait(&Daemon_Queue.Not_Empty_Condition, &Daemon_Queue.Mutex);
+	}
+	
+	// Copy the grid text only, it is much shorter than its buffer for the usual grid sizes
+	Pointer_Queued_Request = &Daemon_Queue.Requests[Daemon_Queue.Head];
+	Pointer_Request->Pointer_Client = Pointer_Queued_Request->Pointer_Client;
+	Pointer_Request->Identifier = Pointer_Queued_Request->Identifier;
+	Pointer_Request->Flags = Pointer_Queued_Request->Flags;
+	strcpy(Pointer_Request->String_Grid, Pointer_Queued_Request->String_Grid);
+	Daemon_Queue.Head = (Daemon_Queue.Head + 1) % DAEMON_QUEUE_SIZE;
+	Daemon_Queue.Count--;
+	
+	pthread_cond_signal(&Daemon_Queue.Not_Full_Condition);
+	pthread_mutex_unlock(&Daemon_Queue.Mutex);
+	return 0;
+}
+
+/** Solve the grid of a request and build its response.
+ * @param Pointer_Worker The solving thread, its request is solved.
+ * @param Pointer_Response On output, contain the response.
+ * @return The response size in bytes.
+ */
+static size_t DaemonSolveRequest(TDaemonWorker *Pointer_Worker, unsigned char *Pointer_Response)
+{
+	TSolver *Pointer_Solver = &Pointer_Worker->Solver;
+	TSolverStatistics Statistics = {0};
+	unsigned long long Solutions_Count = 0, Duration = 0;
+	int Result, Status = DAEMON_STATUS_BAD_GRID, Is_Solution_Present = 0;
+	unsigned int Grid_Size = 0;
+	size_t Size;
+	
+	if (SolverLoadFromString(Pointer_Solver, Pointer_Worker->Request.String_Grid) == 0)
+	{
+		Grid_Size = Pointer_Solver->Grid.Size;
+		Duration = ClockGetTime();
+		if (Daemon_Pointer_Configuration->Is_Counting_Enabled) Result = SolverCountSolutions(Pointer_Solver, Daemon_Pointer_Configuration->Solutions_Limit, &Solutions_Count);
+		else
+		{
+			Result = SolverSolve(Pointer_Solver);
+			if (Result == SOLVER_RESULT_SOLVED)
+			{
+				Solutions_Count = 1;
+				Is_Solution_Present = 1;
+			}
+		}
+		Duration = (ClockGetTime() - Duration) / 1000;
+		SolverGetStatistics(Pointer_Solver, &Statistics);
+		if (Daemon_Pointer_Configuration->Statistics_File != NULL) SolverWriteStatisticsRecord(Pointer_Solver, Pointer_Worker->Request.Identifier, Result, Daemon_Pointer_Configuration->Statistics_File);
+		
+		if (Result == SOLVER_RESULT_SOLVED) Status = DAEMON_STATUS_SOLVED;
+		else if (Result == SOLVER_RESULT_TIMED_OUT) Status = DAEMON_STATUS_TIMED_OUT;
+		else if (Result == SOLVER_RESULT_CANCELLED) Status = DAEMON_STATUS_CANCELLED;
+		else Status = DAEMON_STATUS_UNSOLVABLE;
+	}
+	
+	if (Pointer_Worker->Request.Flags & DAEMON_REQUEST_FLAG_LINE_RESPONSE)
+	{
+		Size = sprintf((char *) Pointer_Response, "%u %s %llu %llu %llu %llu %llu ", Pointer_Worker->Request.Identifier, Daemon_String_Status_Names[Status], Solutions_Count, Statistics.Loops_Count, Statistics.Bad_Solutions_Found_Count, Statistics.Propagated_Cells_Count, Duration);
+		if (Is_Solution_Present)
+		{
+			GridConvertToString(&Pointer_Solver->Grid, (char *) &Pointer_Response[Size]);
+			Size += Grid_Size * Grid_Size;
+		}
+		else
+		{
+			Pointer_Response[Size] = '-';
+			Size++;
+		}
+		Pointer_Response[Size] = '\n';
+		return Size + 1;
+	}
+	
+	DaemonStoreValue(&Pointer_Response[4], Pointer_Worker->Request.Identifier, 4);
+	Pointer_Response[8] = (unsigned char) Status;
+	Pointer_Response[9] = (unsigned char) Grid_Size;
+	DaemonStoreValue(&Pointer_Response[10], 0, 2);
+	DaemonStoreValue(&Pointer_Response[12], Solutions_Count, 8);
+	DaemonStoreValue(&Pointer_Response[20], Statistics.Loops_Count, 8);
+	DaemonStoreValue(&Pointer_Response[28], Statistics.Bad_Solutions_Found_Count, 8);
+	DaemonStoreValue(&Pointer_Response[36], Statistics.Propagated_Cells_Count, 8);
+	DaemonStoreValue(&Pointer_Response[44], Duration, 8);
+	Size = DAEMON_BINARY_RESPONSE_HEADER_SIZE;
+	if (Is_Solution_Present)
+	{
+		PackedGridsPackGrid(&Pointer_Solver->Grid, &Pointer_Response[Size]);
+		Size += PackedGridsGetGridBytesCount(Grid_Size);
+	}
+	DaemonStoreValue(Pointer_Response, Size - 4, 4);
+	return Size;
+}
+
+/** A solving thread, it answers the queued requests until the daemon stops.
+ * @param Pointer_Argument The worker.
+ * @return Always NULL.
+ */
+static void *DaemonWorkerThread(void *Pointer_Argument)
+{
+	TDaemonWorker *Pointer_Worker = Pointer_Argument;
+	TDaemonClient *Pointer_Client;
+	unsigned char Response[DAEMON_MAXIMUM_RESPONSE_SIZE];
+	size_t Response_Size;
+	
+	while (DaemonQueuePop(&Pointer_Worker->Request) == 0)
+	{
+		Response_Size = DaemonSolveRequest(Pointer_Worker, Response);
+		
+		// The response is only added to the client backlog (it always fits), so a client not reading its responses can't block the solving threads
+		Pointer_Client = Pointer_Worker->Request.Pointer_Client;
+		pthread_mutex_lock(&Pointer_Client->Mutex);
+		memcpy(&Pointer_Client->Pointer_Backlog[Pointer_Client->Backlog_Size], Response, Response_Size);
+		Pointer_Client->Backlog_Size += Response_Size;
+		Pointer_Client->Backlog_Responses_Count++;
+		pthread_cond_signal(&Pointer_Client->Response_Condition);
+		pthread_mutex_unlock(&Pointer_Client->Mutex);
+	}
+	return NULL;
+}
+
+/** The thread writing the responses of a client, until the client requests stream is closed and all its responses are written. The client mutex is not held while writing, so the solving threads can add the next responses meanwhile.
+ * @param Pointer_Argument The client.
+ * @return Always NULL.
+ */
+static void *DaemonWriterThread(void *Pointer_Argument)
+{
+	TDaemonClient *Pointer_Client = Pointer_Argument;
+	unsigned char *Pointer_Responses;
+	size_t Size;
+	int Responses_Count;
+	
+	pthread_mutex_lock(&Pointer_Client->Mutex);
+	while (1)
+	{
+		while ((Pointer_Client->Backlog_Size == 0) && (!Pointer_Client->Is_Input_Closed || (Pointer_Client->Pending_Requests_Count > 0))) pthread_cond_wait(&Pointer_Client->Response_Condition, &Pointer_Client->Mutex);
+		if (Pointer_Client->Backlog_Size == 0) break;
+		
+		// Take all responses of the backlog, the next ones go to the spare buffer
+		Pointer_Responses = Pointer_Client->Pointer_Backlog;
+		Size = Pointer_Client->Backlog_Size;
+		Responses_Count = Pointer_Client->Backlog_Responses_Count;
+		Pointer_Client->Pointer_Backlog = Pointer_Client->Pointer_Spare_Backlog;
+		Pointer_Client->Backlog_Size = 0;
+		Pointer_Client->Backlog_Responses_Count = 0;
+		pthread_mutex_unlock(&Pointer_Client->Mutex);
+		
+		if (!Pointer_Client->Is_Output_Failed && (DaemonWriteAll(Pointer_Client, Pointer_Responses, Size) != 0)) Pointer_Client->Is_Output_Failed = 1;
+		
+		pthread_mutex_lock(&Pointer_Client->Mutex);
+		Pointer_Client->Pointer_Spare_Backlog = Pointer_Responses;
+		Pointer_Client->Pending_Requests_Count -= Responses_Count;
+		pthread_cond_signal(&Pointer_Client->Written_Condition);
+	}
+	pthread_mutex_unlock(&Pointer_Client->Mutex);
+	return NULL;
+}
+
+/** Queue all requests of a client until its requests stream is closed. The stream is read by big blocks, so all pipelined requests received at once are queued with a single read.
+ * @param Pointer_Client The client.
+ * @return 0 if the requests stream was closed,
+ * @return -1 if the requests stream is corrupted (it is not read anymore).
+ */
+static int DaemonReadRequests(TDaemonClient *Pointer_Client)
+{
+	unsigned char *Pointer_Buffer;
+	size_t Start = 0, End = 0;
+	ssize_t Read_Bytes_Count;
+	unsigned int Length;
+	int Result = 0;
+	
+	Pointer_Buffer = malloc(DAEMON_READ_BUFFER_SIZE);
+	if (Pointer_Buffer == NULL)
+	{
+		fprintf(stderr, "Error : not enough memory to read the requests of a client.\n");
+		Result = -1;
+	}
+	
+	while (Result == 0)
+	{
+		// Queue all complete requests
+		while (End - Start >= 4)
+		{
+			Length = DaemonLoadValue(&Pointer_Buffer[Start]);
+			if ((Length < DAEMON_REQUEST_HEADER_SIZE - 4) || (Length > DAEMON_REQUEST_HEADER_SIZE - 4 + DAEMON_MAXIMUM_GRID_TEXT_SIZE))
+			{
+				fprintf(stderr, "Error : bad request length %u, the client requests are not read anymore.\n", Length);
+				Result = -1;
+				break;
+			}
+			if (End - Start < Length + 4) break;
+			
+			DaemonQueuePush(Pointer_Client, &Pointer_Buffer[Start]);
+			Start += Length + 4;
+		}
+		if (Result != 0) break;
+		
+		// Keep the beginning of the next request
+		memmove(Pointer_Buffer, &Pointer_Buffer[Start], End - Start);
+		End -= Start;
+		Start = 0;
+		
+		Read_Bytes_Count = read(Pointer_Client->Input_File_Descriptor, &Pointer_Buffer[End], DAEMON_READ_BUFFER_SIZE - End);
+		if ((Read_Bytes_Count < 0) && (errno == EINTR)) continue;
+		// A connection reset by the client ends its requests too
+		if (Read_Bytes_Count <= 0)
+		{
+			if (End > 0)
+			{
+				fprintf(stderr, "Error : the requests stream ends in the middle of a request.\n");
+				Result = -1;
+			}
+			break;
+		}
+		End += Read_Bytes_Count;
+	}
+	free(Pointer_Buffer);
+	
+	// The writing thread stops when the last response is written
+	pthread_mutex_lock(&Pointer_Client->Mutex);
+	Pointer_Client->Is_Input_Closed = 1;
+	pthread_cond_signal(&Pointer_Client->Response_Condition);
+	pthread_mutex_unlock(&Pointer_Client->Mutex);
+	return Result;
+}
+
+/** Serve a client until its requests stream is closed and all its responses are written. The requests are read by the calling thread while another thread writes the responses.
+ * @param Pointer_Client The client.
+ * @return 0 if the requests stream was closed,
+ * @return -1 if the requests stream is corrupted or if the writing thread could not be started.
+ */
+static int DaemonServeClient(TDaemonClient *Pointer_Client)
+{
+	pthread_t Writer_Thread;
+	int Result;
+	
+	if (pthread_create(&Writer_Thread, NULL, DaemonWriterThread, Pointer_Client) != 0)
+	{
+		fprintf(stderr, "Error : could not start the thread writing the responses of a client.\n");
+		Result = -1;
+	}
+	else
+	{
+		Result = DaemonReadRequests(Pointer_Client);
+		pthread_join(Writer_Thread, NULL);
+	}
+	
+	pthread_mutex_lock(&Pointer_Client->Mutex);
+	Pointer_Client->Is_Released = 1;
+	pthread_mutex_unlock(&Pointer_Client->Mutex);
+	return Result;
+}
+
+/** The thread serving a socket connection.
+ * @param Pointer_Argument The client.
+ * @return Always NULL.
+ */
+static void *DaemonClientThread(void *Pointer_Argument)
+{
+	DaemonServeClient(Pointer_Argument);
+	return NULL;
+}
+
+/** Free the socket connections whose threads are over, closing their sockets.
+ * @param Pointer_Pointer_Clients The connections list, the freed connections are removed from it.
+ * @param Is_Waiting_Enabled Set to 1 to wait for all connections to be over and free them all, set to 0 to free only the connections that are already over.
+ */
+static void DaemonReleaseClients(TDaemonClient **Pointer_Pointer_Clients, int Is_Waiting_Enabled)
+{
+	TDaemonClient *Pointer_Client;
+	int Is_Released;
+	
+	while (*Pointer_Pointer_Clients != NULL)
+	{
+		Pointer_Client = *Pointer_Pointer_Clients;
+		pthread_mutex_lock(&Pointer_Client->Mutex);
+		Is_Released = Pointer_Client->Is_Released;
+		pthread_mutex_unlock(&Pointer_Client->Mutex);
+		if (!Is_Released && !Is_Waiting_Enabled)
+		{
+			Pointer_Pointer_Clients = &Pointer_Client->Pointer_Next_Client;
+			continue;
+		}
+		
+		pthread_join(Pointer_Client->Thread, NULL);
+		*Pointer_Pointer_Clients = Pointer_Client->Pointer_Next_Client;
+		close(Pointer_Client->Input_File_Descriptor);
+		DaemonUninitializeClient(Pointer_Client);
+		free(Pointer_Client);
+	}
+}
+
+/** Create the daemon socket.
+ * @param String_Socket_File_Name The socket file.
+ * @return The listening socket,
+ * @return -1 if the socket could not be created.
+ */
+static int DaemonCreateSocket(char *String_Socket_File_Name)
+{
+	struct sockaddr_un Address;
+	struct stat Status;
+	int Socket;
+	
+	if (strlen(String_Socket_File_Name) >= sizeof(Address.sun_path)) return -1;
+	memset(&Address, 0, sizeof(Address));
+	Address.sun_family = AF_UNIX;
+	strcpy(Address.sun_path, String_Socket_File_Name);
+	
+	// Replace the socket left by a previous daemon, but never another kind of file
+	if ((stat(String_Socket_File_Name, &Status) == 0) && S_ISSOCK(Status.st_mode)) unlink(String_Socket_File_Name);
+	
+	Socket = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (Socket < 0) return -1;
+	if ((bind(Socket, (struct sockaddr *) &Address, sizeof(Address)) != 0) || (listen(Socket, SOMAXCONN) != 0))
+	{
+		close(Socket);
+		return -1;
+	}
+	return Socket;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int DaemonRun(TBatchConfiguration *Pointer_Configuration, char *String_Socket_File_Name)
+{
+	TDaemonWorker *Pointer_Workers;
+	TDancingLinks *Pointer_Dancing_Links = NULL;
+	TDaemonClient Standard_Client, *Pointer_Client, *Pointer_Clients = NULL;
+	struct sigaction Action;
+	struct pollfd Poll_Descriptor;
+	sigset_t Stop_Signals, Original_Signals;
+	pthread_attr_t Thread_Attributes;
+	cpu_set_t Processors_Set;
+	int i, Threads_Count, Processors_Count, Listening_Socket = -1, Client_Socket, Exit_Code = EXIT_SUCCESS;
+	
+	Daemon_Pointer_Configuration = Pointer_Configuration;
+	Processors_Count = sysconf(_SC_NPROCESSORS_ONLN);
+	Threads_Count = Pointer_Configuration->Threads_Count;
+	if (Threads_Count <= 0) Threads_Count = Processors_Count;
+	
+	// Listen before starting the threads, so a bad socket is reported at once
+	if (String_Socket_File_Name != NULL)
+	{
+		Listening_Socket = DaemonCreateSocket(String_Socket_File_Name);
+		if (Listening_Socket < 0)
+		{
+			fprintf(stderr, "Error : can't listen to socket %s.\n", String_Socket_File_Name);
+			return EXIT_FAILURE;
+		}
+		
+		// The stop signals are received by this thread only, and only while it waits for a client, so the stop request can't be missed
+		sigemptyset(&Stop_Signals);
+		sigaddset(&Stop_Signals, SIGINT);
+		sigaddset(&Stop_Signals, SIGTERM);
+		pthread_sigmask(SIG_BLOCK, &Stop_Signals, &Original_Signals);
+		Action.sa_handler = DaemonHandleSignal;
+		sigemptyset(&Action.sa_mask);
+		Action.sa_flags = 0;
+		sigaction(SIGINT, &Action, NULL);
+		sigaction(SIGTERM, &Action, NULL);
+	}
+	// A client leaving before receiving its responses must not stop the daemon
+	signal(SIGPIPE, SIG_IGN);
+	
+	// Prepare all solver contexts once
+	Pointer_Workers = malloc(Threads_Count * sizeof(TDaemonWorker));
+	if (Pointer_Configuration->Solver_Configuration.Engine == SOLVER_ENGINE_DANCING_LINKS) Pointer_Dancing_Links = malloc(Threads_Count * sizeof(TDancingLinks)); // Each worker needs its own dancing links storage
+	if ((Pointer_Workers == NULL) || ((Pointer_Configuration->Solver_Configuration.Engine == SOLVER_ENGINE_DANCING_LINKS) && (Pointer_Dancing_Links == NULL)))
+	{
+		fprintf(stderr, "Error : not enough memory to start %d solving threads.\n", Threads_Count);
+		free(Pointer_Workers);
+		free(Pointer_Dancing_Links);
+		if (Listening_Socket >= 0) close(Listening_Socket);
+		return EXIT_FAILURE;
+	}
+	for (i = 0; i < Threads_Count; i++)
+	{
+		SolverInitialize(&Pointer_Workers[i].Solver);
+		SolverSetConfiguration(&Pointer_Workers[i].Solver, (TSolverConfiguration *) &Pointer_Configuration->Solver_Configuration);
+		SolverSetTimeLimit(&Pointer_Workers[i].Solver, Pointer_Configuration->Time_Limit);
+		SolverSetLoopsLimit(&Pointer_Workers[i].Solver, Pointer_Configuration->Loops_Limit);
+		SolverSetCancellationFlag(&Pointer_Workers[i].Solver, &Daemon_Is_Stop_Requested);
+		if (Pointer_Dancing_Links != NULL) SolverSetDancingLinks(&Pointer_Workers[i].Solver, &Pointer_Dancing_Links[i]);
+	}
+	
+	// Start the solving threads
+	for (i = 0; i < Threads_Count; i++)
+	{
+		pthread_attr_init(&Thread_Attributes);
+		if (Pointer_Configuration->Is_Threads_Pinning_Enabled)
+		{
+			CPU_ZERO(&Processors_Set);
+			CPU_SET(i % Processors_Count, &Processors_Set);
+			pthread_attr_setaffinity_np(&Thread_Attributes, sizeof(Processors_Set), &Processors_Set);
+		}
+		
+		if (pthread_create(&Pointer_Workers[i].Thread, &Thread_Attributes, DaemonWorkerThread, &Pointer_Workers[i]) != 0)
+		{
+			pthread_attr_destroy(&Thread_Attributes);
+			break;
+		}
+		pthread_attr_destroy(&Thread_Attributes);
+	}
+	Threads_Count = i;
+	
+	if (Threads_Count == 0)
+	{
+		fprintf(stderr, "Error : could not start the solving threads.\n");
+		Exit_Code = EXIT_FAILURE;
+	}
+	// Read the requests from the standard input, until all of them are answered
+	else if (String_Socket_File_Name == NULL)
+	{
+		if (DaemonInitializeClient(&Standard_Client, STDIN_FILENO, STDOUT_FILENO, 0) != 0)
+		{
+			fprintf(stderr, "Error : not enough memory for the responses backlog.\n");
+			Exit_Code = EXIT_FAILURE;
+		}
+		else
+		{
+			if (DaemonServeClient(&Standard_Client) != 0) Exit_Code = EXIT_FAILURE;
+			if (Standard_Client.Is_Output_Failed)
+			{
+				fprintf(stderr, "Error : could not write the responses.\n");
+				Exit_Code = EXIT_FAILURE;
+			}
+			DaemonUninitializeClient(&Standard_Client);
+		}
+	}
+	// Give each client its own threads
+	else
+	{
+		Poll_Descriptor.fd = Listening_Socket;
+		Poll_Descriptor.events = POLLIN;
+		
+		while (!atomic_load(&Daemon_Is_Stop_Requested))
+		{
+			if (ppoll(&Poll_Descriptor, 1, NULL, &Original_Signals) <= 0) continue;
+			Client_Socket = accept(Listening_Socket, NULL, NULL);
+			if (Client_Socket < 0) continue;
+			
+			// Free the previous connections that are over
+			DaemonReleaseClients(&Pointer_Clients, 0);
+			
+			Pointer_Client = malloc(sizeof(TDaemonClient));
+			if ((Pointer_Client == NULL) || (DaemonInitializeClient(Pointer_Client, Client_Socket, Client_Socket, 1) != 0))
+			{
+				close(Client_Socket);
+				free(Pointer_Client);
+				continue;
+			}
+			if (pthread_create(&Pointer_Client->Thread, NULL, DaemonClientThread, Pointer_Client) != 0)
+			{
+				close(Client_Socket);
+				DaemonUninitializeClient(Pointer_Client);
+				free(Pointer_Client);
+				continue;
+			}
+			Pointer_Client->Pointer_Next_Client = Pointer_Clients;
+			Pointer_Clients = Pointer_Client;
+		}
+		
+		// Stop reading the connections, their threads are over when their queued requests are answered
+		for (Pointer_Client = Pointer_Clients; Pointer_Client != NULL; Pointer_Client = Pointer_Client->Pointer_Next_Client) shutdown(Pointer_Client->Input_File_Descriptor, SHUT_RD);
+		DaemonReleaseClients(&Pointer_Clients, 1);
+	}
+	
+	// Answer the queued requests, then stop the solving threads
+	pthread_mutex_lock(&Daemon_Queue.Mutex);
+	Daemon_Queue.Is_Stopping = 1;
+	pthread_cond_broadcast(&Daemon_Queue.Not_Empty_Condition);
+	pthread_mutex_unlock(&Daemon_Queue.Mutex);
+	for (i = 0; i < Threads_Count; i++) pthread_join(Pointer_Workers[i].Thread, NULL);
+	
+	if (Listening_Socket >= 0)
+	{
+		close(Listening_Socket);
+		unlink(String_Socket_File_Name);
+	}
+	free(Pointer_Workers);
+	free(Pointer_Dancing_Links);
+	return Exit_Code;
+}
@@ -0,0 +1,258 @@
+/** @file Dancing_Links.c
+ * @see Dancing_Links.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Dancing_Links.h>
+#include <string.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** The root node index, the columns headers are linked to it. */
+#define DANCING_LINKS_ROOT_NODE 0
+
+/** Keep only the loops count bits that are zero when the polling callback must be called (it is called every 1024 loops). */
+#define DANCING_LINKS_POLLING_PERIOD_MASK 1023
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Remove a column from the headers list and remove all rows of this column from the other columns.
+ * @param Pointer_Dancing_Links The engine context.
+ * @param Column The column header node.
+ */
+static inline void DancingLinksCoverColumn(TDancingLinks *Pointer_Dancing_Links, int Column)
+{
+	TDancingLinksNode *Pointer_Nodes = Pointer_Dancing_Links->Nodes;
+	int Row_Node, Node;
+	
+	Pointer_Nodes[Pointer_Nodes[Column].Right].Left = Pointer_Nodes[Column].Left;
+	Pointer_Nodes[Pointer_Nodes[Column].Left].Right = Pointer_Nodes[Column].Right;
+	
+	for (Row_Node = Pointer_Nodes[Column].Down; Row_Node != Column; Row_Node = Pointer_Nodes[Row_Node].Down)
+	{
+		for (Node = Pointer_Nodes[Row_Node].Right; Node != Row_Node; Node = Pointer_Nodes[Node].Right)
+		{
+			Pointer_Nodes[Pointer_Nodes[Node].Down].Up = Pointer_Nodes[Node].Up;
+			Pointer_Nodes[Pointer_Nodes[Node].Up].Down = Pointer_Nodes[Node].Down;
+			Pointer_Dancing_Links->Columns_Size[Pointer_Nodes[Node].Column]--;
+		}
+	}
+}
+
+/** Exactly revert DancingLinksCoverColumn() (the links are restored in the reverse order).
+ * @param Pointer_Dancing_Links The engine context.
+ * @param Column The column header node.
+ */
+static inline void DancingLinksUncoverColumn(TDancingLinks *Pointer_Dancing_Links, int Column)
+{
+	TDancingLinksNode *Pointer_Nodes = Pointer_Dancing_Links->Nodes;
+	int Row_Node, Node;
+	
+	for (Row_Node = Pointer_Nodes[Column].Up; Row_Node != Column; Row_Node = Pointer_Nodes[Row_Node].Up)
+	{
+		for (Node = Pointer_Nodes[Row_Node].Left; Node != Row_Node; Node = Pointer_Nodes[Node].Left)
+		{
+			Pointer_Dancing_Links->Columns_Size[Pointer_Nodes[Node].Column]++;
+			Pointer_Nodes[Pointer_Nodes[Node].Down].Up = Node;
+			Pointer_Nodes[Pointer_Nodes[Node].Up].Down = Node;
+		}
+	}
+	
+	Pointer_Nodes[Pointer_Nodes[Column].Right].Left = Column;
+	Pointer_Nodes[Pointer_Nodes[Column].Left].Right = Column;
+}
+
+/** Get the columns satisfied by placing a number in a cell.
+ * @param Pointer_Grid The grid.
+ * @param Cell_Index The cell index.
+ * @param Number The number.
+ * @param Columns On output, contain the 4 column indexes (starting from 0, add 1 to get the header node).
+ */
+static inline void DancingLinksGetRowColumns(TGrid *Pointer_Grid, int Cell_Index, int Number, int Columns[4])
+{
+	const TGridGeometry *Pointer_Geometry = Pointer_Grid->Pointer_Geometry;
+	int Size, Cells_Count;
+	
+	Size = Pointer_Grid->Size;
+	Cells_Count = Size * Size;
+	Columns[0] = Cell_Index;
+	Columns[1] = Cells_Count + Pointer_Geometry->Cells_Row[Cell_Index] * Size + Number;
+	Columns[2] = 2 * Cells_Count + Pointer_Geometry->Cells_Column[Cell_Index] * Size + Number;
+	Columns[3] = 3 * Cells_Count + Pointer_Geometry->Cells_Square[Cell_Index] * Size + Number;
+}
+
+/** The Algorithm X recursive search.
+ * @param Pointer_Dancing_Links The engine context.
+ * @param Depth How many matrix rows are already chosen.
+ * @return 1 if the solutions limit was reached or 0 if the search must go on.
+ */
+static int DancingLinksSearch(TDancingLinks *Pointer_Dancing_Links, int Depth)
+{
+	TDancingLinksNode *Pointer_Nodes = Pointer_Dancing_Links->Nodes;
+	int Column, Chosen_Column, Minimum_Size, Row_Node, Node;
+	
+	// All constraints are satisfied, stop when enough solutions are found
+	if (Pointer_Nodes[DANCING_LINKS_ROOT_NODE].Right == DANCING_LINKS_ROOT_NODE)
+	{
+		Pointer_Dancing_Links->Solution_Rows_Count = Depth;
+		Pointer_Dancing_Links->Solutions_Count++;
+		if (Pointer_Dancing_Links->Solution_Callback != NULL) Pointer_Dancing_Links->Solution_Callback(Pointer_Dancing_Links->Pointer_Callbacks_Argument);
+		return Pointer_Dancing_Links->Solutions_Count == Pointer_Dancing_Links->Solutions_Limit;
+	}
+	
+	// Stop the search if requested
+	if (((Pointer_Dancing_Links->Loops_Count & DANCING_LINKS_POLLING_PERIOD_MASK) == 0) && (Pointer_Dancing_Links->Poll_Callback != NULL) && Pointer_Dancing_Links->Poll_Callback(Pointer_Dancing_Links->Pointer_Callbacks_Argument))
+	{
+		Pointer_Dancing_Links->Is_Stopped = 1;
+		return 0;
+	}
+	
+	// Branch on the constraint that can be satisfied by the fewest rows
+	Chosen_Column = Pointer_Nodes[DANCING_LINKS_ROOT_NODE].Right;
+	Minimum_Size = Pointer_Dancing_Links->Columns_Size[Chosen_Column];
+	for (Column = Pointer_Nodes[Chosen_Column].Right; (Column != DANCING_LINKS_ROOT_NODE) && (Minimum_Size > 1); Column = Pointer_Nodes[Column].Right)
+	{
+		if (Pointer_Dancing_Links->Columns_Size[Column] < Minimum_Size)
+		{
+			Chosen_Column = Column;
+			Minimum_Size = Pointer_Dancing_Links->Columns_Size[Column];
+		}
+	}
+	if (Minimum_Size == 0) return 0; // This constraint can't be satisfied anymore
+	
+	DancingLinksCoverColumn(Pointer_Dancing_Links, Chosen_Column);
+	for (Row_Node = Pointer_Nodes[Chosen_Column].Down; Row_Node != Chosen_Column; Row_Node = Pointer_Nodes[Row_Node].Down)
+	{
+		// Try the row
+		Pointer_Dancing_Links->Solution_Rows[Depth] = Pointer_Nodes[Row_Node].Row;
+		Pointer_Dancing_Links->Loops_Count++;
+		for (Node = Pointer_Nodes[Row_Node].Right; Node != Row_Node; Node = Pointer_Nodes[Node].Right) DancingLinksCoverColumn(Pointer_Dancing_Links, Pointer_Nodes[Node].Column);
+		
+		if (DancingLinksSearch(Pointer_Dancing_Links, Depth + 1) == 1) return 1; // The matrix is left as is, it is rebuilt when the next grid is loaded
+		
+		// Dead end, restore the matrix
+		for (Node = Pointer_Nodes[Row_Node].Left; Node != Row_Node; Node = Pointer_Nodes[Node].Left) DancingLinksUncoverColumn(Pointer_Dancing_Links, Pointer_Nodes[Node].Column);
+		Pointer_Dancing_Links->Bad_Solutions_Found_Count++;
+		
+		if (Pointer_Dancing_Links->Is_Stopped) break;
+	}
+	DancingLinksUncoverColumn(Pointer_Dancing_Links, Chosen_Column);
+	return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+void DancingLinksLoadFromGrid(TDancingLinks *Pointer_Dancing_Links, TGrid *Pointer_Grid)
+{
+	TDancingLinksNode *Pointer_Nodes = Pointer_Dancing_Links->Nodes, *Pointer_Node;
+	int Cell_Index, Cells_Count, Columns_Count, Column, Header_Node, Previous_Header_Node, Free_Node, First_Row_Node, Columns[4], i, Value;
+	unsigned int Number;
+	
+	Pointer_Dancing_Links->Grid_Size = Pointer_Grid->Size;
+	Pointer_Dancing_Links->Is_Grid_Consistent = 1;
+	Pointer_Dancing_Links->Solution_Rows_Count = 0;
+	Pointer_Dancing_Links->Loops_Count = 1;
+	Pointer_Dancing_Links->Bad_Solutions_Found_Count = 0;
+	Cells_Count = Pointer_Grid->Size * Pointer_Grid->Size;
+	Columns_Count = 4 * Cells_Count;
+	
+	// Find the constraints already satisfied by the filled cells, a constraint satisfied twice means that the grid is wrong
+	memset(Pointer_Dancing_Links->Is_Column_Satisfied, 0, Columns_Count);
+	for (Cell_Index = 0; Cell_Index < Cells_Count; Cell_Index++)
+	{
+		Value = Pointer_Grid->Cells[Cell_Index];
+		if (Value == GRID_EMPTY_CELL_VALUE) continue;
+		
+		DancingLinksGetRowColumns(Pointer_Grid, Cell_Index, Value, Columns);
+		for (i = 0; i < 4; i++)
+		{
+			if (Pointer_Dancing_Links->Is_Column_Satisfied[Columns[i]]) Pointer_Dancing_Links->Is_Grid_Consistent = 0;
+			Pointer_Dancing_Links->Is_Column_Satisfied[Columns[i]] = 1;
+		}
+	}
+	
+	// Link the headers of the remaining constraints to the root node (the header of the column N is the node N + 1)
+	Previous_Header_Node = DANCING_LINKS_ROOT_NODE;
+	for (Column = 0; Column < Columns_Count; Column++)
+	{
+		Header_Node = Column + 1;
+		Pointer_Node = &Pointer_Nodes[Header_Node];
+		Pointer_Node->Up = Header_Node;
+		Pointer_Node->Down = Header_Node;
+		Pointer_Node->Column = Header_Node;
+		Pointer_Node->Row = -1;
+		Pointer_Dancing_Links->Columns_Size[Header_Node] = 0;
+		if (Pointer_Dancing_Links->Is_Column_Satisfied[Column]) continue;
+		
+		Pointer_Node->Left = Previous_Header_Node;
+		Pointer_Nodes[Previous_Header_Node].Right = Header_Node;
+		Previous_Header_Node = Header_Node;
+	}
+	Pointer_Nodes[Previous_Header_Node].Right = DANCING_LINKS_ROOT_NODE;
+	Pointer_Nodes[DANCING_LINKS_ROOT_NODE].Left = Previous_Header_Node;
+	
+	// Add a row for each number allowed in each empty cell
+	Free_Node = Columns_Count + 1;
+	for (Cell_Index = 0; Cell_Index < Cells_Count; Cell_Index++)
+	{
+		if (Pointer_Grid->Cells[Cell_Index] != GRID_EMPTY_CELL_VALUE) continue;
+		
+		for (Number = 0; Number < Pointer_Grid->Size; Number++)
+		{
+			DancingLinksGetRowColumns(Pointer_Grid, Cell_Index, Number, Columns);
+			if (Pointer_Dancing_Links->Is_Column_Satisfied[Columns[1]] || Pointer_Dancing_Links->Is_Column_Satisfied[Columns[2]] || Pointer_Dancing_Links->Is_Column_Satisfied[Columns[3]]) continue;
+			
+			// Append the row nodes at the bottom of their columns and link them together
+			First_Row_Node = Free_Node;
+			for (i = 0; i < 4; i++)
+			{
+				Header_Node = Columns[i] + 1;
+				Pointer_Node = &Pointer_Nodes[Free_Node];
+				Pointer_Node->Column = Header_Node;
+				Pointer_Node->Row = Cell_Index * Pointer_Grid->Size + Number;
+				Pointer_Node->Up = Pointer_Nodes[Header_Node].Up;
+				Pointer_Node->Down = Header_Node;
+				Pointer_Nodes[Pointer_Nodes[Header_Node].Up].Down = Free_Node;
+				Pointer_Nodes[Header_Node].Up = Free_Node;
+				Pointer_Dancing_Links->Columns_Size[Header_Node]++;
+				
+				Pointer_Node->Left = (i == 0) ? First_Row_Node + 3 : Free_Node - 1;
+				Pointer_Node->Right = (i == 3) ? First_Row_Node : Free_Node + 1;
+				Free_Node++;
+			}
+		}
+	}
+}
+
+int DancingLinksSolve(TDancingLinks *Pointer_Dancing_Links, unsigned long long Solutions_Limit, TDancingLinksSolutionCallback Solution_Callback, TDancingLinksPollCallback Poll_Callback, void *Pointer_Argument)
+{
+	Pointer_Dancing_Links->Solutions_Limit = Solutions_Limit;
+	Pointer_Dancing_Links->Solutions_Count = 0;
+	Pointer_Dancing_Links->Solution_Callback = Solution_Callback;
+	Pointer_Dancing_Links->Poll_Callback = Poll_Callback;
+	Pointer_Dancing_Links->Pointer_Callbacks_Argument = Pointer_Argument;
+	Pointer_Dancing_Links->Is_Stopped = 0;
+	if (!Pointer_Dancing_Links->Is_Grid_Consistent) return 0;
+	
+	if (DancingLinksSearch(Pointer_Dancing_Links, 0) == 1) return 1;
+	if (Pointer_Dancing_Links->Is_Stopped) return -1;
+	return 0;
+}
+
+void DancingLinksGetSolution(TDancingLinks *Pointer_Dancing_Links, TGrid *Pointer_Grid)
+{
+	int i, Cell_Index, Row, Column;
+	unsigned int Number;
+	
+	for (i = 0; i < Pointer_Dancing_Links->Solution_Rows_Count; i++)
+	{
+		Cell_Index = Pointer_Dancing_Links->Solution_Rows[i] / Pointer_Dancing_Links->Grid_Size;
+		Number = Pointer_Dancing_Links->Solution_Rows[i] % Pointer_Dancing_Links->Grid_Size;
+		Row = Pointer_Grid->Pointer_Geometry->Cells_Row[Cell_Index];
+		Column = Pointer_Grid->Pointer_Geometry->Cells_Column[Cell_Index];
+		GridSetCellValue(Pointer_Grid, Row, Column, Number);
+		GridRemoveCellMissingNumber(Pointer_Grid, Row, Column, Number);
+	}
+}
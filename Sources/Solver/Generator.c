@@ -0,0 +1,233 @@
+/** @file Generator.c
+ * @see Generator.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Generator.h>
+#include <Grid.h>
+#include <Solver.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** The biggest grids whose complete grid is built by the solver. The solver can take a very long time to fill a bigger empty grid when its random choices are bad, so the bigger grids are built from a shuffled pattern. */
+#define GENERATOR_SOLVER_FILL_MAXIMUM_SIZE 25
+/** How many loops the solver can do per grid cell to fill a complete grid. Most fills need about one loop per cell, but some bad random choices near the search tree root can make the solver backtrack for hours, so a fill taking too long is restarted with other random choices. */
+#define GENERATOR_SOLVER_FILL_LOOPS_PER_CELL 16
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Get the next random number.
+ * @param Pointer_Generator The generator context.
+ * @return A random number.
+ */
+static inline unsigned int GeneratorGetRandomNumber(TGenerator *Pointer_Generator)
+{
+	unsigned int State;
+	
+	State = Pointer_Generator->Random_State;
+	State ^= State << 13;
+	State ^= State >> 17;
+	State ^= State << 5;
+	Pointer_Generator->Random_State = State;
+	return State;
+}
+
+/** Shuffle an array of integers.
+ * @param Pointer_Generator The generator context.
+ * @param Pointer_Values The values to shuffle.
+ * @param Values_Count How many values the array contains.
+ */
+static void GeneratorShuffle(TGenerator *Pointer_Generator, int *Pointer_Values, int Values_Count)
+{
+	int i, j, Value;
+	
+	for (i = Values_Count - 1; i > 0; i--)
+	{
+		j = GeneratorGetRandomNumber(Pointer_Generator) % (i + 1);
+		Value = Pointer_Values[i];
+		Pointer_Values[i] = Pointer_Values[j];
+		Pointer_Values[j] = Value;
+	}
+}
+
+/** Build a random complete grid with the solver, trying the numbers in a random order.
+ * @param Pointer_Generator The generator context.
+ * @param Pointer_Grid An empty grid, on output it contains the complete grid.
+ */
+static void GeneratorFillGridWithSolver(TGenerator *Pointer_Generator, TGrid *Pointer_Grid)
+{
+	TSolverConfiguration Configuration;
+	TGrid Empty_Grid;
+	int Numbers[CONFIGURATION_GRID_MAXIMUM_SIZE], i, Result;
+	
+	GridCopy(&Empty_Grid, Pointer_Grid);
+	Configuration = Pointer_Generator->Solver.Configuration;
+	SolverSetLoopsLimit(&Pointer_Generator->Solver, GENERATOR_SOLVER_FILL_LOOPS_PER_CELL * Pointer_Grid->Size * Pointer_Grid->Size);
+	
+	do
+	{
+		// Any permutation of the numbers is a valid first row, this saves the solver some guesses
+		GridCopy(Pointer_Grid, &Empty_Grid);
+		for (i = 0; i < (int) Pointer_Grid->Size; i++) Numbers[i] = i;
+		GeneratorShuffle(Pointer_Generator, Numbers, Pointer_Grid->Size);
+		for (i = 0; i < (int) Pointer_Grid->Size; i++)
+		{
+			GridSetCellValue(Pointer_Grid, 0, i, Numbers[i]);
+			GridRemoveCellMissingNumber(Pointer_Grid, 0, i, Numbers[i]);
+		}
+		
+		// Let the solver fill the other rows (a grid with a single filled row always has a solution, so the solving can only be cancelled by the loops limit)
+		Configuration.Random_Seed = GeneratorGetRandomNumber(Pointer_Generator);
+		SolverSetConfiguration(&Pointer_Generator->Solver, &Configuration);
+		SolverLoadFromGrid(&Pointer_Generator->Solver, Pointer_Grid);
+		Result = SolverSolve(&Pointer_Generator->Solver);
+	} while (Result != SOLVER_RESULT_SOLVED);
+	
+	SolverSetLoopsLimit(&Pointer_Generator->Solver, 0);
+	GridCopy(Pointer_Grid, &Pointer_Generator->Solver.Grid);
+}
+
+/** Build a random complete grid by shuffling a regular pattern : the numbers are renamed, the rows are shuffled inside their band of squares and the bands are shuffled, and the same is done to the columns. All these changes keep a grid valid, so this never needs a guess.
+ * @param Pointer_Generator The generator context.
+ * @param Pointer_Grid An empty grid, on output it contains the complete grid.
+ */
+static void GeneratorFillGridFromPattern(TGenerator *Pointer_Generator, TGrid *Pointer_Grid)
+{
+	int Numbers[CONFIGURATION_GRID_MAXIMUM_SIZE], Rows[CONFIGURATION_GRID_MAXIMUM_SIZE], Columns[CONFIGURATION_GRID_MAXIMUM_SIZE], Bands[CONFIGURATION_GRID_MAXIMUM_SIZE], Lines[CONFIGURATION_GRID_MAXIMUM_SIZE], i, j, Number;
+	unsigned int Size = Pointer_Grid->Size, Width = Pointer_Grid->Square_Width, Height = Pointer_Grid->Square_Height, Row, Column;
+	
+	for (i = 0; i < (int) Size; i++) Numbers[i] = i;
+	GeneratorShuffle(Pointer_Generator, Numbers, Size);
+	
+	// Shuffle the bands of Height rows, then the rows of each band
+	for (i = 0; i < (int) Width; i++) Bands[i] = i;
+	GeneratorShuffle(Pointer_Generator, Bands, Width);
+	for (i = 0; i < (int) Width; i++)
+	{
+		for (j = 0; j < (int) Height; j++) Lines[j] = Bands[i] * Height + j;
+		GeneratorShuffle(Pointer_Generator, Lines, Height);
+		for (j = 0; j < (int) Height; j++) Rows[i * Height + j] = Lines[j];
+	}
+	
+	// Shuffle the stacks of Width columns, then the columns of each stack
+	for (i = 0; i < (int) Height; i++) Bands[i] = i;
+	GeneratorShuffle(Pointer_Generator, Bands, Height);
+	for (i = 0; i < (int) Height; i++)
+	{
+		for (j = 0; j < (int) Width; j++) Lines[j] = Bands[i] * Width + j;
+		GeneratorShuffle(Pointer_Generator, Lines, Width);
+		for (j = 0; j < (int) Width; j++) Columns[i * Width + j] = Lines[j];
+	}
+	
+	// Each row of a band is shifted by a whole square width from the previous one, and each band is shifted by one cell from the previous one, so each row, column and square holds all numbers
+	for (Row = 0; Row < Size; Row++)
+	{
+		for (Column = 0; Column < Size; Column++)
+		{
+			Number = Numbers[(Width * (Rows[Row] % Height) + Rows[Row] / Height + Columns[Column]) % Size];
+			GridSetCellValue(Pointer_Grid, Row, Column, Number);
+			GridRemoveCellMissingNumber(Pointer_Grid, Row, Column, Number);
+		}
+	}
+}
+
+/** Tell whether a grid still has a single solution after one of its givens was removed. The grid had a single solution before, so another solution must have another number in the emptied cell : each other allowed number is tried in this cell and the grid has a single solution when none of these grids can be solved.
+ * @param Pointer_Generator The generator context.
+ * @param Pointer_Grid The grid, it is not modified.
+ * @param Row The emptied cell row.
+ * @param Column The emptied cell column.
+ * @param Removed_Value The number that was removed from the cell.
+ * @return 1 if the grid has a single solution,
+ * @return 0 if the grid has several solutions.
+ */
+static int GeneratorIsSolutionUnique(TGenerator *Pointer_Generator, TGrid *Pointer_Grid, unsigned int Row, unsigned int Column, int Removed_Value)
+{
+	TGridBitmask Other_Numbers;
+	int Number, Is_Solved;
+	
+	Other_Numbers = GridGetCellMissingNumbers(Pointer_Grid, Row, Column) & ~GRID_BITMASK_NUMBER(Removed_Value);
+	while (Other_Numbers != 0)
+	{
+		Number = GRID_BITMASK_GET_SMALLEST_NUMBER(Other_Numbers);
+		Other_Numbers &= Other_Numbers - 1;
+		
+		GridSetCellValue(Pointer_Grid, Row, Column, Number);
+		GridRemoveCellMissingNumber(Pointer_Grid, Row, Column, Number);
+		Pointer_Generator->Uniqueness_Checks_Count++;
+		SolverLoadFromGrid(&Pointer_Generator->Solver, Pointer_Grid);
+		Is_Solved = SolverSolve(&Pointer_Generator->Solver) == SOLVER_RESULT_SOLVED;
+		GridSetCellValue(Pointer_Grid, Row, Column, GRID_EMPTY_CELL_VALUE);
+		GridRestoreCellMissingNumber(Pointer_Grid, Row, Column, Number);
+		
+		if (Is_Solved) return 0;
+	}
+	return 1;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+void GeneratorInitialize(TGenerator *Pointer_Generator)
+{
+	TSolverConfiguration Configuration;
+	
+	SolverInitialize(&Pointer_Generator->Solver);
+	SolverGetDefaultConfiguration(&Configuration);
+	Configuration.Number_Order = SOLVER_NUMBER_ORDER_RANDOM;
+	SolverSetConfiguration(&Pointer_Generator->Solver, &Configuration);
+	
+	GeneratorSetSeed(Pointer_Generator, 0);
+	Pointer_Generator->Uniqueness_Checks_Count = 0;
+}
+
+void GeneratorSetSeed(TGenerator *Pointer_Generator, unsigned long long Seed)
+{
+	// Mix the seed bits (this is the SplitMix64 finalizer), so close seeds give unrelated random numbers
+	Seed += 0x9E3779B97F4A7C15ULL;
+	Seed = (Seed ^ (Seed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	Seed = (Seed ^ (Seed >> 27)) * 0x94D049BB133111EBULL;
+	Seed ^= Seed >> 31;
+	
+	Pointer_Generator->Random_State = (unsigned int) (Seed ^ (Seed >> 32));
+	if (Pointer_Generator->Random_State == 0) Pointer_Generator->Random_State = 1; // The generator would only produce zeros
+}
+
+int GeneratorGenerate(TGenerator *Pointer_Generator, unsigned int Size, unsigned int Givens_Target, TGrid *Pointer_Puzzle, TGrid *Pointer_Solution)
+{
+	const TGridGeometry *Pointer_Geometry;
+	int i, Cells_Count, Cell_Index, Value, Givens_Count;
+	unsigned int Row, Column;
+	
+	if (GridInitialize(Pointer_Puzzle, Size) != 0) return -2;
+	if (Size <= GENERATOR_SOLVER_FILL_MAXIMUM_SIZE) GeneratorFillGridWithSolver(Pointer_Generator, Pointer_Puzzle);
+	else GeneratorFillGridFromPattern(Pointer_Generator, Pointer_Puzzle);
+	if (Pointer_Solution != NULL) GridCopy(Pointer_Solution, Pointer_Puzzle);
+	
+	// Try to remove each given once, in a random order
+	Cells_Count = Size * Size;
+	for (i = 0; i < Cells_Count; i++) Pointer_Generator->Cells_Indexes[i] = i;
+	GeneratorShuffle(Pointer_Generator, Pointer_Generator->Cells_Indexes, Cells_Count);
+	
+	Pointer_Geometry = Pointer_Puzzle->Pointer_Geometry;
+	Givens_Count = Cells_Count;
+	for (i = 0; (i < Cells_Count) && (Givens_Count > (int) Givens_Target); i++)
+	{
+		Cell_Index = Pointer_Generator->Cells_Indexes[i];
+		Row = Pointer_Geometry->Cells_Row[Cell_Index];
+		Column = Pointer_Geometry->Cells_Column[Cell_Index];
+		Value = Pointer_Puzzle->Cells[Cell_Index];
+		
+		GridSetCellValue(Pointer_Puzzle, Row, Column, GRID_EMPTY_CELL_VALUE);
+		GridRestoreCellMissingNumber(Pointer_Puzzle, Row, Column, Value);
+		
+		if (GeneratorIsSolutionUnique(Pointer_Generator, Pointer_Puzzle, Row, Column, Value)) Givens_Count--;
+		// Put the given back, the grid would have several solutions without it (removing it later would not help, as removing other givens can only add solutions)
+		else
+		{
+			GridSetCellValue(Pointer_Puzzle, Row, Column, Value);
+			GridRemoveCellMissingNumber(Pointer_Puzzle, Row, Column, Value);
+		}
+	}
+	return 0;
+}
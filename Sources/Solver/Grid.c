@@ -3,9 +3,11 @@
  * @author Adrien RICCIARDI
  */
 #include <assert.h>
-#include <Cells_Stack.h>
 #include <Configuration.h>
 #include <Grid.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -14,438 +16,621 @@
 // Private macros
 //-------------------------------------------------------------------------------------------------
 /** Get the square index (in the Bitmask_Squares array) in which the cell is located. The formula is Square_Row * Squares_Horizontal_Count + Square_Column.
+ * @param Pointer_Grid The grid.
  * @param Row Cell row coordinate.
  * @param Column Cell column coordinate.
  * @return The square index in the Bitmask_Squares array.
  */
-#define GRID_GET_CELL_SQUARE_INDEX(Row, Column) ((Row / Square_Height) * Squares_Horizontal_Count + (Column / Square_Width))
+#define GRID_GET_CELL_SQUARE_INDEX(Pointer_Grid, Row, Column) ((Row / (Pointer_Grid)->Square_Height) * (Pointer_Grid)->Squares_Horizontal_Count + (Column / (Pointer_Grid)->Square_Width))
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** Size of a buffer able to hold a whole grid stored on a single line (+1 to determinate that the line is too long, and +1 for terminating zero). */
+#define GRID_LINE_BUFFER_SIZE (GRID_STRING_SIZE + 1)
+
+/** How many grid shapes are supported. */
+#define GRID_SHAPES_COUNT (sizeof(Grid_Shapes) / sizeof(Grid_Shapes[0]))
+
+/** The characters representing the cell values, in the values order. */
+#define GRID_VALUES_CHARACTERS "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz@#"
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** Where the grid lines are read from. */
+typedef struct
+{
+	FILE *File; //! The file to read from, or NULL if the lines are read from a string.
+	const char *String; //! The beginning of the next line to read when the lines are read from a string.
+} TGridLinesSource;
+
+/** The shape of the grids of a given size. */
+typedef struct
+{
+	unsigned int Size; //! The grid side size in cells.
+	unsigned int Square_Width; //! Width of a square in cells.
+	unsigned int Square_Height; //! Height of a square in cells.
+	int Display_Starting_Number; //! The number added to all cell values when the grid is displayed.
+} TGridShape;
 
 //-------------------------------------------------------------------------------------------------
 // Private variables
 //-------------------------------------------------------------------------------------------------
-/** The grid. */
-static int Grid[CONFIGURATION_GRID_MAXIMUM_SIZE][CONFIGURATION_GRID_MAXIMUM_SIZE];
-/** Current grid side size in cells. */
-static unsigned int Grid_Size;
-/** Dimensions of a square in cells. */
-static unsigned int Square_Width, Square_Height, Squares_Horizontal_Count, Squares_Vertical_Count;
-/** The grid starting number (usually 0 or 1) added to all cell values when the grid is displayed. */
-static int Grid_Display_Starting_Number;
-
-/** All row bitmasks. */
-static unsigned int Bitmask_Rows[CONFIGURATION_GRID_MAXIMUM_SIZE];
-/** All column bitmasks. */
-static unsigned int Bitmask_Columns[CONFIGURATION_GRID_MAXIMUM_SIZE];
-/** All square bitmasks. */
-static unsigned int Bitmask_Squares[CONFIGURATION_GRID_MAXIMUM_SIZE];
+/** All supported grid shapes. */
+static const TGridShape Grid_Shapes[] =
+{
+	{ 6, 3, 2, 1 },
+	{ 9, 3, 3, 1 },
+	{ 12, 4, 3, 1 },
+	{ 16, 4, 4, 0 }
+	#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 25
+		, { 25, 5, 5, 0 }
+	#endif
+	#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 36
+		, { 36, 6, 6, 0 }
+	#endif
+	#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 49
+		, { 49, 7, 7, 0 }
+	#endif
+	#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 64
+		, { 64, 8, 8, 0 }
+	#endif
+};
+
+/** The geometry tables of each supported grid shape (in the same order than the shapes). */
+static TGridGeometry Grid_Geometries[GRID_SHAPES_COUNT];
+/** Tell whether the geometry tables of each shape have been built. */
+static atomic_int Grid_Geometries_Is_Built[GRID_SHAPES_COUNT];
+/** Make sure a geometry is built by a single thread. */
+static pthread_mutex_t Grid_Geometries_Mutex = PTHREAD_MUTEX_INITIALIZER;
 
 //-------------------------------------------------------------------------------------------------
 // Private functions
 //-------------------------------------------------------------------------------------------------
-/** Create the initial bitmasks for all rows, columns and squares. */
-static inline void GridGenerateInitialBitmasks(void)
+/** Create the initial bitmasks for all rows, columns and squares.
+ * @param Pointer_Grid The grid, its geometry must be set.
+ */
+static inline void GridGenerateInitialBitmasks(TGrid *Pointer_Grid)
 {
-	unsigned int Row, Column, Number, Column_Start, Row_End, Column_End, Square_Row, Square_Column, i;
-	int Is_Number_Found[CONFIGURATION_GRID_MAXIMUM_SIZE];
+	const TGridGeometry *Pointer_Geometry = Pointer_Grid->Pointer_Geometry;
+	unsigned int i, Cells_Count;
+	TGridBitmask Bitmask_All_Numbers, Bitmask_Number;
+	int Number;
 	
-	// Parse all rows
-	for (Row = 0; Row < Grid_Size; Row++)
+	// Start with all numbers allowed
+	Bitmask_All_Numbers = GRID_BITMASK_NUMBER(Pointer_Grid->Size - 1) | (GRID_BITMASK_NUMBER(Pointer_Grid->Size - 1) - 1); // Computed this way to avoid shifting by the bitmask width for the 32x32 and 64x64 grids
+	for (i = 0; i < Pointer_Grid->Size; i++)
 	{
-		// Initialize values
-		Bitmask_Rows[Row] = 0;
-		memset(Is_Number_Found, 0, sizeof(Is_Number_Found));
-		
-		// Find available numbers
-		for (Column = 0; Column < Grid_Size; Column++)
-		{
-			Number = Grid[Row][Column];
-			if (Number != GRID_EMPTY_CELL_VALUE) Is_Number_Found[Number] = 1;
-		}
-		
-		// Set corresponding bits into bitmask
-		for (Number = 0; Number < Grid_Size; Number++)
-		{
-			if (!Is_Number_Found[Number]) Bitmask_Rows[Row] |= 1 << Number;
-		}
+		Pointer_Grid->Bitmask_Rows[i] = Bitmask_All_Numbers;
+		Pointer_Grid->Bitmask_Columns[i] = Bitmask_All_Numbers;
+		Pointer_Grid->Bitmask_Squares[i] = Bitmask_All_Numbers;
 	}
 	
-	// Parse all columns
-	for (Column = 0; Column < Grid_Size; Column++)
+	// Remove the number of each filled cell from its row, column and square in a single pass (the selection is branchless, as the filled cells are not predictable)
+	Cells_Count = Pointer_Grid->Size * Pointer_Grid->Size;
+	for (i = 0; i < Cells_Count; i++)
 	{
-		// Initialize values
-		Bitmask_Columns[Column] = 0;
-		memset(Is_Number_Found, 0, sizeof(Is_Number_Found));
-		
-		// Find available numbers
-		for (Row = 0; Row < Grid_Size; Row++)
-		{
-			Number = Grid[Row][Column];
-			if (Number != GRID_EMPTY_CELL_VALUE) Is_Number_Found[Number] = 1;
-		}
-		
-		// Set corresponding bits into bitmask
-		for (Number = 0; Number < Grid_Size; Number++)
+		Number = Pointer_Grid->Cells[i];
+		Bitmask_Number = (Number != GRID_EMPTY_CELL_VALUE) ? GRID_BITMASK_NUMBER(Number & (sizeof(TGridBitmask) * 8 - 1)) : 0; // The empty cell value is masked so it is never used as a shift count
+		Pointer_Grid->Bitmask_Rows[Pointer_Geometry->Cells_Row[i]] &= ~Bitmask_Number;
+		Pointer_Grid->Bitmask_Columns[Pointer_Geometry->Cells_Column[i]] &= ~Bitmask_Number;
+		Pointer_Grid->Bitmask_Squares[Pointer_Geometry->Cells_Square[i]] &= ~Bitmask_Number;
+	}
+}
+
+/** Read the next line from a grid file or string.
+ * @param Pointer_Source The lines source.
+ * @param String_Destination Where to store the read data. The buffer must be at least GRID_LINE_BUFFER_SIZE bytes long.
+ * @return The size in characters of the read line (without terminating '\n'),
+ * @return -1 if the end of the source was reached.
+ * @note A line too long to fit in the buffer is entirely consumed and its returned size is GRID_LINE_BUFFER_SIZE - 1, which is bigger than any valid line.
+ */
+static int GridReadNextLine(TGridLinesSource *Pointer_Source, char *String_Destination)
+{
+	int Length, Character;
+	const char *String;
+
+	if (Pointer_Source->File != NULL)
+	{
+		// Try to read the next line.
+		if (fgets(String_Destination, GRID_LINE_BUFFER_SIZE, Pointer_Source->File) == NULL) return -1;
+		Length = strlen(String_Destination);
+
+		// Discard the end of a too long line to keep the next read synchronized on a line start
+		if ((Length == GRID_LINE_BUFFER_SIZE - 1) && (String_Destination[Length - 1] != '\n'))
 		{
-			if (!Is_Number_Found[Number]) Bitmask_Columns[Column] |= 1 << Number;
+			do
+			{
+				Character = fgetc(Pointer_Source->File);
+			} while ((Character != '\n') && (Character != EOF));
+			return Length;
 		}
 	}
+	else
+	{
+		String = Pointer_Source->String;
+		if (*String == 0) return -1;
+
+		// Copy the line up to the buffer size
+		for (Length = 0; (String[Length] != 0) && (String[Length] != '\n') && (Length < GRID_LINE_BUFFER_SIZE - 1); Length++) String_Destination[Length] = String[Length];
+		String_Destination[Length] = 0;
+
+		// Go to the next line start, even if the line was too long
+		String += Length;
+		while ((*String != 0) && (*String != '\n')) String++;
+		if (*String == '\n') String++;
+		Pointer_Source->String = String;
+	}
+
+	// Remove any trailing '\n' or '\r' (both are present in Windows files)
+	while ((Length > 0) && ((String_Destination[Length - 1] == '\n') || (String_Destination[Length - 1] == '\r')))
+	{
+		Length--;
+		String_Destination[Length] = 0;
+	}
+
+	return Length;
+}
+
+/** Convert a program operable value into the character representing it in a grid file.
+ * @param Value The cell value.
+ * @return The corresponding character.
+ */
+static inline char GridConvertValueToCharacter(int Value)
+{
+	if (Value == GRID_EMPTY_CELL_VALUE) return '.';
+	return GRID_VALUES_CHARACTERS[Value];
+}
+
+/** Build the tables of a grid geometry.
+ * @param Pointer_Shape The grid shape.
+ * @param Pointer_Geometry On output, contain the geometry tables.
+ */
+static void GridBuildGeometry(const TGridShape *Pointer_Shape, TGridGeometry *Pointer_Geometry)
+{
+	unsigned int Size, Row, Column, Square, Cell_Index, Peer_Row, Peer_Column, Column_Start, Column_End, Peer_Index, Peers_Count = 0, Squares_Horizontal_Count;
 	
-	// Parse all squares
-	i = 0; // Index in the square bitmasks array
+	Size = Pointer_Shape->Size;
+	Squares_Horizontal_Count = Size / Pointer_Shape->Square_Width;
 	
-	for (Square_Row = 0; Square_Row < Squares_Vertical_Count; Square_Row++)
+	// Gather the cells of each row, column and square
+	for (Row = 0; Row < Size; Row++)
 	{
-		for (Square_Column = 0; Square_Column < Squares_Horizontal_Count; Square_Column++)
+		for (Column = 0; Column < Size; Column++)
 		{
-			// Initialize values
-			Bitmask_Squares[i] = 0;
-			memset(Is_Number_Found, 0, sizeof(Is_Number_Found));
-			
-			// Determine coordinates of the square to parse
-			Row = Square_Row * Square_Height;
-			Column_Start = Square_Column * Square_Width;
-			Row_End = Row + Square_Height;
-			Column_End = Column_Start + Square_Width;
+			Cell_Index = Row * Size + Column;
+			Square = (Row / Pointer_Shape->Square_Height) * Squares_Horizontal_Count + (Column / Pointer_Shape->Square_Width);
+			Pointer_Geometry->Cells_Row[Cell_Index] = Row;
+			Pointer_Geometry->Cells_Column[Cell_Index] = Column;
+			Pointer_Geometry->Cells_Square[Cell_Index] = Square;
 			
-			// Find numbers present into the square
-			for ( ; Row < Row_End; Row++)
+			Pointer_Geometry->Units_Cells[Row][Column] = Cell_Index;
+			Pointer_Geometry->Units_Cells[Size + Column][Row] = Cell_Index;
+			Pointer_Geometry->Units_Cells[2 * Size + Square][(Row % Pointer_Shape->Square_Height) * Pointer_Shape->Square_Width + Column % Pointer_Shape->Square_Width] = Cell_Index;
+		}
+	}
+	
+	// A peer is any other cell sharing the row, the column or the square of the cell, the peers are sorted by index
+	for (Cell_Index = 0; Cell_Index < Size * Size; Cell_Index++)
+	{
+		Row = Pointer_Geometry->Cells_Row[Cell_Index];
+		Column = Pointer_Geometry->Cells_Column[Cell_Index];
+		Peers_Count = 0;
+		for (Peer_Row = 0; Peer_Row < Size; Peer_Row++)
+		{
+			// Only the rows crossing the cell square can contain peers outside of the cell column (this matters for the biggest grids)
+			if (Peer_Row / Pointer_Shape->Square_Height == Row / Pointer_Shape->Square_Height)
 			{
-				for (Column = Column_Start; Column < Column_End; Column++)
-				{
-					Number = Grid[Row][Column];
-					if (Number != GRID_EMPTY_CELL_VALUE) Is_Number_Found[Number] = 1;
-				}
+				Column_Start = 0;
+				Column_End = Size;
 			}
-			
-			// Set corresponding bits into bitmask
-			for (Number = 0; Number < Grid_Size; Number++)
+			else
 			{
-				if (!Is_Number_Found[Number]) Bitmask_Squares[i] |= 1 << Number;
+				Column_Start = Column;
+				Column_End = Column + 1;
 			}
 			
-			// Next square bitmask
-			i++;
+			for (Peer_Column = Column_Start; Peer_Column < Column_End; Peer_Column++)
+			{
+				Peer_Index = Peer_Row * Size + Peer_Column;
+				if (Peer_Index == Cell_Index) continue;
+				if ((Peer_Row == Row) || (Peer_Column == Column) || (Pointer_Geometry->Cells_Square[Peer_Index] == Pointer_Geometry->Cells_Square[Cell_Index]))
+				{
+					Pointer_Geometry->Peers[Cell_Index][Peers_Count] = Peer_Index;
+					Peers_Count++;
+				}
+			}
 		}
+		assert(Peers_Count <= GRID_MAXIMUM_PEERS_COUNT);
 	}
+	Pointer_Geometry->Peers_Count = Peers_Count; // All cells have the same peers count
 }
 
-/** Fill the stack with empty cells. */
-static void GridFillStackWithEmptyCells(void)
+/** Configure the grid geometry for the provided size.
+ * @param Pointer_Grid The grid.
+ * @param Size The grid side size in cells.
+ * @return 0 if the size can be handled by the solver,
+ * @return -2 if the size is not 6, 9, 12, 16, 25, 36, 49 or 64.
+ */
+static int GridSetSize(TGrid *Pointer_Grid, unsigned int Size)
 {
-	int Row, Column;
+	unsigned int i;
+	const TGridShape *Pointer_Shape;
 	
-	CellsStackInitialize();
+	// Find the shape of the grids of this size
+	for (i = 0; i < GRID_SHAPES_COUNT; i++)
+	{
+		if (Grid_Shapes[i].Size == Size) break;
+	}
+	if (i == GRID_SHAPES_COUNT) return -2;
+	Pointer_Shape = &Grid_Shapes[i];
 	
-	// Reverse parsing to create a stack with empty coordinates beginning on the top-left part of the grid (this allows to make speed comparisons with the older way to find empty cells)
-	for (Row = Grid_Size - 1; Row >= 0; Row--)
+	Pointer_Grid->Size = Size;
+	Pointer_Grid->Square_Width = Pointer_Shape->Square_Width;
+	Pointer_Grid->Square_Height = Pointer_Shape->Square_Height;
+	Pointer_Grid->Display_Starting_Number = Pointer_Shape->Display_Starting_Number;
+	
+	// Compute number of squares on grid width and height
+	Pointer_Grid->Squares_Horizontal_Count = Size / Pointer_Grid->Square_Width;
+	Pointer_Grid->Squares_Vertical_Count = Size / Pointer_Grid->Square_Height;
+	
+	// A geometry is built the first time a grid of its size is loaded, whatever the thread loading it (the biggest geometries take some time to build, so the unused ones are never built)
+	if (!atomic_load_explicit(&Grid_Geometries_Is_Built[i], memory_order_acquire))
 	{
-		for (Column = Grid_Size - 1; Column >= 0; Column--)
+		pthread_mutex_lock(&Grid_Geometries_Mutex);
+		if (!atomic_load_explicit(&Grid_Geometries_Is_Built[i], memory_order_relaxed))
 		{
-			if (Grid[Row][Column] == GRID_EMPTY_CELL_VALUE) CellsStackPush(Row, Column);
+			GridBuildGeometry(Pointer_Shape, &Grid_Geometries[i]);
+			atomic_store_explicit(&Grid_Geometries_Is_Built[i], 1, memory_order_release);
 		}
+		pthread_mutex_unlock(&Grid_Geometries_Mutex);
 	}
+	Pointer_Grid->Pointer_Geometry = &Grid_Geometries[i];
+	return 0;
 }
 
-/** Read the next line from a grid file.
- * @param File The file to read from.
- * @param String_Destination Where to store the read data. The buffer must be at least CONFIGURATION_GRID_MAXIMUM_SIZE + 2 bytes long (+1 to allow to load a 17-characters string and to determinate that the line is too long, and +1 for terminating zero).
- * @return The size in characters of the read line (without terminating '\n').
+/** Fill a grid row from its text representation.
+ * @param Pointer_Grid The grid.
+ * @param Row The row to fill.
+ * @param String_Cells The row cells characters (there must be at least grid size characters).
+ * @return 0 if the row was correctly loaded,
+ * @return -3 if a cell data is bad.
  */
-static int GridReadNextFileLine(FILE *File, char *String_Destination)
+static int GridLoadRow(TGrid *Pointer_Grid, unsigned int Row, char *String_Cells)
 {
-	int Length, New_Line_Character_Index;
-
-	// Try to read the next line.
-	if (fgets(String_Destination, CONFIGURATION_GRID_MAXIMUM_SIZE + 2, File) == NULL) return 0;
-
-	// Remove any trailing '\n' or '\r'
-	Length = strlen(String_Destination);
-	New_Line_Character_Index = Length - 1; // The index in the string where the new line character can be
-	if ((New_Line_Character_Index >= 0) && ((String_Destination[New_Line_Character_Index] == '\n') || (String_Destination[New_Line_Character_Index] == '\r')))
+	unsigned int Column;
+	int Value;
+	
+	for (Column = 0; Column < Pointer_Grid->Size; Column++)
 	{
-		String_Destination[New_Line_Character_Index] = 0;
-		Length--;
+		// Get the numerical value of each cell
+		Value = GridConvertCharacterToValue(String_Cells[Column]);
+		if (Value == -1)
+		{
+			#ifdef DEBUG
+				printf("[%s] A bad character was read.\n", __FUNCTION__);
+			#endif
+			return -3;
+		}
+		if ((Value != GRID_EMPTY_CELL_VALUE) && (Value >= (int) Pointer_Grid->Size))
+		{
+			#ifdef DEBUG
+				printf("[%s] The read character value (%d) is too big for the grid size.\n", __FUNCTION__, Value);
+			#endif
+			return -3;
+		}
+		
+		Pointer_Grid->Cells[Row * Pointer_Grid->Size + Column] = Value;
 	}
-
-	return Length;
+	return 0;
 }
 
-/** Convert a grid character read from a text file into a program operable value.
- * @param Character The character's value read from the file.
- * @return GRID_EMPTY_CELL_VALUE if the cell is empty,
- * @return The corresponding numerical value if the value was recognized,
- * @return -1 if the character is not an hexadecimal digit or a dot.
+/** Discard the lines of a multi-lines grid which could not be loaded, so the next grid of the source can be read.
+ * @param Pointer_Source The lines source.
+ * @param Last_Line_Length The length of the last read line (the skipping stops immediately if it was a blank line or the source end).
  */
-static int GridConvertCharacterToValue(char Character)
+static void GridSkipRemainingLines(TGridLinesSource *Pointer_Source, int Last_Line_Length)
 {
-	// Is the character a digit ?
-	if ((Character >= '0') && (Character <= '9')) return Character - '0';
-
-	// Is the character an hexadecimal alphanumerical value ?
-	if ((Character >= 'A') && (Character <= 'F')) return Character - 'A' + 10; // Plus 10 as the 'A' letter represents 10
-
-	// Is the character an empty cell ?
-	if (Character == '.') return GRID_EMPTY_CELL_VALUE;
+	char String_Line[GRID_LINE_BUFFER_SIZE];
+	
+	while (Last_Line_Length > 0) Last_Line_Length = GridReadNextLine(Pointer_Source, String_Line);
+}
 
-	// Bad character
-	return -1;
+/** Load the next grid from a lines source.
+ * @param Pointer_Grid The grid to load.
+ * @param Pointer_Source The lines source.
+ * @return 0 if the grid was correctly loaded,
+ * @return 1 if the end of the source was reached,
+ * @return -2 if the grid size is not 6, 9, 12, 16, 25, 36, 49 or 64,
+ * @return -3 if the cells data are bad.
+ */
+static int GridLoadFromSource(TGrid *Pointer_Grid, TGridLinesSource *Pointer_Source)
+{
+	char String_Line[GRID_LINE_BUFFER_SIZE];
+	int Length, Result;
+	unsigned int Row, Size;
+	
+	// Skip the blank lines separating the grids
+	do
+	{
+		Length = GridReadNextLine(Pointer_Source, String_Line);
+		if (Length < 0) return 1;
+	} while (Length == 0);
+	
+	// The whole grid is stored on a single line when the line length is the square of a grid size (this is checked first because a 36x36 grid row has the length of a whole 6x6 grid)
+	for (Size = 1; Size * Size < (unsigned int) Length; Size++);
+	if ((Size * Size == (unsigned int) Length) && (GridSetSize(Pointer_Grid, Size) == 0))
+	{
+		for (Row = 0; Row < Size; Row++)
+		{
+			Result = GridLoadRow(Pointer_Grid, Row, &String_Line[Row * Size]);
+			if (Result != 0) return Result;
+		}
+	}
+	// Or the grid is in the multi-lines format, the first line length is the grid size
+	else
+	{
+		if (GridSetSize(Pointer_Grid, Length) != 0)
+		{
+			#ifdef DEBUG
+				printf("[%s] Unrecognized grid size.\n", __FUNCTION__);
+			#endif
+			return -2;
+		}
+		
+		for (Row = 0; Row < Pointer_Grid->Size; Row++)
+		{
+			// Load the next line (the first one was read to get the grid size)
+			if (Row > 0)
+			{
+				Length = GridReadNextLine(Pointer_Source, String_Line);
+				if (Length != (int) Pointer_Grid->Size)
+				{
+					#ifdef DEBUG
+						printf("[%s] The line %d has not the same length than the previous ones (%d).\n", __FUNCTION__, Row + 1, Length); // +1 because the text editor starts displaying lines from 1
+					#endif
+					GridSkipRemainingLines(Pointer_Source, Length);
+					return -2;
+				}
+			}
+			
+			Result = GridLoadRow(Pointer_Grid, Row, String_Line);
+			if (Result != 0)
+			{
+				GridSkipRemainingLines(Pointer_Source, 1);
+				return Result;
+			}
+		}
+	}
+	
+	// Create first bitmasks
+	GridGenerateInitialBitmasks(Pointer_Grid);
+	return 0;
 }
 
 //-------------------------------------------------------------------------------------------------
 // Public functions
 //-------------------------------------------------------------------------------------------------
-void GridShow(void)
+void GridShow(TGrid *Pointer_Grid)
 {
 	unsigned int Row, Column;
 	int Value;
 	
-	for (Row = 0; Row < Grid_Size; Row++)
+	for (Row = 0; Row < Pointer_Grid->Size; Row++)
 	{
-		for (Column = 0; Column < Grid_Size; Column++)
+		for (Column = 0; Column < Pointer_Grid->Size; Column++)
 		{
-			Value = Grid[Row][Column];
+			Value = Pointer_Grid->Cells[Row * Pointer_Grid->Size + Column];
 			if (Value == GRID_EMPTY_CELL_VALUE) printf(" . ");
-			else printf("%2d ", Value + Grid_Display_Starting_Number);
+			else printf("%2d ", Value + Pointer_Grid->Display_Starting_Number);
 		}
 		putchar('\n');
 	}
 }
 
-unsigned int GridGetCellMissingNumbers(unsigned int Cell_Row, unsigned int Cell_Column)
+void GridShowLine(TGrid *Pointer_Grid)
+{
+	char String_Line[GRID_LINE_BUFFER_SIZE];
+	unsigned int Length;
+	
+	// Build the whole line before printing it, this is a lot faster than printing each cell
+	GridConvertToString(Pointer_Grid, String_Line);
+	Length = Pointer_Grid->Size * Pointer_Grid->Size;
+	String_Line[Length] = '\n';
+	String_Line[Length + 1] = 0;
+	fputs(String_Line, stdout);
+}
+
+void GridConvertToString(TGrid *Pointer_Grid, char *String_Destination)
+{
+	unsigned int i, Cells_Count;
+	
+	Cells_Count = Pointer_Grid->Size * Pointer_Grid->Size;
+	for (i = 0; i < Cells_Count; i++) String_Destination[i] = GridConvertValueToCharacter(Pointer_Grid->Cells[i]);
+	String_Destination[Cells_Count] = 0;
+}
+
+TGridBitmask GridGetCellMissingNumbers(TGrid *Pointer_Grid, unsigned int Cell_Row, unsigned int Cell_Column)
 {
-	unsigned int Bitmask_Missing_Numbers, Square_Index;
+	TGridBitmask Bitmask_Missing_Numbers;
+	unsigned int Square_Index;
 	
 	// No need to check a filled cell
-	assert(Grid[Cell_Row][Cell_Column] == GRID_EMPTY_CELL_VALUE);
+	assert(Pointer_Grid->Cells[Cell_Row * Pointer_Grid->Size + Cell_Column] == GRID_EMPTY_CELL_VALUE);
 	
 	// Determinate the index of the square where the cell is located
-	Square_Index = GRID_GET_CELL_SQUARE_INDEX(Cell_Row, Cell_Column);
+	Square_Index = GRID_GET_CELL_SQUARE_INDEX(Pointer_Grid, Cell_Row, Cell_Column);
 	
 	// Find missing numbers simultaneously on the row, the column and the square of the cell
-	Bitmask_Missing_Numbers = Bitmask_Rows[Cell_Row] & Bitmask_Columns[Cell_Column] & Bitmask_Squares[Square_Index];
+	Bitmask_Missing_Numbers = Pointer_Grid->Bitmask_Rows[Cell_Row] & Pointer_Grid->Bitmask_Columns[Cell_Column] & Pointer_Grid->Bitmask_Squares[Square_Index];
 	return Bitmask_Missing_Numbers;
 }
 
-int GridIsCorrectlyFilled(void)
+int GridIsCorrectlyFilled(TGrid *Pointer_Grid)
 {
-	unsigned int Row, Column, Cell_Row, Cell_Column, Column_Start, Row_End, Column_End;
-	int Number, Is_Number_Found[CONFIGURATION_GRID_MAXIMUM_SIZE];
+	const unsigned short *Pointer_Unit_Cells;
+	unsigned int Unit_Index, i;
+	int Number;
+	TGridBitmask Found_Numbers;
 	
-	// Check each row correctness
-	for (Row = 0; Row < Grid_Size; Row++)
+	// Check each row, column and square once, a number must not be present more than one time in a unit
+	for (Unit_Index = 0; Unit_Index < 3 * Pointer_Grid->Size; Unit_Index++)
 	{
-		// Reset boolean array of found numbers
-		memset(Is_Number_Found, 0, sizeof(Is_Number_Found));
+		Pointer_Unit_Cells = Pointer_Grid->Pointer_Geometry->Units_Cells[Unit_Index];
+		Found_Numbers = 0;
 		
-		// Find all filled numbers
-		for (Column = 0; Column < Grid_Size; Column++)
+		for (i = 0; i < Pointer_Grid->Size; i++)
 		{
-			Number = Grid[Row][Column];
+			Number = Pointer_Grid->Cells[Pointer_Unit_Cells[i]];
 			if (Number == GRID_EMPTY_CELL_VALUE) continue; // Ignore empty cells
-			if (Is_Number_Found[Number]) return 0; // The number is present more than one time
-			Is_Number_Found[Number] = 1;
-		}
-	}
-	
-	// Check each column correctness
-	for (Column = 0; Column < Grid_Size; Column++)
-	{
-		// Reset boolean array of found numbers
-		memset(Is_Number_Found, 0, sizeof(Is_Number_Found));
-		
-		// Find all filled numbers
-		for (Row = 0; Row < Grid_Size; Row++)
-		{
-			Number = Grid[Row][Column];
-			if (Number == GRID_EMPTY_CELL_VALUE) continue; // Ignore empty cells
-			if (Is_Number_Found[Number]) return 0; // The number is present more than one time
-			Is_Number_Found[Number] = 1;
-		}
-	}
-	
-	// Check each cell in each square
-	for (Cell_Row = 0; Cell_Row < Grid_Size; Cell_Row++)
-	{
-		for (Cell_Column = 0; Cell_Column < Grid_Size; Cell_Column++)
-		{
-			// Reset boolean array of found numbers
-			memset(Is_Number_Found, 0, sizeof(Is_Number_Found));
-			
-			// Determine coordinates of the square where the cell is located
-			Row = (Cell_Row / Square_Height) * Square_Height;
-			Column_Start = (Cell_Column / Square_Width) * Square_Width;
-			Row_End = Row + Square_Height;
-			Column_End = Column_Start + Square_Width;
-			
-			// Find numbers present into the square
-			for ( ; Row < Row_End; Row++)
-			{
-				for (Column = Column_Start; Column < Column_End; Column++)
-				{
-					Number = Grid[Row][Column];
-					if (Number == GRID_EMPTY_CELL_VALUE) continue; // Ignore empty cells
-					if (Is_Number_Found[Number]) return 0; // The number is present more than one time
-					Is_Number_Found[Number] = 1;
-				}
-			}
+			if (Found_Numbers & GRID_BITMASK_NUMBER(Number)) return 0; // The number is present more than one time
+			Found_Numbers |= GRID_BITMASK_NUMBER(Number);
 		}
 	}
 	return 1;
 }
 
-void GridSetCellValue(unsigned int Cell_Row, unsigned int Cell_Column, int Cell_Value)
+void GridSetCellValue(TGrid *Pointer_Grid, unsigned int Cell_Row, unsigned int Cell_Column, int Cell_Value)
 {
 	// Check coordinates in debug mode
-	assert(Cell_Row < Grid_Size);
-	assert(Cell_Column < Grid_Size);
+	assert(Cell_Row < Pointer_Grid->Size);
+	assert(Cell_Column < Pointer_Grid->Size);
 
-	Grid[Cell_Row][Cell_Column] = Cell_Value;
+	Pointer_Grid->Cells[Cell_Row * Pointer_Grid->Size + Cell_Column] = Cell_Value;
 }
 
-int GridLoadFromFile(char *String_File_Name, unsigned int *Pointer_Grid_Size)
+void GridCopy(TGrid *Pointer_Destination_Grid, TGrid *Pointer_Source_Grid)
 {
-	FILE *File;
-	unsigned int Row, Column, Temp;
-	char String_Line[CONFIGURATION_GRID_MAXIMUM_SIZE + 2] = {0};
+	// The cells are the last structure member, so the unused cells are at the structure end
+	memcpy(Pointer_Destination_Grid, Pointer_Source_Grid, offsetof(TGrid, Cells) + Pointer_Source_Grid->Size * Pointer_Source_Grid->Size * sizeof(Pointer_Source_Grid->Cells[0]));
+}
+
+int GridInitialize(TGrid *Pointer_Grid, unsigned int Size)
+{
+	unsigned int i;
 	
-	// Try to open the file
-	File = fopen(String_File_Name, "rb");
-	if (File == NULL) return -1;
+	if (GridSetSize(Pointer_Grid, Size) != 0) return -2;
 	
-	// Retrieve the grid size according to the length of the first line
-	Grid_Size = GridReadNextFileLine(File, String_Line);
-	if (Grid_Size > CONFIGURATION_GRID_MAXIMUM_SIZE)
-	{
-		fclose(File);
-		#ifdef DEBUG
-			printf("[%s] First line length is too long.\n", __FUNCTION__);
-		#endif
-		return -2;
-	}
+	for (i = 0; i < Size * Size; i++) Pointer_Grid->Cells[i] = GRID_EMPTY_CELL_VALUE;
+	GridGenerateInitialBitmasks(Pointer_Grid);
+	return 0;
+}
 
-	// Check if the grid size can be handled by the solver
-	switch (Grid_Size)
-	{
-		case 6:
-			Square_Width = 3;
-			Square_Height = 2;
-			Grid_Display_Starting_Number = 1;
-			break;
-
-		case 9:
-			Square_Width = 3;
-			Square_Height = 3;
-			Grid_Display_Starting_Number = 1;
-			break;
-
-		case 12:
-			Square_Width = 4;
-			Square_Height = 3;
-			Grid_Display_Starting_Number = 1;
-			break;
-
-		case 16:
-			Square_Width = 4;
-			Square_Height = 4;
-			Grid_Display_Starting_Number = 0;
-			break;
-
-		default:
-			#ifdef DEBUG
-				printf("[%s] Unrecognized grid size.\n", __FUNCTION__);
-			#endif
-			return -2;
-	}
+int GridConvertCharacterToValue(char Character)
+{
+	// Is the character a digit ?
+	if ((Character >= '0') && (Character <= '9')) return Character - '0';
+
+	// Is the character an uppercase letter (this includes the hexadecimal alphanumerical values) ?
+	if ((Character >= 'A') && (Character <= 'Z')) return Character - 'A' + 10; // Plus 10 as the 'A' letter represents 10
 	
-	// Compute number of squares on grid width and height
-	Squares_Horizontal_Count = Grid_Size / Square_Width;
-	Squares_Vertical_Count = Grid_Size / Square_Height;
+	// Is the character a lowercase letter ?
+	if ((Character >= 'a') && (Character <= 'z')) return Character - 'a' + 36; // Lowercase letters follow the uppercase ones
 	
-	// Load grid
-	for (Row = 0; Row < Grid_Size; Row++)
-	{
-		// Get each cell value
-		for (Column = 0; Column < Grid_Size; Column++)
-		{
-			// Get the numerical value of each cell
-			Temp = GridConvertCharacterToValue(String_Line[Column]);
-			if ((Temp != GRID_EMPTY_CELL_VALUE) && (Temp >= Grid_Size))
-			{
-				#ifdef DEBUG
-					printf("[%s] The read character value (%d) is too big for the grid size.\n", __FUNCTION__, Temp);
-				#endif
-				return -3;
-			}
-			if (Temp == (unsigned int) -1)
-			{
-				#ifdef DEBUG
-					printf("[%s] A bad character was read.\n", __FUNCTION__);
-				#endif
-				return -3;
-			}
+	// The last values of the 64x64 grids
+	if (Character == '@') return 62;
+	if (Character == '#') return 63;
 
-			Grid[Row][Column] = Temp;
-		}
+	// Is the character an empty cell ?
+	if (Character == '.') return GRID_EMPTY_CELL_VALUE;
 
-		// Load the next line
-		if (Row < Grid_Size - 1) // -1 because the first line was read before entering the loop
-		{
-			Temp = GridReadNextFileLine(File, String_Line);
-			if (Temp != Grid_Size)
-			{
-				#ifdef DEBUG
-					printf("[%s] The line %d has not the same length than the previous ones (%d).\n", __FUNCTION__, Row + 2, Temp); // +1 because the text editor starts displaying lines from 1, and +1 because the first line was already read (to get the grid size)
-				#endif
-				return -2;
-			}
-		}
-	}
+	// Bad character
+	return -1;
+}
 
-	// The grid was successfully loaded
-	fclose(File);
+int GridIsSizeSupported(unsigned int Size)
+{
+	unsigned int i;
+	
+	for (i = 0; i < GRID_SHAPES_COUNT; i++)
+	{
+		if (Grid_Shapes[i].Size == Size) return 1;
+	}
+	return 0;
+}
 
-	// Create first bitmasks
-	GridGenerateInitialBitmasks();
+int GridLoadFromCells(TGrid *Pointer_Grid, unsigned int Size)
+{
+	if (GridSetSize(Pointer_Grid, Size) != 0) return -2;
 	
-	// Put the empty cells coordinates into the dedicated stack
-	GridFillStackWithEmptyCells();
-	*Pointer_Grid_Size = Grid_Size;
+	GridGenerateInitialBitmasks(Pointer_Grid);
 	return 0;
 }
 
-void GridRemoveCellMissingNumber(unsigned int Cell_Row, unsigned int Cell_Column, int Number)
+int GridLoadFromStream(TGrid *Pointer_Grid, FILE *File)
+{
+	TGridLinesSource Source;
+	
+	Source.File = File;
+	return GridLoadFromSource(Pointer_Grid, &Source);
+}
+
+int GridLoadFromString(TGrid *Pointer_Grid, const char *String_Grid)
+{
+	TGridLinesSource Source;
+	int Result;
+	
+	Source.File = NULL;
+	Source.String = String_Grid;
+	Result = GridLoadFromSource(Pointer_Grid, &Source);
+	
+	// An empty string does not contain a recognizable grid
+	if (Result == 1) return -2;
+	return Result;
+}
+
+int GridLoadFromFile(TGrid *Pointer_Grid, char *String_File_Name)
+{
+	FILE *File;
+	int Result;
+	
+	// Try to open the file
+	File = fopen(String_File_Name, "rb");
+	if (File == NULL) return -1;
+	
+	// Only the first grid of the file is loaded
+	Result = GridLoadFromStream(Pointer_Grid, File);
+	fclose(File);
+	
+	// An empty file does not contain a recognizable grid
+	if (Result == 1) return -2;
+	return Result;
+}
+
+void GridRemoveCellMissingNumber(TGrid *Pointer_Grid, unsigned int Cell_Row, unsigned int Cell_Column, int Number)
 {
-	unsigned int New_Bitmask;
+	TGridBitmask New_Bitmask;
 	
-	New_Bitmask = ~(1 << Number);
+	New_Bitmask = ~GRID_BITMASK_NUMBER(Number);
 	
 	// Disable the Number bit in all relevant bitmasks
-	Bitmask_Rows[Cell_Row] &= New_Bitmask;
-	Bitmask_Columns[Cell_Column] &= New_Bitmask;
-	Bitmask_Squares[GRID_GET_CELL_SQUARE_INDEX(Cell_Row, Cell_Column)] &= New_Bitmask;
+	Pointer_Grid->Bitmask_Rows[Cell_Row] &= New_Bitmask;
+	Pointer_Grid->Bitmask_Columns[Cell_Column] &= New_Bitmask;
+	Pointer_Grid->Bitmask_Squares[GRID_GET_CELL_SQUARE_INDEX(Pointer_Grid, Cell_Row, Cell_Column)] &= New_Bitmask;
 }
 
-void GridRestoreCellMissingNumber(unsigned int Cell_Row, unsigned int Cell_Column, int Number)
+void GridRestoreCellMissingNumber(TGrid *Pointer_Grid, unsigned int Cell_Row, unsigned int Cell_Column, int Number)
 {
-	unsigned int New_Bitmask;
+	TGridBitmask New_Bitmask;
 	
-	New_Bitmask = 1 << Number;
+	New_Bitmask = GRID_BITMASK_NUMBER(Number);
 	
 	// Disable the Number bit in all relevant bitmasks
-	Bitmask_Rows[Cell_Row] |= New_Bitmask;
-	Bitmask_Columns[Cell_Column] |= New_Bitmask;
-	Bitmask_Squares[GRID_GET_CELL_SQUARE_INDEX(Cell_Row, Cell_Column)] |= New_Bitmask;
+	Pointer_Grid->Bitmask_Rows[Cell_Row] |= New_Bitmask;
+	Pointer_Grid->Bitmask_Columns[Cell_Column] |= New_Bitmask;
+	Pointer_Grid->Bitmask_Squares[GRID_GET_CELL_SQUARE_INDEX(Pointer_Grid, Cell_Row, Cell_Column)] |= New_Bitmask;
 }
 
 #ifdef DEBUG
-	void GridShowBitmask(unsigned int Bitmask)
+	void GridShowBitmask(TGrid *Pointer_Grid, TGridBitmask Bitmask)
 	{
 		int i, j = 0;
 		
-		for (i = Grid_Size; i >= 0 ; i--)
+		for (i = Pointer_Grid->Size; i >= 0 ; i--)
 		{
 			// Show '1' or '0' according to bit value
-			if (Bitmask & (1 << i)) putchar('1');
+			if (Bitmask & GRID_BITMASK_NUMBER(i)) putchar('1');
 			else putchar('0');
 				
 			// Make 4-bit groups to ease reading
@@ -459,20 +644,20 @@ void GridRestoreCellMissingNumber(unsigned int Cell_Row, unsigned int Cell_Colum
 		printf("\n");
 	}
 
-	void GridShowDifferences(int Color_Code)
+	void GridShowDifferences(TGrid *Pointer_Grid, int Color_Code)
 	{
-		static int Last_Grid[CONFIGURATION_GRID_MAXIMUM_SIZE][CONFIGURATION_GRID_MAXIMUM_SIZE];
+		static int Last_Grid[GRID_MAXIMUM_CELLS_COUNT];
 		unsigned int Row, Column;
 		int Has_Color_Changed, Current_Cell_Value;
 		
-		for (Row = 0; Row < Grid_Size; Row++)
+		for (Row = 0; Row < Pointer_Grid->Size; Row++)
 		{
-			for (Column = 0; Column < Grid_Size; Column++)
+			for (Column = 0; Column < Pointer_Grid->Size; Column++)
 			{
 				// Change terminal color if there is a difference between cells
 				Has_Color_Changed = 0;
-				Current_Cell_Value = Grid[Row][Column];
-				if (Last_Grid[Row][Column] != Current_Cell_Value)
+				Current_Cell_Value = Pointer_Grid->Cells[Row * Pointer_Grid->Size + Column];
+				if (Last_Grid[Row * Pointer_Grid->Size + Column] != Current_Cell_Value)
 				{
 					if (Color_Code == GRID_COLOR_CODE_BLUE) printf("\x1B[34m"); // VT100 escape sequence
 					else printf("\x1B[31m"); // VT100 escape sequence
@@ -480,13 +665,13 @@ void GridRestoreCellMissingNumber(unsigned int Cell_Row, unsigned int Cell_Colum
 				}
 				
 				if (Current_Cell_Value == GRID_EMPTY_CELL_VALUE) printf(" . ");
-				else printf("%2d ", Current_Cell_Value + Grid_Display_Starting_Number);
+				else printf("%2d ", Current_Cell_Value + Pointer_Grid->Display_Starting_Number);
 				
 				// Restore terminal color
 				if (Has_Color_Changed) printf("\x1B[0m");
 				
 				// Update grid in the same time
-				Last_Grid[Row][Column] = Current_Cell_Value;
+				Last_Grid[Row * Pointer_Grid->Size + Column] = Current_Cell_Value;
 			}
 			putchar('\n');
 		}
@@ -0,0 +1,67 @@
+/** @file Instrumentation.c
+ * @see Instrumentation.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Instrumentation.h>
+#include <string.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Write an array of counters as a JSON member.
+ * @param String_Name The member name.
+ * @param Pointer_Counts The counters.
+ * @param Counts_Count How many counters to write.
+ * @param File The stream to write to.
+ */
+static void InstrumentationWriteArray(char *String_Name, unsigned long long *Pointer_Counts, int Counts_Count, FILE *File)
+{
+	int i;
+	
+	fprintf(File, ", \"%s\": [", String_Name);
+	for (i = 0; i < Counts_Count; i++)
+	{
+		if (i > 0) fprintf(File, ", ");
+		fprintf(File, "%llu", Pointer_Counts[i]);
+	}
+	fputc(']', File);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+void InstrumentationReset(TInstrumentation *Pointer_Instrumentation)
+{
+	memset(Pointer_Instrumentation, 0, sizeof(TInstrumentation));
+}
+
+void InstrumentationAdd(TInstrumentation *Pointer_Destination, TInstrumentation *Pointer_Source)
+{
+	int i;
+	
+	for (i = 0; i <= Pointer_Source->Maximum_Depth; i++)
+	{
+		Pointer_Destination->Depths_Nodes_Counts[i] += Pointer_Source->Depths_Nodes_Counts[i];
+		Pointer_Destination->Depths_Backtracks_Counts[i] += Pointer_Source->Depths_Backtracks_Counts[i];
+	}
+	if (Pointer_Source->Maximum_Depth > Pointer_Destination->Maximum_Depth) Pointer_Destination->Maximum_Depth = Pointer_Source->Maximum_Depth;
+	
+	for (i = 0; i <= CONFIGURATION_GRID_MAXIMUM_SIZE; i++) Pointer_Destination->Branching_Counts[i] += Pointer_Source->Branching_Counts[i];
+	Pointer_Destination->Propagations_Count += Pointer_Source->Propagations_Count;
+	Pointer_Destination->Contradictions_Count += Pointer_Source->Contradictions_Count;
+	Pointer_Destination->Naked_Singles_Count += Pointer_Source->Naked_Singles_Count;
+	Pointer_Destination->Hidden_Singles_Count += Pointer_Source->Hidden_Singles_Count;
+	for (i = 0; i < INSTRUMENTATION_PHASES_COUNT; i++) Pointer_Destination->Phases_Durations[i] += Pointer_Source->Phases_Durations[i];
+}
+
+void InstrumentationWriteMembers(TInstrumentation *Pointer_Instrumentation, unsigned int Grid_Size, FILE *File)
+{
+	fprintf(File, ", \"maximum_depth\": %d", Pointer_Instrumentation->Maximum_Depth);
+	InstrumentationWriteArray("depths_nodes", Pointer_Instrumentation->Depths_Nodes_Counts, Pointer_Instrumentation->Maximum_Depth + 1, File);
+	InstrumentationWriteArray("depths_backtracks", Pointer_Instrumentation->Depths_Backtracks_Counts, Pointer_Instrumentation->Maximum_Depth + 1, File);
+	InstrumentationWriteArray("branching_numbers_counts", Pointer_Instrumentation->Branching_Counts, Grid_Size + 1, File);
+	fprintf(File, ", \"propagations\": %llu, \"contradictions\": %llu, \"naked_singles\": %llu, \"hidden_singles\": %llu", Pointer_Instrumentation->Propagations_Count, Pointer_Instrumentation->Contradictions_Count, Pointer_Instrumentation->Naked_Singles_Count,
+		Pointer_Instrumentation->Hidden_Singles_Count);
+	fprintf(File, ", \"preparation_ns\": %llu, \"propagation_ns\": %llu, \"search_ns\": %llu", Pointer_Instrumentation->Phases_Durations[INSTRUMENTATION_PHASE_PREPARATION], Pointer_Instrumentation->Phases_Durations[INSTRUMENTATION_PHASE_PROPAGATION],
+		Pointer_Instrumentation->Phases_Durations[INSTRUMENTATION_PHASE_SEARCH]);
+}
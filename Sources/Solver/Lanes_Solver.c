@@ -0,0 +1,213 @@
+/** @file Lanes_Solver.c
+ * @see Lanes_Solver.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Candidates.h>
+#include <Lanes_Solver.h>
+#include <string.h>
+
+// The propagation is written with the compiler vector extensions, so the same code is built for the AVX2 instruction set (a single instruction per operation) and for all other processors (the compiler splits each operation into narrower ones)
+#if defined(__x86_64__) || defined(__i386__)
+	#define LANES_SOLVER_IS_AVX2_AVAILABLE
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** All numbers of a 9x9 grid. */
+#define LANES_SOLVER_ALL_NUMBERS_BITMASK ((1 << LANES_SOLVER_GRID_SIZE) - 1)
+/** How many peers a 9x9 grid cell has. */
+#define LANES_SOLVER_PEERS_COUNT 20
+/** How many rows, columns and squares a 9x9 grid has. */
+#define LANES_SOLVER_UNITS_COUNT (3 * LANES_SOLVER_GRID_SIZE)
+
+//-------------------------------------------------------------------------------------------------
+// Private macros
+//-------------------------------------------------------------------------------------------------
+#ifdef LANES_SOLVER_IS_AVX2_AVAILABLE
+	/** Build a function for the AVX2 instruction set. */
+	#define LANES_SOLVER_AVX2_FUNCTION __attribute__((target("avx2")))
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** The same cell bitmask of all lanes. The comparisons set all bits of the lanes where they are true. */
+typedef unsigned short TLanesSolverVector __attribute__((vector_size(LANES_SOLVER_LANES_COUNT * sizeof(unsigned short))));
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Tell whether at least one bit of a vector is set.
+ * @param Pointer_Vector The vector.
+ * @return 1 if a bit is set or 0 if the vector is empty.
+ */
+static inline __attribute__((always_inline)) int LanesSolverIsAnyBitSet(const TLanesSolverVector *Pointer_Vector)
+{
+	unsigned long long Words[sizeof(TLanesSolverVector) / sizeof(unsigned long long)], Bits = 0;
+	unsigned int i;
+	
+	// The loop is unrolled by the compiler, whatever the lanes count is
+	memcpy(Words, Pointer_Vector, sizeof(Words));
+	for (i = 0; i < sizeof(Words) / sizeof(Words[0]); i++) Bits |= Words[i];
+	return Bits != 0;
+}
+
+/** Propagate the naked and hidden singles of all lanes until no lane changes anymore.
+ * @param Pointer_Lanes_Solver The lanes solver context.
+ * @param Pointer_Geometry The 9x9 grids geometry.
+ * @param Pointer_Contradictions On output, all bits of a lane are set when its grid has no solution.
+ * @note This function is inlined in the versions built for each instruction set.
+ */
+static inline __attribute__((always_inline)) void LanesSolverPropagateAllLanes(TLanesSolver *Pointer_Lanes_Solver, const TGridGeometry *Pointer_Geometry, TLanesSolverVector *Pointer_Contradictions)
+{
+	TLanesSolverVector *Pointer_Cells = (TLanesSolverVector *) Pointer_Lanes_Solver->Cells_Candidates, *Pointer_Propagated = (TLanesSolverVector *) Pointer_Lanes_Solver->Cells_Propagated;
+	TLanesSolverVector Bitmask, Singles, Changes, Contradictions = {0}, Once, Twice, Hidden, Is_Hidden_Found;
+	const unsigned short *Pointer_Peers, *Pointer_Unit_Cells;
+	int Cell_Index, Unit_Index, i;
+	
+	do
+	{
+		Changes = (TLanesSolverVector) {0};
+		
+		// Remove the number of each new naked single from its peers
+		for (Cell_Index = 0; Cell_Index < LANES_SOLVER_CELLS_COUNT; Cell_Index++)
+		{
+			Bitmask = Pointer_Cells[Cell_Index];
+			Contradictions |= (TLanesSolverVector) (Bitmask == 0);
+			
+			Singles = (TLanesSolverVector) ((Bitmask & (Bitmask - 1)) == 0) & ~Pointer_Propagated[Cell_Index];
+			if (!LanesSolverIsAnyBitSet(&Singles)) continue; // Most cells are already propagated in all lanes after the first passes
+			Pointer_Propagated[Cell_Index] |= Singles;
+			Changes |= Singles;
+			
+			Bitmask = ~(Bitmask & Singles);
+			Pointer_Peers = Pointer_Geometry->Peers[Cell_Index];
+			#pragma GCC unroll 20
+			for (i = 0; i < LANES_SOLVER_PEERS_COUNT; i++) Pointer_Cells[Pointer_Peers[i]] &= Bitmask;
+		}
+		
+		// Keep only the number of the cells that are the only ones of a unit allowing it
+		for (Unit_Index = 0; Unit_Index < LANES_SOLVER_UNITS_COUNT; Unit_Index++)
+		{
+			Pointer_Unit_Cells = Pointer_Geometry->Units_Cells[Unit_Index];
+			
+			// Find the numbers allowed by a single cell of the unit
+			Once = (TLanesSolverVector) {0};
+			Twice = (TLanesSolverVector) {0};
+			#pragma GCC unroll 9
+			for (i = 0; i < LANES_SOLVER_GRID_SIZE; i++)
+			{
+				Bitmask = Pointer_Cells[Pointer_Unit_Cells[i]];
+				Twice |= Once & Bitmask;
+				Once |= Bitmask;
+			}
+			
+			// A number allowed nowhere in the unit is a contradiction
+			Contradictions |= (TLanesSolverVector) (Once != LANES_SOLVER_ALL_NUMBERS_BITMASK);
+			Once &= ~Twice;
+			
+			#pragma GCC unroll 9
+			for (i = 0; i < LANES_SOLVER_GRID_SIZE; i++)
+			{
+				Bitmask = Pointer_Cells[Pointer_Unit_Cells[i]];
+				Hidden = Bitmask & Once;
+				
+				// A cell can't be the only place of two numbers
+				Contradictions |= (TLanesSolverVector) ((Hidden & (Hidden - 1)) != 0);
+				
+				Is_Hidden_Found = (TLanesSolverVector) (Hidden != 0);
+				Changes |= Is_Hidden_Found & (TLanesSolverVector) (Hidden != Bitmask);
+				Pointer_Cells[Pointer_Unit_Cells[i]] = (Hidden & Is_Hidden_Found) | (Bitmask & ~Is_Hidden_Found);
+			}
+		}
+		
+		// The lanes having a contradiction can change forever, they do not need to be propagated anymore
+		Changes &= ~Contradictions;
+	} while (LanesSolverIsAnyBitSet(&Changes));
+	
+	*Pointer_Contradictions = Contradictions;
+}
+
+/** Propagate all lanes with the instructions available on all processors.
+ * @param Pointer_Lanes_Solver The lanes solver context.
+ * @param Pointer_Geometry The 9x9 grids geometry.
+ * @param Pointer_Contradictions On output, all bits of a lane are set when its grid has no solution.
+ */
+static void LanesSolverPropagateAllLanesDefault(TLanesSolver *Pointer_Lanes_Solver, const TGridGeometry *Pointer_Geometry, TLanesSolverVector *Pointer_Contradictions)
+{
+	LanesSolverPropagateAllLanes(Pointer_Lanes_Solver, Pointer_Geometry, Pointer_Contradictions);
+}
+
+#ifdef LANES_SOLVER_IS_AVX2_AVAILABLE
+	/** Propagate all lanes with the AVX2 instructions.
+	 * @param Pointer_Lanes_Solver The lanes solver context.
+	 * @param Pointer_Geometry The 9x9 grids geometry.
+	 * @param Pointer_Contradictions On output, all bits of a lane are set when its grid has no solution.
+	 */
+	static LANES_SOLVER_AVX2_FUNCTION void LanesSolverPropagateAllLanesAVX2(TLanesSolver *Pointer_Lanes_Solver, const TGridGeometry *Pointer_Geometry, TLanesSolverVector *Pointer_Contradictions)
+	{
+		LanesSolverPropagateAllLanes(Pointer_Lanes_Solver, Pointer_Geometry, Pointer_Contradictions);
+	}
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+void LanesSolverPropagate(TLanesSolver *Pointer_Lanes_Solver, TGrid *Pointer_Grids[], int Grids_Count, int *Pointer_Results)
+{
+	const TGridGeometry *Pointer_Geometry = Pointer_Grids[0]->Pointer_Geometry; // All 9x9 grids share the same geometry
+	TGrid *Pointer_Grid;
+	TLanesSolverVector Contradictions, Solved_Lanes;
+	int Lane, Cell_Index, Number;
+	unsigned short Bitmask, *Pointer_Solved_Lanes = (unsigned short *) &Solved_Lanes, *Pointer_Contradictions = (unsigned short *) &Contradictions;
+	
+	// Transpose the grids into the lanes, a filled cell allows only its number and the unused lanes allow no number at all (so they are immediately unsolvable)
+	memset(Pointer_Lanes_Solver, 0, sizeof(TLanesSolver));
+	for (Lane = 0; Lane < Grids_Count; Lane++)
+	{
+		Pointer_Grid = Pointer_Grids[Lane];
+		for (Cell_Index = 0; Cell_Index < LANES_SOLVER_CELLS_COUNT; Cell_Index++)
+		{
+			if (Pointer_Grid->Cells[Cell_Index] == GRID_EMPTY_CELL_VALUE) Pointer_Lanes_Solver->Cells_Candidates[Cell_Index][Lane] = LANES_SOLVER_ALL_NUMBERS_BITMASK;
+			else Pointer_Lanes_Solver->Cells_Candidates[Cell_Index][Lane] = 1 << Pointer_Grid->Cells[Cell_Index];
+		}
+	}
+	
+	#ifdef LANES_SOLVER_IS_AVX2_AVAILABLE
+		if (CandidatesGetInstructionSet() == CANDIDATES_INSTRUCTION_SET_AVX2) LanesSolverPropagateAllLanesAVX2(Pointer_Lanes_Solver, Pointer_Geometry, &Contradictions);
+		else LanesSolverPropagateAllLanesDefault(Pointer_Lanes_Solver, Pointer_Geometry, &Contradictions);
+	#else
+		LanesSolverPropagateAllLanesDefault(Pointer_Lanes_Solver, Pointer_Geometry, &Contradictions);
+	#endif
+	
+	// A grid is solved when all its cells hold a single number that has been removed from their peers
+	Solved_Lanes = ((TLanesSolverVector *) Pointer_Lanes_Solver->Cells_Propagated)[0];
+	for (Cell_Index = 1; Cell_Index < LANES_SOLVER_CELLS_COUNT; Cell_Index++) Solved_Lanes &= ((TLanesSolverVector *) Pointer_Lanes_Solver->Cells_Propagated)[Cell_Index];
+	
+	// Transpose the lanes back into the grids
+	for (Lane = 0; Lane < Grids_Count; Lane++)
+	{
+		if (Pointer_Contradictions[Lane] != 0)
+		{
+			Pointer_Results[Lane] = LANES_SOLVER_RESULT_UNSOLVABLE;
+			continue;
+		}
+		if (Pointer_Solved_Lanes[Lane] != 0) Pointer_Results[Lane] = LANES_SOLVER_RESULT_SOLVED;
+		else Pointer_Results[Lane] = LANES_SOLVER_RESULT_GUESS_NEEDED;
+		
+		// Fill the forced cells
+		Pointer_Grid = Pointer_Grids[Lane];
+		for (Cell_Index = 0; Cell_Index < LANES_SOLVER_CELLS_COUNT; Cell_Index++)
+		{
+			if (Pointer_Grid->Cells[Cell_Index] != GRID_EMPTY_CELL_VALUE) continue;
+			
+			Bitmask = Pointer_Lanes_Solver->Cells_Candidates[Cell_Index][Lane];
+			if ((Bitmask & (Bitmask - 1)) != 0) continue; // The cell still allows several numbers (a cell allowing no number would be a contradiction)
+			
+			Number = __builtin_ctz(Bitmask);
+			GridSetCellValue(Pointer_Grid, Pointer_Geometry->Cells_Row[Cell_Index], Pointer_Geometry->Cells_Column[Cell_Index], Number);
+			GridRemoveCellMissingNumber(Pointer_Grid, Pointer_Geometry->Cells_Row[Cell_Index], Pointer_Geometry->Cells_Column[Cell_Index], Number);
+		}
+	}
+}
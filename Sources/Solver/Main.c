@@ -14,122 +14,455 @@
  * @version 1.1.1 : 16/04/2014, made a little optimization on grid access.
  * @version 1.1.2 : 18/04/2014, used a stack to list the empty cells, the solving is more than 2 times faster.
  * @version 1.2.0 : 28/04/2014, changed the grid format to a more compact one and enabled automatic grid size detection; the solving algorithm handles now numbers starting from 0 (and not 1 as previously).
+ * @version 1.3.0 : 17/10/2026, added the batch mode solving all grids of a file or of the standard input in a single run.
+ * @version 1.4.0 : 17/10/2026, moved the solving algorithm to the reentrant solver library.
+ * @version 1.5.0 : 17/10/2026, the batch mode can solve the grids with several threads.
+ * @version 1.6.0 : 17/10/2026, a single grid can be solved with several threads.
+ * @version 1.7.0 : 17/10/2026, the solver fills the most constrained cell first, the cells and numbers orders can be chosen.
+ * @version 1.8.0 : 17/10/2026, the naked and hidden singles are propagated at each search step.
+ * @version 1.9.0 : 17/10/2026, added the dancing links engine.
+ * @version 1.10.0 : 17/10/2026, the allowed numbers of all cells are computed with SIMD instructions, the instruction set can be chosen.
+ * @version 1.11.0 : 17/10/2026, the batch mode propagates the 9x9 grids several at once in SIMD lanes.
+ * @version 1.12.0 : 17/10/2026, added the solutions counting mode.
+ * @version 1.13.0 : 17/10/2026, the statistics of each solving can be written to a file, the statistics are shown for the unsolvable grids too.
+ * @version 1.14.0 : 17/10/2026, the solving can be limited in time and in loops.
+ * @version 1.15.0 : 17/10/2026, the state of a long solving can be saved to a checkpoint file and resumed later.
+ * @version 1.16.0 : 17/10/2026, the progress of a long solving can be reported periodically and on SIGUSR1.
+ * @version 1.17.0 : 17/10/2026, the batch mode maps the grids file in memory.
+ * @version 1.18.0 : 17/10/2026, the batch mode reads and writes the packed grids files.
+ * @version 1.19.0 : 17/10/2026, added the daemon mode solving the grids requests of clients.
  */
+#include <Batch.h>
+#include <Candidates.h>
+#include <Checkpoint.h>
 #include <Configuration.h>
+#include <Corpus.h>
+#include <ctype.h>
+#include <Daemon.h>
+#include <errno.h>
 #include <Grid.h>
+#include <limits.h>
+#include <Packed_Grids.h>
+#include <Parallel_Solver.h>
+#include <Progress_Reporter.h>
+#include <signal.h>
+#include <Solver.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** The default time between two checkpoints, in seconds. */
+#define MAIN_DEFAULT_CHECKPOINT_PERIOD 60
 
 //-------------------------------------------------------------------------------------------------
 // Private variables
 //-------------------------------------------------------------------------------------------------
-/** How many loops were done. */
-static unsigned long long Loops_Count = 1;
-/** How many bad solutions were found before the good one (or before crashing...). */
-static unsigned long long Bad_Solutions_Found_Count = 0;
-/** How many impossible solutions were avoided. */
-static unsigned long long Avoided_Bad_Solutions_Count = 0;
-/** Cache grid size value. */
-static unsigned int Grid_Size;
+/** Set by SIGUSR2 to write a checkpoint at once. */
+static atomic_int Main_Is_Checkpoint_Requested;
+/** Set by SIGINT and SIGTERM to stop a checkpointed solving after writing its last checkpoint. */
+static atomic_int Main_Is_Solving_Cancelled;
+/** Print the progress reports of a single grid solving. */
+static TProgressReporter Main_Progress_Reporter;
 
 //-------------------------------------------------------------------------------------------------
 // Private functions
 //-------------------------------------------------------------------------------------------------
-/** The brute force backtrack algorithm.
- * @return 1 if the grid was solved or 0 if not.
+/** Request a progress report or a checkpoint, or stop the solving when a signal is received.
+ * @param Signal_Number The received signal.
  */
-static int Backtrack(void)
+static void MainHandleSignal(int Signal_Number)
 {
-	int Row, Column;
-	unsigned int Bitmask_Missing_Numbers, Tested_Number;
+	if (Signal_Number == SIGUSR1) ProgressReporterRequestReport(&Main_Progress_Reporter);
+	else if (Signal_Number == SIGUSR2) atomic_store(&Main_Is_Checkpoint_Requested, 1);
+	else atomic_store(&Main_Is_Solving_Cancelled, 1);
+}
+
+/** Show a solution as soon as it is found when counting the solutions of a single grid.
+ * @param Pointer_Argument Not used.
+ * @param Pointer_Grid The solved grid.
+ */
+static void MainShowSolution(void __attribute__((unused)) *Pointer_Argument, TGrid *Pointer_Grid)
+{
+	printf("Solution :\n");
+	GridShow(Pointer_Grid);
+	putchar('\n');
+}
+
+/** Tell whether a command line argument is a number.
+ * @param String The argument.
+ * @return 1 if the argument is made of digits only,
+ * @return 0 if the argument is not a number.
+ */
+static int MainIsNumber(char *String)
+{
+	return (String[0] != 0) && (String[strspn(String, "0123456789")] == 0);
+}
+
+/** Convert a threads count command line argument.
+ * @param String The argument.
+ * @param Pointer_Threads_Count On output, contain the threads count.
+ * @return 0 if the argument is a non-negative integer,
+ * @return -1 if the argument is not a threads count.
+ */
+static int MainParseThreadsCount(char *String, int *Pointer_Threads_Count)
+{
+	char *Pointer_End;
+	long Value;
 	
-	// Find the first empty cell (don't remove the stack top now as the backtrack can return soon if no available number is found) 
-	if (CellsStackReadTop(&Row, &Column) == 0)
+	errno = 0;
+	Value = strtol(String, &Pointer_End, 10);
+	if ((Pointer_End == String) || (*Pointer_End != 0) || (errno != 0) || (Value < 0) || (Value > INT_MAX)) return -1;
+	*Pointer_Threads_Count = (int) Value;
+	return 0;
+}
+
+/** Convert a non-negative integer command line argument.
+ * @param String The argument.
+ * @param Pointer_Value On output, contain the number.
+ * @return 0 if the argument is a non-negative integer,
+ * @return -1 if the argument is not a number or if it is too big.
+ */
+static int MainParseNumber(char *String, unsigned long long *Pointer_Value)
+{
+	// strtoull() would accept the leading spaces, a sign and trailing characters
+	if (!MainIsNumber(String)) return -1;
+	
+	errno = 0;
+	*Pointer_Value = strtoull(String, NULL, 10);
+	if (errno != 0) return -1;
+	return 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Entry point
+//-------------------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+	char *String_Grid_File_Name = NULL, *String_Statistics_File_Name = NULL, *String_Checkpoint_File_Name = NULL, *String_Packed_Output_File_Name = NULL, *String_Socket_File_Name = NULL;
+	FILE *File, *Resumed_File = NULL;
+	int Exit_Code, i, Is_Batch_Mode_Enabled = 0, Is_Daemon_Mode_Enabled = 0, Is_Parameter_Bad = 0, Instruction_Set = CANDIDATES_INSTRUCTION_SET_AUTOMATIC, Result, Is_Resume_Enabled = 0, Is_Progress_Enabled = 0;
+	unsigned long long Solutions_Count, Checkpoint_Period = MAIN_DEFAULT_CHECKPOINT_PERIOD, Progress_Period = 0;
+	static TSolver Solver;
+	static TDancingLinks Dancing_Links;
+	TBatchConfiguration Batch_Configuration;
+	TCheckpoint Checkpoint;
+	TCorpus Corpus;
+	TPackedGrids Packed_Grids;
+	TSolverConfiguration *Pointer_Configuration = &Batch_Configuration.Solver_Configuration;
+	
+	BatchGetDefaultConfiguration(&Batch_Configuration);
+	
+	// Parse the command line
+	for (i = 1; i < argc; i++)
 	{
-		// No empty cell remain and there is no error in the grid : the solution has been found
-		if (GridIsCorrectlyFilled()) return 1;
-		
-		// A bad grid was generated...
-		#ifdef DEBUG
-			printf("[%s] Bad grid generated !\n", __FUNCTION__);
-		#endif
-		return 0;
+		if (strcmp(argv[i], "--batch") == 0) Is_Batch_Mode_Enabled = 1;
+		else if (strcmp(argv[i], "--daemon") == 0) Is_Daemon_Mode_Enabled = 1;
+		else if ((strcmp(argv[i], "--socket") == 0) && (i + 1 < argc))
+		{
+			i++;
+			String_Socket_File_Name = argv[i];
+		}
+		else if ((strcmp(argv[i], "--threads") == 0) && (i + 1 < argc))
+		{
+			i++;
+			if (MainParseThreadsCount(argv[i], &Batch_Configuration.Threads_Count) != 0)
+			{
+				Is_Parameter_Bad = 1;
+				break;
+			}
+		}
+		else if (strcmp(argv[i], "--pin") == 0) Batch_Configuration.Is_Threads_Pinning_Enabled = 1;
+		else if (strcmp(argv[i], "--no-lanes") == 0) Batch_Configuration.Is_Lanes_Solver_Enabled = 0;
+		else if (strcmp(argv[i], "--count") == 0)
+		{
+			Batch_Configuration.Is_Counting_Enabled = 1;
+			
+			// The limit is optional, a signed number is taken as a bad limit rather than as the grid file name
+			if ((i + 1 < argc) && (MainIsNumber(argv[i + 1]) || (((argv[i + 1][0] == '-') || (argv[i + 1][0] == '+')) && isdigit((unsigned char) argv[i + 1][1]))))
+			{
+				i++;
+				if (MainParseNumber(argv[i], &Batch_Configuration.Solutions_Limit) != 0)
+				{
+					Is_Parameter_Bad = 1;
+					break;
+				}
+			}
+		}
+		else if (strcmp(argv[i], "--show-solutions") == 0) Batch_Configuration.Is_Solutions_Display_Enabled = 1;
+		else if ((strcmp(argv[i], "--time-limit") == 0) && (i + 1 < argc))
+		{
+			i++;
+			if (MainParseNumber(argv[i], &Batch_Configuration.Time_Limit) != 0)
+			{
+				Is_Parameter_Bad = 1;
+				break;
+			}
+		}
+		else if ((strcmp(argv[i], "--loops-limit") == 0) && (i + 1 < argc))
+		{
+			i++;
+			if (MainParseNumber(argv[i], &Batch_Configuration.Loops_Limit) != 0)
+			{
+				Is_Parameter_Bad = 1;
+				break;
+			}
+		}
+		else if ((strcmp(argv[i], "--checkpoint") == 0) && (i + 1 < argc))
+		{
+			i++;
+			String_Checkpoint_File_Name = argv[i];
+		}
+		else if ((strcmp(argv[i], "--checkpoint-period") == 0) && (i + 1 < argc))
+		{
+			i++;
+			// A zero period would write a checkpoint at each poll, and the period is converted to microseconds
+			if ((MainParseNumber(argv[i], &Checkpoint_Period) != 0) || (Checkpoint_Period == 0) || (Checkpoint_Period > ULLONG_MAX / 1000000))
+			{
+				Is_Parameter_Bad = 1;
+				break;
+			}
+		}
+		else if (strcmp(argv[i], "--resume") == 0) Is_Resume_Enabled = 1;
+		else if ((strcmp(argv[i], "--progress") == 0) && (i + 1 < argc))
+		{
+			i++;
+			Is_Progress_Enabled = 1;
+			// The period is converted to microseconds, 0 is kept for the reports requested by SIGUSR1 only
+			if ((MainParseNumber(argv[i], &Progress_Period) != 0) || (Progress_Period > ULLONG_MAX / 1000000))
+			{
+				Is_Parameter_Bad = 1;
+				break;
+			}
+		}
+		else if ((strcmp(argv[i], "--statistics") == 0) && (i + 1 < argc))
+		{
+			i++;
+			String_Statistics_File_Name = argv[i];
+		}
+		else if ((strcmp(argv[i], "--packed-output") == 0) && (i + 1 < argc))
+		{
+			i++;
+			String_Packed_Output_File_Name = argv[i];
+		}
+		else if ((strcmp(argv[i], "--engine") == 0) && (i + 1 < argc))
+		{
+			i++;
+			if (strcmp(argv[i], "backtracking") == 0) Pointer_Configuration->Engine = SOLVER_ENGINE_BACKTRACKING;
+			else if (strcmp(argv[i], "dlx") == 0) Pointer_Configuration->Engine = SOLVER_ENGINE_DANCING_LINKS;
+			else
+			{
+				Is_Parameter_Bad = 1;
+				break;
+			}
+		}
+		else if ((strcmp(argv[i], "--cell-order") == 0) && (i + 1 < argc))
+		{
+			i++;
+			if (strcmp(argv[i], "fixed") == 0) Pointer_Configuration->Cell_Order = SOLVER_CELL_ORDER_FIXED;
+			else if (strcmp(argv[i], "constrained") == 0) Pointer_Configuration->Cell_Order = SOLVER_CELL_ORDER_MOST_CONSTRAINED;
+			else
+			{
+				Is_Parameter_Bad = 1;
+				break;
+			}
+		}
+		else if ((strcmp(argv[i], "--number-order") == 0) && (i + 1 < argc))
+		{
+			i++;
+			if (strcmp(argv[i], "ascending") == 0) Pointer_Configuration->Number_Order = SOLVER_NUMBER_ORDER_ASCENDING;
+			else if (strcmp(argv[i], "descending") == 0) Pointer_Configuration->Number_Order = SOLVER_NUMBER_ORDER_DESCENDING;
+			else if (strcmp(argv[i], "random") == 0) Pointer_Configuration->Number_Order = SOLVER_NUMBER_ORDER_RANDOM;
+			else
+			{
+				Is_Parameter_Bad = 1;
+				break;
+			}
+		}
+		else if (strcmp(argv[i], "--no-propagation") == 0) Pointer_Configuration->Is_Propagation_Enabled = 0;
+		else if ((strcmp(argv[i], "--instruction-set") == 0) && (i + 1 < argc))
+		{
+			i++;
+			if (strcmp(argv[i], "scalar") == 0) Instruction_Set = CANDIDATES_INSTRUCTION_SET_SCALAR;
+			else if (strcmp(argv[i], "sse4") == 0) Instruction_Set = CANDIDATES_INSTRUCTION_SET_SSE4;
+			else if (strcmp(argv[i], "avx2") == 0) Instruction_Set = CANDIDATES_INSTRUCTION_SET_AVX2;
+			else
+			{
+				Is_Parameter_Bad = 1;
+				break;
+			}
+		}
+		else if ((strcmp(argv[i], "--seed") == 0) && (i + 1 < argc))
+		{
+			i++;
+			Pointer_Configuration->Random_Seed = strtoul(argv[i], NULL, 10);
+		}
+		else if (String_Grid_File_Name == NULL) String_Grid_File_Name = argv[i];
+		else
+		{
+			Is_Parameter_Bad = 1;
+			break;
+		}
 	}
 	
-	// Get available numbers for this cell
-	Bitmask_Missing_Numbers = GridGetCellMissingNumbers(Row, Column);
-	// If no number is available a bad grid has been generated... It's safe to return here as the top of the stack has not been altered
-	if (Bitmask_Missing_Numbers == 0) return 0;
+	// The processor may not support the requested instruction set
+	if (CandidatesSetInstructionSet(Instruction_Set) != 0)
+	{
+		printf("Error : the processor does not support this instruction set.\n");
+		return EXIT_FAILURE;
+	}
 	
-	#ifdef DEBUG
-		printf("[%s] Available numbers for (row %d ; column %d) : ", __FUNCTION__, Row, Column);
-		GridShowBitmask(Bitmask_Missing_Numbers);
-	#endif
+	// The statistics records are written to a file, so they do not mix with the solutions
+	if ((String_Statistics_File_Name != NULL) && !Is_Parameter_Bad)
+	{
+		Batch_Configuration.Statistics_File = fopen(String_Statistics_File_Name, "w");
+		if (Batch_Configuration.Statistics_File == NULL)
+		{
+			printf("Error : can't create file %s.\n", String_Statistics_File_Name);
+			return EXIT_FAILURE;
+		}
+	}
 	
-	// Try each available number
-	for (Tested_Number = 0; Tested_Number < Grid_Size; Tested_Number++)
+	// The progress is published by a single backtracking search
+	if (Is_Progress_Enabled && (Is_Batch_Mode_Enabled || Is_Daemon_Mode_Enabled || (Pointer_Configuration->Engine != SOLVER_ENGINE_BACKTRACKING) || (Batch_Configuration.Threads_Count != 1))) Is_Parameter_Bad = 1;
+	
+	// The packed grids file receives the batch grids with their solutions
+	if ((String_Packed_Output_File_Name != NULL) && (!Is_Batch_Mode_Enabled || Batch_Configuration.Is_Counting_Enabled)) Is_Parameter_Bad = 1;
+	
+	// The daemon receives its grids from its clients and answers each of them with a single response
+	if (Is_Daemon_Mode_Enabled && (Is_Batch_Mode_Enabled || (String_Grid_File_Name != NULL) || Batch_Configuration.Is_Solutions_Display_Enabled || (String_Checkpoint_File_Name != NULL) || Is_Resume_Enabled)) Is_Parameter_Bad = 1;
+	if ((String_Socket_File_Name != NULL) && !Is_Daemon_Mode_Enabled) Is_Parameter_Bad = 1;
+	
+	// The daemon mode writes nothing but the responses, so the standard output can carry them
+	if (Is_Daemon_Mode_Enabled && !Is_Parameter_Bad)
+	{
+		Exit_Code = DaemonRun(&Batch_Configuration, String_Socket_File_Name);
+		if (Batch_Configuration.Statistics_File != NULL) fclose(Batch_Configuration.Statistics_File);
+		return Exit_Code;
+	}
+	
+	// The batch mode only displays the solutions to make them easy to process by other programs
+	if (Is_Batch_Mode_Enabled && !Is_Parameter_Bad)
 	{
-		// Loop until an available number is found
-		if (!(Bitmask_Missing_Numbers & (1 << Tested_Number)))
+		if (String_Packed_Output_File_Name != NULL)
 		{
-			Avoided_Bad_Solutions_Count++;
-			continue;
+			Batch_Configuration.Packed_Output_File = fopen(String_Packed_Output_File_Name, "wb");
+			if (Batch_Configuration.Packed_Output_File == NULL)
+			{
+				printf("Error : can't create file %s.\n", String_Packed_Output_File_Name);
+				return EXIT_FAILURE;
+			}
 		}
 		
-		// Try the number
-		GridSetCellValue(Row, Column, Tested_Number);
-		GridRemoveCellMissingNumber(Row, Column, Tested_Number);
-		CellsStackRemoveTop(); // Really try to fill this cell, removing it for next simulation step
-		Loops_Count++;
-		
-		#ifdef DEBUG
-			printf("[%s] Modified grid :\n", __FUNCTION__);
-			GridShowDifferences(GRID_COLOR_CODE_BLUE);
-			putchar('\n');
-		#endif
-
-		// Simulate next state
-		if (Backtrack() == 1) return 1; // Good solution found, go to tree root
-		
-		// Bad solution found, restore old value
-		GridSetCellValue(Row, Column, GRID_EMPTY_CELL_VALUE);
-		GridRestoreCellMissingNumber(Row, Column, Tested_Number);
-		CellsStackPush(Row, Column); // The cell is available again
-		Bad_Solutions_Found_Count++;
+		// Grids are read from the standard input if no file is provided
+		if ((String_Grid_File_Name == NULL) || (strcmp(String_Grid_File_Name, "-") == 0)) Exit_Code = BatchSolve(stdin, &Batch_Configuration);
+		// A packed grids file is recognized by its header
+		else if (PackedGridsIsPackedFile(String_Grid_File_Name))
+		{
+			File = fopen(String_Grid_File_Name, "rb");
+			if ((File == NULL) || (PackedGridsOpen(&Packed_Grids, File) != 0))
+			{
+				printf("Error : can't read the packed grids file %s.\n", String_Grid_File_Name);
+				Exit_Code = EXIT_FAILURE;
+			}
+			else Exit_Code = BatchSolvePacked(&Packed_Grids, &Batch_Configuration);
+			if (File != NULL) fclose(File);
+		}
+		else
+		{
+			// A regular file is mapped in memory to avoid copying its content, the other files are read as streams
+			Result = CorpusOpen(&Corpus, String_Grid_File_Name);
+			if (Result == 0)
+			{
+				Exit_Code = BatchSolveCorpus(&Corpus, &Batch_Configuration);
+				CorpusClose(&Corpus);
+			}
+			else
+			{
+				File = NULL;
+				if (Result == -2) File = fopen(String_Grid_File_Name, "rb");
+				if (File == NULL)
+				{
+					printf("Error : can't open file %s.\n", String_Grid_File_Name);
+					Exit_Code = EXIT_FAILURE;
+				}
+				else
+				{
+					Exit_Code = BatchSolve(File, &Batch_Configuration);
+					fclose(File);
+				}
+			}
+		}
 		
-		#ifdef DEBUG
-			printf("[%s] Restored grid :\n", __FUNCTION__);
-			GridShowDifferences(GRID_COLOR_CODE_RED);
-			putchar('\n');
-		#endif
+		if (Batch_Configuration.Statistics_File != NULL) fclose(Batch_Configuration.Statistics_File);
+		if ((Batch_Configuration.Packed_Output_File != NULL) && (fclose(Batch_Configuration.Packed_Output_File) != 0))
+		{
+			printf("Error : could not write the packed grids file.\n");
+			Exit_Code = EXIT_FAILURE;
+		}
+		return Exit_Code;
 	}
-	// All numbers were tested unsuccessfully, go back into the tree
-	return 0;
-}
-
-//-------------------------------------------------------------------------------------------------
-// Entry point
-//-------------------------------------------------------------------------------------------------
-int main(int argc, char *argv[])
-{
-	char *String_Grid_File_Name;
 	
 	// Show the title
 	printf("+---------------+\n");
 	printf("| Sudoku Solver |\n");
 	printf("+---------------+\n\n");
 	
+	// A resumed solving goes on saving its state to the resumed file by default
+	if (Is_Resume_Enabled && (String_Checkpoint_File_Name == NULL)) String_Checkpoint_File_Name = String_Grid_File_Name;
+	// The search state can only be saved by the backtracking engine, and the solutions count is not part of it
+	if ((String_Checkpoint_File_Name != NULL) && ((Pointer_Configuration->Engine != SOLVER_ENGINE_BACKTRACKING) || Batch_Configuration.Is_Counting_Enabled)) Is_Parameter_Bad = 1;
+	
 	// Check parameters
-	if (argc != 2)
+	if (Is_Parameter_Bad || (String_Grid_File_Name == NULL))
 	{
 		printf("Error : bad parameters.\n");
-		printf("Usage : %s Grid_File_Name\n", argv[0]);
+		printf("Usage : %s [Options] [--threads Threads_Count] Grid_File_Name\n", argv[0]);
+		printf("        %s --count [Limit] [--show-solutions] [Options] Grid_File_Name\n", argv[0]);
+		printf("        %s [Options] --checkpoint Checkpoint_File_Name [--checkpoint-period Seconds] Grid_File_Name\n", argv[0]);
+		printf("        %s [Options] --resume [--checkpoint Checkpoint_File_Name] [--checkpoint-period Seconds] Resumed_Checkpoint_File_Name\n", argv[0]);
+		printf("        %s --batch [Options] [--threads Threads_Count] [--pin] [--no-lanes] [--count [Limit] [--show-solutions]] [--packed-output Packed_Grids_File_Name] [Grids_File_Name]\n", argv[0]);
+		printf("        %s --daemon [Options] [--threads Threads_Count] [--pin] [--count [Limit]] [--socket Socket_File_Name]\n", argv[0]);
+		printf("Options : --engine backtracking|dlx : solve with the bitmasks backtracking (default) or with the dancing links exact cover algorithm.\n");
+		printf("          --cell-order fixed|constrained : fill the cells from the top-left one or fill the cell with the fewest allowed numbers first (default).\n");
+		printf("          --number-order ascending|descending|random : the order the allowed numbers of a cell are tried in (default is ascending).\n");
+		printf("          --seed Seed : the seed of the random numbers order.\n");
+		printf("          --no-propagation : do not fill the forced cells (naked and hidden singles) at each search step.\n");
+		printf("          --instruction-set scalar|sse4|avx2 : the instructions computing the allowed numbers of all cells at once (default is the best one supported by the processor).\n");
+		printf("          --count [Limit] : count the solutions instead of solving, stop when Limit solutions are found (count all solutions if no limit is provided, use 2 to check that a grid has a single solution).\n");
+		printf("          --show-solutions : when counting, show each solution as soon as it is found.\n");
+		printf("          --time-limit Microseconds : stop the solving of a grid when it lasts longer (the limit is checked every %d search iterations).\n", SOLVER_POLLING_PERIOD);
+		printf("          --loops-limit Loops_Count : stop the solving of a grid when it does more loops (the limit is checked every %d search iterations, the loops of all threads count when several threads solve a single grid).\n", SOLVER_POLLING_PERIOD);
+		printf("          --checkpoint File_Name : save the search state to a file every %d seconds (change it with --checkpoint-period, the period must be at least 1 second), when receiving SIGUSR2 and when the solving is stopped by SIGINT, SIGTERM or a limit. The grid is solved by a single thread with the backtracking engine.\n", MAIN_DEFAULT_CHECKPOINT_PERIOD);
+		printf("          --resume : solve the grids of a checkpoint file until one of them is solved, the new checkpoints replace the resumed file unless --checkpoint is provided.\n");
+		printf("          --progress Seconds : print a progress report to the error output every Seconds seconds (use 0 to print the reports only when receiving SIGUSR1) and when receiving SIGUSR1. The grid must be solved by a single thread with the backtracking engine.\n");
+		printf("          --packed-output File_Name : in batch mode, write each grid with its solution to a packed grids file (the grids files given to the batch mode can be packed grids files too).\n");
+		printf("          --daemon : solve the grids requests received from a Unix domain socket (use --socket to create it, the daemon is stopped by SIGINT or SIGTERM) or from the standard input (the responses are then written to the standard output), see Daemon.h for the protocol. Each thread has its own solver context, prepared once.\n");
+		printf("          --statistics File_Name : write the statistics of each solving to a file, one JSON object per line (with the search instrumentation measures when the program is built with \"make instrumentation\").\n");
 		return EXIT_FAILURE;
 	}
-	String_Grid_File_Name = argv[1];
+	SolverInitialize(&Solver);
+	SolverSetConfiguration(&Solver, Pointer_Configuration);
+	SolverSetDancingLinks(&Solver, &Dancing_Links);
+	SolverSetTimeLimit(&Solver, Batch_Configuration.Time_Limit);
+	SolverSetLoopsLimit(&Solver, Batch_Configuration.Loops_Limit);
 
-	// Try to load the grid file
-	switch (GridLoadFromFile(String_Grid_File_Name, &Grid_Size))
+	// Try to load the grid file, a resumed checkpoint is read one grid at a time
+	if (Is_Resume_Enabled)
+	{
+		Resumed_File = fopen(String_Grid_File_Name, "rb");
+		if (Resumed_File == NULL) Result = -1;
+		else
+		{
+			Result = SolverLoadFromStream(&Solver, Resumed_File);
+			if (Result == 1) Result = -2; // The file contains no grid
+		}
+	}
+	else Result = SolverLoadFromFile(&Solver, String_Grid_File_Name);
+	switch (Result)
 	{
 		case -1:
 			printf("Error : can't open file %s.\n", String_Grid_File_Name);
@@ -148,25 +481,103 @@ int main(int argc, char *argv[])
 	printf("File : %s.\n\n", String_Grid_File_Name);
 	// Show grid
 	printf("Grid to solve :\n");
-	GridShow();
+	GridShow(&Solver.Grid);
 	putchar('\n');
 	
+	// The reports are printed by their own thread, so they are printed even when the search takes a long time between two pollings
+	if (Is_Progress_Enabled)
+	{
+		if (ProgressReporterStart(&Main_Progress_Reporter, &Solver, Progress_Period * 1000000, stderr) != 0)
+		{
+			printf("Error : the progress reporting thread could not be started.\n");
+			return EXIT_FAILURE;
+		}
+		signal(SIGUSR1, MainHandleSignal);
+	}
+	
+	// Search all solutions with a single thread, so they are counted once
+	if (Batch_Configuration.Is_Counting_Enabled)
+	{
+		if (Batch_Configuration.Is_Solutions_Display_Enabled) SolverSetSolutionCallback(&Solver, MainShowSolution, NULL);
+		Result = SolverCountSolutions(&Solver, Batch_Configuration.Solutions_Limit, &Solutions_Count);
+		if (Is_Progress_Enabled)
+		{
+			signal(SIGUSR1, SIG_IGN);
+			ProgressReporterStop(&Main_Progress_Reporter, &Solver);
+		}
+		if (Batch_Configuration.Statistics_File != NULL)
+		{
+			SolverWriteStatisticsRecord(&Solver, 0, Result, Batch_Configuration.Statistics_File);
+			fclose(Batch_Configuration.Statistics_File);
+		}
+		
+		printf("Solutions count : %llu", Solutions_Count);
+		if (Result == SOLVER_RESULT_TIMED_OUT) printf(" (the counting reached its time or loops limit after %llu loops, the grid may have more solutions).\n", Solver.Statistics.Loops_Count);
+		else if ((Batch_Configuration.Solutions_Limit > 0) && (Solutions_Count == Batch_Configuration.Solutions_Limit)) printf(" (the limit was reached, the grid may have more solutions).\n");
+		else if (Solutions_Count == 1) printf(", the grid has a single solution.\n");
+		else printf(".\n");
+		
+		if (Solutions_Count > 0) return EXIT_SUCCESS;
+		return EXIT_FAILURE;
+	}
+	
 	// Start solving
-	if (Backtrack() == 1)
+	if (String_Checkpoint_File_Name != NULL)
+	{
+		// Save the search state before stopping when the program is interrupted
+		SolverSetCancellationFlag(&Solver, &Main_Is_Solving_Cancelled);
+		signal(SIGINT, MainHandleSignal);
+		signal(SIGTERM, MainHandleSignal);
+		signal(SIGUSR2, MainHandleSignal);
+		
+		CheckpointInitialize(&Checkpoint, String_Checkpoint_File_Name, Checkpoint_Period * 1000000, &Main_Is_Checkpoint_Requested);
+		Result = CheckpointSolve(&Checkpoint, &Solver, Resumed_File);
+		if (Resumed_File != NULL) fclose(Resumed_File);
+		
+		if (Result == -3)
+		{
+			printf("Error : the checkpoint file contains a bad grid.\n");
+			return EXIT_FAILURE;
+		}
+		if (Checkpoint.Is_Write_Failed) printf("Error : could not write the checkpoint file %s.\n", String_Checkpoint_File_Name);
+		else if ((Result != SOLVER_RESULT_SOLVED) && (Result != SOLVER_RESULT_UNSOLVABLE) && (Checkpoint.Checkpoints_Count > 0)) printf("The search state was saved to %s, use \"--resume %s\" to resume the solving.\n", String_Checkpoint_File_Name, String_Checkpoint_File_Name);
+	}
+	else Result = ParallelSolverSolve(&Solver, Batch_Configuration.Threads_Count);
+	if (Is_Progress_Enabled)
+	{
+		signal(SIGUSR1, SIG_IGN);
+		ProgressReporterStop(&Main_Progress_Reporter, &Solver);
+	}
+	if (Batch_Configuration.Statistics_File != NULL)
+	{
+		SolverWriteStatisticsRecord(&Solver, 0, Result, Batch_Configuration.Statistics_File);
+		fclose(Batch_Configuration.Statistics_File);
+	}
+	
+	if (Result == SOLVER_RESULT_SOLVED)
 	{
-		printf("Grid successfully solved in %llu loops.\n", Loops_Count);
-		printf("Bad solutions found before the good one : %llu\n", Bad_Solutions_Found_Count);
-		printf("Avoided bad solutions : %llu\n", Avoided_Bad_Solutions_Count);
+		printf("Grid successfully solved in %llu loops.\n", Solver.Statistics.Loops_Count);
+		printf("Bad solutions found before the good one : %llu\n", Solver.Statistics.Bad_Solutions_Found_Count);
+		printf("Avoided bad solutions : %llu\n", Solver.Statistics.Avoided_Bad_Solutions_Count);
+		printf("Cells filled by propagation : %llu\n", Solver.Statistics.Propagated_Cells_Count);
 		printf("\nSolved grid :\n");
-		GridShow();
+		GridShow(&Solver.Grid);
 		putchar('\n');
 		return EXIT_SUCCESS;
 	}
 
+	// The search was stopped before exploring the whole search tree, so the grid may still have a solution
+	if (Result == SOLVER_RESULT_TIMED_OUT) printf("Failure : the solving reached its time or loops limit.\n");
+	else if ((Result == SOLVER_RESULT_CANCELLED) && (String_Checkpoint_File_Name != NULL)) printf("Failure : the solving was interrupted.\n");
+	else if (Result == SOLVER_RESULT_CANCELLED) printf("Failure : the solving threads could not be started.\n");
 	// Backtracking lead to the original grid, it is not solvable
-	printf("Failure : none stategie can solve this grid, sorry.\n\n");
+	else printf("Failure : none stategie can solve this grid, sorry.\n");
+	printf("Loops done : %llu\n", Solver.Statistics.Loops_Count);
+	printf("Bad solutions found : %llu\n", Solver.Statistics.Bad_Solutions_Found_Count);
+	printf("Avoided bad solutions : %llu\n", Solver.Statistics.Avoided_Bad_Solutions_Count);
+	printf("Cells filled by propagation : %llu\n\n", Solver.Statistics.Propagated_Cells_Count);
 	printf("Found grid :\n");
-	GridShow();
+	GridShow(&Solver.Grid);
 	putchar('\n');
 	return EXIT_FAILURE;
 }
@@ -0,0 +1,294 @@
+/** @file Packed_Grids.c
+ * @see Packed_Grids.h for description.
+ * @author Adrien RICCIARDI
+ */
+#define _FILE_OFFSET_BITS 64 // To position the stream beyond 2GB on 32-bit systems
+#include <Packed_Grids.h>
+#include <string.h>
+#include <sys/stat.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** The first bytes of a packed grids file. */
+#define PACKED_GRIDS_MAGIC "SUDOKUPK"
+/** The size of the magic, without its terminating zero. */
+#define PACKED_GRIDS_MAGIC_SIZE 8
+/** The format version written by this program. */
+#define PACKED_GRIDS_FORMAT_VERSION 1
+
+/** The offset of the records count in the header. */
+#define PACKED_GRIDS_HEADER_RECORDS_COUNT_OFFSET 16
+/** The header flag telling that a solution is stored beside each grid. */
+#define PACKED_GRIDS_HEADER_FLAG_SOLUTIONS_COLUMN 0x01
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Tell how many bits are needed to store the codes of all cells of a grid (from 0 for an empty cell to the grid size).
+ * @param Grid_Size The grid size.
+ * @return How many bits a cell uses.
+ */
+static inline unsigned int PackedGridsGetBitsPerCell(unsigned int Grid_Size)
+{
+	return 32 - __builtin_clz(Grid_Size);
+}
+
+/** Store a 64-bit value in little-endian order.
+ * @param Pointer_Bytes Where to store the value.
+ * @param Value The value.
+ */
+static void PackedGridsStoreValue(unsigned char *Pointer_Bytes, unsigned long long Value)
+{
+	int i;
+	
+	for (i = 0; i < 8; i++) Pointer_Bytes[i] = (unsigned char) (Value >> (i * 8));
+}
+
+/** Load a 64-bit value stored in little-endian order.
+ * @param Pointer_Bytes The stored value.
+ * @return The value.
+ */
+static unsigned long long PackedGridsLoadValue(const unsigned char *Pointer_Bytes)
+{
+	unsigned long long Value = 0;
+	int i;
+	
+	for (i = 7; i >= 0; i--) Value = (Value << 8) | Pointer_Bytes[i];
+	return Value;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+unsigned int PackedGridsGetGridBytesCount(unsigned int Grid_Size)
+{
+	return (Grid_Size * Grid_Size * PackedGridsGetBitsPerCell(Grid_Size) + 7) / 8;
+}
+
+unsigned int PackedGridsGetRecordBytesCount(TPackedGrids *Pointer_Packed_Grids)
+{
+	if (Pointer_Packed_Grids->Is_Solutions_Column_Present) return 2 * Pointer_Packed_Grids->Grid_Bytes_Count;
+	return Pointer_Packed_Grids->Grid_Bytes_Count;
+}
+
+void PackedGridsPackGrid(TGrid *Pointer_Grid, unsigned char *Pointer_Packed_Grid)
+{
+	unsigned int i, Cells_Count, Bits_Per_Cell, Pending_Bits_Count = 0, Code;
+	unsigned long long Pending_Bits = 0;
+	
+	Cells_Count = Pointer_Grid->Size * Pointer_Grid->Size;
+	Bits_Per_Cell = PackedGridsGetBitsPerCell(Pointer_Grid->Size);
+	
+	// The cells codes are appended to the bits stream from the least significant bit of each byte
+	for (i = 0; i < Cells_Count; i++)
+	{
+		// The empty cells are masked instead of being tested, as they are not predictable
+		Code = ((unsigned int) Pointer_Grid->Cells[i] + 1) & -(unsigned int) (Pointer_Grid->Cells[i] != GRID_EMPTY_CELL_VALUE);
+		Pending_Bits |= (unsigned long long) Code << Pending_Bits_Count;
+		Pending_Bits_Count += Bits_Per_Cell;
+		
+		while (Pending_Bits_Count >= 8)
+		{
+			*Pointer_Packed_Grid = (unsigned char) Pending_Bits;
+			Pointer_Packed_Grid++;
+			Pending_Bits >>= 8;
+			Pending_Bits_Count -= 8;
+		}
+	}
+	
+	// Write the last partial byte
+	if (Pending_Bits_Count > 0) *Pointer_Packed_Grid = (unsigned char) Pending_Bits;
+}
+
+int PackedGridsUnpackGrid(const unsigned char *Pointer_Packed_Grid, unsigned int Grid_Size, TGrid *Pointer_Grid)
+{
+	unsigned int i, Cells_Count, Bits_Per_Cell, Pending_Bits_Count = 0, Code, Code_Mask, Is_Bad = 0;
+	unsigned long long Pending_Bits = 0;
+	
+	if (!GridIsSizeSupported(Grid_Size)) return -2;
+	Cells_Count = Grid_Size * Grid_Size;
+	Bits_Per_Cell = PackedGridsGetBitsPerCell(Grid_Size);
+	Code_Mask = (1 << Bits_Per_Cell) - 1;
+	
+	for (i = 0; i < Cells_Count; i++)
+	{
+		// Get enough bits for the next cell code
+		while (Pending_Bits_Count < Bits_Per_Cell)
+		{
+			Pending_Bits |= (unsigned long long) *Pointer_Packed_Grid << Pending_Bits_Count;
+			Pointer_Packed_Grid++;
+			Pending_Bits_Count += 8;
+		}
+		Code = Pending_Bits & Code_Mask;
+		Pending_Bits >>= Bits_Per_Cell;
+		Pending_Bits_Count -= Bits_Per_Cell;
+		
+		Is_Bad |= Code > Grid_Size;
+		Pointer_Grid->Cells[i] = (int) Code - 1 + ((GRID_EMPTY_CELL_VALUE + 1) & -(int) (Code == 0));
+	}
+	
+	if (Is_Bad) return -3;
+	return GridLoadFromCells(Pointer_Grid, Grid_Size);
+}
+
+int PackedGridsIsPackedFile(char *String_File_Name)
+{
+	FILE *File;
+	struct stat File_Status;
+	char Magic[PACKED_GRIDS_MAGIC_SIZE];
+	int Is_Packed_File = 0;
+	
+	// Only the regular files are checked, so the first bytes of a pipe are never consumed
+	if ((stat(String_File_Name, &File_Status) != 0) || !S_ISREG(File_Status.st_mode)) return 0;
+	
+	File = fopen(String_File_Name, "rb");
+	if (File == NULL) return 0;
+	if ((fread(Magic, 1, sizeof(Magic), File) == sizeof(Magic)) && (memcmp(Magic, PACKED_GRIDS_MAGIC, PACKED_GRIDS_MAGIC_SIZE) == 0)) Is_Packed_File = 1;
+	fclose(File);
+	return Is_Packed_File;
+}
+
+int PackedGridsCreate(TPackedGrids *Pointer_Packed_Grids, FILE *File, TGrid *Pointer_Grid, int Is_Solutions_Column_Present)
+{
+	unsigned char Header[PACKED_GRIDS_HEADER_SIZE];
+	
+	Pointer_Packed_Grids->File = File;
+	Pointer_Packed_Grids->Grid_Size = Pointer_Grid->Size;
+	Pointer_Packed_Grids->Grid_Bytes_Count = PackedGridsGetGridBytesCount(Pointer_Grid->Size);
+	Pointer_Packed_Grids->Is_Solutions_Column_Present = Is_Solutions_Column_Present;
+	Pointer_Packed_Grids->Records_Count = PACKED_GRIDS_UNKNOWN_RECORDS_COUNT;
+	Pointer_Packed_Grids->Record_Index = 0;
+	
+	// The records count is written when the file is finished, if the stream can be rewound
+	memset(Header, 0, sizeof(Header));
+	memcpy(Header, PACKED_GRIDS_MAGIC, PACKED_GRIDS_MAGIC_SIZE);
+	Header[8] = PACKED_GRIDS_FORMAT_VERSION;
+	Header[9] = Pointer_Grid->Size;
+	Header[10] = Pointer_Grid->Square_Width;
+	Header[11] = Pointer_Grid->Square_Height;
+	Header[12] = PackedGridsGetBitsPerCell(Pointer_Grid->Size);
+	if (Is_Solutions_Column_Present) Header[13] = PACKED_GRIDS_HEADER_FLAG_SOLUTIONS_COLUMN;
+	PackedGridsStoreValue(&Header[PACKED_GRIDS_HEADER_RECORDS_COUNT_OFFSET], PACKED_GRIDS_UNKNOWN_RECORDS_COUNT);
+	
+	if (fwrite(Header, sizeof(Header), 1, File) != 1) return -1;
+	return 0;
+}
+
+int PackedGridsWriteRecord(TPackedGrids *Pointer_Packed_Grids, const unsigned char *Pointer_Packed_Grid, const unsigned char *Pointer_Packed_Solution)
+{
+	unsigned int Grid_Bytes_Count = Pointer_Packed_Grids->Grid_Bytes_Count;
+	
+	// Build the whole record, so it is written at once
+	memcpy(Pointer_Packed_Grids->Record, Pointer_Packed_Grid, Grid_Bytes_Count);
+	if (Pointer_Packed_Grids->Is_Solutions_Column_Present)
+	{
+		// A grid without solution has an empty solution
+		if (Pointer_Packed_Solution == NULL) memset(&Pointer_Packed_Grids->Record[Grid_Bytes_Count], 0, Grid_Bytes_Count);
+		else memcpy(&Pointer_Packed_Grids->Record[Grid_Bytes_Count], Pointer_Packed_Solution, Grid_Bytes_Count);
+	}
+	
+	if (fwrite(Pointer_Packed_Grids->Record, PackedGridsGetRecordBytesCount(Pointer_Packed_Grids), 1, Pointer_Packed_Grids->File) != 1) return -1;
+	Pointer_Packed_Grids->Record_Index++;
+	return 0;
+}
+
+int PackedGridsFinishWriting(TPackedGrids *Pointer_Packed_Grids)
+{
+	unsigned char Records_Count[8];
+	FILE *File = Pointer_Packed_Grids->File;
+	
+	// Keep the unknown records count if the stream is a pipe or a terminal
+	if (fseeko(File, PACKED_GRIDS_HEADER_RECORDS_COUNT_OFFSET, SEEK_SET) == 0)
+	{
+		PackedGridsStoreValue(Records_Count, Pointer_Packed_Grids->Record_Index);
+		if (fwrite(Records_Count, sizeof(Records_Count), 1, File) != 1) return -1;
+		if (fseeko(File, 0, SEEK_END) != 0) return -1;
+		Pointer_Packed_Grids->Records_Count = Pointer_Packed_Grids->Record_Index;
+	}
+	
+	if (fflush(File) != 0) return -1;
+	return 0;
+}
+
+int PackedGridsDecodeHeader(TPackedGrids *Pointer_Packed_Grids, const unsigned char *Pointer_Header)
+{
+	unsigned int Grid_Size;
+	
+	if (memcmp(Pointer_Header, PACKED_GRIDS_MAGIC, PACKED_GRIDS_MAGIC_SIZE) != 0) return -1;
+	
+	// Check that the header describes grids that can be loaded
+	if (Pointer_Header[8] != PACKED_GRIDS_FORMAT_VERSION) return -2;
+	Grid_Size = Pointer_Header[9];
+	if (!GridIsSizeSupported(Grid_Size) || (Pointer_Header[10] * Pointer_Header[11] != Grid_Size) || (Pointer_Header[12] != PackedGridsGetBitsPerCell(Grid_Size))) return -2;
+	
+	Pointer_Packed_Grids->File = NULL;
+	Pointer_Packed_Grids->Grid_Size = Grid_Size;
+	Pointer_Packed_Grids->Grid_Bytes_Count = PackedGridsGetGridBytesCount(Grid_Size);
+	Pointer_Packed_Grids->Is_Solutions_Column_Present = (Pointer_Header[13] & PACKED_GRIDS_HEADER_FLAG_SOLUTIONS_COLUMN) != 0;
+	Pointer_Packed_Grids->Records_Count = PackedGridsLoadValue(&Pointer_Header[PACKED_GRIDS_HEADER_RECORDS_COUNT_OFFSET]);
+	Pointer_Packed_Grids->Record_Index = 0;
+	return 0;
+}
+
+int PackedGridsOpen(TPackedGrids *Pointer_Packed_Grids, FILE *File)
+{
+	unsigned char Header[PACKED_GRIDS_HEADER_SIZE];
+	int Result;
+	
+	if (fread(Header, sizeof(Header), 1, File) != 1) return -1;
+	Result = PackedGridsDecodeHeader(Pointer_Packed_Grids, Header);
+	if (Result != 0) return Result;
+	
+	Pointer_Packed_Grids->File = File;
+	return 0;
+}
+
+int PackedGridsSeekRecord(TPackedGrids *Pointer_Packed_Grids, unsigned long long Record_Index)
+{
+	if ((Pointer_Packed_Grids->Records_Count != PACKED_GRIDS_UNKNOWN_RECORDS_COUNT) && (Record_Index >= Pointer_Packed_Grids->Records_Count)) return -1;
+	
+	// All records have the same size
+	if (fseeko(Pointer_Packed_Grids->File, PACKED_GRIDS_HEADER_SIZE + Record_Index * PackedGridsGetRecordBytesCount(Pointer_Packed_Grids), SEEK_SET) != 0) return -1;
+	Pointer_Packed_Grids->Record_Index = Record_Index;
+	return 0;
+}
+
+int PackedGridsReadRecord(TPackedGrids *Pointer_Packed_Grids, TGrid *Pointer_Grid, TGrid *Pointer_Solution, int *Pointer_Is_Solution_Present)
+{
+	// A truncated last record is ignored
+	if (Pointer_Packed_Grids->Record_Index >= Pointer_Packed_Grids->Records_Count) return 1;
+	if (fread(Pointer_Packed_Grids->Record, PackedGridsGetRecordBytesCount(Pointer_Packed_Grids), 1, Pointer_Packed_Grids->File) != 1) return 1;
+	Pointer_Packed_Grids->Record_Index++;
+	
+	return PackedGridsUnpackRecord(Pointer_Packed_Grids, Pointer_Packed_Grids->Record, Pointer_Grid, Pointer_Solution, Pointer_Is_Solution_Present);
+}
+
+int PackedGridsUnpackRecord(TPackedGrids *Pointer_Packed_Grids, const unsigned char *Pointer_Record, TGrid *Pointer_Grid, TGrid *Pointer_Solution, int *Pointer_Is_Solution_Present)
+{
+	unsigned int i, Grid_Bytes_Count = Pointer_Packed_Grids->Grid_Bytes_Count;
+	const unsigned char *Pointer_Packed_Solution;
+	
+	if (PackedGridsUnpackGrid(Pointer_Record, Pointer_Packed_Grids->Grid_Size, Pointer_Grid) != 0) return -3;
+	
+	if (Pointer_Solution == NULL) return 0;
+	*Pointer_Is_Solution_Present = 0;
+	if (!Pointer_Packed_Grids->Is_Solutions_Column_Present) return 0;
+	
+	// An empty solution means that the grid was not solved
+	Pointer_Packed_Solution = &Pointer_Record[Grid_Bytes_Count];
+	for (i = 0; i < Grid_Bytes_Count; i++)
+	{
+		if (Pointer_Packed_Solution[i] != 0) break;
+	}
+	if (i == Grid_Bytes_Count) return 0;
+	
+	// A solution has all its cells filled
+	if (PackedGridsUnpackGrid(Pointer_Packed_Solution, Pointer_Packed_Grids->Grid_Size, Pointer_Solution) != 0) return -3;
+	for (i = 0; i < Pointer_Solution->Size * Pointer_Solution->Size; i++)
+	{
+		if (Pointer_Solution->Cells[i] == GRID_EMPTY_CELL_VALUE) return -3;
+	}
+	*Pointer_Is_Solution_Present = 1;
+	return 0;
+}
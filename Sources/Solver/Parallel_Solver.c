@@ -0,0 +1,451 @@
+/** @file Parallel_Solver.c
+ * @see Parallel_Solver.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Clock.h>
+#include <Grid.h>
+#include <Parallel_Solver.h>
+#include <pthread.h>
+#include <sched.h>
+#include <Solver.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <Tasks_Deque.h>
+#include <unistd.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** How many grids are created for each thread before starting the threads. */
+#define PARALLEL_SOLVER_INITIAL_GRIDS_PER_THREAD 8
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+struct TParallelSolverContext;
+
+/** A solving thread. */
+typedef struct
+{
+	TTasksDeque Deque; //! The grids to solve by this thread (other threads can steal them).
+	TSolver Solver; //! This thread solver context.
+	TSolverStatistics Statistics; //! The statistics of all grids solved by this thread.
+	#if CONFIGURATION_SOLVER_INSTRUMENTATION
+		TInstrumentation Instrumentation; //! The measures of all grids solved by this thread (their depths start from each grid root).
+	#endif
+	unsigned long long Published_Loops_Count; //! The loops of the grid being solved that were already added to the loops count of all workers.
+	pthread_t Thread; //! The thread identifier.
+	int Index; //! The thread index in the workers array.
+	struct TParallelSolverContext *Pointer_Context; //! The data shared by all workers.
+} TParallelSolverWorker;
+
+/** All data shared by the solving threads. */
+typedef struct TParallelSolverContext
+{
+	TParallelSolverWorker *Pointer_Workers; //! All workers.
+	int Workers_Count; //! How many workers are running.
+	atomic_long Pending_Grids_Count; //! How many grids are not fully explored yet (a grid is counted from its creation until its solving ends).
+	atomic_int Idle_Workers_Count; //! How many workers are looking for a grid to solve.
+	atomic_int Is_Search_Stopped; //! Set to 1 by the first worker finding a solution or noticing that the solving must stop, this cancels all other workers.
+	int Result; //! Why the search was stopped (a SOLVER_RESULT_XXX value), it is set by the worker which stopped the search.
+	atomic_int *Pointer_Cancellation_Flag; //! The cancellation flag of the solver context, or NULL if the solving can't be cancelled.
+	unsigned long long Deadline; //! When the solving must stop, in nanoseconds of the monotonic clock (0 means no time limit).
+	atomic_ullong Loops_Count; //! The loops done by the expansion and by all workers, each worker adds its loops at each polling.
+	unsigned long long Loops_Limit; //! The solving stops when all workers together have done this many loops (0 means no limit).
+	TGrid Solution; //! The solved grid.
+} TParallelSolverContext;
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Find the cell to branch on, in the same order than the solver.
+ * @param Pointer_Grid The grid.
+ * @param Cell_Order How the solver chooses the cells (SOLVER_CELL_ORDER_XXX).
+ * @param Pointer_Row On output, contain the cell row coordinate.
+ * @param Pointer_Column On output, contain the cell column coordinate.
+ * @return 1 if an empty cell was found,
+ * @return 0 if the grid is full.
+ */
+static int ParallelSolverFindCellToFill(TGrid *Pointer_Grid, int Cell_Order, unsigned int *Pointer_Row, unsigned int *Pointer_Column)
+{
+	unsigned int Row, Column;
+	int Count, Minimum_Count = CONFIGURATION_GRID_MAXIMUM_SIZE + 1;
+	
+	for (Row = 0; Row < Pointer_Grid->Size; Row++)
+	{
+		for (Column = 0; Column < Pointer_Grid->Size; Column++)
+		{
+			if (Pointer_Grid->Cells[Row * Pointer_Grid->Size + Column] != GRID_EMPTY_CELL_VALUE) continue;
+			
+			// The first empty cell is the right one in fixed order
+			if (Cell_Order == SOLVER_CELL_ORDER_FIXED)
+			{
+				*Pointer_Row = Row;
+				*Pointer_Column = Column;
+				return 1;
+			}
+			
+			// Otherwise keep the cell with the fewest allowed numbers
+			Count = GRID_BITMASK_COUNT_NUMBERS(GridGetCellMissingNumbers(Pointer_Grid, Row, Column));
+			if (Count < Minimum_Count)
+			{
+				Minimum_Count = Count;
+				*Pointer_Row = Row;
+				*Pointer_Column = Column;
+			}
+		}
+	}
+	return Minimum_Count <= CONFIGURATION_GRID_MAXIMUM_SIZE;
+}
+
+/** Stop all workers. Only the first stop is kept, so the result is the one of the first worker stopping the search.
+ * @param Pointer_Context The workers context.
+ * @param Result Why the search is stopped (a SOLVER_RESULT_XXX value).
+ * @return 1 if this call stopped the search,
+ * @return 0 if the search was already stopped.
+ */
+static int ParallelSolverStopSearch(TParallelSolverContext *Pointer_Context, int Result)
+{
+	int Expected_Value = 0;
+	
+	if (!atomic_compare_exchange_strong(&Pointer_Context->Is_Search_Stopped, &Expected_Value, 1)) return 0;
+	Pointer_Context->Result = Result;
+	return 1;
+}
+
+/** Add the loops done by a worker since its previous publication to the loops count of all workers.
+ * @param Pointer_Worker The worker.
+ */
+static inline void ParallelSolverPublishLoops(TParallelSolverWorker *Pointer_Worker)
+{
+	unsigned long long Loops_Count = Pointer_Worker->Solver.Statistics.Loops_Count;
+	
+	atomic_fetch_add_explicit(&Pointer_Worker->Pointer_Context->Loops_Count, Loops_Count - Pointer_Worker->Published_Loops_Count, memory_order_relaxed);
+	Pointer_Worker->Published_Loops_Count = Loops_Count;
+}
+
+/** Stop all workers when the solving is cancelled by the caller or when it reaches its time limit or its loops limit.
+ * @param Pointer_Context The workers context.
+ * @return 1 if the search is stopped,
+ * @return 0 if the search can go on.
+ */
+static int ParallelSolverIsStopNeeded(TParallelSolverContext *Pointer_Context)
+{
+	if ((Pointer_Context->Pointer_Cancellation_Flag != NULL) && atomic_load_explicit(Pointer_Context->Pointer_Cancellation_Flag, memory_order_relaxed)) ParallelSolverStopSearch(Pointer_Context, SOLVER_RESULT_CANCELLED);
+	else if ((Pointer_Context->Deadline != 0) && (ClockGetTime() >= Pointer_Context->Deadline)) ParallelSolverStopSearch(Pointer_Context, SOLVER_RESULT_TIMED_OUT);
+	else if ((Pointer_Context->Loops_Limit != 0) && (atomic_load_explicit(&Pointer_Context->Loops_Count, memory_order_relaxed) >= Pointer_Context->Loops_Limit)) ParallelSolverStopSearch(Pointer_Context, SOLVER_RESULT_TIMED_OUT);
+	return atomic_load(&Pointer_Context->Is_Search_Stopped);
+}
+
+/** Allocate a copy of a grid.
+ * @param Pointer_Grid The grid to copy.
+ * @return The copy,
+ * @return NULL if there is not enough memory.
+ */
+static TGrid *ParallelSolverDuplicateGrid(TGrid *Pointer_Grid)
+{
+	TGrid *Pointer_Copy;
+	
+	Pointer_Copy = malloc(sizeof(TGrid));
+	if (Pointer_Copy != NULL) GridCopy(Pointer_Copy, Pointer_Grid);
+	return Pointer_Copy;
+}
+
+/** The solver callback telling whether the worker should hand out a part of its search tree. As the solvers call it periodically, it also publishes the worker loops and stops all workers when the solving must stop (the workers solvers are stopped by their cancellation flag at their next polling).
+ * @param Pointer_Argument The worker.
+ * @return 1 if some workers are idle and this worker has no grid left in its deque for them,
+ * @return 0 if no split is needed.
+ */
+static int ParallelSolverIsSplitRequested(void *Pointer_Argument)
+{
+	TParallelSolverWorker *Pointer_Worker = Pointer_Argument;
+	
+	ParallelSolverPublishLoops(Pointer_Worker);
+	if (ParallelSolverIsStopNeeded(Pointer_Worker->Pointer_Context)) return 0;
+	if ((atomic_load_explicit(&Pointer_Worker->Pointer_Context->Idle_Workers_Count, memory_order_relaxed) > 0) && TasksDequeIsEmpty(&Pointer_Worker->Deque)) return 1;
+	return 0;
+}
+
+/** The solver callback receiving a part of the search tree, it is pushed to the worker deque so idle workers can steal it.
+ * @param Pointer_Argument The worker.
+ * @param Pointer_Grid The grid to solve.
+ * @return 0 if the grid was taken,
+ * @return -1 if the grid could not be taken.
+ */
+static int ParallelSolverSplit(void *Pointer_Argument, TGrid *Pointer_Grid)
+{
+	TParallelSolverWorker *Pointer_Worker = Pointer_Argument;
+	TGrid *Pointer_Copy;
+	
+	Pointer_Copy = ParallelSolverDuplicateGrid(Pointer_Grid);
+	if (Pointer_Copy == NULL) return -1;
+	
+	// Count the grid before it can be stolen, so the pending grids count can't reach zero while this grid is not solved
+	atomic_fetch_add(&Pointer_Worker->Pointer_Context->Pending_Grids_Count, 1);
+	if (TasksDequePush(&Pointer_Worker->Deque, Pointer_Copy) != 0)
+	{
+		atomic_fetch_sub(&Pointer_Worker->Pointer_Context->Pending_Grids_Count, 1);
+		free(Pointer_Copy);
+		return -1;
+	}
+	return 0;
+}
+
+/** Take a grid from another worker deque.
+ * @param Pointer_Worker The worker looking for a grid.
+ * @return The stolen grid,
+ * @return NULL if no grid could be stolen.
+ */
+static TGrid *ParallelSolverStealGrid(TParallelSolverWorker *Pointer_Worker)
+{
+	int i, Workers_Count;
+	void *Pointer_Task;
+	TParallelSolverWorker *Pointer_Workers;
+	
+	Workers_Count = Pointer_Worker->Pointer_Context->Workers_Count;
+	Pointer_Workers = Pointer_Worker->Pointer_Context->Pointer_Workers;
+	for (i = 1; i < Workers_Count; i++)
+	{
+		if (TasksDequeSteal(&Pointer_Workers[(Pointer_Worker->Index + i) % Workers_Count].Deque, &Pointer_Task) == TASKS_DEQUE_STEAL_RESULT_SUCCESS) return Pointer_Task;
+	}
+	return NULL;
+}
+
+/** A solving thread, it solves grids until a solution is found, until all grids are fully explored or until the solving must stop.
+ * @param Pointer_Argument The worker.
+ * @return Always NULL.
+ */
+static void *ParallelSolverWorkerThread(void *Pointer_Argument)
+{
+	TParallelSolverWorker *Pointer_Worker = Pointer_Argument;
+	TParallelSolverContext *Pointer_Context = Pointer_Worker->Pointer_Context;
+	TGrid *Pointer_Grid;
+	int Is_Idle = 0, Result;
+	
+	while (!ParallelSolverIsStopNeeded(Pointer_Context))
+	{
+		// Find a grid to solve, starting with the ones of this worker
+		Pointer_Grid = TasksDequePop(&Pointer_Worker->Deque);
+		if (Pointer_Grid == NULL) Pointer_Grid = ParallelSolverStealGrid(Pointer_Worker);
+		if (Pointer_Grid == NULL)
+		{
+			// Tell the busy workers that their search trees should be split
+			if (!Is_Idle)
+			{
+				atomic_fetch_add(&Pointer_Context->Idle_Workers_Count, 1);
+				Is_Idle = 1;
+			}
+			
+			// The grid has no solution when all grids have been fully explored
+			if (atomic_load(&Pointer_Context->Pending_Grids_Count) == 0) break;
+			sched_yield();
+			continue;
+		}
+		if (Is_Idle)
+		{
+			atomic_fetch_sub(&Pointer_Context->Idle_Workers_Count, 1);
+			Is_Idle = 0;
+		}
+		
+		// Explore the grid subtree
+		SolverLoadFromGrid(&Pointer_Worker->Solver, Pointer_Grid);
+		free(Pointer_Grid);
+		Result = SolverSolve(&Pointer_Worker->Solver);
+		// Only the first solution is kept
+		if ((Result == SOLVER_RESULT_SOLVED) && ParallelSolverStopSearch(Pointer_Context, SOLVER_RESULT_SOLVED)) GridCopy(&Pointer_Context->Solution, &Pointer_Worker->Solver.Grid);
+		ParallelSolverPublishLoops(Pointer_Worker);
+		Pointer_Worker->Published_Loops_Count = 0; // The next grid loops are counted from zero
+		Pointer_Worker->Statistics.Loops_Count += Pointer_Worker->Solver.Statistics.Loops_Count;
+		Pointer_Worker->Statistics.Bad_Solutions_Found_Count += Pointer_Worker->Solver.Statistics.Bad_Solutions_Found_Count;
+		Pointer_Worker->Statistics.Avoided_Bad_Solutions_Count += Pointer_Worker->Solver.Statistics.Avoided_Bad_Solutions_Count;
+		Pointer_Worker->Statistics.Propagated_Cells_Count += Pointer_Worker->Solver.Statistics.Propagated_Cells_Count;
+		#if CONFIGURATION_SOLVER_INSTRUMENTATION
+			InstrumentationAdd(&Pointer_Worker->Instrumentation, &Pointer_Worker->Solver.Instrumentation);
+		#endif
+		
+		// The grids handed out during the solving were counted before, so the pending count can't reach zero too soon
+		atomic_fetch_sub(&Pointer_Context->Pending_Grids_Count, 1);
+	}
+	
+	if (Is_Idle) atomic_fetch_sub(&Pointer_Context->Idle_Workers_Count, 1);
+	return NULL;
+}
+
+/** Expand the top levels of the search tree until there are enough independent grids to give to the workers. The grids are given to the workers in turn.
+ * @param Pointer_Context The workers context.
+ * @param Pointer_Root_Grid The grid to solve.
+ * @param Cell_Order How the solvers choose the cells (SOLVER_CELL_ORDER_XXX).
+ * @param Pointer_Statistics On output, the loops done by the expansion are added to the statistics.
+ * @return 1 if the expansion found the solution (which is stored in the context),
+ * @return 0 if the grids were distributed,
+ * @return -1 if there is not enough memory.
+ */
+static int ParallelSolverExpand(TParallelSolverContext *Pointer_Context, TGrid *Pointer_Root_Grid, int Cell_Order, TSolverStatistics *Pointer_Statistics)
+{
+	TGrid **Pointer_Grids, *Pointer_Grid, *Pointer_Child_Grid;
+	int Read_Index = 0, Write_Index = 0, Maximum_Grids_Count, Queue_Size, Result = 0;
+	unsigned int Row, Column, Number;
+	TGridBitmask Bitmask_Missing_Numbers;
+	
+	// The circular queue can receive all children of the last expanded grid
+	Maximum_Grids_Count = Pointer_Context->Workers_Count * PARALLEL_SOLVER_INITIAL_GRIDS_PER_THREAD;
+	Queue_Size = Maximum_Grids_Count + CONFIGURATION_GRID_MAXIMUM_SIZE;
+	Pointer_Grids = malloc(Queue_Size * sizeof(TGrid *));
+	if (Pointer_Grids == NULL) return -1;
+	Pointer_Grid = ParallelSolverDuplicateGrid(Pointer_Root_Grid);
+	if (Pointer_Grid == NULL)
+	{
+		free(Pointer_Grids);
+		return -1;
+	}
+	Pointer_Grids[Write_Index] = Pointer_Grid;
+	Write_Index++;
+	
+	// Breadth-first expansion, so all grids have about the same size
+	while ((Read_Index < Write_Index) && (Write_Index - Read_Index < Maximum_Grids_Count))
+	{
+		Pointer_Grid = Pointer_Grids[Read_Index % Queue_Size];
+		
+		// A full grid is the solution if it is correct
+		if (!ParallelSolverFindCellToFill(Pointer_Grid, Cell_Order, &Row, &Column))
+		{
+			if (GridIsCorrectlyFilled(Pointer_Grid))
+			{
+				GridCopy(&Pointer_Context->Solution, Pointer_Grid);
+				Result = 1;
+				break;
+			}
+			free(Pointer_Grid);
+			Read_Index++;
+			continue;
+		}
+		Read_Index++;
+		
+		// Create a child grid for each allowed number (a grid with no allowed number is a dead end and simply disappears)
+		Bitmask_Missing_Numbers = GridGetCellMissingNumbers(Pointer_Grid, Row, Column);
+		for (Number = 0; Number < Pointer_Grid->Size; Number++)
+		{
+			if (!(Bitmask_Missing_Numbers & GRID_BITMASK_NUMBER(Number))) continue;
+			
+			Pointer_Child_Grid = ParallelSolverDuplicateGrid(Pointer_Grid);
+			if (Pointer_Child_Grid == NULL)
+			{
+				Result = -1;
+				break;
+			}
+			GridSetCellValue(Pointer_Child_Grid, Row, Column, Number);
+			GridRemoveCellMissingNumber(Pointer_Child_Grid, Row, Column, Number);
+			Pointer_Grids[Write_Index % Queue_Size] = Pointer_Child_Grid;
+			Write_Index++;
+			Pointer_Statistics->Loops_Count++;
+		}
+		free(Pointer_Grid);
+		if (Result != 0) break;
+	}
+	
+	// Give the grids to the workers in turn, or release them if the expansion is over
+	atomic_init(&Pointer_Context->Pending_Grids_Count, 0);
+	for ( ; Read_Index < Write_Index; Read_Index++)
+	{
+		Pointer_Grid = Pointer_Grids[Read_Index % Queue_Size];
+		if (Result != 0) free(Pointer_Grid);
+		else
+		{
+			TasksDequePush(&Pointer_Context->Pointer_Workers[Read_Index % Pointer_Context->Workers_Count].Deque, Pointer_Grid); // The deques are big enough to hold all grids
+			atomic_fetch_add(&Pointer_Context->Pending_Grids_Count, 1);
+		}
+	}
+	
+	free(Pointer_Grids);
+	return Result;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int ParallelSolverSolve(TSolver *Pointer_Solver, int Threads_Count)
+{
+	TParallelSolverContext Context;
+	TParallelSolverWorker *Pointer_Workers;
+	TGrid *Pointer_Grid;
+	int i, Result, Started_Threads_Count;
+	
+	// Use all processor cores if no threads count is provided
+	if (Threads_Count <= 0) Threads_Count = sysconf(_SC_NPROCESSORS_ONLN);
+	// The dancing links engine can't hand out parts of its search tree
+	if ((Threads_Count <= 1) || (Pointer_Solver->Configuration.Engine == SOLVER_ENGINE_DANCING_LINKS)) return SolverSolve(Pointer_Solver);
+	
+	// Create the workers (the deques must be aligned on a cache line)
+	Pointer_Workers = aligned_alloc(TASKS_DEQUE_CACHE_LINE_SIZE, Threads_Count * sizeof(TParallelSolverWorker));
+	if (Pointer_Workers == NULL) return SOLVER_RESULT_CANCELLED;
+	Context.Pointer_Workers = Pointer_Workers;
+	Context.Workers_Count = Threads_Count;
+	atomic_init(&Context.Idle_Workers_Count, 0);
+	atomic_init(&Context.Is_Search_Stopped, 0);
+	Context.Pointer_Cancellation_Flag = Pointer_Solver->Pointer_Cancellation_Flag;
+	if (Pointer_Solver->Time_Limit != 0) Context.Deadline = ClockGetTime() + Pointer_Solver->Time_Limit * 1000;
+	else Context.Deadline = 0;
+	Context.Loops_Limit = Pointer_Solver->Loops_Limit;
+	for (i = 0; i < Threads_Count; i++)
+	{
+		TasksDequeInitialize(&Pointer_Workers[i].Deque);
+		SolverInitialize(&Pointer_Workers[i].Solver);
+		SolverSetConfiguration(&Pointer_Workers[i].Solver, &Pointer_Solver->Configuration);
+		SolverSetCancellationFlag(&Pointer_Workers[i].Solver, &Context.Is_Search_Stopped);
+		SolverSetSplitCallbacks(&Pointer_Workers[i].Solver, ParallelSolverIsSplitRequested, ParallelSolverSplit, &Pointer_Workers[i]);
+		Pointer_Workers[i].Statistics.Loops_Count = 0;
+		Pointer_Workers[i].Statistics.Bad_Solutions_Found_Count = 0;
+		Pointer_Workers[i].Statistics.Avoided_Bad_Solutions_Count = 0;
+		Pointer_Workers[i].Statistics.Propagated_Cells_Count = 0;
+		Pointer_Workers[i].Published_Loops_Count = 0;
+		#if CONFIGURATION_SOLVER_INSTRUMENTATION
+			InstrumentationReset(&Pointer_Workers[i].Instrumentation);
+		#endif
+		Pointer_Workers[i].Index = i;
+		Pointer_Workers[i].Pointer_Context = &Context;
+	}
+	
+	// Split the top of the search tree
+	Pointer_Solver->Statistics.Loops_Count = 1;
+	Pointer_Solver->Statistics.Bad_Solutions_Found_Count = 0;
+	Pointer_Solver->Statistics.Avoided_Bad_Solutions_Count = 0;
+	Pointer_Solver->Statistics.Propagated_Cells_Count = 0;
+	Result = ParallelSolverExpand(&Context, &Pointer_Solver->Grid, Pointer_Solver->Configuration.Cell_Order, &Pointer_Solver->Statistics);
+	if (Result != 0)
+	{
+		free(Pointer_Workers);
+		if (Result < 0) return SOLVER_RESULT_CANCELLED;
+		GridCopy(&Pointer_Solver->Grid, &Context.Solution);
+		return SOLVER_RESULT_SOLVED;
+	}
+	
+	// Explore all subtrees, the loops limit also counts the expansion loops
+	atomic_init(&Context.Loops_Count, Pointer_Solver->Statistics.Loops_Count);
+	for (Started_Threads_Count = 0; Started_Threads_Count < Threads_Count; Started_Threads_Count++)
+	{
+		if (pthread_create(&Pointer_Workers[Started_Threads_Count].Thread, NULL, ParallelSolverWorkerThread, &Pointer_Workers[Started_Threads_Count]) != 0) break; // The running workers steal the grids of the missing ones
+	}
+	if (Started_Threads_Count == 0) atomic_store(&Context.Is_Search_Stopped, 1); // Nothing can be explored, only release the grids
+	for (i = 0; i < Started_Threads_Count; i++) pthread_join(Pointer_Workers[i].Thread, NULL);
+	
+	// Gather the results
+	for (i = 0; i < Threads_Count; i++)
+	{
+		// Release the grids left when a solution was found
+		while ((Pointer_Grid = TasksDequePop(&Pointer_Workers[i].Deque)) != NULL) free(Pointer_Grid);
+		
+		Pointer_Solver->Statistics.Loops_Count += Pointer_Workers[i].Statistics.Loops_Count;
+		Pointer_Solver->Statistics.Bad_Solutions_Found_Count += Pointer_Workers[i].Statistics.Bad_Solutions_Found_Count;
+		Pointer_Solver->Statistics.Avoided_Bad_Solutions_Count += Pointer_Workers[i].Statistics.Avoided_Bad_Solutions_Count;
+		Pointer_Solver->Statistics.Propagated_Cells_Count += Pointer_Workers[i].Statistics.Propagated_Cells_Count;
+		#if CONFIGURATION_SOLVER_INSTRUMENTATION
+			InstrumentationAdd(&Pointer_Solver->Instrumentation, &Pointer_Workers[i].Instrumentation);
+		#endif
+	}
+	free(Pointer_Workers);
+	
+	if (Started_Threads_Count == 0) return SOLVER_RESULT_CANCELLED;
+	if (!atomic_load(&Context.Is_Search_Stopped)) return SOLVER_RESULT_UNSOLVABLE;
+	if (Context.Result == SOLVER_RESULT_SOLVED) GridCopy(&Pointer_Solver->Grid, &Context.Solution);
+	return Context.Result;
+}
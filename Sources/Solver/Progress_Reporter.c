@@ -0,0 +1,102 @@
+/** @file Progress_Reporter.c
+ * @see Progress_Reporter.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <Clock.h>
+#include <errno.h>
+#include <Progress_Reporter.h>
+#include <Solver.h>
+#include <time.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Print a report.
+ * @param Pointer_Reporter The progress reporter.
+ */
+static void ProgressReporterPrint(TProgressReporter *Pointer_Reporter)
+{
+	TSolverProgress *Pointer_Progress = &Pointer_Reporter->Progress;
+	unsigned long long Current_Time, Loops_Count, Loops_Per_Second = 0;
+	
+	Current_Time = ClockGetTime();
+	Loops_Count = atomic_load_explicit(&Pointer_Progress->Loops_Count, memory_order_relaxed);
+	if (Current_Time > Pointer_Reporter->Previous_Report_Time) Loops_Per_Second = (Loops_Count - Pointer_Reporter->Previous_Loops_Count) * 1000000000.0 / (Current_Time - Pointer_Reporter->Previous_Report_Time);
+	
+	fprintf(Pointer_Reporter->File, "Progress : %.1f s, %llu loops (%llu loops/s), depth %d (deepest %d), about %.10f %% of the search tree explored.\n", (Current_Time - Pointer_Reporter->Start_Time) / 1000000000.0, Loops_Count, Loops_Per_Second,
+		atomic_load_explicit(&Pointer_Progress->Depth, memory_order_relaxed), atomic_load_explicit(&Pointer_Progress->Maximum_Depth, memory_order_relaxed),
+		atomic_load_explicit(&Pointer_Progress->Explored_Fraction, memory_order_relaxed) * 100.0 / SOLVER_PROGRESS_FRACTION_UNIT);
+	fflush(Pointer_Reporter->File);
+	
+	Pointer_Reporter->Previous_Report_Time = Current_Time;
+	Pointer_Reporter->Previous_Loops_Count = Loops_Count;
+}
+
+/** The reporting thread, it sleeps until the period is elapsed or until it is woken up by a request or by the stop.
+ * @param Pointer_Argument The progress reporter.
+ * @return Always NULL.
+ */
+static void *ProgressReporterThread(void *Pointer_Argument)
+{
+	TProgressReporter *Pointer_Reporter = Pointer_Argument;
+	struct timespec Wake_Up_Time;
+	unsigned long long Nanoseconds;
+	int Result;
+	
+	while (1)
+	{
+		if (Pointer_Reporter->Period == 0) Result = sem_wait(&Pointer_Reporter->Semaphore);
+		else
+		{
+			// The semaphore timeout is an absolute time of the realtime clock
+			clock_gettime(CLOCK_REALTIME, &Wake_Up_Time);
+			Nanoseconds = Wake_Up_Time.tv_nsec + Pointer_Reporter->Period * 1000;
+			Wake_Up_Time.tv_sec += Nanoseconds / 1000000000ULL;
+			Wake_Up_Time.tv_nsec = Nanoseconds % 1000000000ULL;
+			Result = sem_timedwait(&Pointer_Reporter->Semaphore, &Wake_Up_Time);
+		}
+		if (atomic_load(&Pointer_Reporter->Is_Stop_Requested)) break;
+		
+		// A signal received by this thread interrupts the wait, the request it made is handled by the next wait
+		if ((Result != 0) && (errno == EINTR)) continue;
+		ProgressReporterPrint(Pointer_Reporter);
+	}
+	return NULL;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+int ProgressReporterStart(TProgressReporter *Pointer_Reporter, TSolver *Pointer_Solver, unsigned long long Period, FILE *File)
+{
+	SolverClearProgress(&Pointer_Reporter->Progress);
+	Pointer_Reporter->Period = Period;
+	Pointer_Reporter->File = File;
+	atomic_init(&Pointer_Reporter->Is_Stop_Requested, 0);
+	Pointer_Reporter->Start_Time = ClockGetTime();
+	Pointer_Reporter->Previous_Report_Time = Pointer_Reporter->Start_Time;
+	Pointer_Reporter->Previous_Loops_Count = 0;
+	if (sem_init(&Pointer_Reporter->Semaphore, 0, 0) != 0) return -1;
+	
+	if (pthread_create(&Pointer_Reporter->Thread, NULL, ProgressReporterThread, Pointer_Reporter) != 0)
+	{
+		sem_destroy(&Pointer_Reporter->Semaphore);
+		return -1;
+	}
+	SolverSetProgress(Pointer_Solver, &Pointer_Reporter->Progress);
+	return 0;
+}
+
+void ProgressReporterRequestReport(TProgressReporter *Pointer_Reporter)
+{
+	sem_post(&Pointer_Reporter->Semaphore);
+}
+
+void ProgressReporterStop(TProgressReporter *Pointer_Reporter, TSolver *Pointer_Solver)
+{
+	SolverSetProgress(Pointer_Solver, NULL);
+	atomic_store(&Pointer_Reporter->Is_Stop_Requested, 1);
+	sem_post(&Pointer_Reporter->Semaphore);
+	pthread_join(Pointer_Reporter->Thread, NULL);
+	sem_destroy(&Pointer_Reporter->Semaphore);
+}
@@ -0,0 +1,667 @@
+/** @file Solver.c
+ * @see Solver.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <assert.h>
+#include <Cells_Buckets.h>
+#include <Cells_Stack.h>
+#include <Clock.h>
+#include <Dancing_Links.h>
+#include <Grid.h>
+#include <Solver.h>
+#include <stdio.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** How many search kernels are available. */
+#define SOLVER_KERNELS_COUNT (sizeof(Solver_Kernels) / sizeof(Solver_Kernels[0]))
+
+//-------------------------------------------------------------------------------------------------
+// Private types
+//-------------------------------------------------------------------------------------------------
+/** A search kernel specialized for a grid shape. */
+typedef struct
+{
+	unsigned int Grid_Size; //! The side size of the grids handled by the kernel.
+	int (*Backtrack_Function)(TSolver *Pointer_Solver); //! The kernel search function, it returns 1 if the solutions limit was reached or 0 if not.
+} TSolverKernel;
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Tell whether the dancing links engine must be used.
+ * @param Pointer_Solver The solver context.
+ * @return 1 if the dancing links engine is selected and its storage is available,
+ * @return 0 if the backtracking engine must be used.
+ */
+static inline int SolverIsDancingLinksEngineUsed(TSolver *Pointer_Solver)
+{
+	return (Pointer_Solver->Configuration.Engine == SOLVER_ENGINE_DANCING_LINKS) && (Pointer_Solver->Pointer_Dancing_Links != NULL);
+}
+
+/** Empty the cells filled by the search in a copy of the solver grid.
+ * @param Pointer_Solver The solver context.
+ * @param Pointer_Grid The grid copy.
+ * @param First_Trail_Index The trail index of the first cell to empty.
+ * @param Last_Trail_Index The trail index following the last cell to empty.
+ */
+static void SolverEmptyTrailCells(TSolver *Pointer_Solver, TGrid *Pointer_Grid, int First_Trail_Index, int Last_Trail_Index)
+{
+	const TGridGeometry *Pointer_Geometry = Pointer_Grid->Pointer_Geometry;
+	int i, Row, Column, Value;
+	
+	for (i = First_Trail_Index; i < Last_Trail_Index; i++)
+	{
+		Row = Pointer_Geometry->Cells_Row[Pointer_Solver->Trail[i]];
+		Column = Pointer_Geometry->Cells_Column[Pointer_Solver->Trail[i]];
+		Value = Pointer_Grid->Cells[Pointer_Solver->Trail[i]];
+		GridSetCellValue(Pointer_Grid, Row, Column, GRID_EMPTY_CELL_VALUE);
+		GridRestoreCellMissingNumber(Pointer_Grid, Row, Column, Value);
+	}
+}
+
+/** Write a grid on a single line.
+ * @param Pointer_Grid The grid.
+ * @param File The stream to write to.
+ */
+static void SolverWriteGridLine(TGrid *Pointer_Grid, FILE *File)
+{
+	char String_Line[GRID_STRING_SIZE];
+	
+	GridConvertToString(Pointer_Grid, String_Line);
+	fprintf(File, "%s\n", String_Line);
+}
+
+/** Hand out all untried numbers of the shallowest search tree level that still has some.
+ * @param Pointer_Solver The solver context.
+ */
+static void SolverSplit(TSolver *Pointer_Solver)
+{
+	TGrid Level_Grid, Split_Grid;
+	const TGridGeometry *Pointer_Geometry = Pointer_Solver->Grid.Pointer_Geometry;
+	TSolverLevel *Pointer_Level;
+	int Depth, Levels_Count, Row, Column;
+	unsigned int Number;
+	
+	// Find the shallowest level with untried numbers, it has the biggest subtrees to hand out (the current level has some when its numbers are being tried)
+	Levels_Count = Pointer_Solver->Depth + Pointer_Solver->Is_Level_Branching;
+	for (Depth = 0; Depth < Levels_Count; Depth++)
+	{
+		if (Pointer_Solver->Levels[Depth].Remaining_Numbers != 0) break;
+	}
+	if (Depth == Levels_Count) return;
+	Pointer_Level = &Pointer_Solver->Levels[Depth];
+	
+	// Rebuild the grid as it was on this level by emptying the cell chosen on this level and all cells filled after it
+	GridCopy(&Level_Grid, &Pointer_Solver->Grid);
+	SolverEmptyTrailCells(Pointer_Solver, &Level_Grid, Pointer_Level->Branch_Trail_Index, Pointer_Solver->Trail_Size);
+	
+	// Hand out a grid for each untried number of the level cell
+	Row = Pointer_Geometry->Cells_Row[Pointer_Level->Cell_Index];
+	Column = Pointer_Geometry->Cells_Column[Pointer_Level->Cell_Index];
+	for (Number = 0; Number < Level_Grid.Size; Number++)
+	{
+		if (!(Pointer_Level->Remaining_Numbers & GRID_BITMASK_NUMBER(Number))) continue;
+		
+		GridCopy(&Split_Grid, &Level_Grid);
+		GridSetCellValue(&Split_Grid, Row, Column, Number);
+		GridRemoveCellMissingNumber(&Split_Grid, Row, Column, Number);
+		if (Pointer_Solver->Split_Callback(Pointer_Solver->Pointer_Split_Callbacks_Argument, &Split_Grid) != 0) break; // Keep the remaining numbers if the grid could not be taken
+		
+		// This number will not be tried by this solver
+		Pointer_Level->Remaining_Numbers &= ~GRID_BITMASK_NUMBER(Number);
+	}
+}
+
+/** Generate a pseudo-random number (xorshift algorithm, this is fast and good enough to shuffle the numbers order).
+ * @param Pointer_Solver The solver context.
+ * @return The random number.
+ */
+static inline unsigned int SolverGetRandomNumber(TSolver *Pointer_Solver)
+{
+	unsigned int State;
+	
+	State = Pointer_Solver->Random_State;
+	State ^= State << 13;
+	State ^= State >> 17;
+	State ^= State << 5;
+	Pointer_Solver->Random_State = State;
+	return State;
+}
+
+/** Check whether the solving must be stopped by the cancellation flag or by the limits.
+ * @param Pointer_Solver The solver context.
+ * @param Loops_Count How many loops the search has done.
+ * @return 1 if the solving must stop (the reason is stored in the solver context),
+ * @return 0 if the solving can go on.
+ */
+static int SolverIsStopNeeded(TSolver *Pointer_Solver, unsigned long long Loops_Count)
+{
+	if ((Pointer_Solver->Pointer_Cancellation_Flag != NULL) && atomic_load_explicit(Pointer_Solver->Pointer_Cancellation_Flag, memory_order_relaxed))
+	{
+		Pointer_Solver->Is_Cancelled = 1;
+		return 1;
+	}
+	
+	// The clock is read here only, so reading it is amortized over a whole polling period
+	if (((Pointer_Solver->Loops_Limit != 0) && (Loops_Count >= Pointer_Solver->Loops_Limit)) || ((Pointer_Solver->Deadline != 0) && (ClockGetTime() >= Pointer_Solver->Deadline)))
+	{
+		Pointer_Solver->Is_Timed_Out = 1;
+		return 1;
+	}
+	return 0;
+}
+
+/** Publish the backtracking search progress.
+ * @param Pointer_Solver The solver context, it must have a progress.
+ */
+static void SolverPublishProgress(TSolver *Pointer_Solver)
+{
+	TSolverProgress *Pointer_Progress = Pointer_Solver->Pointer_Progress;
+	TSolverLevel *Pointer_Level;
+	double Explored_Fraction = 0, Subtree_Fraction = 1;
+	int Depth, Levels_Count;
+	
+	// Each level splits the subtree of the branch explored by the previous level into as many subtrees as its cell allowed numbers, the branch being explored on a level is not counted because its own progress is given by the next levels (the current level has no branch being explored when its numbers are being tried)
+	Levels_Count = Pointer_Solver->Depth + Pointer_Solver->Is_Level_Branching;
+	if (Levels_Count > SOLVER_PROGRESS_LEVELS_COUNT) Levels_Count = SOLVER_PROGRESS_LEVELS_COUNT;
+	for (Depth = 0; Depth < Levels_Count; Depth++)
+	{
+		Pointer_Level = &Pointer_Solver->Levels[Depth];
+		Subtree_Fraction /= Pointer_Level->Numbers_Count;
+		Explored_Fraction += (Pointer_Level->Numbers_Count - GRID_BITMASK_COUNT_NUMBERS(Pointer_Level->Remaining_Numbers) - (Depth < Pointer_Solver->Depth)) * Subtree_Fraction;
+	}
+	
+	// The solver is the only writer of the progress, so the loops count does not need an atomic addition
+	atomic_store_explicit(&Pointer_Progress->Loops_Count, atomic_load_explicit(&Pointer_Progress->Loops_Count, memory_order_relaxed) + Pointer_Solver->Statistics.Loops_Count - Pointer_Solver->Published_Loops_Count, memory_order_relaxed);
+	Pointer_Solver->Published_Loops_Count = Pointer_Solver->Statistics.Loops_Count;
+	atomic_store_explicit(&Pointer_Progress->Depth, Pointer_Solver->Depth, memory_order_relaxed);
+	if (Pointer_Solver->Depth > atomic_load_explicit(&Pointer_Progress->Maximum_Depth, memory_order_relaxed)) atomic_store_explicit(&Pointer_Progress->Maximum_Depth, Pointer_Solver->Depth, memory_order_relaxed);
+	atomic_store_explicit(&Pointer_Progress->Explored_Fraction, (unsigned long long) (Explored_Fraction * SOLVER_PROGRESS_FRACTION_UNIT), memory_order_relaxed);
+}
+
+/** Check whether the solving must be stopped (by the cancellation flag or by the limits) or whether a part of the search tree must be handed out, and give the checkpoint callback a chance to save the search state. The search calls it every SOLVER_POLLING_PERIOD iterations.
+ * @param Pointer_Solver The solver context, its Is_Level_Branching field must tell the state of the current level.
+ * @return 1 if the solving must stop,
+ * @return 0 if the solving can go on.
+ */
+static int SolverPoll(TSolver *Pointer_Solver)
+{
+	if (Pointer_Solver->Pointer_Progress != NULL) SolverPublishProgress(Pointer_Solver);
+	if (SolverIsStopNeeded(Pointer_Solver, Pointer_Solver->Statistics.Loops_Count))
+	{
+		if (Pointer_Solver->Checkpoint_Callback != NULL) Pointer_Solver->Checkpoint_Callback(Pointer_Solver->Pointer_Checkpoint_Callback_Argument, Pointer_Solver, 1);
+		return 1;
+	}
+	if (Pointer_Solver->Checkpoint_Callback != NULL) Pointer_Solver->Checkpoint_Callback(Pointer_Solver->Pointer_Checkpoint_Callback_Argument, Pointer_Solver, 0);
+	
+	if ((Pointer_Solver->Is_Split_Requested_Callback != NULL) && Pointer_Solver->Is_Split_Requested_Callback(Pointer_Solver->Pointer_Split_Callbacks_Argument)) SolverSplit(Pointer_Solver);
+	return 0;
+}
+
+/** Count a solution found by the backtracking search and give it to the solution callback.
+ * @param Pointer_Solver The solver context, its grid holds the solution.
+ * @return 1 if the search must stop because the solutions limit is reached,
+ * @return 0 if the search must go on to find the next solution.
+ */
+static inline int SolverRecordSolution(TSolver *Pointer_Solver)
+{
+	Pointer_Solver->Solutions_Count++;
+	if (Pointer_Solver->Solution_Callback != NULL) Pointer_Solver->Solution_Callback(Pointer_Solver->Pointer_Solution_Callback_Argument, &Pointer_Solver->Grid);
+	return Pointer_Solver->Solutions_Count == Pointer_Solver->Solutions_Limit;
+}
+
+/** Give a solution found by the dancing links engine to the solution callback.
+ * @param Pointer_Argument The solver context.
+ */
+static void SolverRecordDancingLinksSolution(void *Pointer_Argument)
+{
+	TSolver *Pointer_Solver = Pointer_Argument;
+	TGrid Solved_Grid;
+	
+	// The solver grid must stay as it was loaded, because each solution is written over the empty cells
+	GridCopy(&Solved_Grid, &Pointer_Solver->Grid);
+	DancingLinksGetSolution(Pointer_Solver->Pointer_Dancing_Links, &Solved_Grid);
+	Pointer_Solver->Solution_Callback(Pointer_Solver->Pointer_Solution_Callback_Argument, &Solved_Grid);
+}
+
+/** Tell the dancing links engine whether its search must stop, the engine calls it every 1024 loops.
+ * @param Pointer_Argument The solver context.
+ * @return 1 if the search must stop,
+ * @return 0 if the search can go on.
+ */
+static int SolverPollDancingLinks(void *Pointer_Argument)
+{
+	TSolver *Pointer_Solver = Pointer_Argument;
+	
+	return SolverIsStopNeeded(Pointer_Solver, Pointer_Solver->Pointer_Dancing_Links->Loops_Count);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Search kernels
+//-------------------------------------------------------------------------------------------------
+// One backtracking kernel is built for each grid shape of Grid.c
+#define SOLVER_KERNEL_SUFFIX 6x6
+#define SOLVER_KERNEL_SIZE 6
+#define SOLVER_KERNEL_SQUARE_WIDTH 3
+#define SOLVER_KERNEL_SQUARE_HEIGHT 2
+#include <Solver_Kernel.h>
+
+#define SOLVER_KERNEL_SUFFIX 9x9
+#define SOLVER_KERNEL_SIZE 9
+#define SOLVER_KERNEL_SQUARE_WIDTH 3
+#define SOLVER_KERNEL_SQUARE_HEIGHT 3
+#include <Solver_Kernel.h>
+
+#define SOLVER_KERNEL_SUFFIX 12x12
+#define SOLVER_KERNEL_SIZE 12
+#define SOLVER_KERNEL_SQUARE_WIDTH 4
+#define SOLVER_KERNEL_SQUARE_HEIGHT 3
+#include <Solver_Kernel.h>
+
+#define SOLVER_KERNEL_SUFFIX 16x16
+#define SOLVER_KERNEL_SIZE 16
+#define SOLVER_KERNEL_SQUARE_WIDTH 4
+#define SOLVER_KERNEL_SQUARE_HEIGHT 4
+#include <Solver_Kernel.h>
+
+#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 25
+	#define SOLVER_KERNEL_SUFFIX 25x25
+	#define SOLVER_KERNEL_SIZE 25
+	#define SOLVER_KERNEL_SQUARE_WIDTH 5
+	#define SOLVER_KERNEL_SQUARE_HEIGHT 5
+	#include <Solver_Kernel.h>
+#endif
+
+#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 36
+	#define SOLVER_KERNEL_SUFFIX 36x36
+	#define SOLVER_KERNEL_SIZE 36
+	#define SOLVER_KERNEL_SQUARE_WIDTH 6
+	#define SOLVER_KERNEL_SQUARE_HEIGHT 6
+	#include <Solver_Kernel.h>
+#endif
+
+#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 49
+	#define SOLVER_KERNEL_SUFFIX 49x49
+	#define SOLVER_KERNEL_SIZE 49
+	#define SOLVER_KERNEL_SQUARE_WIDTH 7
+	#define SOLVER_KERNEL_SQUARE_HEIGHT 7
+	#include <Solver_Kernel.h>
+#endif
+
+#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 64
+	#define SOLVER_KERNEL_SUFFIX 64x64
+	#define SOLVER_KERNEL_SIZE 64
+	#define SOLVER_KERNEL_SQUARE_WIDTH 8
+	#define SOLVER_KERNEL_SQUARE_HEIGHT 8
+	#include <Solver_Kernel.h>
+#endif
+
+/** The search kernel of each grid size. */
+static const TSolverKernel Solver_Kernels[] =
+{
+	{ 6, SolverBacktrack6x6 },
+	{ 9, SolverBacktrack9x9 },
+	{ 12, SolverBacktrack12x12 },
+	{ 16, SolverBacktrack16x16 }
+	#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 25
+		, { 25, SolverBacktrack25x25 }
+	#endif
+	#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 36
+		, { 36, SolverBacktrack36x36 }
+	#endif
+	#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 49
+		, { 49, SolverBacktrack49x49 }
+	#endif
+	#if CONFIGURATION_GRID_MAXIMUM_SIZE >= 64
+		, { 64, SolverBacktrack64x64 }
+	#endif
+};
+
+//-------------------------------------------------------------------------------------------------
+// Private functions
+//-------------------------------------------------------------------------------------------------
+/** Index the empty cells (or build the exact cover matrix) and reset the statistics, so the solving can start.
+ * @param Pointer_Solver The solver context.
+ */
+static void SolverPrepare(TSolver *Pointer_Solver)
+{
+	int Row, Column, Cell_Index, Cells_Count;
+	unsigned int i;
+	TGrid *Pointer_Grid = &Pointer_Solver->Grid;
+	#if CONFIGURATION_SOLVER_INSTRUMENTATION
+		unsigned long long Start_Time;
+		
+		InstrumentationReset(&Pointer_Solver->Instrumentation);
+		Start_Time = ClockGetTime();
+	#endif
+	
+	// Select the search kernel of this grid shape once for the whole solving
+	for (i = 0; i < SOLVER_KERNELS_COUNT; i++)
+	{
+		if (Solver_Kernels[i].Grid_Size == Pointer_Grid->Size) break;
+	}
+	assert(i < SOLVER_KERNELS_COUNT); // Each shape of Grid.c must have its kernel
+	Pointer_Solver->Backtrack_Function = Solver_Kernels[i].Backtrack_Function;
+	
+	if (SolverIsDancingLinksEngineUsed(Pointer_Solver)) DancingLinksLoadFromGrid(Pointer_Solver->Pointer_Dancing_Links, Pointer_Grid);
+	else if (Pointer_Solver->Configuration.Cell_Order == SOLVER_CELL_ORDER_FIXED)
+	{
+		CellsStackInitialize(&Pointer_Solver->Cells_Stack);
+		
+		// Reverse parsing to create a stack with empty coordinates beginning on the top-left part of the grid (this allows to make speed comparisons with the older way to find empty cells)
+		for (Row = Pointer_Grid->Size - 1; Row >= 0; Row--)
+		{
+			for (Column = Pointer_Grid->Size - 1; Column >= 0; Column--)
+			{
+				if (Pointer_Grid->Cells[Row * Pointer_Grid->Size + Column] == GRID_EMPTY_CELL_VALUE) CellsStackPush(&Pointer_Solver->Cells_Stack, Row, Column);
+			}
+		}
+	}
+	else
+	{
+		CellsBucketsInitialize(&Pointer_Solver->Cells_Buckets);
+		
+		// Count the allowed numbers of all cells at once (an empty cell allowing no number is found by the search)
+		CandidatesCompute(&Pointer_Solver->Candidates, Pointer_Grid);
+		Cells_Count = Pointer_Grid->Size * Pointer_Grid->Size;
+		for (Cell_Index = 0; Cell_Index < Cells_Count; Cell_Index++)
+		{
+			if (Pointer_Grid->Cells[Cell_Index] == GRID_EMPTY_CELL_VALUE) CellsBucketsAdd(&Pointer_Solver->Cells_Buckets, Cell_Index, Pointer_Solver->Candidates.Cells_Candidates_Count[Cell_Index]);
+		}
+	}
+	
+	Pointer_Solver->Depth = 0;
+	Pointer_Solver->Is_Level_Branching = 0;
+	Pointer_Solver->Trail_Size = 0;
+	Pointer_Solver->Random_State = Pointer_Solver->Configuration.Random_Seed;
+	if (Pointer_Solver->Random_State == 0) Pointer_Solver->Random_State = 1; // The generator would only produce zeros
+	Pointer_Solver->Statistics.Loops_Count = 1;
+	Pointer_Solver->Statistics.Bad_Solutions_Found_Count = 0;
+	Pointer_Solver->Statistics.Avoided_Bad_Solutions_Count = 0;
+	Pointer_Solver->Statistics.Propagated_Cells_Count = 0;
+	
+	#if CONFIGURATION_SOLVER_INSTRUMENTATION
+		Pointer_Solver->Instrumentation.Phases_Durations[INSTRUMENTATION_PHASE_PREPARATION] = ClockGetTime() - Start_Time;
+	#endif
+}
+
+/** Search the solutions of the loaded grid until enough of them are found.
+ * @param Pointer_Solver The solver context.
+ * @param Solutions_Limit The search stops when this many solutions are found, use 0 to find all solutions.
+ * @return SOLVER_RESULT_SOLVED if at least one solution was found,
+ * @return SOLVER_RESULT_UNSOLVABLE if the grid has no solution,
+ * @return SOLVER_RESULT_CANCELLED if the search was cancelled,
+ * @return SOLVER_RESULT_TIMED_OUT if the search reached a limit.
+ */
+static int SolverSearch(TSolver *Pointer_Solver, unsigned long long Solutions_Limit)
+{
+	TDancingLinks *Pointer_Dancing_Links;
+	int Result;
+	#if CONFIGURATION_SOLVER_INSTRUMENTATION
+		unsigned long long Start_Time = ClockGetTime();
+	#endif
+	
+	Pointer_Solver->Solutions_Limit = Solutions_Limit;
+	Pointer_Solver->Solutions_Count = 0;
+	Pointer_Solver->Is_Cancelled = 0;
+	Pointer_Solver->Is_Timed_Out = 0;
+	Pointer_Solver->Published_Loops_Count = Pointer_Solver->Statistics.Loops_Count;
+	if (Pointer_Solver->Time_Limit != 0) Pointer_Solver->Deadline = ClockGetTime() + Pointer_Solver->Time_Limit * 1000;
+	else Pointer_Solver->Deadline = 0;
+	
+	if (SolverIsDancingLinksEngineUsed(Pointer_Solver))
+	{
+		Pointer_Dancing_Links = Pointer_Solver->Pointer_Dancing_Links;
+		if (Pointer_Solver->Solution_Callback != NULL) Result = DancingLinksSolve(Pointer_Dancing_Links, Solutions_Limit, SolverRecordDancingLinksSolution, SolverPollDancingLinks, Pointer_Solver);
+		else Result = DancingLinksSolve(Pointer_Dancing_Links, Solutions_Limit, NULL, SolverPollDancingLinks, Pointer_Solver);
+		Pointer_Solver->Statistics.Loops_Count = Pointer_Dancing_Links->Loops_Count;
+		Pointer_Solver->Statistics.Bad_Solutions_Found_Count = Pointer_Dancing_Links->Bad_Solutions_Found_Count;
+		Pointer_Solver->Solutions_Count = Pointer_Dancing_Links->Solutions_Count;
+		if (Result == 1) DancingLinksGetSolution(Pointer_Dancing_Links, &Pointer_Solver->Grid);
+	}
+	else
+	{
+		Pointer_Solver->Backtrack_Function(Pointer_Solver);
+		
+		// Account for the loops done since the last polling
+		if (Pointer_Solver->Pointer_Progress != NULL) SolverPublishProgress(Pointer_Solver);
+	}
+	
+	#if CONFIGURATION_SOLVER_INSTRUMENTATION
+		Pointer_Solver->Instrumentation.Phases_Durations[INSTRUMENTATION_PHASE_SEARCH] += ClockGetTime() - Start_Time;
+	#endif
+	
+	if (Pointer_Solver->Is_Cancelled) return SOLVER_RESULT_CANCELLED;
+	if (Pointer_Solver->Is_Timed_Out) return SOLVER_RESULT_TIMED_OUT;
+	if (Pointer_Solver->Solutions_Count > 0) return SOLVER_RESULT_SOLVED;
+	return SOLVER_RESULT_UNSOLVABLE;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+void SolverInitialize(TSolver *Pointer_Solver)
+{
+	SolverGetDefaultConfiguration(&Pointer_Solver->Configuration);
+	Pointer_Solver->Pointer_Cancellation_Flag = NULL;
+	Pointer_Solver->Loops_Limit = 0;
+	Pointer_Solver->Time_Limit = 0;
+	Pointer_Solver->Is_Split_Requested_Callback = NULL;
+	Pointer_Solver->Split_Callback = NULL;
+	Pointer_Solver->Pointer_Split_Callbacks_Argument = NULL;
+	Pointer_Solver->Solution_Callback = NULL;
+	Pointer_Solver->Pointer_Solution_Callback_Argument = NULL;
+	Pointer_Solver->Checkpoint_Callback = NULL;
+	Pointer_Solver->Pointer_Checkpoint_Callback_Argument = NULL;
+	Pointer_Solver->Pointer_Progress = NULL;
+	Pointer_Solver->Pointer_Dancing_Links = NULL;
+}
+
+void SolverGetDefaultConfiguration(TSolverConfiguration *Pointer_Configuration)
+{
+	Pointer_Configuration->Engine = SOLVER_ENGINE_BACKTRACKING;
+	Pointer_Configuration->Cell_Order = SOLVER_CELL_ORDER_MOST_CONSTRAINED;
+	Pointer_Configuration->Number_Order = SOLVER_NUMBER_ORDER_ASCENDING;
+	Pointer_Configuration->Random_Seed = 1;
+	Pointer_Configuration->Is_Propagation_Enabled = 1;
+}
+
+void SolverSetConfiguration(TSolver *Pointer_Solver, TSolverConfiguration *Pointer_Configuration)
+{
+	Pointer_Solver->Configuration = *Pointer_Configuration;
+}
+
+void SolverSetDancingLinks(TSolver *Pointer_Solver, TDancingLinks *Pointer_Dancing_Links)
+{
+	Pointer_Solver->Pointer_Dancing_Links = Pointer_Dancing_Links;
+}
+
+void SolverSetCancellationFlag(TSolver *Pointer_Solver, atomic_int *Pointer_Cancellation_Flag)
+{
+	Pointer_Solver->Pointer_Cancellation_Flag = Pointer_Cancellation_Flag;
+}
+
+void SolverSetLoopsLimit(TSolver *Pointer_Solver, unsigned long long Loops_Limit)
+{
+	Pointer_Solver->Loops_Limit = Loops_Limit;
+}
+
+void SolverSetTimeLimit(TSolver *Pointer_Solver, unsigned long long Time_Limit)
+{
+	Pointer_Solver->Time_Limit = Time_Limit;
+}
+
+void SolverSetSplitCallbacks(TSolver *Pointer_Solver, TSolverIsSplitRequestedCallback Is_Split_Requested_Callback, TSolverSplitCallback Split_Callback, void *Pointer_Argument)
+{
+	Pointer_Solver->Is_Split_Requested_Callback = Is_Split_Requested_Callback;
+	Pointer_Solver->Split_Callback = Split_Callback;
+	Pointer_Solver->Pointer_Split_Callbacks_Argument = Pointer_Argument;
+}
+
+void SolverSetSolutionCallback(TSolver *Pointer_Solver, TSolverSolutionCallback Solution_Callback, void *Pointer_Argument)
+{
+	Pointer_Solver->Solution_Callback = Solution_Callback;
+	Pointer_Solver->Pointer_Solution_Callback_Argument = Pointer_Argument;
+}
+
+void SolverSetCheckpointCallback(TSolver *Pointer_Solver, TSolverCheckpointCallback Checkpoint_Callback, void *Pointer_Argument)
+{
+	Pointer_Solver->Checkpoint_Callback = Checkpoint_Callback;
+	Pointer_Solver->Pointer_Checkpoint_Callback_Argument = Pointer_Argument;
+}
+
+void SolverClearProgress(TSolverProgress *Pointer_Progress)
+{
+	atomic_init(&Pointer_Progress->Loops_Count, 0);
+	atomic_init(&Pointer_Progress->Depth, 0);
+	atomic_init(&Pointer_Progress->Maximum_Depth, 0);
+	atomic_init(&Pointer_Progress->Explored_Fraction, 0);
+}
+
+void SolverSetProgress(TSolver *Pointer_Solver, TSolverProgress *Pointer_Progress)
+{
+	Pointer_Solver->Pointer_Progress = Pointer_Progress;
+}
+
+int SolverLoadFromFile(TSolver *Pointer_Solver, char *String_File_Name)
+{
+	int Result;
+	
+	Result = GridLoadFromFile(&Pointer_Solver->Grid, String_File_Name);
+	if (Result == 0) SolverPrepare(Pointer_Solver);
+	return Result;
+}
+
+int SolverLoadFromStream(TSolver *Pointer_Solver, FILE *File)
+{
+	int Result;
+	
+	Result = GridLoadFromStream(&Pointer_Solver->Grid, File);
+	if (Result == 0) SolverPrepare(Pointer_Solver);
+	return Result;
+}
+
+int SolverLoadFromString(TSolver *Pointer_Solver, const char *String_Grid)
+{
+	int Result;
+	
+	Result = GridLoadFromString(&Pointer_Solver->Grid, String_Grid);
+	if (Result == 0) SolverPrepare(Pointer_Solver);
+	return Result;
+}
+
+void SolverLoadFromGrid(TSolver *Pointer_Solver, TGrid *Pointer_Grid)
+{
+	GridCopy(&Pointer_Solver->Grid, Pointer_Grid);
+	SolverPrepare(Pointer_Solver);
+}
+
+int SolverSolve(TSolver *Pointer_Solver)
+{
+	// Stop at the first solution
+	return SolverSearch(Pointer_Solver, 1);
+}
+
+int SolverCountSolutions(TSolver *Pointer_Solver, unsigned long long Solutions_Limit, unsigned long long *Pointer_Solutions_Count)
+{
+	int Result;
+	
+	Result = SolverSearch(Pointer_Solver, Solutions_Limit);
+	*Pointer_Solutions_Count = Pointer_Solver->Solutions_Count;
+	return Result;
+}
+
+int SolverGetSolution(TSolver *Pointer_Solver, char *String_Solution, int Buffer_Size)
+{
+	int Length;
+	
+	// Make sure the whole grid fits in the buffer
+	Length = Pointer_Solver->Grid.Size * Pointer_Solver->Grid.Size;
+	if (Buffer_Size < Length + 1) return -1;
+	
+	GridConvertToString(&Pointer_Solver->Grid, String_Solution);
+	return Length;
+}
+
+void SolverGetStatistics(TSolver *Pointer_Solver, TSolverStatistics *Pointer_Statistics)
+{
+	*Pointer_Statistics = Pointer_Solver->Statistics;
+}
+
+int SolverWriteCheckpoint(TSolver *Pointer_Solver, FILE *File)
+{
+	TGrid Grid;
+	TSolverLevel *Pointer_Level;
+	int Depth, Trail_Size, Row, Column;
+	unsigned int Number;
+	
+	// The current node is not explored yet, it holds all cells chosen and forced so far, unless the numbers of its cell are being tried (its untried numbers are then written like the ones of the other levels)
+	GridCopy(&Grid, &Pointer_Solver->Grid);
+	if (Pointer_Solver->Is_Level_Branching) Depth = Pointer_Solver->Depth;
+	else
+	{
+		SolverWriteGridLine(&Grid, File);
+		Depth = Pointer_Solver->Depth - 1;
+	}
+	
+	// Go up the search tree, the grid of each level is rebuilt by emptying the cells filled since the level cell was chosen
+	Trail_Size = Pointer_Solver->Trail_Size;
+	for (; Depth >= 0; Depth--)
+	{
+		Pointer_Level = &Pointer_Solver->Levels[Depth];
+		SolverEmptyTrailCells(Pointer_Solver, &Grid, Pointer_Level->Branch_Trail_Index, Trail_Size);
+		Trail_Size = Pointer_Level->Branch_Trail_Index;
+		
+		// Each untried number of the level cell is the root of an unexplored subtree
+		Row = Grid.Pointer_Geometry->Cells_Row[Pointer_Level->Cell_Index];
+		Column = Grid.Pointer_Geometry->Cells_Column[Pointer_Level->Cell_Index];
+		for (Number = 0; Number < Grid.Size; Number++)
+		{
+			if (!(Pointer_Level->Remaining_Numbers & GRID_BITMASK_NUMBER(Number))) continue;
+			
+			GridSetCellValue(&Grid, Row, Column, Number);
+			SolverWriteGridLine(&Grid, File);
+			GridSetCellValue(&Grid, Row, Column, GRID_EMPTY_CELL_VALUE);
+		}
+	}
+	
+	if (ferror(File)) return -1;
+	return 0;
+}
+
+void SolverWriteStatisticsRecord(TSolver *Pointer_Solver, unsigned long long Grid_Index, int Result, FILE *File)
+{
+	TSolverStatistics *Pointer_Statistics = &Pointer_Solver->Statistics;
+	char *String_Result;
+	
+	switch (Result)
+	{
+		case SOLVER_RESULT_SOLVED:
+			String_Result = "solved";
+			break;
+			
+		case SOLVER_RESULT_UNSOLVABLE:
+			String_Result = "unsolvable";
+			break;
+			
+		case SOLVER_RESULT_TIMED_OUT:
+			String_Result = "timed_out";
+			break;
+			
+		default:
+			String_Result = "cancelled";
+			break;
+	}
+	
+	// Keep the other threads from writing in the middle of the record
+	flockfile(File);
+	fprintf(File, "{\"grid\": %llu, \"size\": %u, \"result\": \"%s\", \"loops_count\": %llu, \"bad_solutions_found_count\": %llu, \"avoided_bad_solutions_count\": %llu, \"propagated_cells_count\": %llu", Grid_Index, Pointer_Solver->Grid.Size, String_Result, Pointer_Statistics->Loops_Count,
+		Pointer_Statistics->Bad_Solutions_Found_Count, Pointer_Statistics->Avoided_Bad_Solutions_Count, Pointer_Statistics->Propagated_Cells_Count);
+	#if CONFIGURATION_SOLVER_INSTRUMENTATION
+		InstrumentationWriteMembers(&Pointer_Solver->Instrumentation, Pointer_Solver->Grid.Size, File);
+	#endif
+	fprintf(File, "}\n");
+	funlockfile(File);
+}
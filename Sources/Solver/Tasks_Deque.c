@@ -0,0 +1,84 @@
+/** @file Tasks_Deque.c
+ * @see Tasks_Deque.h for description.
+ * @author Adrien RICCIARDI
+ */
+#include <stddef.h>
+#include <Tasks_Deque.h>
+
+//-------------------------------------------------------------------------------------------------
+// Private constants
+//-------------------------------------------------------------------------------------------------
+/** Turn a task index into a circular buffer index. */
+#define TASKS_DEQUE_INDEX_MASK (TASKS_DEQUE_SIZE - 1)
+
+//-------------------------------------------------------------------------------------------------
+// Public functions
+//-------------------------------------------------------------------------------------------------
+void TasksDequeInitialize(TTasksDeque *Pointer_Deque)
+{
+	atomic_init(&Pointer_Deque->Top, 0);
+	atomic_init(&Pointer_Deque->Bottom, 0);
+}
+
+int TasksDequePush(TTasksDeque *Pointer_Deque, void *Pointer_Task)
+{
+	long Top, Bottom;
+	
+	Bottom = atomic_load_explicit(&Pointer_Deque->Bottom, memory_order_relaxed);
+	Top = atomic_load_explicit(&Pointer_Deque->Top, memory_order_acquire);
+	if (Bottom - Top >= TASKS_DEQUE_SIZE) return -1;
+	
+	// Publish the task before making it visible to the thieves
+	atomic_store_explicit(&Pointer_Deque->Tasks[Bottom & TASKS_DEQUE_INDEX_MASK], Pointer_Task, memory_order_relaxed);
+	atomic_store_explicit(&Pointer_Deque->Bottom, Bottom + 1, memory_order_release);
+	return 0;
+}
+
+void *TasksDequePop(TTasksDeque *Pointer_Deque)
+{
+	long Top, Bottom;
+	void *Pointer_Task;
+	
+	// Reserve the bottom task before looking at what the thieves are doing
+	Bottom = atomic_load_explicit(&Pointer_Deque->Bottom, memory_order_relaxed) - 1;
+	atomic_store_explicit(&Pointer_Deque->Bottom, Bottom, memory_order_relaxed);
+	atomic_thread_fence(memory_order_seq_cst);
+	Top = atomic_load_explicit(&Pointer_Deque->Top, memory_order_relaxed);
+	
+	// The deque is empty
+	if (Top > Bottom)
+	{
+		atomic_store_explicit(&Pointer_Deque->Bottom, Bottom + 1, memory_order_relaxed);
+		return NULL;
+	}
+	
+	Pointer_Task = atomic_load_explicit(&Pointer_Deque->Tasks[Bottom & TASKS_DEQUE_INDEX_MASK], memory_order_relaxed);
+	if (Top == Bottom)
+	{
+		// This is the last task, a thief may be trying to take it too
+		if (!atomic_compare_exchange_strong_explicit(&Pointer_Deque->Top, &Top, Top + 1, memory_order_seq_cst, memory_order_relaxed)) Pointer_Task = NULL;
+		atomic_store_explicit(&Pointer_Deque->Bottom, Bottom + 1, memory_order_relaxed);
+	}
+	return Pointer_Task;
+}
+
+int TasksDequeSteal(TTasksDeque *Pointer_Deque, void **Pointer_Task)
+{
+	long Top, Bottom;
+	
+	Top = atomic_load_explicit(&Pointer_Deque->Top, memory_order_acquire);
+	atomic_thread_fence(memory_order_seq_cst);
+	Bottom = atomic_load_explicit(&Pointer_Deque->Bottom, memory_order_acquire);
+	if (Top >= Bottom) return TASKS_DEQUE_STEAL_RESULT_EMPTY;
+	
+	// Take the task only if no other thread took it in the meantime
+	*Pointer_Task = atomic_load_explicit(&Pointer_Deque->Tasks[Top & TASKS_DEQUE_INDEX_MASK], memory_order_relaxed);
+	if (!atomic_compare_exchange_strong_explicit(&Pointer_Deque->Top, &Top, Top + 1, memory_order_seq_cst, memory_order_relaxed)) return TASKS_DEQUE_STEAL_RESULT_ABORT;
+	return TASKS_DEQUE_STEAL_RESULT_SUCCESS;
+}
+
+int TasksDequeIsEmpty(TTasksDeque *Pointer_Deque)
+{
+	if (atomic_load_explicit(&Pointer_Deque->Top, memory_order_relaxed) >= atomic_load_explicit(&Pointer_Deque->Bottom, memory_order_relaxed)) return 1;
+	return 0;
+}
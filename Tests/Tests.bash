@@ -5,6 +5,26 @@
 # Version 0.0.2 : 31/05/2013, used a for loop.
 # Version 0.0.3 : 26/12/2013, formated "time" output.
 # Version 0.0.4 : 29/08/2014, tests are now launched by grid size order.
+# Version 0.0.5 : 17/10/2026, added a batch mode test.
+# Version 0.0.6 : 17/10/2026, the batch mode test is run with both cells orders.
+# Version 0.0.7 : 17/10/2026, added the 25x25, 36x36, 49x49 and 64x64 grids.
+# Version 0.0.8 : 17/10/2026, the batch mode test is run with each instruction set supported by the processor.
+# Version 0.0.9 : 17/10/2026, the batch mode test is run with and without the lanes solver, with one and several threads.
+# Version 0.0.10 : 17/10/2026, added a solutions counting test with each engine.
+# Version 0.0.11 : 17/10/2026, added a grids generator test.
+# Version 0.0.12 : 17/10/2026, added a benchmark program test.
+# Version 0.0.13 : 17/10/2026, added a statistics records test.
+# Version 0.0.14 : 17/10/2026, added a solving limits test.
+# Version 0.0.15 : 17/10/2026, added a checkpoints test.
+# Version 0.0.16 : 17/10/2026, added a progress reports test.
+# Version 0.0.17 : 17/10/2026, added a mapped grids file test.
+# Version 0.0.18 : 17/10/2026, added a packed grids file test.
+# Version 0.0.19 : 17/10/2026, added a grids formats conversion test.
+# Version 0.0.20 : 17/10/2026, added a daemon mode test.
+# Version 0.0.21 : 17/10/2026, added a grids deduplication test.
+# Version 0.0.22 : 17/10/2026, the grids bigger than 32x32 are tested only when the program is built for them.
+# Version 0.0.23 : 17/10/2026, added a bad threads count test.
+# Version 0.0.24 : 17/10/2026, the bad numbers test covers all numeric options.
 export TIME="Time=%es Memory=%MkB"
 Program="time ../Binaries/Sudoku_Solver"
 
@@ -22,6 +42,29 @@ function PrintSuccess
 	echo -e "#########################################\033[0m"
 }
 
+# Print a daemon request asking for a text line response, the request length and identifier are little-endian
+function PrintDaemonRequest
+{
+	Length=$((${#2} + 5))
+	Header=$(printf '\\x%02x\\x%02x\\x00\\x00\\x%02x\\x%02x\\x00\\x00\\x01' $((Length & 255)) $((Length >> 8)) $(($1 & 255)) $(($1 >> 8)))
+	printf "$Header%s" "$2"
+}
+
+# List the test files of each provided grid size, skipping the sizes the program is not built for (the grids bigger than 32x32 need "make big_grids")
+function ListFiles
+{
+	for Size in "$@"
+	do
+		# A grid made of empty cells can be converted only if its size is supported
+		if printf "%$((Size * Size))s\n" | tr ' ' '.' | ../Binaries/Converter > /dev/null 2>&1
+		then
+			find ${Size}x${Size}_*.txt
+		else
+			echo "Skipping the ${Size}x${Size} grids, the program is not built for them." >&2
+		fi
+	done
+}
+
 function SolveList
 {
 	for File in $Files_List
@@ -51,4 +94,307 @@ SolveList
 Files_List=`find 16x16_*.txt`
 SolveList
 
+# Solve all bigger grids
+Files_List=`ListFiles 25 36 49 64`
+SolveList
+
+# Solve all 6x6 and 9x9 grids in a single batch run, with each cells order
+for Cell_Order in constrained fixed
+do
+	for File in `find 6x6_*.txt 9x9_*.txt`
+	do
+		cat $File
+		echo
+	done | $Program --batch --cell-order $Cell_Order > /dev/null
+	if [ $? != 0 ]
+	then
+		PrintFailure
+		exit
+	fi
+done
+
+# Solve all 9x9 and 16x16 grids in a single batch run, with each instruction set the processor supports
+for Instruction_Set in scalar sse4 avx2
+do
+	../Binaries/Sudoku_Solver --batch --instruction-set $Instruction_Set /dev/null > /dev/null || continue
+	for Cell_Order in constrained fixed
+	do
+		for File in `find 9x9_*.txt 16x16_*.txt`
+		do
+			cat $File
+			echo
+		done | $Program --batch --instruction-set $Instruction_Set --cell-order $Cell_Order > /dev/null
+		if [ $? != 0 ]
+		then
+			PrintFailure
+			exit
+		fi
+	done
+done
+
+# Solve all 9x9 grids in a single batch run, with and without the lanes solver
+for Lanes_Option in "" --no-lanes
+do
+	for Threads_Count in 1 2
+	do
+		for File in `find 9x9_*.txt`
+		do
+			cat $File
+			echo
+		done | $Program --batch --threads $Threads_Count $Lanes_Option > /dev/null
+		if [ $? != 0 ]
+		then
+			PrintFailure
+			exit
+		fi
+	done
+done
+
+# A grids file is mapped in memory, its grids must be solved like the same grids read from a stream with each instruction set, and a bad grid must be reported with its location in the file
+for File in `find 6x6_*.txt 9x9_*.txt 16x16_*.txt`
+do
+	cat $File
+	echo
+done > Corpus.txt
+Bad_Grid_Line=$((`wc -l < Corpus.txt` + 1))
+Bad_Grid_Offset=`wc -c < Corpus.txt`
+echo "12345" >> Corpus.txt
+cat 9x9_1.txt >> Corpus.txt
+for Instruction_Set in scalar sse4 avx2
+do
+	../Binaries/Sudoku_Solver --batch --instruction-set $Instruction_Set /dev/null > /dev/null || continue
+	[ "`../Binaries/Sudoku_Solver --batch --instruction-set $Instruction_Set Corpus.txt 2> Warnings.txt`" == "`cat Corpus.txt | ../Binaries/Sudoku_Solver --batch --instruction-set $Instruction_Set 2> /dev/null`" ] && [ "`cat Warnings.txt`" == "Warning : bad grid at line $Bad_Grid_Line (byte offset $Bad_Grid_Offset)." ]
+	Result=$?
+	if [ $Result != 0 ]
+	then
+		break
+	fi
+done
+rm -f Corpus.txt Warnings.txt
+if [ $Result != 0 ]
+then
+	PrintFailure
+	exit
+fi
+
+# The 9x9 grids packed by the converter must be solved like the text grids, and the solutions written to a packed grids file must be the batch mode solutions
+for File in `find 9x9_*.txt`
+do
+	cat $File
+	echo
+done > Grids.txt
+../Binaries/Converter --to packed Grids.txt Packed_Grids.bin && ../Binaries/Sudoku_Solver --batch --packed-output Packed_Solutions.bin Grids.txt > Solutions.txt && ../Binaries/Converter --solutions Packed_Solutions.bin Unpacked_Solutions.txt
+Result=$?
+[ $Result == 0 ] && [ "`../Binaries/Sudoku_Solver --batch Packed_Grids.bin`" == "`cat Solutions.txt`" ] && cmp -s Solutions.txt Unpacked_Solutions.txt
+Result=$?
+rm -f Grids.txt Packed_Grids.bin Packed_Solutions.bin Solutions.txt Unpacked_Solutions.txt
+if [ $Result != 0 ]
+then
+	PrintFailure
+	exit
+fi
+
+# The grids of all sizes up to 49x49 converted to each format and back must be the same grids, the input format being automatically found
+for File in `ListFiles 6 9 12 16 25 36 49`
+do
+	tr -d '\n' < $File
+	echo
+done > Grids.txt
+Result=0
+for Format in esudoku text line sdk
+do
+	[ "`../Binaries/Converter --to $Format Grids.txt | ../Binaries/Converter`" == "`cat Grids.txt`" ]
+	Result=$?
+	if [ $Result != 0 ]
+	then
+		break
+	fi
+done
+rm -f Grids.txt
+if [ $Result != 0 ]
+then
+	PrintFailure
+	exit
+fi
+
+# The relabeled, transposed and rows swapped copies of generated 9x9 grids must be dropped, and the solutions of the unique grids expanded to all grids must be the batch mode solutions of all grids
+../Binaries/Sudoku_Generator --count 20 --seed 3 > Unique_Grids.txt
+tr '012345678' '876543210' < Unique_Grids.txt > Relabeled_Grids.txt
+awk '{ Grid = ""; for (Column = 0; Column < 9; Column++) for (Row = 0; Row < 9; Row++) Grid = Grid substr($0, Row * 9 + Column + 1, 1); print Grid }' Unique_Grids.txt > Transposed_Grids.txt
+awk '{ print substr($0, 64, 9) substr($0, 55, 9) substr($0, 73, 9) substr($0, 1, 54) }' Unique_Grids.txt > Swapped_Grids.txt
+paste -d '\n' Unique_Grids.txt Relabeled_Grids.txt Transposed_Grids.txt Swapped_Grids.txt > Grids.txt
+../Binaries/Converter --dedup Map.txt Grids.txt Deduplicated_Grids.txt && ../Binaries/Sudoku_Solver --batch Deduplicated_Grids.txt > Solutions.txt && ../Binaries/Converter --expand Map.txt Solutions.txt Expanded_Solutions.txt
+Result=$?
+[ $Result == 0 ] && cmp -s Unique_Grids.txt Deduplicated_Grids.txt && [ "`../Binaries/Sudoku_Solver --batch Grids.txt`" == "`cat Expanded_Solutions.txt`" ]
+Result=$?
+rm -f Unique_Grids.txt Relabeled_Grids.txt Transposed_Grids.txt Swapped_Grids.txt Grids.txt Map.txt Deduplicated_Grids.txt Solutions.txt Expanded_Solutions.txt
+if [ $Result != 0 ]
+then
+	PrintFailure
+	exit
+fi
+
+# The pipelined requests of the grids of all sizes up to 49x49 must receive the batch mode solutions, whatever the order the threads answer them in
+for File in `ListFiles 6 9 12 16 25 36 49`
+do
+	tr -d '\n' < $File
+	echo
+done > Grids.txt
+echo 123 >> Grids.txt
+Identifier=0
+while read Grid
+do
+	PrintDaemonRequest $Identifier "$Grid"
+	Identifier=$((Identifier + 1))
+done < Grids.txt > Requests.bin
+Responses=`../Binaries/Sudoku_Solver --daemon --threads 2 < Requests.bin`
+Result=$?
+[ $Result == 0 ] && [ "`echo "$Responses" | sort -n | awk '{ print $2, $8 }'`" == "`../Binaries/Sudoku_Solver --batch Grids.txt | awk '{ if ($0 == "Bad grid") print "bad-grid -"; else if ($0 == "Unsolvable") print "unsolvable -"; else print "solved", $0 }'`" ]
+Result=$?
+rm -f Grids.txt Requests.bin
+if [ $Result != 0 ]
+then
+	PrintFailure
+	exit
+fi
+
+# Count all solutions of the 6x6 and 9x9 grids with each engine, the counts must be the same and the counts stopped at 2 solutions must agree with them
+for Engine in backtracking dlx
+do
+	for Limit in "" 2
+	do
+		for File in `find 6x6_*.txt 9x9_*.txt`
+		do
+			cat $File
+			echo
+		done | $Program --batch --engine $Engine --count $Limit > Counts_${Engine}_${Limit}.txt
+		if [ $? != 0 ]
+		then
+			PrintFailure
+			exit
+		fi
+	done
+done
+awk '{ if ($1 > 2) print 2; else print $1 }' Counts_backtracking_.txt > Counts_Expected_2.txt
+cmp -s Counts_backtracking_.txt Counts_dlx_.txt && cmp -s Counts_backtracking_2.txt Counts_Expected_2.txt && cmp -s Counts_dlx_2.txt Counts_Expected_2.txt
+Result=$?
+rm -f Counts_*.txt
+if [ $Result != 0 ]
+then
+	PrintFailure
+	exit
+fi
+
+# Generate grids of each size up to 16x16, they must all have a single solution and must not depend on the threads count
+for Grid_Size in 6 9 12 16
+do
+	../Binaries/Sudoku_Generator --size $Grid_Size --count 2 --seed 2 > Generated_Grids_1.txt
+	../Binaries/Sudoku_Generator --size $Grid_Size --count 2 --seed 2 --threads 2 > Generated_Grids_2.txt
+	Counts=`$Program --batch --count 2 Generated_Grids_1.txt`
+	cmp -s Generated_Grids_1.txt Generated_Grids_2.txt && [ "$Counts" == "`printf '1\n1'`" ]
+	Result=$?
+	rm -f Generated_Grids_*.txt
+	if [ $Result != 0 ]
+	then
+		PrintFailure
+		exit
+	fi
+done
+
+# Write the statistics of each 9x9 grid solving with several threads, there must be one record per grid
+for File in `find 9x9_*.txt`
+do
+	cat $File
+	echo
+done | $Program --batch --threads 2 --statistics Statistics.txt > /dev/null
+Result=$?
+Records_Count=`grep -c '^{"grid": [0-9]*, "size": 9, "result": "solved", ' Statistics.txt`
+rm -f Statistics.txt
+if [ $Result != 0 ] || [ "$Records_Count" != `find 9x9_*.txt | wc -l` ]
+then
+	PrintFailure
+	exit
+fi
+
+# The solving of a grid taking a very long time must be stopped by the limits, with each engine and with several threads
+Output=`$Program --cell-order fixed --no-propagation --threads 2 --time-limit 100000 16x16_6.impossible`
+Result=$?
+echo "$Output" | grep -q "reached its time or loops limit" && [ $Result == 1 ]
+Result=$?
+for Engine in backtracking dlx
+do
+	[ $Result == 0 ] && [ "`printf '%081d\n' 0 | tr 0 . | $Program --batch --count --engine $Engine --loops-limit 10000`" == "Timed out" ]
+	Result=$?
+done
+if [ $Result != 0 ]
+then
+	PrintFailure
+	exit
+fi
+
+# A solving stopped by a limit must be resumed from its checkpoint until the grid is solved, then the checkpoint must be removed
+rm -f Checkpoint.txt
+$Program --cell-order fixed --no-propagation --loops-limit 20000 --checkpoint Checkpoint.txt 9x9_2.txt | grep -q "saved to Checkpoint.txt"
+Result=$?
+Resumes_Count=0
+while [ $Result == 0 ] && [ -f Checkpoint.txt ] && [ $Resumes_Count -lt 100 ]
+do
+	$Program --cell-order fixed --no-propagation --loops-limit 20000 --resume Checkpoint.txt > Resumed.txt
+	Resumes_Count=$((Resumes_Count + 1))
+done
+[ $Result == 0 ] && [ ! -f Checkpoint.txt ] && [ $Resumes_Count -gt 1 ] && [ "`sed -n '/Solved grid/,$p' Resumed.txt`" == "`$Program 9x9_2.txt | sed -n '/Solved grid/,$p'`" ]
+Result=$?
+rm -f Checkpoint.txt Resumed.txt
+if [ $Result != 0 ]
+then
+	PrintFailure
+	exit
+fi
+
+# A long solving must print periodic progress reports until it is stopped
+Reports_Count=`$Program --cell-order fixed --no-propagation --progress 1 --time-limit 2500000 16x16_6.impossible 2>&1 > /dev/null | grep -c '^Progress : .* loops/s), depth [0-9]* (deepest [0-9]*), about .* explored.$'`
+if [ "$Reports_Count" != 2 ]
+then
+	PrintFailure
+	exit
+fi
+
+# Run a short benchmark and compare it with itself, the JSON file must be read back and the search must be the same
+../Binaries/Sudoku_Benchmark --repetitions 1 --generated 2 --json Benchmark.json 6x6_*.txt 9x9_*.txt > /dev/null
+Result=$?
+if [ $Result == 0 ]
+then
+	Comparison=`../Binaries/Sudoku_Benchmark --repetitions 1 --generated 2 --baseline Benchmark.json --tolerance 100000 6x6_*.txt 9x9_*.txt`
+	Result=$?
+	echo "$Comparison" | grep -q "search changed\|not measured" && Result=1
+fi
+rm -f Benchmark.json
+if [ $Result != 0 ]
+then
+	PrintFailure
+	exit
+fi
+
+# A numeric option that is not a non-negative integer must be rejected
+for Value in -1 5ms abc 99999999999999999999999
+do
+	for Option in --threads --time-limit --loops-limit --checkpoint-period --progress --count
+	do
+		if ../Binaries/Sudoku_Solver --batch $Option $Value 9x9_1.txt > /dev/null 2>&1
+		then
+			PrintFailure
+			exit
+		fi
+	done
+	
+	for Option in --threads --size --count --givens --seed
+	do
+		if ../Binaries/Sudoku_Generator $Option $Value > /dev/null 2>&1
+		then
+			PrintFailure
+			exit
+		fi
+	done
+done
+
 PrintSuccess